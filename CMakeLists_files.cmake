@@ -79,6 +79,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/models/io/restart.cpp
   opm/models/nonlinear/newtonmethodparams.cpp
   opm/models/parallel/mpiutil.cpp
+  opm/models/parallel/chunkscheduler.cpp
   opm/models/parallel/tasklets.cpp
   opm/models/parallel/threadmanager.cpp
   opm/models/utils/parametersystem.cpp
@@ -173,6 +174,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/GlobalWellInfo.cpp
   opm/simulators/wells/GroupEconomicLimitsChecker.cpp
   opm/simulators/wells/GroupState.cpp
+  opm/simulators/wells/GroupTree.cpp
   opm/simulators/wells/MSWellHelpers.cpp
   opm/simulators/wells/MultisegmentWellAssemble.cpp
   opm/simulators/wells/MultisegmentWellEquations.cpp
@@ -199,6 +201,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/VFPProdProperties.cpp
   opm/simulators/wells/WellAssemble.cpp
   opm/simulators/wells/WellBhpThpCalculator.cpp
+  opm/simulators/wells/WellCommunicationBatch.cpp
   opm/simulators/wells/WellConnectionAuxiliaryModule.cpp
   opm/simulators/wells/WellConstraints.cpp
   opm/simulators/wells/WellConvergence.cpp
@@ -366,6 +369,7 @@ endif()
 # originally generated with the command:
 # find tests -name '*.cpp' -a ! -wholename '*/not-unit/*' -printf '\t%p\n' | sort
 list (APPEND TEST_SOURCE_FILES
+  tests/models/test_chunkscheduler.cpp
   tests/models/test_quadrature.cpp
   tests/models/test_propertysystem.cpp
   tests/models/test_tasklets.cpp
@@ -379,10 +383,13 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_dilu.cpp
   tests/test_equil.cpp
   tests/test_extractMatrix.cpp
+  tests/test_faceassembly.cpp
   tests/test_flexiblesolver.cpp
+  tests/test_gcrodrsolver.cpp
   tests/test_glift1.cpp
   tests/test_graphcoloring.cpp
   tests/test_GroupState.cpp
+  tests/test_incrementaliqupdate.cpp
   tests/test_interregflows.cpp
   tests/test_invert.cpp
   tests/test_keyword_validator.cpp
@@ -393,17 +400,24 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_outputdir.cpp
   tests/test_parametersystem.cpp
   tests/test_parallel_wbp_sourcevalues.cpp
+  tests/test_parallelspmv.cpp
   tests/test_parallelwellinfo.cpp
   tests/test_partitionCells.cpp
+  tests/test_pipelinedsolvers.cpp
   tests/test_preconditionerfactory.cpp
   tests/test_privarspacking.cpp
   tests/test_region_phase_pvaverage.cpp
   tests/test_relpermdiagnostics.cpp
   tests/test_RestartSerialization.cpp
   tests/test_rstconv.cpp
+  tests/test_smalldensematrixkernels.cpp
   tests/test_stoppedwells.cpp
+  tests/test_threadedwells.cpp
   tests/test_timer.cpp
+  tests/test_tracermodel.cpp
+  tests/test_upwindorderedsolver.cpp
   tests/test_vfpproperties.cpp
+  tests/test_wellbhpthpcalculator.cpp
   tests/test_wellmodel.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
@@ -425,6 +439,7 @@ endif()
 
 if(MPI_FOUND)
   list(APPEND TEST_SOURCE_FILES tests/test_ghostlastmatrixadapter.cpp
+                                tests/test_haloexchange.cpp
                                 tests/test_parallelistlinformation.cpp
                                 tests/test_ParallelSerialization.cpp)
 endif()
@@ -504,6 +519,7 @@ list (APPEND TEST_DATA_FILES
   tests/msw.data
   tests/TESTTIMER.DATA
   tests/TESTWELLMODEL.DATA
+  tests/TRACER1.DATA
   tests/liveoil.DATA
   tests/capillary.DATA
   tests/capillary_overlap.DATA
@@ -733,6 +749,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/models/nonlinear/newtonmethodparams.hpp
   opm/models/nonlinear/newtonmethodproperties.hh
   opm/models/nonlinear/nullconvergencewriter.hh
+  opm/models/parallel/chunkedentityiterator.hh
+  opm/models/parallel/chunkscheduler.hpp
   opm/models/parallel/gridcommhandles.hh
   opm/models/parallel/mpibuffer.hh
   opm/models/parallel/mpiutil.hpp
@@ -865,6 +883,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/aquifers/BlackoilAquiferModel.hpp
   opm/simulators/aquifers/BlackoilAquiferModel_impl.hpp
   opm/simulators/aquifers/SupportsFaceTag.hpp
+  opm/simulators/linalg/AmgclPreconditioner.hpp
   opm/simulators/linalg/amgcpr.hh
   opm/simulators/linalg/bicgstabsolver.hh
   opm/simulators/linalg/blacklist.hh
@@ -881,10 +900,13 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlexibleSolver_impl.hpp
   opm/simulators/linalg/FlowLinearSolverParameters.hpp
+  opm/simulators/linalg/FusedReduction.hpp
   opm/simulators/linalg/foreignoverlapfrombcrsmatrix.hh
+  opm/simulators/linalg/GcroDrSolver.hpp
   opm/simulators/linalg/getQuasiImpesWeights.hpp
   opm/simulators/linalg/globalindices.hh
   opm/simulators/linalg/GraphColoring.hpp
+  opm/simulators/linalg/HaloExchange.hpp
   opm/simulators/linalg/ilufirstelement.hh
   opm/simulators/linalg/ISTLSolver.hpp
   opm/simulators/linalg/istlpreconditionerwrappers.hh
@@ -895,6 +917,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/linearsolverreport.hh
   opm/simulators/linalg/matrixblock.hh
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
+  opm/simulators/linalg/MixedPrecisionPreconditioner.hpp
   opm/simulators/linalg/nullborderlistmanager.hh
   opm/simulators/linalg/overlappingbcrsmatrix.hh
   opm/simulators/linalg/overlappingblockvector.hh
@@ -911,6 +934,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/ParallelIstlInformation.hpp
   opm/simulators/linalg/ParallelOverlappingILU0.hpp
   opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp
+  opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp
+  opm/simulators/linalg/PipelinedGMResSolver.hpp
   opm/simulators/linalg/PressureSolverPolicy.hpp
   opm/simulators/linalg/PressureTransferPolicy.hpp
   opm/simulators/linalg/PreconditionerFactory.hpp
@@ -923,6 +948,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/twolevelmethodcpr.hh
   opm/simulators/linalg/vertexborderlistfromgrid.hh
   opm/simulators/linalg/weightedresidreductioncriterion.hh
+  opm/simulators/linalg/ParallelSpMV.hpp
+  opm/simulators/linalg/UpwindOrderedSolver.hpp
   opm/simulators/linalg/WellOperators.hpp
   opm/simulators/linalg/WriteSystemMatrixHelper.hpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp
@@ -972,6 +999,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/GlobalWellInfo.hpp
   opm/simulators/wells/GroupEconomicLimitsChecker.hpp
   opm/simulators/wells/GroupState.hpp
+  opm/simulators/wells/GroupTree.hpp
   opm/simulators/wells/MSWellHelpers.hpp
   opm/simulators/wells/MultisegmentWell.hpp
   opm/simulators/wells/MultisegmentWell_impl.hpp
@@ -999,12 +1027,14 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/StandardWellEval.hpp
   opm/simulators/wells/StandardWellPrimaryVariables.hpp
   opm/simulators/wells/TargetCalculator.hpp
+  opm/simulators/wells/ThreadedWellLoop.hpp
   opm/simulators/wells/VFPHelpers.hpp
   opm/simulators/wells/VFPInjProperties.hpp
   opm/simulators/wells/VFPProdProperties.hpp
   opm/simulators/wells/VFPProperties.hpp
   opm/simulators/wells/WellAssemble.hpp
   opm/simulators/wells/WellBhpThpCalculator.hpp
+  opm/simulators/wells/WellCommunicationBatch.hpp
   opm/simulators/wells/WellConnectionAuxiliaryModule.hpp
   opm/simulators/wells/WellConstraints.hpp
   opm/simulators/wells/WellConvergence.hpp
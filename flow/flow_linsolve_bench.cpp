@@ -0,0 +1,522 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+ * \file
+ *
+ * \brief Replays a linear system written by the linear solver with a list
+ *        of solver configurations.
+ *
+ * Usage: flow_linsolve_bench --matrix=FILE --rhs=FILE [OPTIONS] CONFIG...
+ *
+ * The linear solver writes the system matrix and right hand side to the
+ * 'reports' directory of the output for a linear solver verbosity above
+ * 10, see WriteSystemMatrixHelper.hpp. In serial runs these are the files
+ * '*matrix_istl.mm' and '*rhs_istl.mm'. Parallel runs write one file per
+ * process, '*matrix_istl_<rank>.mm' with the index set in
+ * '*matrix_istl_<rank>.idx', and the system is replayed on the same number
+ * of MPI processes by passing the file names without '_<rank>.mm'.
+ *
+ * Each CONFIG is either a JSON file with a FlexibleSolver configuration or
+ * the name of a predefined configuration of the --linear-solver option
+ * of flow, e.g. 'ilu0', 'dilu', 'amg' or 'cpr'. For each configuration the
+ * solver is set up once and applied REPETITIONS times to the system, and
+ * one line with a JSON object holding the setup time, the average apply
+ * time, the number of iterations, the convergence flag and the resident
+ * memory added by the setup is written. In parallel the times are the
+ * maxima and the memory is the sum over the processes.
+ *
+ * Options:
+ *   --matrix=FILE          the system matrix
+ *   --rhs=FILE             the right hand side
+ *   --wells=FILE           a matrix with the same block size and dimensions
+ *                          which is added to the system matrix, e.g. the
+ *                          well contributions of a run without
+ *                          --matrix-add-well-contributions
+ *   --repetitions=N        number of solves per configuration (default 3)
+ *   --threads=N            number of OpenMP threads (default OMP_NUM_THREADS)
+ *   --pressure-index=N     the pressure unknown of a block for the CPR
+ *                          weights (default 0)
+ *   --output=FILE          append the results to FILE instead of stdout
+ *
+ * The exit status is nonzero if any configuration fails to set up or to
+ * converge, which allows checking for solver regressions.
+ */
+#include "config.h"
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/matrixmarket.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/solver.hh>
+
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/schwarz.hh>
+#include <mpi.h>
+#endif
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/MatrixMarketSpecializations.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+#if HAVE_MPI
+using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
+#endif
+
+struct Options
+{
+    std::string matrixFile;
+    std::string rhsFile;
+    std::string wellsFile;
+    std::vector<std::string> configs;
+    std::string outputFile;
+    int repetitions = 3;
+    int threads = 0;
+    int pressureIndex = 0;
+};
+
+struct Result
+{
+    double setupTime = 0.0;
+    double applyTime = 0.0;
+    int iterations = 0;
+    bool converged = false;
+    double reduction = 0.0;
+    long memoryKB = 0;
+    std::string error;
+};
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " --matrix=FILE --rhs=FILE [--wells=FILE]"
+              << " [--repetitions=N] [--threads=N] [--pressure-index=N] [--output=FILE]"
+              << " CONFIG...\n"
+              << "CONFIG is a JSON file with a FlexibleSolver configuration or a\n"
+              << "predefined configuration of flow's --linear-solver option.\n";
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            opts.configs.push_back(arg);
+            continue;
+        }
+        const auto pos = arg.find('=');
+        if (pos == std::string::npos) {
+            throw std::invalid_argument("Option '" + arg + "' has no value");
+        }
+        const std::string key = arg.substr(2, pos - 2);
+        const std::string value = arg.substr(pos + 1);
+        if (key == "matrix") {
+            opts.matrixFile = value;
+        } else if (key == "rhs") {
+            opts.rhsFile = value;
+        } else if (key == "wells") {
+            opts.wellsFile = value;
+        } else if (key == "output") {
+            opts.outputFile = value;
+        } else if (key == "repetitions") {
+            opts.repetitions = std::max(1, std::stoi(value));
+        } else if (key == "threads") {
+            opts.threads = std::stoi(value);
+        } else if (key == "pressure-index") {
+            opts.pressureIndex = std::stoi(value);
+        } else {
+            throw std::invalid_argument("Unknown option '" + arg + "'");
+        }
+    }
+    if (opts.matrixFile.empty() || opts.rhsFile.empty() || opts.configs.empty()) {
+        throw std::invalid_argument("A matrix, a right hand side and at least one configuration are required");
+    }
+    return opts;
+}
+
+// The name of the file read by this process, see storeMatrixMarket().
+std::string localFileName(const std::string& name, const int rank, const int size)
+{
+    return size > 1 ? name + "_" + std::to_string(rank) + ".mm" : name;
+}
+
+// The block size from the '% ISTL_STRUCT blocked n n' header line written
+// by storeMatrixMarket(), 1 if there is none.
+int readBlockSize(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open matrix file '" + filename + "'");
+    }
+    std::string line;
+    while (std::getline(file, line) && !line.empty() && line[0] == '%') {
+        std::istringstream header(line);
+        std::string percent, istlStruct, blocked;
+        int rows = 0;
+        int cols = 0;
+        if (header >> percent >> istlStruct >> blocked >> rows >> cols &&
+            istlStruct == "ISTL_STRUCT" && blocked == "blocked") {
+            if (rows != cols) {
+                throw std::runtime_error("Matrix blocks are not square in '" + filename + "'");
+            }
+            return rows;
+        }
+    }
+    return 1;
+}
+
+// Resident memory of the process, -1 if unknown.
+long residentMemoryKB()
+{
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    if (statm >> size >> resident) {
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+    return -1;
+}
+
+Opm::PropertyTree createConfig(const std::string& config)
+{
+    if (std::filesystem::is_regular_file(config)) {
+        return Opm::PropertyTree(config);
+    }
+    Opm::FlowLinearSolverParameters params;
+    params.linsolver_ = config;
+    params.linear_solver_print_json_definition_ = false;
+    return Opm::setupPropertyTree(params, false, false);
+}
+
+std::string jsonEscape(const std::string& text)
+{
+    std::string escaped;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Returns A + W, whose sparsity pattern is the union of both.
+template <class Matrix>
+Matrix addMatrices(const Matrix& A, const Matrix& W)
+{
+    if (A.N() != W.N() || A.M() != W.M()) {
+        throw std::runtime_error("The well matrix does not have the dimensions of the system matrix");
+    }
+    std::vector<std::vector<std::size_t>> pattern(A.N());
+    for (std::size_t row = 0; row < A.N(); ++row) {
+        std::vector<std::size_t> colsA;
+        for (auto col = A[row].begin(); col != A[row].end(); ++col) {
+            colsA.push_back(col.index());
+        }
+        std::vector<std::size_t> colsW;
+        for (auto col = W[row].begin(); col != W[row].end(); ++col) {
+            colsW.push_back(col.index());
+        }
+        std::set_union(colsA.begin(), colsA.end(), colsW.begin(), colsW.end(),
+                       std::back_inserter(pattern[row]));
+    }
+
+    Matrix sum(A.N(), A.M(), Matrix::random);
+    for (std::size_t row = 0; row < A.N(); ++row) {
+        sum.setrowsize(row, pattern[row].size());
+    }
+    sum.endrowsizes();
+    for (std::size_t row = 0; row < A.N(); ++row) {
+        for (const auto col : pattern[row]) {
+            sum.addindex(row, col);
+        }
+    }
+    sum.endindices();
+    sum = 0.0;
+    for (const Matrix* term : {&A, &W}) {
+        for (auto row = term->begin(); row != term->end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                sum[row.index()][col.index()] += *col;
+            }
+        }
+    }
+    return sum;
+}
+
+template <class Operator, class Matrix, class Vector, class... Comm>
+Result benchmark(Operator& op,
+                 const Matrix& A,
+                 const Vector& b,
+                 const Opm::PropertyTree& prm,
+                 const Options& opts,
+                 const Comm&... comm)
+{
+    Result result;
+    const bool transpose = prm.get<std::string>("preconditioner.type", "") == "cprt";
+    const int pressureIndex = opts.pressureIndex;
+    auto weightsCalculator = [&A, pressureIndex, transpose]()
+    {
+        return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(A, pressureIndex, transpose);
+    };
+
+    const long memoryBefore = residentMemoryKB();
+    Dune::Timer timer;
+    Dune::FlexibleSolver<Operator> solver(op, comm..., prm, weightsCalculator, pressureIndex);
+    result.setupTime = timer.elapsed();
+    const long memoryAfter = residentMemoryKB();
+    result.memoryKB = memoryBefore < 0 ? -1 : memoryAfter - memoryBefore;
+
+    for (int rep = 0; rep < opts.repetitions; ++rep) {
+        Vector x(b.size());
+        x = 0.0;
+        Vector rhs = b;
+        Dune::InverseOperatorResult res;
+        timer.reset();
+        solver.apply(x, rhs, res);
+        result.applyTime += timer.elapsed();
+        result.iterations = res.iterations;
+        result.converged = res.converged;
+        result.reduction = res.reduction;
+    }
+    result.applyTime /= opts.repetitions;
+    return result;
+}
+
+// Print the error and terminate all processes. Used for errors which may
+// be thrown on some of the processes only, while the others wait in a
+// collective operation.
+[[noreturn]] void abortAll(const int rank, const std::string& message)
+{
+    std::cerr << "Rank " << rank << ": " << message << std::endl;
+#if HAVE_MPI
+    if (Dune::MPIHelper::getCommunication().size() > 1) {
+        MPI_Abort(Dune::MPIHelper::getCommunicator(), EXIT_FAILURE);
+    }
+#endif
+    std::exit(EXIT_FAILURE);
+}
+
+template <int bz>
+int run(const Options& opts, std::ostream& out)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+
+    const auto& mpiComm = Dune::MPIHelper::getCommunication();
+    const int rank = mpiComm.rank();
+    const int size = mpiComm.size();
+
+    Matrix A;
+    Vector b;
+#if HAVE_MPI
+    Communication comm(Dune::MPIHelper::getCommunicator());
+#endif
+    if (size > 1) {
+#if HAVE_MPI
+        Dune::loadMatrixMarket(A, opts.matrixFile, comm, true);
+        Dune::loadMatrixMarket(b, opts.rhsFile, comm, false);
+        if (!opts.wellsFile.empty()) {
+            Matrix W;
+            Dune::loadMatrixMarket(W, opts.wellsFile, comm, false);
+            A = addMatrices(A, W);
+        }
+#endif
+    } else {
+        Dune::loadMatrixMarket(A, opts.matrixFile);
+        Dune::loadMatrixMarket(b, opts.rhsFile);
+        if (!opts.wellsFile.empty()) {
+            Matrix W;
+            Dune::loadMatrixMarket(W, opts.wellsFile);
+            A = addMatrices(A, W);
+        }
+    }
+
+    int threads = 1;
+#if HAVE_OPENMP
+    threads = omp_get_max_threads();
+#endif
+
+    int status = EXIT_SUCCESS;
+    for (const auto& config : opts.configs) {
+        Result result;
+        Opm::PropertyTree prm;
+        try {
+            prm = createConfig(config);
+        }
+        catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        // A configuration which cannot be read is skipped on all processes.
+        if (!mpiComm.max(static_cast<int>(!result.error.empty()))) {
+            try {
+                if (size > 1) {
+#if HAVE_MPI
+                    using Operator = Dune::OverlappingSchwarzOperator<Matrix, Vector, Vector, Communication>;
+                    Operator op(A, comm);
+                    result = benchmark(op, A, b, prm, opts, comm);
+#endif
+                } else {
+                    using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+                    Operator op(A);
+                    result = benchmark(op, A, b, prm, opts);
+                }
+            }
+            catch (const std::exception& e) {
+                if (size > 1) {
+                    // the other processes may be inside the solver
+                    abortAll(rank, e.what());
+                }
+                result.error = e.what();
+            }
+        }
+
+        const bool failed = mpiComm.max(static_cast<int>(!result.error.empty() || !result.converged));
+        result.setupTime = mpiComm.max(result.setupTime);
+        result.applyTime = mpiComm.max(result.applyTime);
+        result.memoryKB = mpiComm.sum(result.memoryKB);
+        if (failed) {
+            status = EXIT_FAILURE;
+        }
+        if (rank == 0) {
+            out << "{\"config\": \"" << jsonEscape(config) << "\""
+                << ", \"block_size\": " << bz
+                << ", \"ranks\": " << size
+                << ", \"threads\": " << threads
+                << std::scientific << std::setprecision(6)
+                << ", \"setup_time\": " << result.setupTime
+                << ", \"apply_time\": " << result.applyTime
+                << ", \"iterations\": " << result.iterations
+                << ", \"converged\": " << (failed ? "false" : "true")
+                << ", \"reduction\": " << result.reduction
+                << ", \"memory_kb\": " << result.memoryKB;
+            if (!result.error.empty()) {
+                out << ", \"error\": \"" << jsonEscape(result.error) << "\"";
+            }
+            out << "}" << std::endl;
+        }
+    }
+    return status;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const auto& helper = Dune::MPIHelper::instance(argc, argv);
+    const int rank = helper.rank();
+    const int size = helper.size();
+
+    Options opts;
+    try {
+        opts = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e) {
+        if (rank == 0) {
+            std::cerr << e.what() << "\n";
+            printUsage(argv[0]);
+        }
+        return EXIT_FAILURE;
+    }
+
+#if HAVE_OPENMP
+    if (opts.threads > 0) {
+        omp_set_num_threads(opts.threads);
+    }
+#endif
+
+    // Errors which do not occur on all processes must be agreed on, such
+    // that all processes return instead of waiting for each other.
+    const auto& comm = helper.getCommunication();
+    std::ofstream outputFile;
+    int openFailed = 0;
+    if (!opts.outputFile.empty() && rank == 0) {
+        outputFile.open(opts.outputFile, std::ios::app);
+        openFailed = !outputFile;
+    }
+    if (comm.max(openFailed)) {
+        if (rank == 0) {
+            std::cerr << "Could not open output file '" << opts.outputFile << "'\n";
+        }
+        return EXIT_FAILURE;
+    }
+    std::ostream& out = outputFile.is_open() ? outputFile : std::cout;
+
+    int bz = 0;
+    try {
+        bz = readBlockSize(localFileName(opts.matrixFile, rank, size));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Rank " << rank << ": " << e.what() << std::endl;
+        bz = -1;
+    }
+    if (comm.min(bz) < 0) {
+        return EXIT_FAILURE;
+    }
+    if (comm.min(bz) != comm.max(bz)) {
+        if (rank == 0) {
+            std::cerr << "The block sizes of the matrix files differ between the processes\n";
+        }
+        return EXIT_FAILURE;
+    }
+
+    try {
+        switch (bz) {
+        case 1: return run<1>(opts, out);
+        case 2: return run<2>(opts, out);
+        case 3: return run<3>(opts, out);
+        case 4: return run<4>(opts, out);
+        case 5: return run<5>(opts, out);
+        case 6: return run<6>(opts, out);
+        default:
+            if (rank == 0) {
+                std::cerr << "Unsupported block size " << bz << "\n";
+            }
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& e) {
+        // e.g. a matrix file which cannot be read on some of the processes
+        abortAll(rank, e.what());
+    }
+}
@@ -39,10 +39,14 @@
 #include "blackoilconvectivemixingmodule.hh"
 #include "blackoildispersionmodule.hh"
 #include "blackoilmicpmodules.hh"
+#include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/fluidstates/BlackOilFluidState.hpp>
 #include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/input/eclipse/Schedule/BCProp.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Opm {
 /*!
  * \ingroup BlackOilModel
@@ -134,6 +138,12 @@ public:
         ConvectiveMixingModuleParam convectiveMixingModuleParam;
     };
 
+    //! Evaluation with regard to the primary variables of both cells of a
+    //! face: the first numEq derivatives belong to the interior cell, the
+    //! others to the exterior cell.
+    using FaceEvaluation = DenseAd::Evaluation<Scalar, 2*numEq>;
+    using FaceRateVector = Dune::FieldVector<FaceEvaluation, numEq>;
+
     /*!
      * \copydoc FvBaseLocalResidual::computeStorage
      */
@@ -503,6 +513,163 @@ public:
 
     }
 
+    /*!
+     * \brief Returns true if computeFaceFlux() yields the same fluxes as
+     *        computeFlux() for the current problem.
+     *
+     * The face flux only covers the flow of the black-oil phases. It can
+     * thus not be used by thermal models, with dispersion, or if diffusion
+     * or convective mixing are active.
+     */
+    static bool faceFluxApplicable([[maybe_unused]] const ModuleParams& moduleParams)
+    {
+        if constexpr (enableEnergy || enableDispersion) {
+            return false;
+        }
+        if (enableDiffusion && FluidSystem::enableDiffusion()) {
+            return false;
+        }
+        if constexpr (enableConvectiveMixing) {
+            const auto& active = moduleParams.convectiveMixingModuleParam.active_;
+            if (std::find(active.begin(), active.end(), true) != active.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Calculate the flux over a face with derivatives with regard to
+     *        the primary variables of both adjacent cells.
+     *
+     * A single evaluation yields the flux and the derivatives which
+     * computeFlux() yields when it is called once for each side of the
+     * face: the first numEq derivatives are those of the flux from the
+     * interior cell, the others are those of the flux from the exterior
+     * cell with reversed sign. Only valid if faceFluxApplicable() is true.
+     */
+    static void computeFaceFlux(FaceRateVector& flux,
+                                RateVector& darcy,
+                                const unsigned globalIndexIn,
+                                const unsigned globalIndexEx,
+                                const IntensiveQuantities& intQuantsIn,
+                                const IntensiveQuantities& intQuantsEx,
+                                const ResidualNBInfo& nbInfo)
+    {
+        OPM_TIMEBLOCK_LOCAL(computeFaceFlux);
+        flux = 0.0;
+        darcy = 0.0;
+
+        const Scalar trans = nbInfo.trans;
+        const Scalar faceArea = nbInfo.faceArea;
+        const Scalar thpres = nbInfo.thpres;
+        const FaceDir::DirEnum facedir = nbInfo.faceDir;
+        const auto& fsIn = intQuantsIn.fluidState();
+        const auto& fsEx = intQuantsEx.fluidState();
+
+        const FaceEvaluation transMult = (toFace_(intQuantsIn.rockCompTransMultiplier(), 0) +
+                                          toFace_(intQuantsEx.rockCompTransMultiplier(), 1)) / 2;
+
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                continue;
+            }
+            // the phase does not flow if it is immobile on both sides
+            if (intQuantsIn.mobility(phaseIdx) <= 0.0 &&
+                intQuantsEx.mobility(phaseIdx) <= 0.0)
+            {
+                continue;
+            }
+
+            // the same pressure difference and upstream cell as
+            // ExtensiveQuantities::calculatePhasePressureDiff_()
+            const FaceEvaluation rhoAvg = (toFace_(fsIn.density(phaseIdx), 0) +
+                                           toFace_(fsEx.density(phaseIdx), 1)) / 2;
+            FaceEvaluation pressureDifference = toFace_(fsEx.pressure(phaseIdx), 1)
+                + rhoAvg * nbInfo.dZg
+                - toFace_(fsIn.pressure(phaseIdx), 0);
+
+            bool upIsIn;
+            if (pressureDifference > 0.0) {
+                upIsIn = false;
+            }
+            else if (pressureDifference < 0.0) {
+                upIsIn = true;
+            }
+            else if (nbInfo.Vin != nbInfo.Vex) {
+                upIsIn = nbInfo.Vin > nbInfo.Vex;
+            }
+            else {
+                upIsIn = globalIndexIn < globalIndexEx;
+            }
+
+            if (thpres > 0.0) {
+                if (std::abs(pressureDifference.value()) > thpres) {
+                    if (pressureDifference < 0.0) {
+                        pressureDifference += thpres;
+                    }
+                    else {
+                        pressureDifference -= thpres;
+                    }
+                }
+                else {
+                    pressureDifference = 0.0;
+                }
+            }
+
+            const IntensiveQuantities& up = upIsIn ? intQuantsIn : intQuantsEx;
+            const unsigned upSide = upIsIn ? 0 : 1;
+            const FaceEvaluation darcyFlux = pressureDifference
+                * toFace_(up.mobility(phaseIdx, facedir), upSide) * transMult * (-trans / faceArea);
+
+            const unsigned activeCompIdx =
+                Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
+            darcy[conti0EqIdx + activeCompIdx] = darcyFlux.value() * faceArea;
+
+            const unsigned pvtRegionIdx = up.pvtRegionIndex();
+            const auto& upFs = up.fluidState();
+            const FaceEvaluation surfaceVolumeFlux =
+                toFace_(getInvB_<FluidSystem, FluidState, Evaluation>(upFs, phaseIdx, pvtRegionIdx), upSide)
+                * darcyFlux;
+
+            // same as evalPhaseFluxes_()
+            const auto addComponentFlux = [&](const unsigned compIdx,
+                                              const unsigned refPhaseIdx,
+                                              const FaceEvaluation& surfaceFlux)
+            {
+                const unsigned eqIdx = conti0EqIdx + Indices::canonicalToActiveComponentIndex(compIdx);
+                if (blackoilConserveSurfaceVolume)
+                    flux[eqIdx] += surfaceFlux;
+                else
+                    flux[eqIdx] += surfaceFlux * FluidSystem::referenceDensity(refPhaseIdx, pvtRegionIdx);
+            };
+
+            addComponentFlux(FluidSystem::solventComponentIndex(phaseIdx), phaseIdx, surfaceVolumeFlux);
+            if (phaseIdx == oilPhaseIdx) {
+                if (FluidSystem::enableDissolvedGas()) {
+                    const auto& Rs = BlackOil::getRs_<FluidSystem, FluidState, Evaluation>(upFs, pvtRegionIdx);
+                    addComponentFlux(gasCompIdx, gasPhaseIdx, toFace_(Rs, upSide) * surfaceVolumeFlux);
+                }
+            }
+            else if (phaseIdx == waterPhaseIdx) {
+                if (FluidSystem::enableDissolvedGasInWater()) {
+                    const auto& Rsw = BlackOil::getRsw_<FluidSystem, FluidState, Evaluation>(upFs, pvtRegionIdx);
+                    addComponentFlux(gasCompIdx, gasPhaseIdx, toFace_(Rsw, upSide) * surfaceVolumeFlux);
+                }
+            }
+            else if (phaseIdx == gasPhaseIdx) {
+                if (FluidSystem::enableVaporizedOil()) {
+                    const auto& Rv = BlackOil::getRv_<FluidSystem, FluidState, Evaluation>(upFs, pvtRegionIdx);
+                    addComponentFlux(oilCompIdx, oilPhaseIdx, toFace_(Rv, upSide) * surfaceVolumeFlux);
+                }
+                if (FluidSystem::enableVaporizedWater()) {
+                    const auto& Rvw = BlackOil::getRvw_<FluidSystem, FluidState, Evaluation>(upFs, pvtRegionIdx);
+                    addComponentFlux(waterCompIdx, waterPhaseIdx, toFace_(Rvw, upSide) * surfaceVolumeFlux);
+                }
+            }
+        }
+    }
+
     template <class BoundaryConditionData>
     static void computeBoundaryFlux(RateVector& bdyFlux,
                                     const Problem& problem,
@@ -851,6 +1018,18 @@ public:
     }
 
 
+    // Converts a quantity of one cell of a face to an evaluation with
+    // regard to the primary variables of both cells. 'side' is 0 for the
+    // interior and 1 for the exterior cell.
+    static FaceEvaluation toFace_(const Evaluation& value, const unsigned side)
+    {
+        FaceEvaluation result(value.value());
+        for (unsigned pvIdx = 0; pvIdx < numEq; ++pvIdx) {
+            result.setDerivative(side*numEq + pvIdx, value.derivative(pvIdx));
+        }
+        return result;
+    }
+
     static FaceDir::DirEnum faceDirFromDirId(const int dirId)
     {
         // NNC does not have a direction
@@ -413,6 +413,11 @@ protected:
         }
 
         if (wasSwitched_[globalDofIdx]) {
+            // the subdomain variant of update_() may be called concurrently
+            // for disjoint sets of degrees of freedom
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
             ++numPriVarsSwitched_;
         }
         if (bparams_.projectSaturations_) {
@@ -428,8 +433,9 @@ private:
     BlackoilNewtonParams<Scalar> bparams_{};
 
     // keep track of cells where the primary variable meaning has changed
-    // to detect and hinder oscillations
-    std::vector<bool> wasSwitched_{};
+    // to detect and hinder oscillations. (not a std::vector<bool> to allow
+    // concurrent updates of different cells.)
+    std::vector<unsigned char> wasSwitched_{};
 };
 
 } // namespace Opm
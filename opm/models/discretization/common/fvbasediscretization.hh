@@ -55,6 +55,7 @@
 
 #include <opm/models/io/vtkprimaryvarsmodule.hpp>
 
+#include <opm/models/parallel/chunkedentityiterator.hh>
 #include <opm/models/parallel/gridcommhandles.hh>
 #include <opm/models/parallel/threadmanager.hpp>
 
@@ -69,6 +70,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 #include <string>
@@ -703,6 +705,9 @@ public:
             return;
 
         intensiveQuantityCacheUpToDate_[timeIdx][globalIdx] = newValue ? 1 : 0;
+        if (!newValue && timeIdx == 0 && trackIntensiveQuantityChanges_) {
+            intensiveQuantityChanged_[globalIdx] = 1;
+        }
     }
 
     /*!
@@ -717,6 +722,59 @@ public:
                       intensiveQuantityCacheUpToDate_[timeIdx].end(),
                       /*value=*/0);
         }
+        if (timeIdx == 0) {
+            allIntensiveQuantitiesChanged_ = true;
+        }
+    }
+
+    /*!
+     * \brief Enable or disable keeping track of the degrees of freedom whose
+     *        intensive quantities for the most recent time index have been
+     *        invalidated.
+     *
+     * This allows the linearizer to skip the terms which only depend on
+     * unchanged intensive quantities. It requires the intensive quantity cache.
+     */
+    void setTrackIntensiveQuantityChanges(bool yesno)
+    {
+        trackIntensiveQuantityChanges_ = yesno && storeIntensiveQuantities();
+        intensiveQuantityChanged_.assign(trackIntensiveQuantityChanges_ ? asImp_().numGridDof() : 0, 1);
+        allIntensiveQuantitiesChanged_ = true;
+    }
+
+    /*!
+     * \brief Returns true if the model keeps track of changed intensive quantities.
+     */
+    bool trackIntensiveQuantityChanges() const
+    { return trackIntensiveQuantityChanges_; }
+
+    /*!
+     * \brief Returns the flags of the degrees of freedom whose intensive
+     *        quantities for time index 0 were invalidated since the last call
+     *        to resetIntensiveQuantityChanges().
+     *
+     * A null pointer is returned if the changes are not tracked or if the
+     * whole cache has been invalidated in the meantime, i.e., if all degrees
+     * of freedom must be considered to be changed.
+     */
+    const std::vector<unsigned char>* changedIntensiveQuantities() const
+    {
+        if (!trackIntensiveQuantityChanges_ || allIntensiveQuantitiesChanged_) {
+            return nullptr;
+        }
+        return &intensiveQuantityChanged_;
+    }
+
+    /*!
+     * \brief Mark the intensive quantities of all degrees of freedom as unchanged.
+     */
+    void resetIntensiveQuantityChanges() const
+    {
+        if (!trackIntensiveQuantityChanges_) {
+            return;
+        }
+        std::fill(intensiveQuantityChanged_.begin(), intensiveQuantityChanged_.end(), /*value=*/0);
+        allIntensiveQuantitiesChanged_ = false;
     }
 
     void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx) const
@@ -724,18 +782,18 @@ public:
         invalidateIntensiveQuantitiesCache(timeIdx);
 
         // loop over all elements...
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_);
+        auto& chunkedElemIt = chunkedElementIterator_();
+        chunkedElemIt.reset();
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
             ElementContext elemCtx(simulator_);
-            ElementIterator elemIt = threadedElemIt.beginParallel();
-            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
-                const Element& elem = *elemIt;
+            chunkedElemIt.forEach([&](const Element& elem)
+            {
                 elemCtx.updatePrimaryStencil(elem);
                 elemCtx.updatePrimaryIntensiveQuantities(timeIdx);
-            }
+            });
         }
     }
 
@@ -743,19 +801,18 @@ public:
     void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx, const GridViewType& gridView) const
     {
         // loop over all elements...
-        ThreadedEntityIterator<GridViewType, /*codim=*/0> threadedElemIt(gridView);
+        ChunkedEntityIterator<GridViewType, /*codim=*/0> chunkedElemIt(gridView);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
 
             ElementContext elemCtx(simulator_);
-            auto elemIt = threadedElemIt.beginParallel();
-            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
-                if (elemIt->partitionType() != Dune::InteriorEntity) {
-                    continue;
+            chunkedElemIt.forEach([&](const auto& elem)
+            {
+                if (elem.partitionType() != Dune::InteriorEntity) {
+                    return;
                 }
-                const Element& elem = *elemIt;
                 elemCtx.updatePrimaryStencil(elem);
                 // Mark cache for this element as invalid.
                 const std::size_t numPrimaryDof = elemCtx.numPrimaryDof(timeIdx);
@@ -765,7 +822,7 @@ public:
                 }
                 // Update for this element.
                 elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            }
+            });
         }
     }
 
@@ -1829,8 +1886,28 @@ public:
     }
 
 protected:
+    using ChunkedElementIterator = ChunkedEntityIterator<GridView, /*codim=*/0>;
+
+    /*!
+     * \brief Returns the chunked iterator over all elements of the grid view.
+     *
+     * The chunk boundaries only depend on the grid, so they are computed once
+     * and reused by all threaded loops until the grid changes. This method
+     * must be called in a sequential context.
+     */
+    ChunkedElementIterator& chunkedElementIterator_() const
+    {
+        if (!chunkedElemIt_) {
+            chunkedElemIt_ = std::make_unique<ChunkedElementIterator>(gridView_);
+        }
+        return *chunkedElemIt_;
+    }
+
     void resizeAndResetIntensiveQuantitiesCache_()
     {
+        // the grid may have changed
+        chunkedElemIt_.reset();
+
         // allocate the storage cache
         if (enableStorageCache()) {
             size_t numDof = asImp_().numGridDof();
@@ -1848,6 +1925,11 @@ protected:
                 invalidateIntensiveQuantitiesCache(timeIdx);
             }
         }
+
+        if (trackIntensiveQuantityChanges_) {
+            intensiveQuantityChanged_.assign(asImp_().numGridDof(), 1);
+        }
+        allIntensiveQuantitiesChanged_ = true;
     }
     template <class Context>
     void supplementInitialSolution_(PrimaryVariables&,
@@ -1922,6 +2004,14 @@ protected:
 
     mutable std::array< std::unique_ptr< DiscreteFunction >, historySize > solution_;
 
+    mutable std::unique_ptr<ChunkedElementIterator> chunkedElemIt_;
+
+    // flags of the degrees of freedom whose intensive quantities for time index 0 were
+    // invalidated since the last call to resetIntensiveQuantityChanges()
+    mutable std::vector<unsigned char> intensiveQuantityChanged_;
+    mutable bool allIntensiveQuantitiesChanged_ = true;
+    bool trackIntensiveQuantityChanges_ = false;
+
     std::list<BaseOutputModule<TypeTag>*> outputModules_;
 
     Scalar gridTotalVolume_;
@@ -124,6 +124,12 @@ struct MinTimeStepSize { static constexpr Scalar value = 0.0; };
  */
 struct OutputDir { static constexpr auto value = ""; };
 
+//! \brief Number of consecutive grid entities handed out at once by chunked threaded iterations.
+struct ThreadedIterationChunkSize { static constexpr unsigned value = 64; };
+
+//! \brief Scheduling policy of chunked threaded iterations ("static", "dynamic" or "stealing").
+struct ThreadedIterationMode { static constexpr auto value = "dynamic"; };
+
 //! \brief Number of threads per process.
 struct ThreadsPerProcess { static constexpr int value = 1; };
 
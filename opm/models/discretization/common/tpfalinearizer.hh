@@ -44,19 +44,36 @@
 #include <opm/models/discretization/common/fvbaseproperties.hh>
 #include <opm/models/discretization/common/linearizationtype.hh>
 
+#include <atomic>
+#include <cstdint>
 #include <exception>   // current_exception, rethrow_exception
 #include <iostream>
 #include <numeric>
 #include <set>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 namespace Opm::Parameters {
 
 struct SeparateSparseSourceTerms { static constexpr bool value = false; };
+struct FaceBasedAssembly { static constexpr bool value = false; };
 
 } // namespace Opm::Parameters
 
+namespace Opm::detail {
+
+//! True if the local residual can evaluate the flux over a face with
+//! derivatives with regard to both adjacent cells.
+template <class LocalResidual, class = void>
+struct HasFaceFlux : std::false_type {};
+
+template <class LocalResidual>
+struct HasFaceFlux<LocalResidual, std::void_t<typename LocalResidual::FaceRateVector>>
+    : std::true_type {};
+
+} // namespace Opm::detail
+
 namespace Opm {
 
 // forward declarations
@@ -108,6 +125,7 @@ class TpfaLinearizer
     static const bool linearizeNonLocalElements = getPropValue<TypeTag, Properties::LinearizeNonLocalElements>();
     static const bool enableEnergy = getPropValue<TypeTag, Properties::EnableEnergy>();
     static const bool enableDiffusion = getPropValue<TypeTag, Properties::EnableDiffusion>();
+    static constexpr bool hasFaceFlux = detail::HasFaceFlux<LocalResidual>::value;
 
     // copying the linearizer is not a good idea
     TpfaLinearizer(const TpfaLinearizer&) = delete;
@@ -119,6 +137,7 @@ public:
     {
         simulatorPtr_ = 0;
         separateSparseSourceTerms_ = Parameters::Get<Parameters::SeparateSparseSourceTerms>();
+        faceBasedAssembly_ = hasFaceFlux && Parameters::Get<Parameters::FaceBasedAssembly>();
     }
 
     ~TpfaLinearizer()
@@ -132,6 +151,10 @@ public:
     {
         Parameters::Register<Parameters::SeparateSparseSourceTerms>
             ("Treat well source terms all in one go, instead of on a cell by cell basis.");
+        Parameters::Register<Parameters::FaceBasedAssembly>
+            ("Assemble the flux terms by looping over the faces and evaluate the flux "
+             "over each face only once. Falls back to the cell based assembly where "
+             "the flux model does not support it.");
     }
 
     /*!
@@ -234,14 +257,28 @@ public:
             initFirstIteration_();
 
         // Called here because it is no longer called from linearize_().
-        if (domain.cells.size() == model_().numTotalDof()) {
+        const bool on_full_domain = (domain.cells.size() == model_().numTotalDof());
+        const std::vector<unsigned char>* changedCells = nullptr;
+        if (on_full_domain) {
             // We are on the full domain.
-            resetSystem_();
+            changedCells = reusableFluxCells_();
+            if (changedCells) {
+                resetSystemKeepingFluxes_();
+            } else {
+                resetSystem_();
+            }
         } else {
             resetSystem_(domain);
         }
 
-        linearize_(domain);
+        // the cached flux terms are only consistent with the system if the
+        // linearization of the full domain succeeds
+        fluxCacheValid_ = false;
+        linearize_(domain, changedCells);
+        if (on_full_domain && storeFluxes_()) {
+            fluxCacheValid_ = true;
+            model_().resetIntensiveQuantityChanges();
+        }
     }
 
     void finalize()
@@ -401,6 +438,7 @@ private:
     {
         // initialize the BCRS matrix for the Jacobian of the residual function
         createMatrix_();
+        fluxCacheValid_ = false;
 
         // initialize the Jacobian matrix and the vector for the residual function
         residual_.resize(model_().numTotalDof());
@@ -522,6 +560,65 @@ private:
         // Create dummy full domain.
         fullDomain_.cells.resize(numCells);
         std::iota(fullDomain_.cells.begin(), fullDomain_.cells.end(), 0);
+
+        if (faceBasedAssembly_) {
+            createFaces_();
+        }
+    }
+
+    // Create the list of faces used by the face based assembly, grouped by
+    // colors such that no two faces of the same color share a cell.
+    void createFaces_()
+    {
+        OPM_TIMEBLOCK(createFaces);
+        const unsigned numCells = model_().numTotalDof();
+
+        // Faces which cannot be colored with one of the first maxColors
+        // colors are put into an extra batch which is processed serially.
+        constexpr unsigned maxColors = 64;
+        std::vector<std::uint64_t> usedColors(numCells, 0);
+        std::vector<std::vector<FaceInfo>> facesPerColor(maxColors + 1);
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            const auto& nbInfos = neighborInfo_[globI];
+            for (unsigned locI = 0; locI < nbInfos.size(); ++locI) {
+                const unsigned globJ = nbInfos[locI].neighbor;
+                if (globJ < globI) {
+                    // already added from the other side
+                    continue;
+                }
+                const auto& nbInfosJ = neighborInfo_[globJ];
+                unsigned locJ = 0;
+                while (locJ < nbInfosJ.size() && nbInfosJ[locJ].neighbor != globI) {
+                    ++locJ;
+                }
+                if (locJ == nbInfosJ.size()) {
+                    OPM_THROW(std::logic_error,
+                              "Neighbor relation between cells " + std::to_string(globI) +
+                              " and " + std::to_string(globJ) + " is not symmetric");
+                }
+
+                const std::uint64_t used = usedColors[globI] | usedColors[globJ];
+                unsigned color = maxColors;
+                if (~used != 0) {
+                    // index of the lowest unset bit
+                    color = 0;
+                    while (used & (std::uint64_t(1) << color)) {
+                        ++color;
+                    }
+                    usedColors[globI] |= std::uint64_t(1) << color;
+                    usedColors[globJ] |= std::uint64_t(1) << color;
+                }
+                facesPerColor[color].push_back(FaceInfo{globI, globJ, locI, locJ});
+            }
+        }
+
+        faceColors_ = SparseTable<FaceInfo>();
+        for (unsigned color = 0; color < maxColors; ++color) {
+            if (!facesPerColor[color].empty()) {
+                faceColors_.appendRow(facesPerColor[color].begin(), facesPerColor[color].end());
+            }
+        }
+        serialFaces_ = std::move(facesPerColor[maxColors]);
     }
 
     // reset the global linear system of equations.
@@ -532,6 +629,41 @@ private:
         jacobian_->clear();
     }
 
+    // reset the residual and the diagonal blocks of the Jacobian. The
+    // off-diagonal blocks are only written by the flux terms, so they are
+    // kept for the cells whose flux terms are reused and overwritten by
+    // linearize_() for all others.
+    void resetSystemKeepingFluxes_()
+    {
+        residual_ = 0.0;
+        const std::size_t numCells = diagMatAddress_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t globI = 0; globI < numCells; ++globI) {
+            *diagMatAddress_[globI] = 0.0;
+        }
+    }
+
+    // Returns true if the flux terms of each cell are stored, so that they can
+    // be reused by the next linearization for the cells whose intensive
+    // quantities and those of their neighbors did not change.
+    bool storeFluxes_() const
+    { return model_().trackIntensiveQuantityChanges(); }
+
+    // Returns the flags of the cells whose intensive quantities changed since
+    // the last linearization if the flux terms of all other cells can be
+    // reused, and a null pointer if all flux terms must be recomputed.
+    const std::vector<unsigned char>* reusableFluxCells_() const
+    {
+        // the first iteration of a time step always starts from scratch since
+        // the problem may have changed quantities the fluxes depend on
+        if (!fluxCacheValid_ || !storeFluxes_() || model_().newtonMethod().numIterations() == 0) {
+            return nullptr;
+        }
+        return model_().changedIntensiveQuantities();
+    }
+
     // Initialize the flows, flores, and velocity sparse tables
     void createFlows_()
     {
@@ -708,7 +840,8 @@ public:
 
 private:
     template <class SubDomainType>
-    void linearize_(const SubDomainType& domain)
+    void linearize_(const SubDomainType& domain,
+                    const std::vector<unsigned char>* changedCells)
     {
         // This check should be removed once this is addressed by
         // for example storing the previous timesteps' values for
@@ -728,6 +861,30 @@ private:
         const unsigned int numCells = domain.cells.size();
         const bool on_full_domain = (numCells == model_().numTotalDof());
 
+        // The storage of the previous time step only needs to be cached by the
+        // first linearization of the full domain. The linearization of a
+        // subdomain thus does not depend on the (shared) iteration index.
+        const bool updateStorageCache = on_full_domain && model_().enableStorageCache()
+            && model_().newtonMethod().numIterations() == 0;
+
+        const bool storeFluxes = on_full_domain && storeFluxes_();
+        if (storeFluxes) {
+            fluxResCache_.resize(numCells);
+            fluxDiagCache_.resize(numCells);
+        }
+
+        // The face based assembly only covers the full domain. If the flux
+        // terms of some cells are reused, the remaining ones are recomputed
+        // by the cell loop.
+        bool faceBased = false;
+        if constexpr (hasFaceFlux) {
+            faceBased = faceBasedAssembly_ && on_full_domain && !changedCells &&
+                        LocalResidual::faceFluxApplicable(problem_().moduleParams());
+            if (faceBased) {
+                linearizeFaceFluxes_(enableDispersion);
+            }
+        }
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -742,8 +899,21 @@ private:
             const IntensiveQuantities& intQuantsIn = model_().intensiveQuantities(globI, /*timeIdx*/ 0);
 
             // Flux term.
-            {
+            if (changedCells && !fluxesChanged_(globI, nbInfos, *changedCells)) {
+                // neither the cell nor its neighbors changed: the off-diagonal
+                // blocks are still in place, only add the cached contributions
+                // to the residual and the diagonal block.
+                residual_[globI] += fluxResCache_[globI];
+                *diagMatAddress_[globI] += fluxDiagCache_[globI];
+            }
+            else {
+            if (!faceBased) {
             OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachCell);
+            if (changedCells) {
+                for (const auto& nbInfo : nbInfos) {
+                    *nbInfo.matBlockAddress = 0.0;
+                }
+            }
             short loc = 0;
             for (const auto& nbInfo : nbInfos) {
                 OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachFace);
@@ -771,6 +941,12 @@ private:
                 ++loc;
             }
             }
+            if (storeFluxes) {
+                // so far, only the flux terms have been added to row globI
+                fluxResCache_[globI] = residual_[globI];
+                fluxDiagCache_[globI] = *diagMatAddress_[globI];
+            }
+            }
 
             // Accumulation term.
             double dt = simulator_().timeStepSize();
@@ -788,20 +964,18 @@ private:
                 // used, but after storage cache is shifted at the end of the
                 // timestep, it will become cached storage for timeIdx 1.
                 model_().updateCachedStorage(globI, /*timeIdx=*/0, res);
-                if (model_().newtonMethod().numIterations() == 0) {
+                if (updateStorageCache) {
                     // Need to update the storage cache.
                     if (problem_().recycleFirstIterationStorage()) {
                         // Assumes nothing have changed in the system which
                         // affects masses calculated from primary variables.
-                        if (on_full_domain) {
-                            // This is to avoid resetting the start-of-step storage
-                            // to incorrect numbers when we do local solves, where the iteration
-                            // number will start from 0, but the starting state may not be identical
-                            // to the start-of-step state.
-                            // Note that a full assembly must be done before local solves
-                            // otherwise this will be left un-updated.
-                            model_().updateCachedStorage(globI, /*timeIdx=*/1, res);
-                        }
+                        // This is only done on the full domain to avoid resetting
+                        // the start-of-step storage to incorrect numbers when we
+                        // do local solves, where the starting state may not be
+                        // identical to the start-of-step state.
+                        // Note that a full assembly must be done before local solves
+                        // otherwise this will be left un-updated.
+                        model_().updateCachedStorage(globI, /*timeIdx=*/1, res);
                     } else {
                         Dune::FieldVector<Scalar, numEq> tmp;
                         IntensiveQuantities intQuantOld = model_().intensiveQuantities(globI, 1);
@@ -851,6 +1025,10 @@ private:
             if (bdyInfo.bcdata.type == BCType::NONE)
                 continue;
 
+            // the rows of other subdomains may be linearized concurrently
+            if (!on_full_domain && !isInDomain_(domain, bdyInfo.cell))
+                continue;
+
             VectorBlock res(0.0);
             MatrixBlock bMat(0.0);
             ADVectorBlock adres(0.0);
@@ -865,8 +1043,114 @@ private:
         }
     }
 
+    // returns true if a cell is part of a (sub-)domain. an empty 'interior'
+    // vector means that all cells are part of it.
+    template <class SubDomainType>
+    static bool isInDomain_(const SubDomainType& domain, unsigned cell)
+    {
+        return domain.interior.empty()
+            || (cell < domain.interior.size() && domain.interior[cell]);
+    }
+
+    // returns true if the intensive quantities of a cell or of one of its
+    // neighbors changed since the flux terms of the cell were stored
+    template <class NeighborInfos>
+    static bool fluxesChanged_(const unsigned globI,
+                               const NeighborInfos& nbInfos,
+                               const std::vector<unsigned char>& changedCells)
+    {
+        if (changedCells[globI]) {
+            return true;
+        }
+        for (const auto& nbInfo : nbInfos) {
+            if (changedCells[nbInfo.neighbor]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // an interior face given by its two cells and the positions of each
+    // cell in the neighbor list of the other one
+    struct FaceInfo
+    {
+        unsigned int cellI;
+        unsigned int cellJ;
+        unsigned int locI;
+        unsigned int locJ;
+    };
+
+    // Assemble the flux terms of all interior faces. Each face is processed
+    // by exactly one thread which evaluates the flux once and adds it to the
+    // residuals and to the four Jacobian blocks of both adjacent cells.
+    void linearizeFaceFluxes_(const bool enableDispersion)
+    {
+        OPM_TIMEBLOCK(linearizeFaces);
+        for (unsigned color = 0; color < faceColors_.size(); ++color) {
+            const auto& faces = faceColors_[color];
+            const std::size_t numFaces = faces.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (std::size_t faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+                linearizeFaceFlux_(faces[faceIdx], enableDispersion);
+            }
+        }
+
+        for (const auto& face : serialFaces_) {
+            linearizeFaceFlux_(face, enableDispersion);
+        }
+    }
+
+    void linearizeFaceFlux_(const FaceInfo& face, const bool enableDispersion)
+    {
+        OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachFace);
+        const unsigned globI = face.cellI;
+        const unsigned globJ = face.cellJ;
+        const auto& nbInfoI = neighborInfo_[globI][face.locI];
+        const auto& nbInfoJ = neighborInfo_[globJ][face.locJ];
+        const IntensiveQuantities& intQuantsI = model_().intensiveQuantities(globI, /*timeIdx*/ 0);
+        const IntensiveQuantities& intQuantsJ = model_().intensiveQuantities(globJ, /*timeIdx*/ 0);
+
+        // flux from I to J with derivatives with regard to the variables of
+        // both cells
+        typename LocalResidual::FaceRateVector adres;
+        ADVectorBlock darcyFlux(0.0);
+        LocalResidual::computeFaceFlux(adres, darcyFlux, globI, globJ, intQuantsI, intQuantsJ,
+                                       nbInfoI.res_nbinfo);
+        const Scalar faceArea = nbInfoI.res_nbinfo.faceArea;
+        adres *= faceArea;
+        if (enableDispersion) {
+            for (unsigned phaseIdx = 0; phaseIdx < numEq; ++ phaseIdx) {
+                const Scalar velocity = darcyFlux[phaseIdx].value() / faceArea;
+                velocityInfo_[globI][face.locI].velocity[phaseIdx] = velocity;
+                velocityInfo_[globJ][face.locJ].velocity[phaseIdx] = -velocity;
+            }
+        }
+
+        VectorBlock res;
+        MatrixBlock bMatI;
+        MatrixBlock bMatJ;
+        for (unsigned eqIdx = 0; eqIdx < numEq; eqIdx++) {
+            res[eqIdx] = adres[eqIdx].value();
+            for (unsigned pvIdx = 0; pvIdx < numEq; pvIdx++) {
+                bMatI[eqIdx][pvIdx] = adres[eqIdx].derivative(pvIdx);
+                bMatJ[eqIdx][pvIdx] = adres[eqIdx].derivative(numEq + pvIdx);
+            }
+        }
+
+        // the flux leaves cell I and enters cell J
+        residual_[globI] += res;
+        residual_[globJ] -= res;
+        *diagMatAddress_[globI] += bMatI;
+        *nbInfoJ.matBlockAddress += bMatJ; // block (I, J)
+        *nbInfoI.matBlockAddress -= bMatI; // block (J, I)
+        *diagMatAddress_[globJ] -= bMatJ;
+    }
+
     void updateStoredTransmissibilities()
     {
+        fluxCacheValid_ = false;
         if (neighborInfo_.empty()) {
             // This function was called before createMatrix_() was called.
             // We call initFirstIteration_(), not createMatrix_(), because
@@ -907,6 +1191,17 @@ private:
     SparseTable<NeighborInfo> neighborInfo_;
     std::vector<MatrixBlock*> diagMatAddress_;
 
+    // the flux contributions to the residual and to the diagonal block of
+    // each cell from the last linearization of the full domain
+    std::vector<VectorBlock> fluxResCache_;
+    std::vector<MatrixBlock> fluxDiagCache_;
+    // atomic because subdomains may be linearized concurrently
+    std::atomic<bool> fluxCacheValid_{false};
+
+    // one row per color, the faces of a color do not share any cell
+    SparseTable<FaceInfo> faceColors_;
+    std::vector<FaceInfo> serialFaces_;
+
     struct FlowInfo
     {
         int faceId;
@@ -942,6 +1237,7 @@ private:
     };
     std::vector<BoundaryInfo> boundaryInfo_;
     bool separateSparseSourceTerms_ = false;
+    bool faceBasedAssembly_ = false;
     struct FullDomain
     {
         std::vector<int> cells;
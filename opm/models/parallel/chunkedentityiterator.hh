@@ -0,0 +1,126 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::ChunkedEntityIterator
+ */
+#ifndef OPM_CHUNKED_ENTITY_ITERATOR_HH
+#define OPM_CHUNKED_ENTITY_ITERATOR_HH
+
+#include <opm/models/parallel/chunkscheduler.hpp>
+#include <opm/models/parallel/threadmanager.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Iterates over the entities of a GridView in OpenMP threaded
+ *        applications by handing out chunks of consecutive entities.
+ *
+ * In contrast to ThreadedEntityIterator, no lock is taken per entity: The
+ * grid is traversed once when the object is constructed to record an
+ * iterator at the beginning of each chunk, and the chunks are then
+ * distributed over the threads by a ChunkScheduler. The object is intended
+ * to be kept alive as long as the grid does not change and to be reset()
+ * before each loop.
+ *
+ * Usage:
+ * \code
+ * chunkedElemIt.reset();
+ * #pragma omp parallel
+ * {
+ *     ElementContext elemCtx(simulator);
+ *     chunkedElemIt.forEach([&](const Element& elem) { ... });
+ * }
+ * \endcode
+ *
+ * ATTENTION: This class must be instantiated and reset in a sequential context!
+ */
+template <class GridView, int codim>
+class ChunkedEntityIterator
+{
+    using EntityIterator = typename GridView::template Codim<codim>::Iterator;
+
+public:
+    explicit ChunkedEntityIterator(const GridView& gridView)
+        : ChunkedEntityIterator(gridView,
+                                ThreadManager::iterationChunkSize(),
+                                ThreadManager::iterationMode())
+    {}
+
+    ChunkedEntityIterator(const GridView& gridView,
+                          std::size_t chunkSize,
+                          ChunkScheduler::Mode mode)
+        : numEntities_(gridView.size(codim))
+        , scheduler_(numEntities_, chunkSize, mode)
+    {
+        chunkBegin_.reserve(scheduler_.numChunks());
+        std::size_t entityIdx = 0;
+        const auto endIt = gridView.template end<codim>();
+        for (auto it = gridView.template begin<codim>(); it != endIt; ++it, ++entityIdx) {
+            if (entityIdx % scheduler_.chunkSize() == 0) {
+                chunkBegin_.push_back(it);
+            }
+        }
+    }
+
+    /*!
+     * \brief Returns the number of entities which are iterated over.
+     */
+    std::size_t size() const
+    { return numEntities_; }
+
+    /*!
+     * \brief Make all entities available again for the next loop.
+     */
+    void reset()
+    { scheduler_.reset(); }
+
+    /*!
+     * \brief Call fn(entity) for every entity assigned to the calling thread.
+     *
+     * This must be called exactly once by every thread of the parallel region.
+     */
+    template <class Functor>
+    void forEach(Functor&& fn)
+    {
+        scheduler_.run([this, &fn](std::size_t beginIdx, std::size_t endIdx)
+        {
+            auto it = chunkBegin_[beginIdx / scheduler_.chunkSize()];
+            for (std::size_t idx = beginIdx; idx < endIdx; ++idx, ++it) {
+                fn(*it);
+            }
+        });
+    }
+
+private:
+    std::size_t numEntities_;
+    ChunkScheduler scheduler_;
+    std::vector<EntityIterator> chunkBegin_;
+};
+
+} // namespace Opm
+
+#endif // OPM_CHUNKED_ENTITY_ITERATOR_HH
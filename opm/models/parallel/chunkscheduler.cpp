@@ -0,0 +1,109 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include <config.h>
+#include <opm/models/parallel/chunkscheduler.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <stdexcept>
+
+namespace Opm {
+
+ChunkScheduler::ChunkScheduler(std::size_t numItems,
+                               std::size_t chunkSize,
+                               Mode mode,
+                               unsigned numSlots)
+    : numItems_(numItems)
+    , chunkSize_(std::max<std::size_t>(chunkSize, 1))
+    , numChunks_((numItems + chunkSize_ - 1) / chunkSize_)
+    , mode_(mode)
+    , numSlots_(numSlots)
+{
+    if (numSlots_ == 0) {
+#ifdef _OPENMP
+        numSlots_ = static_cast<unsigned>(omp_get_max_threads());
+#else
+        numSlots_ = 1;
+#endif
+    }
+
+    slots_ = std::make_unique<Slot[]>(numSlots_);
+    reset();
+}
+
+ChunkScheduler::~ChunkScheduler() = default;
+
+void ChunkScheduler::reset()
+{
+    nextChunk_.store(0, std::memory_order_relaxed);
+
+    // contiguous partition of the chunks, the first (numChunks % numSlots)
+    // slots get one chunk more than the remaining ones
+    const std::size_t baseSize = numChunks_ / numSlots_;
+    const std::size_t remainder = numChunks_ % numSlots_;
+    std::size_t begin = 0;
+    for (unsigned slotIdx = 0; slotIdx < numSlots_; ++slotIdx) {
+        const std::size_t size = baseSize + (slotIdx < remainder ? 1 : 0);
+        slots_[slotIdx].next.store(begin, std::memory_order_relaxed);
+        slots_[slotIdx].end = begin + size;
+        begin += size;
+    }
+}
+
+ChunkScheduler::Mode ChunkScheduler::modeFromString(const std::string& name)
+{
+    if (name == "static") {
+        return Mode::Static;
+    }
+    else if (name == "dynamic") {
+        return Mode::Dynamic;
+    }
+    else if (name == "stealing") {
+        return Mode::WorkStealing;
+    }
+
+    throw std::invalid_argument("Unknown threaded iteration mode '" + name + "'. "
+                                "Valid values are 'static', 'dynamic' and 'stealing'");
+}
+
+unsigned ChunkScheduler::threadId_()
+{
+#ifdef _OPENMP
+    return static_cast<unsigned>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+}
+
+unsigned ChunkScheduler::numThreadsInTeam_()
+{
+#ifdef _OPENMP
+    return static_cast<unsigned>(omp_get_num_threads());
+#else
+    return 1;
+#endif
+}
+
+} // namespace Opm
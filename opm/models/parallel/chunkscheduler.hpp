@@ -0,0 +1,185 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::ChunkScheduler
+ */
+#ifndef OPM_CHUNK_SCHEDULER_HPP
+#define OPM_CHUNK_SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Opm {
+
+/*!
+ * \brief Lock-free distribution of an index range [0, numItems) over the
+ *        threads of an OpenMP parallel region.
+ *
+ * The index range is split into chunks of a fixed size. Chunks are handed
+ * out to the threads using one of the following policies:
+ *
+ * - Static: The chunks are partitioned into contiguous slots up front and
+ *   each thread only processes the slots it owns. No shared counter is
+ *   touched by more than one thread.
+ * - Dynamic: All threads fetch the next chunk from a single atomic counter.
+ * - WorkStealing: Like 'Static', but threads which have finished their own
+ *   slots continue to take chunks from the slots of other threads.
+ *
+ * The number of slots is fixed when the object is constructed (by default
+ * to the maximum number of OpenMP threads). If the parallel region uses
+ * fewer threads, each thread owns every numThreads-th slot so that no work
+ * is lost.
+ *
+ * ATTENTION: The constructor and reset() must be called in a sequential
+ *            context, run() must be called by every thread of the parallel
+ *            region exactly once between two calls to reset().
+ */
+class ChunkScheduler
+{
+public:
+    enum class Mode {
+        Static,
+        Dynamic,
+        WorkStealing
+    };
+
+    /*!
+     * \brief Create a scheduler for the index range [0, numItems).
+     *
+     * \param numItems Number of indices to be distributed
+     * \param chunkSize Number of consecutive indices which are handed out at once
+     * \param mode The scheduling policy
+     * \param numSlots Number of static partitions, '0' means the maximum
+     *                 number of OpenMP threads
+     */
+    ChunkScheduler(std::size_t numItems,
+                   std::size_t chunkSize,
+                   Mode mode,
+                   unsigned numSlots = 0);
+
+    ~ChunkScheduler();
+
+    /*!
+     * \brief Make all chunks available again.
+     */
+    void reset();
+
+    /*!
+     * \brief Process all chunks which are assigned to the calling thread.
+     *
+     * The functor is called as fn(beginIdx, endIdx) for each chunk.
+     */
+    template <class Functor>
+    void run(Functor&& fn)
+    {
+        if (mode_ == Mode::Dynamic) {
+            std::size_t chunkIdx;
+            while ((chunkIdx = nextChunk_.fetch_add(1, std::memory_order_relaxed)) < numChunks_) {
+                callChunk_(fn, chunkIdx);
+            }
+            return;
+        }
+
+        const unsigned tid = threadId_();
+        const unsigned numThreads = numThreadsInTeam_();
+
+        // first process the slots owned by the calling thread
+        for (unsigned slotIdx = tid; slotIdx < numSlots_; slotIdx += numThreads) {
+            drainSlot_(slotIdx, fn);
+        }
+
+        if (mode_ == Mode::WorkStealing) {
+            // help the other threads. since the slot counters are only ever
+            // incremented, every chunk is processed exactly once.
+            for (unsigned i = 1; i < numSlots_; ++i) {
+                drainSlot_((tid + i) % numSlots_, fn);
+            }
+        }
+    }
+
+    std::size_t numItems() const
+    { return numItems_; }
+
+    std::size_t chunkSize() const
+    { return chunkSize_; }
+
+    std::size_t numChunks() const
+    { return numChunks_; }
+
+    Mode mode() const
+    { return mode_; }
+
+    /*!
+     * \brief Convert a string ("static", "dynamic" or "stealing") to a scheduling mode.
+     */
+    static Mode modeFromString(const std::string& name);
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<std::size_t> next{0};
+        std::size_t end{0};
+    };
+
+    template <class Functor>
+    void drainSlot_(unsigned slotIdx, Functor& fn)
+    {
+        Slot& slot = slots_[slotIdx];
+        if (slot.next.load(std::memory_order_relaxed) >= slot.end) {
+            return;
+        }
+
+        std::size_t chunkIdx;
+        while ((chunkIdx = slot.next.fetch_add(1, std::memory_order_relaxed)) < slot.end) {
+            callChunk_(fn, chunkIdx);
+        }
+    }
+
+    template <class Functor>
+    void callChunk_(Functor& fn, std::size_t chunkIdx) const
+    {
+        const std::size_t beginIdx = chunkIdx * chunkSize_;
+        const std::size_t endIdx = std::min(beginIdx + chunkSize_, numItems_);
+        fn(beginIdx, endIdx);
+    }
+
+    static unsigned threadId_();
+    static unsigned numThreadsInTeam_();
+
+    std::size_t numItems_;
+    std::size_t chunkSize_;
+    std::size_t numChunks_;
+    Mode mode_;
+    unsigned numSlots_;
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> nextChunk_{0};
+};
+
+} // namespace Opm
+
+#endif // OPM_CHUNK_SCHEDULER_HPP
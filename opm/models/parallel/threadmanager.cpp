@@ -33,12 +33,20 @@
 namespace Opm {
 
 int ThreadManager::numThreads_ = 1;
+std::size_t ThreadManager::iterationChunkSize_ = Parameters::ThreadedIterationChunkSize::value;
+ChunkScheduler::Mode ThreadManager::iterationMode_ = ChunkScheduler::Mode::Dynamic;
 
 void ThreadManager::registerParameters()
 {
     Parameters::Register<Parameters::ThreadsPerProcess>
         ("The maximum number of threads to be instantiated per process "
          "('-1' means 'automatic')");
+    Parameters::Register<Parameters::ThreadedIterationChunkSize>
+        ("The number of consecutive grid entities which are handed out to a thread "
+         "at once by chunked threaded iterations");
+    Parameters::Register<Parameters::ThreadedIterationMode>
+        ("The scheduling policy of chunked threaded iterations: 'static', 'dynamic' or "
+         "'stealing' (static partitioning with work stealing)");
 }
 
 void ThreadManager::init(bool queryCommandLineParameter)
@@ -75,6 +83,13 @@ void ThreadManager::init(bool queryCommandLineParameter)
 #endif
     }
 
+    const unsigned chunkSize = Parameters::Get<Parameters::ThreadedIterationChunkSize>();
+    if (chunkSize == 0) {
+        throw std::invalid_argument("The chunk size of threaded iterations must be at least 1");
+    }
+    iterationChunkSize_ = chunkSize;
+    iterationMode_ = ChunkScheduler::modeFromString(Parameters::Get<Parameters::ThreadedIterationMode>());
+
 #ifdef _OPENMP
     // get the number of threads which are used in the end.
     numThreads_ = omp_get_max_threads();
@@ -27,6 +27,10 @@
 #ifndef OPM_THREAD_MANAGER_HPP
 #define OPM_THREAD_MANAGER_HPP
 
+#include <opm/models/parallel/chunkscheduler.hpp>
+
+#include <cstddef>
+
 namespace Opm {
 
 /*!
@@ -71,8 +75,23 @@ public:
      */
     static unsigned threadId();
 
+    /*!
+     * \brief Return the number of entities handed out at once by chunked
+     *        threaded iterations.
+     */
+    static std::size_t iterationChunkSize()
+    { return iterationChunkSize_; }
+
+    /*!
+     * \brief Return the scheduling policy used by chunked threaded iterations.
+     */
+    static ChunkScheduler::Mode iterationMode()
+    { return iterationMode_; }
+
 private:
     static int numThreads_;
+    static std::size_t iterationChunkSize_;
+    static ChunkScheduler::Mode iterationMode_;
 };
 
 } // namespace Opm
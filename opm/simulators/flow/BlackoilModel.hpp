@@ -253,6 +253,11 @@ namespace Opm {
             } else {
                 OPM_THROW(std::runtime_error, "Unknown nonlinear solver option: " + param_.nonlinear_solver_);
             }
+
+            // The linearizer may only reuse the flux terms of unchanged cells if
+            // nobody else modifies the off-diagonal blocks of the Jacobian.
+            simulator_.model().setTrackIntensiveQuantityChanges(param_.incremental_iq_update_ &&
+                                                                !param_.matrix_add_well_contributions_);
         }
 
 
@@ -290,7 +295,9 @@ namespace Opm {
             simulator_.setTimeStepSize(timer.currentStepLength());
             simulator_.model().newtonMethod().setIterationIndex(0);
 
+            const double wellPotentialsTime = wellModel().wellPotentialsTime();
             simulator_.problem().beginTimeStep();
+            report.well_potentials_time += wellModel().wellPotentialsTime() - wellPotentialsTime;
 
             unsigned numDof = simulator_.model().numGridDof();
             wasSwitched_.resize(numDof);
@@ -515,7 +522,9 @@ namespace Opm {
             SimulatorReportSingle report;
             Dune::Timer perfTimer;
             perfTimer.start();
+            const double wellPotentialsTime = wellModel().wellPotentialsTime();
             simulator_.problem().endTimeStep();
+            report.well_potentials_time += wellModel().wellPotentialsTime() - wellPotentialsTime;
             simulator_.problem().setConvData(rst_conv_.getData());
             report.pre_post_time += perfTimer.stop();
             return report;
@@ -700,6 +709,16 @@ namespace Opm {
             auto& newtonMethod = simulator_.model().newtonMethod();
             SolutionVector& solution = simulator_.model().solution(/*timeIdx=*/0);
 
+            // The intensive quantities of the first iteration of a time step are
+            // always recomputed from scratch since the problem may have changed
+            // quantities they depend on at the beginning of the time step. The
+            // local solves of NLDD update the intensive quantities of their
+            // domains by themselves, so iqSolution_ would not match them.
+            const bool incremental = param_.incremental_iq_update_ &&
+                                     !nlddSolver_ &&
+                                     newtonMethod.numIterations() > 0 &&
+                                     iqSolution_.size() == solution.size();
+
             newtonMethod.update_(/*nextSolution=*/solution,
                                  /*curSolution=*/solution,
                                  /*update=*/dx,
@@ -708,12 +727,32 @@ namespace Opm {
                                                 // residual
 
             // if the solution is updated, the intensive quantities need to be recalculated
-            {
+            if (incremental) {
+                OPM_TIMEBLOCK(updateChangedIntensiveQuantities);
+                markChangedCells_(solution);
+                numSkippedIqCells_ = simulator_.model().updateChangedIntensiveQuantities(cellChanged_);
+                const auto globalSkipped = grid_.comm().sum(numSkippedIqCells_);
+                if (terminal_output_) {
+                    OpmLog::debug(fmt::format("Newton iteration {}: kept the intensive quantities of {} cells",
+                                              newtonMethod.numIterations(), globalSkipped));
+                }
+            } else {
                 OPM_TIMEBLOCK(invalidateAndUpdateIntensiveQuantities);
                 simulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+                numSkippedIqCells_ = 0;
+                if (param_.incremental_iq_update_) {
+                    iqSolution_ = solution;
+                }
             }
         }
 
+        /// Number of local cells whose intensive quantities were kept by the
+        /// last call of updateSolution().
+        std::size_t numSkippedIntensiveQuantities() const
+        {
+            return numSkippedIqCells_;
+        }
+
         /// Return true if output to cout is wanted.
         bool terminalOutputEnabled() const
         {
@@ -1294,6 +1333,13 @@ namespace Opm {
         Scalar current_relaxation_;
         BVector dx_old_;
 
+        // primary variables of each cell at the last update of its intensive
+        // quantities and the cells which are updated by the current Newton
+        // update (for the incremental update of the intensive quantities)
+        SolutionVector iqSolution_;
+        std::vector<unsigned char> cellChanged_;
+        std::size_t numSkippedIqCells_ = 0;
+
         std::vector<StepReport> convergence_reports_;
         ComponentName compNames_{};
 
@@ -1450,6 +1496,42 @@ namespace Opm {
         Scalar dsMax() const { return param_.ds_max_; }
         Scalar drMaxRel() const { return param_.dr_max_rel_; }
         Scalar maxResidualAllowed() const { return param_.max_residual_allowed_; }
+
+        // flag the cells whose primary variables differ by more than the
+        // tolerance of the incremental update from the ones their intensive
+        // quantities were last computed with, or which switched their variable
+        // meanings or PVT region since. The reference of the flagged cells is
+        // set to the new primary variables. Comparing against the last update
+        // instead of the last iterate keeps cells which move by small steps
+        // from being skipped forever.
+        void markChangedCells_(const SolutionVector& newSolution)
+        {
+            const Scalar tol = param_.incremental_iq_update_tolerance_;
+            const std::size_t numCells = newSolution.size();
+            cellChanged_.resize(numCells);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+                PrimaryVariables& oldPv = iqSolution_[cellIdx];
+                const PrimaryVariables& newPv = newSolution[cellIdx];
+                bool changed = oldPv.primaryVarsMeaningWater() != newPv.primaryVarsMeaningWater() ||
+                               oldPv.primaryVarsMeaningPressure() != newPv.primaryVarsMeaningPressure() ||
+                               oldPv.primaryVarsMeaningGas() != newPv.primaryVarsMeaningGas() ||
+                               oldPv.primaryVarsMeaningBrine() != newPv.primaryVarsMeaningBrine() ||
+                               oldPv.primaryVarsMeaningSolvent() != newPv.primaryVarsMeaningSolvent() ||
+                               oldPv.pvtRegionIndex() != newPv.pvtRegionIndex();
+                for (int pvIdx = 0; pvIdx < numEq && !changed; ++pvIdx) {
+                    const Scalar oldVal = oldPv[pvIdx];
+                    changed = std::abs(newPv[pvIdx] - oldVal) > tol * std::max(Scalar{1.0}, std::abs(oldVal));
+                }
+                cellChanged_[cellIdx] = changed ? 1 : 0;
+                if (changed) {
+                    oldPv = newPv;
+                }
+            }
+        }
+
         double linear_solve_setup_time_;
         ConvergenceReport::PenaltyCard total_penaltyCard_;
         double prev_distance_ = std::numeric_limits<double>::infinity();
@@ -28,6 +28,8 @@
 
 #include <opm/grid/common/SubGridPart.hpp>
 
+#include <opm/models/parallel/threadmanager.hpp>
+
 #include <opm/simulators/aquifers/AquiferGridUtils.hpp>
 
 #include <opm/simulators/flow/countGlobalCells.hpp>
@@ -63,6 +65,7 @@
 #include <iomanip>
 #include <ios>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -154,6 +157,7 @@ public:
         domain_matrices_.resize(num_domains);
 
         // Set up container for the local linear solvers.
+        bool cpr_local_solvers = false;
         for (int index = 0; index < num_domains; ++index) {
             // TODO: The ISTLSolver constructor will make
             // parallel structures appropriate for the full grid
@@ -167,12 +171,29 @@ public:
                 loc_param.linsolver_ = "umfpack";
             }
             loc_param.linear_solver_print_json_definition_ = false;
+            cpr_local_solvers = cpr_local_solvers || loc_param.linsolver_.rfind("cpr", 0) == 0;
             const bool force_serial = true;
             domain_linsolvers_.emplace_back(model_.simulator(), loc_param, force_serial);
             domain_linsolvers_.back().setDomainIndex(index);
         }
 
         assert(int(domains_.size()) == num_domains);
+
+        // Set up the domain adjacency used to find domains which can be solved concurrently.
+        if (model_.param().concurrent_local_solves_ && ThreadManager::maxThreads() > 1) {
+            // The CPR preconditioners and the sparse source terms access data
+            // of the full model, which is not safe when several domains are
+            // solved at the same time.
+            if (cpr_local_solvers || Parameters::Get<Parameters::SeparateSparseSourceTerms>()) {
+                if (rank_ == 0) {
+                    OpmLog::warning("Concurrent local solves are not supported with CPR local linear "
+                                    "solvers or separate sparse source terms, solving the domains sequentially.");
+                }
+            } else {
+                concurrent_local_solves_ = true;
+                domain_neighbors_ = this->findDomainNeighbors(partition_vector);
+            }
+        }
     }
 
     //! \brief Called before starting a time step.
@@ -210,34 +231,33 @@ public:
         // -----------   Solve each domain separately   -----------
         DeferredLogger logger;
         std::vector<SimulatorReportSingle> domain_reports(domains_.size());
-        for (const int domain_index : domain_order) {
-            const auto& domain = domains_[domain_index];
-            SimulatorReportSingle local_report;
-            try {
-                switch (model_.param().local_solve_approach_) {
-                case DomainSolveApproach::Jacobi:
-                    solveDomainJacobi(solution, locally_solved, local_report, logger,
-                                      iteration, timer, domain);
-                    break;
-                default:
-                case DomainSolveApproach::GaussSeidel:
-                    solveDomainGaussSeidel(solution, locally_solved, local_report, logger,
-                                           iteration, timer, domain);
-                    break;
+        if (concurrent_local_solves_) {
+            // Domains of the same color do not share any face and are solved
+            // concurrently. Each domain logs to its own logger, the messages
+            // are collected in the order of the domains afterwards.
+            std::vector<DeferredLogger> domain_loggers(domains_.size());
+            for (const auto& color : this->colorDomains(domain_order)) {
+                const int num_color_domains = color.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for (int ii = 0; ii < num_color_domains; ++ii) {
+                    const int domain_index = color[ii];
+                    domain_reports[domain_index] = this->trySolveDomain(solution, locally_solved,
+                                                                        domain_loggers[domain_index],
+                                                                        iteration, timer,
+                                                                        domains_[domain_index]);
                 }
             }
-            catch (...) {
-                // Something went wrong during local solves.
-                local_report.converged = false;
+            for (const int domain_index : domain_order) {
+                logger.append(domain_loggers[domain_index]);
             }
-            // This should have updated the global matrix to be
-            // dR_i/du_j evaluated at new local solutions for
-            // i == j, at old solution for i != j.
-            if (!local_report.converged) {
-                // TODO: more proper treatment, including in parallel.
-                logger.debug(fmt::format("Convergence failure in domain {} on rank {}." , domain.index, rank_));
+        } else {
+            for (const int domain_index : domain_order) {
+                domain_reports[domain_index] = this->trySolveDomain(solution, locally_solved, logger,
+                                                                    iteration, timer,
+                                                                    domains_[domain_index]);
             }
-            domain_reports[domain.index] = local_report;
         }
 
         // Communicate and log all messages.
@@ -353,6 +373,54 @@ public:
 
 private:
 
+    //! \brief Solve a single domain using the configured approach.
+    //! A failure of the local solve is reported as a convergence failure.
+    template<class GlobalEqVector>
+    SimulatorReportSingle trySolveDomain(GlobalEqVector& solution,
+                                         GlobalEqVector& locally_solved,
+                                         DeferredLogger& logger,
+                                         const int iteration,
+                                         const SimulatorTimerInterface& timer,
+                                         const Domain& domain)
+    {
+        SimulatorReportSingle local_report;
+        try {
+            switch (model_.param().local_solve_approach_) {
+            case DomainSolveApproach::Jacobi:
+                solveDomainJacobi(solution, locally_solved, local_report, logger,
+                                  iteration, timer, domain);
+                break;
+            default:
+            case DomainSolveApproach::GaussSeidel:
+                solveDomainGaussSeidel(solution, locally_solved, local_report, logger,
+                                       iteration, timer, domain);
+                break;
+            }
+        }
+        catch (...) {
+            // Something went wrong during local solves.
+            local_report.converged = false;
+        }
+        // This should have updated the global matrix to be
+        // dR_i/du_j evaluated at new local solutions for
+        // i == j, at old solution for i != j.
+        if (!local_report.converged) {
+            // TODO: more proper treatment, including in parallel.
+            logger.debug(fmt::format("Convergence failure in domain {} on rank {}." , domain.index, rank_));
+        }
+        return local_report;
+    }
+
+    //! \brief Call a function with the well model as argument.
+    //! The well model (and the iteration index of the Newton method which
+    //! it reads) is shared by all domains, so the calls are serialized.
+    template<class Func>
+    decltype(auto) withWellModel(Func&& func)
+    {
+        std::lock_guard<std::mutex> lock(well_model_mutex_);
+        return func(model_.wellModel());
+    }
+
     //! \brief Solve the equation system for a single domain.
     std::pair<SimulatorReportSingle, ConvergenceReport>
     solveDomain(const Domain& domain,
@@ -368,8 +436,6 @@ private:
         solveTimer.start();
         Dune::Timer detailTimer;
 
-        modelSimulator.model().newtonMethod().setIterationIndex(0);
-
         // When called, if assembly has already been performed
         // with the initial values, we only need to check
         // for local convergence. Otherwise, we must do a local
@@ -377,14 +443,11 @@ private:
         int iter = 0;
         if (initial_assembly_required) {
             detailTimer.start();
-            modelSimulator.model().newtonMethod().setIterationIndex(iter);
             // TODO: we should have a beginIterationLocal function()
             // only handling the well model for now
-            modelSimulator.problem().wellModel().assembleDomain(modelSimulator.model().newtonMethod().numIterations(),
-                                                                modelSimulator.timeStepSize(),
-                                                               domain);
+            report += this->assembleWellsDomain(iter, domain);
             // Assemble reservoir locally.
-            report += this->assembleReservoirDomain(domain);
+            this->assembleReservoirDomain(domain);
             report.assemble_time += detailTimer.stop();
         }
         detailTimer.reset();
@@ -401,9 +464,7 @@ private:
         // but not done the Schur complement for the wells yet.
         detailTimer.reset();
         detailTimer.start();
-        model_.wellModel().linearizeDomain(domain,
-                                           modelSimulator.model().linearizer().jacobian(),
-                                           modelSimulator.model().linearizer().residual());
+        this->linearizeWellsDomain(domain);
         const double tt1 = detailTimer.stop();
         report.assemble_time += tt1;
         report.assemble_time_well += tt1;
@@ -422,13 +483,16 @@ private:
             BVector x(nc);
             detailTimer.reset();
             detailTimer.start();
-            this->solveJacobianSystemDomain(domain, x);
-            model_.wellModel().postSolveDomain(x, domain);
+            report.linear_solve_setup_time += this->solveJacobianSystemDomain(domain, x);
+            this->withWellModel([&](auto& wellModel)
+            {
+                modelSimulator.model().newtonMethod().setIterationIndex(iter);
+                wellModel.postSolveDomain(x, domain);
+            });
             if (damping_factor != 1.0) {
                 x *= damping_factor;
             }
             report.linear_solve_time += detailTimer.stop();
-            report.linear_solve_setup_time += model_.linearSolveSetupTime();
             report.total_linear_iterations = model_.linearIterationsLastSolve();
 
             // Update local solution. // TODO: x is still full size, should we optimize it?
@@ -441,14 +505,11 @@ private:
             detailTimer.reset();
             detailTimer.start();
             ++iter;
-            modelSimulator.model().newtonMethod().setIterationIndex(iter);
             // TODO: we should have a beginIterationLocal function()
             // only handling the well model for now
+            report += this->assembleWellsDomain(iter, domain);
             // Assemble reservoir locally.
-            modelSimulator.problem().wellModel().assembleDomain(modelSimulator.model().newtonMethod().numIterations(),
-                                                                modelSimulator.timeStepSize(),
-                                                                domain);
-            report += this->assembleReservoirDomain(domain);
+            this->assembleReservoirDomain(domain);
             report.assemble_time += detailTimer.stop();
 
             // Check for local convergence.
@@ -462,9 +523,7 @@ private:
             // reservoir linearized equations
             detailTimer.reset();
             detailTimer.start();
-            model_.wellModel().linearizeDomain(domain,
-                                               modelSimulator.model().linearizer().jacobian(),
-                                               modelSimulator.model().linearizer().residual());
+            this->linearizeWellsDomain(domain);
             const double tt2 = detailTimer.stop();
             report.assemble_time += tt2;
             report.assemble_time_well += tt2;
@@ -483,7 +542,7 @@ private:
             }
         } while (!convreport.converged() && iter <= max_iter);
 
-        modelSimulator.problem().endIteration();
+        this->withWellModel([&modelSimulator](auto&) { modelSimulator.problem().endIteration(); });
 
         report.converged = convreport.converged();
         report.total_newton_iterations = iter;
@@ -493,16 +552,38 @@ private:
         return { report, convreport };
     }
 
+    /// Assemble the well equations of a domain at a given local iteration.
+    SimulatorReportSingle assembleWellsDomain(const int iteration, const Domain& domain)
+    {
+        return this->withWellModel([&](auto& wellModel)
+        {
+            auto& modelSimulator = model_.simulator();
+            modelSimulator.model().newtonMethod().setIterationIndex(iteration);
+            wellModel.assembleDomain(iteration, modelSimulator.timeStepSize(), domain);
+            return wellModel.lastReport();
+        });
+    }
+
+    /// Apply the Schur complement of the wells of a domain to the reservoir equations.
+    void linearizeWellsDomain(const Domain& domain)
+    {
+        auto& linearizer = model_.simulator().model().linearizer();
+        this->withWellModel([&](auto& wellModel)
+        {
+            wellModel.linearizeDomain(domain, linearizer.jacobian(), linearizer.residual());
+        });
+    }
+
     /// Assemble the residual and Jacobian of the nonlinear system.
-    SimulatorReportSingle assembleReservoirDomain(const Domain& domain)
+    void assembleReservoirDomain(const Domain& domain)
     {
         // -------- Mass balance equations --------
         model_.simulator().model().linearizer().linearizeDomain(domain);
-        return model_.wellModel().lastReport();
     }
 
     //! \brief Solve the linearized system for a domain.
-    void solveJacobianSystemDomain(const Domain& domain, BVector& global_x)
+    //! \return The time spent setting up the linear solver.
+    double solveJacobianSystemDomain(const Domain& domain, BVector& global_x)
     {
         const auto& modelSimulator = model_.simulator();
 
@@ -527,11 +608,12 @@ private:
         auto& linsolver = domain_linsolvers_[domain.index];
 
         linsolver.prepare(jac, res);
-        model_.linearSolveSetupTime() = perfTimer.stop();
+        const double setup_time = perfTimer.stop();
         linsolver.setResidual(res);
         linsolver.solve(x);
 
         Details::setGlobal(x, domain.cells, global_x);
+        return setup_time;
     }
 
     /// Apply an update to the primary variables.
@@ -736,10 +818,72 @@ private:
                                                           logger,
                                                           B_avg,
                                                           residual_norms);
-        report += model_.wellModel().getDomainWellConvergence(domain, B_avg, logger);
+        report += this->withWellModel([&](auto& wellModel)
+        {
+            model_.simulator().model().newtonMethod().setIterationIndex(iteration);
+            return wellModel.getDomainWellConvergence(domain, B_avg, logger);
+        });
         return report;
     }
 
+    //! \brief Returns the indices of the domains which share at least one face with each domain.
+    std::vector<std::vector<int>> findDomainNeighbors(const std::vector<int>& partition_vector) const
+    {
+        const auto& gridView = model_.simulator().vanguard().grid().leafGridView();
+        const auto& elementMapper = model_.simulator().model().elementMapper();
+        const int num_owned = partition_vector.size();
+
+        std::vector<std::vector<int>> neighbors(domains_.size());
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const int domain = partition_vector[elementMapper.index(elem)];
+            for (const auto& intersection : intersections(gridView, elem)) {
+                if (!intersection.neighbor()) {
+                    continue;
+                }
+                // Cells owned by other processes are not part of any local domain.
+                const int nb_cell = elementMapper.index(intersection.outside());
+                if (nb_cell >= num_owned) {
+                    continue;
+                }
+                const int nb_domain = partition_vector[nb_cell];
+                if (nb_domain != domain) {
+                    neighbors[domain].push_back(nb_domain);
+                }
+            }
+        }
+        for (auto& nb : neighbors) {
+            std::sort(nb.begin(), nb.end());
+            nb.erase(std::unique(nb.begin(), nb.end()), nb.end());
+        }
+        return neighbors;
+    }
+
+    //! \brief Greedily color the domains such that no two neighboring domains
+    //! have the same color. The domains are visited in the given order, so
+    //! the domains ordered first end up in the first colors.
+    //! \return The domains of each color, in the order of the colors.
+    std::vector<std::vector<int>> colorDomains(const std::vector<int>& domain_order) const
+    {
+        std::vector<int> domain_color(domains_.size(), -1);
+        std::vector<std::vector<int>> colors;
+        std::vector<unsigned char> color_used;
+        for (const int domain_index : domain_order) {
+            color_used.assign(colors.size() + 1, 0);
+            for (const int nb : domain_neighbors_[domain_index]) {
+                if (domain_color[nb] >= 0) {
+                    color_used[domain_color[nb]] = 1;
+                }
+            }
+            const int color = std::find(color_used.begin(), color_used.end(), 0) - color_used.begin();
+            if (color == static_cast<int>(colors.size())) {
+                colors.emplace_back();
+            }
+            colors[color].push_back(domain_index);
+            domain_color[domain_index] = color;
+        }
+        return colors;
+    }
+
     //! \brief Returns subdomain ordered according to method and ordering measure.
     std::vector<int> getSubdomainOrder()
     {
@@ -815,7 +959,10 @@ private:
                            const SimulatorTimerInterface& timer,
                            const Domain& domain)
     {
-        auto initial_local_well_primary_vars = model_.wellModel().getPrimaryVarsDomain(domain);
+        auto initial_local_well_primary_vars = this->withWellModel([&domain](auto& wellModel)
+        {
+            return wellModel.getPrimaryVarsDomain(domain);
+        });
         auto initial_local_solution = Details::extractVector(solution, domain.cells);
         auto res = solveDomain(domain, timer, logger, iteration, false);
         local_report = res.first;
@@ -825,7 +972,10 @@ private:
             Details::setGlobal(initial_local_solution, domain.cells, solution);
             model_.simulator().model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0, domain);
         } else {
-            model_.wellModel().setPrimaryVarsDomain(domain, initial_local_well_primary_vars);
+            this->withWellModel([&](auto& wellModel)
+            {
+                wellModel.setPrimaryVarsDomain(domain, initial_local_well_primary_vars);
+            });
             Details::setGlobal(initial_local_solution, domain.cells, solution);
             model_.simulator().model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0, domain);
         }
@@ -840,7 +990,10 @@ private:
                                 const SimulatorTimerInterface& timer,
                                 const Domain& domain)
     {
-        auto initial_local_well_primary_vars = model_.wellModel().getPrimaryVarsDomain(domain);
+        auto initial_local_well_primary_vars = this->withWellModel([&domain](auto& wellModel)
+        {
+            return wellModel.getPrimaryVarsDomain(domain);
+        });
         auto initial_local_solution = Details::extractVector(solution, domain.cells);
         auto res = solveDomain(domain, timer, logger, iteration, true);
         local_report = res.first;
@@ -881,7 +1034,10 @@ private:
             auto local_solution = Details::extractVector(solution, domain.cells);
             Details::setGlobal(local_solution, domain.cells, locally_solved);
         } else {
-            model_.wellModel().setPrimaryVarsDomain(domain, initial_local_well_primary_vars);
+            this->withWellModel([&](auto& wellModel)
+            {
+                wellModel.setPrimaryVarsDomain(domain, initial_local_well_primary_vars);
+            });
             Details::setGlobal(initial_local_solution, domain.cells, solution);
             model_.simulator().model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0, domain);
         }
@@ -1000,6 +1156,9 @@ private:
     std::vector<std::unique_ptr<Mat>> domain_matrices_; //!< Vector of matrix operator for each subdomain
     std::vector<ISTLSolverType> domain_linsolvers_; //!< Vector of linear solvers for each domain
     SimulatorReportSingle local_reports_accumulated_; //!< Accumulated convergence report for subdomain solvers
+    std::vector<std::vector<int>> domain_neighbors_; //!< Domains sharing a face with each domain
+    bool concurrent_local_solves_ = false; //!< Whether independent domains are solved concurrently
+    std::mutex well_model_mutex_; //!< Serializes the access to the well model during local solves
     int rank_ = 0; //!< MPI rank of this process
 };
 
@@ -69,6 +69,8 @@ BlackoilModelParameters<Scalar>::BlackoilModelParameters()
     update_equations_scaling_ = Parameters::Get<Parameters::UpdateEquationsScaling>();
     use_update_stabilization_ = Parameters::Get<Parameters::UseUpdateStabilization>();
     matrix_add_well_contributions_ = Parameters::Get<Parameters::MatrixAddWellContributions>();
+    incremental_iq_update_ = Parameters::Get<Parameters::IncrementalIntensiveQuantities>();
+    incremental_iq_update_tolerance_ = std::max(Scalar{0.0}, Parameters::Get<Parameters::IncrementalIntensiveQuantitiesTolerance<Scalar>>());
     check_well_operability_ = Parameters::Get<Parameters::EnableWellOperabilityCheck>();
     check_well_operability_iter_ = Parameters::Get<Parameters::EnableWellOperabilityCheckIter>();
     max_number_of_well_switches_ = Parameters::Get<Parameters::MaximumNumberOfWellSwitches>();
@@ -76,6 +78,7 @@ BlackoilModelParameters<Scalar>::BlackoilModelParameters()
     local_well_solver_control_switching_ = Parameters::Get<Parameters::LocalWellSolveControlSwitching>();
     use_implicit_ipr_ = Parameters::Get<Parameters::UseImplicitIpr>();
     check_group_constraints_inner_well_iterations_ = Parameters::Get<Parameters::CheckGroupConstraintsInnerWellIterations>();
+    threaded_wells_ = Parameters::Get<Parameters::ThreadedWells>();
     nonlinear_solver_ = Parameters::Get<Parameters::NonlinearSolver>();
     const auto approach = Parameters::Get<Parameters::LocalSolveApproach>();
     if (approach == "jacobi") {
@@ -87,6 +90,7 @@ BlackoilModelParameters<Scalar>::BlackoilModelParameters()
     }
 
     max_local_solve_iterations_ = Parameters::Get<Parameters::MaxLocalSolveIterations>();
+    concurrent_local_solves_ = Parameters::Get<Parameters::ConcurrentLocalSolves>();
     local_tolerance_scaling_mb_ = Parameters::Get<Parameters::LocalToleranceScalingMb<Scalar>>();
     local_tolerance_scaling_cnv_ = Parameters::Get<Parameters::LocalToleranceScalingCnv<Scalar>>();
     nldd_num_initial_newton_iter_ = Parameters::Get<Parameters::NlddNumInitialNewtonIter>();
@@ -199,6 +203,13 @@ void BlackoilModelParameters<Scalar>::registerParameters()
     Parameters::Register<Parameters::MatrixAddWellContributions>
         ("Explicitly specify the influences of wells between cells in "
          "the Jacobian and preconditioner matrices");
+    Parameters::Register<Parameters::IncrementalIntensiveQuantities>
+        ("Only update the intensive quantities and the flux terms of the cells "
+         "whose primary variables changed after the first Newton iteration of a time step");
+    Parameters::Register<Parameters::IncrementalIntensiveQuantitiesTolerance<Scalar>>
+        ("Relative change of a primary variable since the last update of the intensive "
+         "quantities of its cell below which the cell is considered to be unchanged by "
+         "the incremental update. Not used with the nldd nonlinear solver");
     Parameters::Register<Parameters::EnableWellOperabilityCheck>
         ("Enable the well operability checking");
     Parameters::Register<Parameters::EnableWellOperabilityCheckIter>
@@ -213,6 +224,10 @@ void BlackoilModelParameters<Scalar>::registerParameters()
         ("Compute implict IPR for stability checks and stable solution search");
     Parameters::Register<Parameters::CheckGroupConstraintsInnerWellIterations>
         ("Allow checking of group constraints during inner well iterations");        
+    Parameters::Register<Parameters::ThreadedWells>
+        ("Distribute the wells over the threads when assembling the well equations, "
+         "applying the well part of the linear operator and updating the well solutions. "
+         "The local well solves before the assembly are still done sequentially.");
     Parameters::Register<Parameters::NetworkMaxStrictIterations>
         ("Maximum iterations in network solver before relaxing tolerance");
     Parameters::Register<Parameters::NetworkMaxIterations>
@@ -223,6 +238,10 @@ void BlackoilModelParameters<Scalar>::registerParameters()
         ("Choose local solve approach. Valid choices are jacobi and gauss-seidel");
     Parameters::Register<Parameters::MaxLocalSolveIterations>
         ("Max iterations for local solves with NLDD nonlinear solver.");
+    Parameters::Register<Parameters::ConcurrentLocalSolves>
+        ("Solve the subdomains of the NLDD nonlinear solver concurrently on the "
+         "available threads. Only subdomains which do not share a face are solved "
+         "at the same time.");
     Parameters::Register<Parameters::LocalToleranceScalingMb<Scalar>>
         ("Set lower than 1.0 to use stricter convergence tolerance for local solves.");
     Parameters::Register<Parameters::LocalToleranceScalingCnv<Scalar>>
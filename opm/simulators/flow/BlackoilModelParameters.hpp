@@ -90,6 +90,10 @@ struct SolveWelleqInitially { static constexpr bool value = true; };
 struct UpdateEquationsScaling { static constexpr bool value = false; };
 struct UseUpdateStabilization { static constexpr bool value = true; };
 struct MatrixAddWellContributions { static constexpr bool value = false; };
+struct IncrementalIntensiveQuantities { static constexpr bool value = false; };
+
+template<class Scalar>
+struct IncrementalIntensiveQuantitiesTolerance { static constexpr Scalar value = 0.0; };
 
 struct UseMultisegmentWell { static constexpr bool value = true; };
 
@@ -125,6 +129,7 @@ struct UseAverageDensityMsWells { static constexpr bool value = false; };
 struct LocalWellSolveControlSwitching { static constexpr bool value = true; };
 struct UseImplicitIpr { static constexpr bool value = true; };
 struct CheckGroupConstraintsInnerWellIterations { static constexpr bool value = true; };
+struct ThreadedWells { static constexpr bool value = false; };
 
 // Network solver parameters
 struct NetworkMaxStrictIterations { static constexpr int value = 10; };
@@ -132,6 +137,7 @@ struct NetworkMaxIterations { static constexpr int value = 20; };
 struct NonlinearSolver { static constexpr auto value = "newton"; };
 struct LocalSolveApproach { static constexpr auto value = "gauss-seidel"; };
 struct MaxLocalSolveIterations { static constexpr int value = 20; };
+struct ConcurrentLocalSolves { static constexpr bool value = false; };
 
 template<class Scalar>
 struct LocalToleranceScalingMb { static constexpr Scalar value = 1.0; };
@@ -267,6 +273,14 @@ public:
     /// Whether to add influences of wells between cells to the matrix and preconditioner matrix
     bool matrix_add_well_contributions_;
 
+    /// Whether to only update the intensive quantities of the cells whose primary
+    /// variables changed during a Newton iteration
+    bool incremental_iq_update_;
+
+    /// Relative change of a primary variable since the last update of the intensive
+    /// quantities of its cell below which the cell is considered unchanged
+    Scalar incremental_iq_update_tolerance_;
+
     /// Whether to check well operability
     bool check_well_operability_;
     /// Whether to check well operability during iterations
@@ -287,6 +301,9 @@ public:
     /// Whether to allow checking/changing to group controls during inner well iterations
     bool check_group_constraints_inner_well_iterations_; 
 
+    /// Whether to assemble, apply and update the wells in parallel threads
+    bool threaded_wells_;
+
     /// Maximum number of iterations in the network solver before relaxing tolerance
     int network_max_strict_iterations_;
 
@@ -300,6 +317,9 @@ public:
 
     int max_local_solve_iterations_;
 
+    /// Whether to solve independent subdomains concurrently on the OpenMP threads.
+    bool concurrent_local_solves_{false};
+
     Scalar local_tolerance_scaling_mb_;
     Scalar local_tolerance_scaling_cnv_;
 
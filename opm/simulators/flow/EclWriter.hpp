@@ -54,6 +54,7 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <exception>
 #include <limits>
 #include <map>
 #include <memory>
@@ -732,12 +733,15 @@ private:
 
             this->outputModule_->prepareDensityAccumulation();
 
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            // The interior cells are the first num_interior degrees of
+            // freedom and their intensive quantities are up to date in the
+            // cache, so the cells can be processed independently.
+            forEachInteriorCell_(num_interior, [this](const int dofIdx)
+            {
+                const auto& intQuants = *simulator_.model().cachedIntensiveQuantities(dofIdx, /*timeIdx=*/0);
 
-                this->outputModule_->processElement(elemCtx);
-            }
+                this->outputModule_->processCell(dofIdx, intQuants);
+            });
 
             this->outputModule_->accumulateDensityParallel();
         }
@@ -755,36 +759,32 @@ private:
 
         if (! this->simulator_.model().linearizer().getFlowsInfo().empty()) {
             OPM_TIMEBLOCK(prepareFlowsData);
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                this->outputModule_->processElementFlows(elemCtx);
-            }
+            forEachInteriorCell_(num_interior, [this](const int dofIdx)
+            {
+                this->outputModule_->processCellFlows(dofIdx);
+            });
         }
 
         {
             OPM_TIMEBLOCK(prepareBlockData);
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            forEachInteriorCell_(num_interior, [this](const int dofIdx)
+            {
+                const auto& intQuants = *simulator_.model().cachedIntensiveQuantities(dofIdx, /*timeIdx=*/0);
 
-                this->outputModule_->processElementBlockData(elemCtx);
-            }
+                this->outputModule_->processCellBlockData(dofIdx, intQuants);
+            });
         }
 
         {
             OPM_TIMEBLOCK(prepareFluidInPlace);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for (int dofIdx = 0; dofIdx < num_interior; ++dofIdx) {
+            forEachInteriorCell_(num_interior, [this](const int dofIdx)
+            {
                 const auto& intQuants = *simulator_.model().cachedIntensiveQuantities(dofIdx, /*timeIdx=*/0);
                 const auto totVolume = simulator_.model().dofTotalVolume(dofIdx);
 
                 this->outputModule_->updateFluidInPlace(dofIdx, intQuants, totVolume);
-            }
+            });
         }
 
         this->outputModule_->validateLocalData();
@@ -793,6 +793,36 @@ private:
                                    this->simulator_.vanguard().grid().comm());
     }
 
+    // Calls func(dofIdx) for the first num_interior cells, distributed over
+    // the OpenMP threads. An exception must not leave the parallel region,
+    // so the first one thrown is kept and rethrown after the loop.
+    template <class Func>
+    static void forEachInteriorCell_(const int num_interior, Func&& func)
+    {
+        std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int dofIdx = 0; dofIdx < num_interior; ++dofIdx) {
+            try {
+                func(dofIdx);
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                {
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                }
+            }
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
     void captureLocalFluxData()
     {
         OPM_TIMEBLOCK(captureLocalData);
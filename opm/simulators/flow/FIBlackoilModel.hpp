@@ -35,7 +35,9 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
+#include <cstddef>
 #include <stdexcept>
+#include <vector>
 
 namespace Opm
 {
@@ -67,38 +69,75 @@ public:
         this->invalidateIntensiveQuantitiesCache(timeIdx);
         OPM_BEGIN_PARALLEL_TRY_CATCH()
         // loop over all elements...
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView_);
+        auto& chunkedElemIt = this->chunkedElementIterator_();
+        chunkedElemIt.reset();
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
             ElementContext elemCtx(this->simulator_);
-            ElementIterator elemIt = threadedElemIt.beginParallel();
-            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
-                const Element& elem = *elemIt;
+            chunkedElemIt.forEach([&](const Element& elem)
+            {
                 elemCtx.updatePrimaryStencil(elem);
                 elemCtx.updatePrimaryIntensiveQuantities(timeIdx);
-            }
+            });
         }
         OPM_END_PARALLEL_TRY_CATCH("InvalideAndUpdateIntensiveQuantities: state error", this->simulator_.vanguard().grid().comm());
     }
 
+    /*!
+     * \brief Update the intensive quantities of the most recent time index
+     *        only for the cells which are flagged in 'cellChanged'.
+     *
+     * The intensive quantities of all other cells are kept as they are,
+     * i.e., the caller must make sure that their primary variables did not
+     * change (significantly) since they were last updated.
+     *
+     * \return The number of cells whose intensive quantities were kept.
+     */
+    std::size_t updateChangedIntensiveQuantities(const std::vector<unsigned char>& cellChanged) const
+    {
+        std::size_t numSkipped = 0;
+        OPM_BEGIN_PARALLEL_TRY_CATCH()
+        auto& chunkedElemIt = this->chunkedElementIterator_();
+        chunkedElemIt.reset();
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:numSkipped)
+#endif
+        {
+            ElementContext elemCtx(this->simulator_);
+            chunkedElemIt.forEach([&](const Element& elem)
+            {
+                const unsigned globalIndex = this->elementMapper().index(elem);
+                if (!cellChanged[globalIndex]) {
+                    ++numSkipped;
+                    return;
+                }
+                this->setIntensiveQuantitiesCacheEntryValidity(globalIndex, /*timeIdx=*/0, false);
+                elemCtx.updatePrimaryStencil(elem);
+                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            });
+        }
+        OPM_END_PARALLEL_TRY_CATCH("UpdateChangedIntensiveQuantities: state error", this->simulator_.vanguard().grid().comm());
+        return numSkipped;
+    }
+
     void invalidateAndUpdateIntensiveQuantitiesOverlap(unsigned timeIdx) const
     {
         // loop over all elements
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView_);
+        auto& chunkedElemIt = this->chunkedElementIterator_();
+        chunkedElemIt.reset();
         OPM_BEGIN_PARALLEL_TRY_CATCH()
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
             ElementContext elemCtx(this->simulator_);
-            auto elemIt = threadedElemIt.beginParallel();
-            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
-                if (elemIt->partitionType() != Dune::OverlapEntity) {
-                    continue;
+            chunkedElemIt.forEach([&](const Element& elem)
+            {
+                if (elem.partitionType() != Dune::OverlapEntity) {
+                    return;
                 }
-                const Element& elem = *elemIt;
                 elemCtx.updatePrimaryStencil(elem);
                 // Mark cache for this element as invalid.
                 const std::size_t numPrimaryDof = elemCtx.numPrimaryDof(timeIdx);
@@ -108,7 +147,7 @@ public:
                 }
                 // Update for this element.
                 elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            }
+            });
         }
         OPM_END_PARALLEL_TRY_CATCH("InvalideAndUpdateIntensiveQuantitiesOverlap: state error", this->simulator_.vanguard().grid().comm());
     }
@@ -118,18 +157,17 @@ public:
     {
         // loop over all elements in the subdomain
         using GridViewType = decltype(gridSubDomain.view);
-        ThreadedEntityIterator<GridViewType, /*codim=*/0> threadedElemIt(gridSubDomain.view);
+        ChunkedEntityIterator<GridViewType, /*codim=*/0> chunkedElemIt(gridSubDomain.view);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
             ElementContext elemCtx(this->simulator_);
-            auto elemIt = threadedElemIt.beginParallel();
-            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
-                if (elemIt->partitionType() != Dune::InteriorEntity) {
-                    continue;
+            chunkedElemIt.forEach([&](const auto& elem)
+            {
+                if (elem.partitionType() != Dune::InteriorEntity) {
+                    return;
                 }
-                const Element& elem = *elemIt;
                 elemCtx.updatePrimaryStencil(elem);
                 // Mark cache for this element as invalid.
                 const std::size_t numPrimaryDof = elemCtx.numPrimaryDof(timeIdx);
@@ -139,7 +177,7 @@ public:
                 }
                 // Update for this element.
                 elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            }
+            });
         }
     }
 
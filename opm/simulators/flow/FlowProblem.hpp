@@ -342,6 +342,7 @@ public:
             updateReferencePorosity_();
             updatePffDofData_();
             this->model().linearizer().updateDiscretizationParameters();
+            tracerModel_.updateStoredTransmissibilities();
         }
 
         bool tuningEvent = this->beginEpisode_(enableExperiments, this->episodeIndex());
@@ -56,6 +56,9 @@ void registerFlowProblemParameters()
     Parameters::Register<Parameters::EnableDriftCompensation>
         ("Enable partial compensation of systematic mass losses via "
          "the source term of the next time step");
+    Parameters::Register<Parameters::EnableTracerUpwindSolver>
+        ("Solve the tracer equations by a forward substitution in the upwind order of the cells. "
+         "Cyclic regions are solved locally with GMRES. Only used in sequential runs");
     Parameters::Register<Parameters::OutputMode>
         ("Specify which messages are going to be printed. "
          "Valid values are: none, log, all (default)");
@@ -50,6 +50,10 @@ struct NumSatfuncConsistencySamplePoints { static constexpr int value = 5; };
 struct NumPressurePointsEquil
 { static constexpr int value = ParserKeywords::EQLDIMS::DEPTH_NODES_P::defaultValue; };
 
+// Solve the tracer equations by forward substitution in upwind order of
+// the cells instead of using a Krylov solver (sequential runs only)
+struct EnableTracerUpwindSolver { static constexpr bool value = false; };
+
 struct OutputMode { static constexpr auto value = "all"; };
 
 // The frequency of writing restart (*.ers) files. This is the number of time steps
@@ -155,6 +155,9 @@ protected:
 
     /// \brief Function returning the cell centers
     std::function<std::array<double,dimWorld>(int)> centroids_;
+
+    /// \brief Solve sequential tracer systems by forward substitution in upwind order
+    bool useUpwindSolver_ = false;
 };
 
 } // namespace Opm
@@ -49,6 +49,7 @@
 #include <opm/simulators/linalg/ilufirstelement.hh>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/UpwindOrderedSolver.hpp>
 
 #include <fmt/format.h>
 
@@ -412,6 +413,11 @@ linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
     else
     {
 #endif
+        if (useUpwindSolver_) {
+            UpwindOrderedSolver<TracerMatrix,TracerVector> solver(M, tolerance, maxIter);
+            return solver.apply(x, b);
+        }
+
         using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
         using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
         using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
@@ -468,6 +474,16 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     else
     {
 #endif
+        if (useUpwindSolver_) {
+            // the ordering only depends on the matrix and is shared by all tracers
+            UpwindOrderedSolver<TracerMatrix,TracerVector> solver(M, tolerance, maxIter);
+            bool converged = true;
+            for (std::size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
+                converged = solver.apply(x[nrhs], b[nrhs]) && converged;
+            }
+            return converged;
+        }
+
         using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
         using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
         using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
@@ -275,452 +275,477 @@ public:
         if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
             return;
 
-        const auto& problem = elemCtx.simulator().problem();
-        const auto& modelResid = elemCtx.simulator().model().linearizer().residual();
         for (unsigned dofIdx = 0; dofIdx < elemCtx.numPrimaryDof(/*timeIdx=*/0); ++dofIdx) {
-            const auto& intQuants = elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0);
-            const auto& fs = intQuants.fluidState();
+            this->processCell(elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0),
+                              elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0));
+        }
+    }
 
-            using FluidState = std::remove_cv_t<std::remove_reference_t<decltype(fs)>>;
+    /*!
+     * \brief Modify the internal buffers according to the intensive
+     *        quantities of a single cell
+     *
+     * This only writes to the entries of the cell and may be called
+     * concurrently for different cells by OpenMP threads.
+     */
+    void processCell(const unsigned globalDofIdx, const IntensiveQuantities& intQuants)
+    {
+        if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
+            return;
 
-            const unsigned globalDofIdx = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
-            const unsigned pvtRegionIdx = elemCtx.primaryVars(dofIdx, /*timeIdx=*/0).pvtRegionIndex();
+        const auto& problem = simulator_.problem();
+        const auto& modelResid = simulator_.model().linearizer().residual();
+        const auto& fs = intQuants.fluidState();
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->saturation_[phaseIdx].empty())
-                    continue;
+        using FluidState = std::remove_cv_t<std::remove_reference_t<decltype(fs)>>;
 
-                this->saturation_[phaseIdx][globalDofIdx] = getValue(fs.saturation(phaseIdx));
-                Valgrind::CheckDefined(this->saturation_[phaseIdx][globalDofIdx]);
-            }
+        const unsigned pvtRegionIdx = intQuants.pvtRegionIndex();
 
-            if (this->regionAvgDensity_.has_value()) {
-                // Note: We intentionally exclude effects of rock
-                // compressibility by using referencePorosity() here.
-                const auto porv = intQuants.referencePorosity()
-                    * elemCtx.simulator().model().dofTotalVolume(globalDofIdx);
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->saturation_[phaseIdx].empty())
+                continue;
 
-                this->aggregateAverageDensityContributions_(fs, globalDofIdx,
-                                                            static_cast<double>(porv));
-            }
+            this->saturation_[phaseIdx][globalDofIdx] = getValue(fs.saturation(phaseIdx));
+            Valgrind::CheckDefined(this->saturation_[phaseIdx][globalDofIdx]);
+        }
 
-            if (!this->fluidPressure_.empty()) {
-                if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
-                    // Output oil pressure as default
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx));
-                } else if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
-                    // Output gas if oil is not present
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx));
-                } else {
-                    // Output water if neither oil nor gas is present
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(waterPhaseIdx));
-                }
-                Valgrind::CheckDefined(this->fluidPressure_[globalDofIdx]);
-            }
+        if (this->regionAvgDensity_.has_value()) {
+            // Note: We intentionally exclude effects of rock
+            // compressibility by using referencePorosity() here.
+            const auto porv = intQuants.referencePorosity()
+                * simulator_.model().dofTotalVolume(globalDofIdx);
 
-            if (!this->temperature_.empty()) {
-                this->temperature_[globalDofIdx] = getValue(fs.temperature(oilPhaseIdx));
-                Valgrind::CheckDefined(this->temperature_[globalDofIdx]);
-            }
-            if (!this->gasDissolutionFactor_.empty()) {
-                Scalar SoMax = elemCtx.problem().maxOilSaturation(globalDofIdx);
-                this->gasDissolutionFactor_[globalDofIdx]
-                    = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
-                        fs, oilPhaseIdx, pvtRegionIdx, SoMax);
-                Valgrind::CheckDefined(this->gasDissolutionFactor_[globalDofIdx]);
-            }
-            if (!this->oilVaporizationFactor_.empty()) {
-                Scalar SoMax = elemCtx.problem().maxOilSaturation(globalDofIdx);
-                this->oilVaporizationFactor_[globalDofIdx]
-                    = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
-                        fs, gasPhaseIdx, pvtRegionIdx, SoMax);
-                Valgrind::CheckDefined(this->oilVaporizationFactor_[globalDofIdx]);
-            }
-            if (!this->gasDissolutionFactorInWater_.empty()) {
-                Scalar SwMax = elemCtx.problem().maxWaterSaturation(globalDofIdx);
-                this->gasDissolutionFactorInWater_[globalDofIdx]
-                    = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
-                        fs, waterPhaseIdx, pvtRegionIdx, SwMax);
-                Valgrind::CheckDefined(this->gasDissolutionFactorInWater_[globalDofIdx]);
-            }
-            if (!this->waterVaporizationFactor_.empty()) {
-                this->waterVaporizationFactor_[globalDofIdx]
-                    = FluidSystem::template saturatedVaporizationFactor<FluidState, Scalar>(
-                        fs, gasPhaseIdx, pvtRegionIdx);
-                Valgrind::CheckDefined(this->waterVaporizationFactor_[globalDofIdx]);
-            }
-            if (!this->gasFormationVolumeFactor_.empty()) {
-                this->gasFormationVolumeFactor_[globalDofIdx] = 1.0
-                    / FluidSystem::template inverseFormationVolumeFactor<FluidState, Scalar>(
-                                                                    fs, gasPhaseIdx, pvtRegionIdx);
-                Valgrind::CheckDefined(this->gasFormationVolumeFactor_[globalDofIdx]);
-            }
-            if (!this->saturatedOilFormationVolumeFactor_.empty()) {
-                this->saturatedOilFormationVolumeFactor_[globalDofIdx] = 1.0
-                    / FluidSystem::template saturatedInverseFormationVolumeFactor<FluidState, Scalar>(
-                                                                             fs, oilPhaseIdx, pvtRegionIdx);
-                Valgrind::CheckDefined(this->saturatedOilFormationVolumeFactor_[globalDofIdx]);
-            }
-            if (!this->oilSaturationPressure_.empty()) {
-                this->oilSaturationPressure_[globalDofIdx]
-                    = FluidSystem::template saturationPressure<FluidState, Scalar>(fs, oilPhaseIdx, pvtRegionIdx);
-                Valgrind::CheckDefined(this->oilSaturationPressure_[globalDofIdx]);
-            }
+            this->aggregateAverageDensityContributions_(fs, globalDofIdx,
+                                                        static_cast<double>(porv));
+        }
 
-            if (!this->rs_.empty()) {
-                this->rs_[globalDofIdx] = getValue(fs.Rs());
-                Valgrind::CheckDefined(this->rs_[globalDofIdx]);
-            }
-            if (!this->rsw_.empty()) {
-                this->rsw_[globalDofIdx] = getValue(fs.Rsw());
-                Valgrind::CheckDefined(this->rsw_[globalDofIdx]);
+        if (!this->fluidPressure_.empty()) {
+            if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
+                // Output oil pressure as default
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx));
+            } else if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
+                // Output gas if oil is not present
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx));
+            } else {
+                // Output water if neither oil nor gas is present
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(waterPhaseIdx));
             }
+            Valgrind::CheckDefined(this->fluidPressure_[globalDofIdx]);
+        }
 
-            if (!this->rv_.empty()) {
-                this->rv_[globalDofIdx] = getValue(fs.Rv());
-                Valgrind::CheckDefined(this->rv_[globalDofIdx]);
-            }
-            if (!this->pcgw_.empty()) {
-                this->pcgw_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
-                Valgrind::CheckDefined(this->pcgw_[globalDofIdx]);
-            }
-            if (!this->pcow_.empty()) {
-                this->pcow_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
-                Valgrind::CheckDefined(this->pcow_[globalDofIdx]);
-            }
-            if (!this->pcog_.empty()) {
-                this->pcog_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
-                Valgrind::CheckDefined(this->pcog_[globalDofIdx]);
-            }
+        if (!this->temperature_.empty()) {
+            this->temperature_[globalDofIdx] = getValue(fs.temperature(oilPhaseIdx));
+            Valgrind::CheckDefined(this->temperature_[globalDofIdx]);
+        }
+        if (!this->gasDissolutionFactor_.empty()) {
+            Scalar SoMax = problem.maxOilSaturation(globalDofIdx);
+            this->gasDissolutionFactor_[globalDofIdx]
+                = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
+                    fs, oilPhaseIdx, pvtRegionIdx, SoMax);
+            Valgrind::CheckDefined(this->gasDissolutionFactor_[globalDofIdx]);
+        }
+        if (!this->oilVaporizationFactor_.empty()) {
+            Scalar SoMax = problem.maxOilSaturation(globalDofIdx);
+            this->oilVaporizationFactor_[globalDofIdx]
+                = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
+                    fs, gasPhaseIdx, pvtRegionIdx, SoMax);
+            Valgrind::CheckDefined(this->oilVaporizationFactor_[globalDofIdx]);
+        }
+        if (!this->gasDissolutionFactorInWater_.empty()) {
+            Scalar SwMax = problem.maxWaterSaturation(globalDofIdx);
+            this->gasDissolutionFactorInWater_[globalDofIdx]
+                = FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(
+                    fs, waterPhaseIdx, pvtRegionIdx, SwMax);
+            Valgrind::CheckDefined(this->gasDissolutionFactorInWater_[globalDofIdx]);
+        }
+        if (!this->waterVaporizationFactor_.empty()) {
+            this->waterVaporizationFactor_[globalDofIdx]
+                = FluidSystem::template saturatedVaporizationFactor<FluidState, Scalar>(
+                    fs, gasPhaseIdx, pvtRegionIdx);
+            Valgrind::CheckDefined(this->waterVaporizationFactor_[globalDofIdx]);
+        }
+        if (!this->gasFormationVolumeFactor_.empty()) {
+            this->gasFormationVolumeFactor_[globalDofIdx] = 1.0
+                / FluidSystem::template inverseFormationVolumeFactor<FluidState, Scalar>(
+                                                                fs, gasPhaseIdx, pvtRegionIdx);
+            Valgrind::CheckDefined(this->gasFormationVolumeFactor_[globalDofIdx]);
+        }
+        if (!this->saturatedOilFormationVolumeFactor_.empty()) {
+            this->saturatedOilFormationVolumeFactor_[globalDofIdx] = 1.0
+                / FluidSystem::template saturatedInverseFormationVolumeFactor<FluidState, Scalar>(
+                                                                         fs, oilPhaseIdx, pvtRegionIdx);
+            Valgrind::CheckDefined(this->saturatedOilFormationVolumeFactor_[globalDofIdx]);
+        }
+        if (!this->oilSaturationPressure_.empty()) {
+            this->oilSaturationPressure_[globalDofIdx]
+                = FluidSystem::template saturationPressure<FluidState, Scalar>(fs, oilPhaseIdx, pvtRegionIdx);
+            Valgrind::CheckDefined(this->oilSaturationPressure_[globalDofIdx]);
+        }
 
-            if (!this->rvw_.empty()) {
-                this->rvw_[globalDofIdx] = getValue(fs.Rvw());
-                Valgrind::CheckDefined(this->rvw_[globalDofIdx]);
-            }
+        if (!this->rs_.empty()) {
+            this->rs_[globalDofIdx] = getValue(fs.Rs());
+            Valgrind::CheckDefined(this->rs_[globalDofIdx]);
+        }
+        if (!this->rsw_.empty()) {
+            this->rsw_[globalDofIdx] = getValue(fs.Rsw());
+            Valgrind::CheckDefined(this->rsw_[globalDofIdx]);
+        }
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->invB_[phaseIdx].empty())
-                    continue;
+        if (!this->rv_.empty()) {
+            this->rv_[globalDofIdx] = getValue(fs.Rv());
+            Valgrind::CheckDefined(this->rv_[globalDofIdx]);
+        }
+        if (!this->pcgw_.empty()) {
+            this->pcgw_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
+            Valgrind::CheckDefined(this->pcgw_[globalDofIdx]);
+        }
+        if (!this->pcow_.empty()) {
+            this->pcow_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
+            Valgrind::CheckDefined(this->pcow_[globalDofIdx]);
+        }
+        if (!this->pcog_.empty()) {
+            this->pcog_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
+            Valgrind::CheckDefined(this->pcog_[globalDofIdx]);
+        }
 
-                this->invB_[phaseIdx][globalDofIdx] = getValue(fs.invB(phaseIdx));
-                Valgrind::CheckDefined(this->invB_[phaseIdx][globalDofIdx]);
-            }
+        if (!this->rvw_.empty()) {
+            this->rvw_[globalDofIdx] = getValue(fs.Rvw());
+            Valgrind::CheckDefined(this->rvw_[globalDofIdx]);
+        }
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->density_[phaseIdx].empty())
-                    continue;
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->invB_[phaseIdx].empty())
+                continue;
 
-                this->density_[phaseIdx][globalDofIdx] = getValue(fs.density(phaseIdx));
-                Valgrind::CheckDefined(this->density_[phaseIdx][globalDofIdx]);
-            }
+            this->invB_[phaseIdx][globalDofIdx] = getValue(fs.invB(phaseIdx));
+            Valgrind::CheckDefined(this->invB_[phaseIdx][globalDofIdx]);
+        }
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->viscosity_[phaseIdx].empty())
-                    continue;
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->density_[phaseIdx].empty())
+                continue;
 
-                if (!this->extboX_.empty() && phaseIdx == oilPhaseIdx)
-                    this->viscosity_[phaseIdx][globalDofIdx] = getValue(intQuants.oilViscosity());
-                else if (!this->extboX_.empty() && phaseIdx == gasPhaseIdx)
-                    this->viscosity_[phaseIdx][globalDofIdx] = getValue(intQuants.gasViscosity());
-                else
-                    this->viscosity_[phaseIdx][globalDofIdx] = getValue(fs.viscosity(phaseIdx));
-                Valgrind::CheckDefined(this->viscosity_[phaseIdx][globalDofIdx]);
-            }
+            this->density_[phaseIdx][globalDofIdx] = getValue(fs.density(phaseIdx));
+            Valgrind::CheckDefined(this->density_[phaseIdx][globalDofIdx]);
+        }
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->relativePermeability_[phaseIdx].empty())
-                    continue;
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->viscosity_[phaseIdx].empty())
+                continue;
 
-                this->relativePermeability_[phaseIdx][globalDofIdx]
-                    = getValue(intQuants.relativePermeability(phaseIdx));
-                Valgrind::CheckDefined(this->relativePermeability_[phaseIdx][globalDofIdx]);
-            }
+            if (!this->extboX_.empty() && phaseIdx == oilPhaseIdx)
+                this->viscosity_[phaseIdx][globalDofIdx] = getValue(intQuants.oilViscosity());
+            else if (!this->extboX_.empty() && phaseIdx == gasPhaseIdx)
+                this->viscosity_[phaseIdx][globalDofIdx] = getValue(intQuants.gasViscosity());
+            else
+                this->viscosity_[phaseIdx][globalDofIdx] = getValue(fs.viscosity(phaseIdx));
+            Valgrind::CheckDefined(this->viscosity_[phaseIdx][globalDofIdx]);
+        }
 
-            if (!this->drsdtcon_.empty()) {
-                this->drsdtcon_[globalDofIdx] = problem.drsdtcon(globalDofIdx, elemCtx.simulator().episodeIndex());
-            }
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->relativePermeability_[phaseIdx].empty())
+                continue;
 
-            if (!this->sSol_.empty()) {
-                this->sSol_[globalDofIdx] = intQuants.solventSaturation().value();
-            }
+            this->relativePermeability_[phaseIdx][globalDofIdx]
+                = getValue(intQuants.relativePermeability(phaseIdx));
+            Valgrind::CheckDefined(this->relativePermeability_[phaseIdx][globalDofIdx]);
+        }
 
-            if (!this->rswSol_.empty()) {
-                this->rswSol_[globalDofIdx] = intQuants.rsSolw().value();
-            }
+        if (!this->drsdtcon_.empty()) {
+            this->drsdtcon_[globalDofIdx] = problem.drsdtcon(globalDofIdx, simulator_.episodeIndex());
+        }
 
-            if (!this->cPolymer_.empty()) {
-                this->cPolymer_[globalDofIdx] = intQuants.polymerConcentration().value();
-            }
+        if (!this->sSol_.empty()) {
+            this->sSol_[globalDofIdx] = intQuants.solventSaturation().value();
+        }
 
-            if (!this->cFoam_.empty()) {
-                this->cFoam_[globalDofIdx] = intQuants.foamConcentration().value();
-            }
+        if (!this->rswSol_.empty()) {
+            this->rswSol_[globalDofIdx] = intQuants.rsSolw().value();
+        }
 
-            if (!this->cSalt_.empty()) {
-                this->cSalt_[globalDofIdx] = fs.saltConcentration().value();
-            }
+        if (!this->cPolymer_.empty()) {
+            this->cPolymer_[globalDofIdx] = intQuants.polymerConcentration().value();
+        }
 
-            if (!this->pSalt_.empty()) {
-                this->pSalt_[globalDofIdx] = intQuants.saltSaturation().value();
-            }
+        if (!this->cFoam_.empty()) {
+            this->cFoam_[globalDofIdx] = intQuants.foamConcentration().value();
+        }
 
-            if (!this->permFact_.empty()) {
-                this->permFact_[globalDofIdx] = intQuants.permFactor().value();
-            }
+        if (!this->cSalt_.empty()) {
+            this->cSalt_[globalDofIdx] = fs.saltConcentration().value();
+        }
 
-            if (!this->extboX_.empty()) {
-                this->extboX_[globalDofIdx] = intQuants.xVolume().value();
-            }
+        if (!this->pSalt_.empty()) {
+            this->pSalt_[globalDofIdx] = intQuants.saltSaturation().value();
+        }
 
-            if (!this->extboY_.empty()) {
-                this->extboY_[globalDofIdx] = intQuants.yVolume().value();
-            }
+        if (!this->permFact_.empty()) {
+            this->permFact_[globalDofIdx] = intQuants.permFactor().value();
+        }
 
-            if (!this->extboZ_.empty()) {
-                this->extboZ_[globalDofIdx] = intQuants.zFraction().value();
-            }
+        if (!this->extboX_.empty()) {
+            this->extboX_[globalDofIdx] = intQuants.xVolume().value();
+        }
 
-            if (!this->rPorV_.empty()) {
-                const auto totVolume = elemCtx.simulator().model().dofTotalVolume(globalDofIdx);
-                this->rPorV_[globalDofIdx] = totVolume * intQuants.porosity().value();
-            }
+        if (!this->extboY_.empty()) {
+            this->extboY_[globalDofIdx] = intQuants.yVolume().value();
+        }
 
-            if (!this->mFracCo2_.empty()) {
-                const Scalar stdVolOil = getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx))
-                    + getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx)) * getValue(fs.Rv());
-                const Scalar stdVolGas = getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx))
-                        * (1.0 - intQuants.yVolume().value())
-                    + getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx)) * getValue(fs.Rs())
-                        * (1.0 - intQuants.xVolume().value());
-                const Scalar stdVolCo2 = getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx))
-                        * intQuants.yVolume().value()
-                    + getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx)) * getValue(fs.Rs())
-                        * intQuants.xVolume().value();
-                const Scalar rhoO = FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
-                const Scalar rhoG = FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
-                const Scalar rhoCO2 = intQuants.zRefDensity();
-                const Scalar stdMassTotal = 1.0e-10 + stdVolOil * rhoO + stdVolGas * rhoG + stdVolCo2 * rhoCO2;
-                this->mFracOil_[globalDofIdx] = stdVolOil * rhoO / stdMassTotal;
-                this->mFracGas_[globalDofIdx] = stdVolGas * rhoG / stdMassTotal;
-                this->mFracCo2_[globalDofIdx] = stdVolCo2 * rhoCO2 / stdMassTotal;
-            }
+        if (!this->extboZ_.empty()) {
+            this->extboZ_[globalDofIdx] = intQuants.zFraction().value();
+        }
 
-            if (!this->cMicrobes_.empty()) {
-                this->cMicrobes_[globalDofIdx] = intQuants.microbialConcentration().value();
-            }
+        if (!this->rPorV_.empty()) {
+            const auto totVolume = simulator_.model().dofTotalVolume(globalDofIdx);
+            this->rPorV_[globalDofIdx] = totVolume * intQuants.porosity().value();
+        }
 
-            if (!this->cOxygen_.empty()) {
-                this->cOxygen_[globalDofIdx] = intQuants.oxygenConcentration().value();
-            }
+        if (!this->mFracCo2_.empty()) {
+            const Scalar stdVolOil = getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx))
+                + getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx)) * getValue(fs.Rv());
+            const Scalar stdVolGas = getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx))
+                    * (1.0 - intQuants.yVolume().value())
+                + getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx)) * getValue(fs.Rs())
+                    * (1.0 - intQuants.xVolume().value());
+            const Scalar stdVolCo2 = getValue(fs.saturation(gasPhaseIdx)) * getValue(fs.invB(gasPhaseIdx))
+                    * intQuants.yVolume().value()
+                + getValue(fs.saturation(oilPhaseIdx)) * getValue(fs.invB(oilPhaseIdx)) * getValue(fs.Rs())
+                    * intQuants.xVolume().value();
+            const Scalar rhoO = FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
+            const Scalar rhoG = FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
+            const Scalar rhoCO2 = intQuants.zRefDensity();
+            const Scalar stdMassTotal = 1.0e-10 + stdVolOil * rhoO + stdVolGas * rhoG + stdVolCo2 * rhoCO2;
+            this->mFracOil_[globalDofIdx] = stdVolOil * rhoO / stdMassTotal;
+            this->mFracGas_[globalDofIdx] = stdVolGas * rhoG / stdMassTotal;
+            this->mFracCo2_[globalDofIdx] = stdVolCo2 * rhoCO2 / stdMassTotal;
+        }
 
-            if (!this->cUrea_.empty()) {
-                this->cUrea_[globalDofIdx] = 10
-                    * intQuants.ureaConcentration()
-                          .value(); // Reescaling back the urea concentration (see WellInterface_impl.hpp)
-            }
+        if (!this->cMicrobes_.empty()) {
+            this->cMicrobes_[globalDofIdx] = intQuants.microbialConcentration().value();
+        }
 
-            if (!this->cBiofilm_.empty()) {
-                this->cBiofilm_[globalDofIdx] = intQuants.biofilmConcentration().value();
-            }
+        if (!this->cOxygen_.empty()) {
+            this->cOxygen_[globalDofIdx] = intQuants.oxygenConcentration().value();
+        }
 
-            if (!this->cCalcite_.empty()) {
-                this->cCalcite_[globalDofIdx] = intQuants.calciteConcentration().value();
-            }
+        if (!this->cUrea_.empty()) {
+            this->cUrea_[globalDofIdx] = 10
+                * intQuants.ureaConcentration()
+                      .value(); // Reescaling back the urea concentration (see WellInterface_impl.hpp)
+        }
 
-            if (!this->bubblePointPressure_.empty()) {
-                try {
-                    this->bubblePointPressure_[globalDofIdx]
-                        = getValue(FluidSystem::bubblePointPressure(fs, intQuants.pvtRegionIndex()));
-                } catch (const NumericalProblem&) {
-                    const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-                    this->failedCellsPb_.push_back(cartesianIdx);
-                }
+        if (!this->cBiofilm_.empty()) {
+            this->cBiofilm_[globalDofIdx] = intQuants.biofilmConcentration().value();
+        }
+
+        if (!this->cCalcite_.empty()) {
+            this->cCalcite_[globalDofIdx] = intQuants.calciteConcentration().value();
+        }
+
+        if (!this->bubblePointPressure_.empty()) {
+            try {
+                this->bubblePointPressure_[globalDofIdx]
+                    = getValue(FluidSystem::bubblePointPressure(fs, intQuants.pvtRegionIndex()));
+            } catch (const NumericalProblem&) {
+                const auto cartesianIdx = simulator_.vanguard().cartesianIndex(globalDofIdx);
+#ifdef _OPENMP
+#pragma omp critical (failedCellsPb)
+#endif
+                this->failedCellsPb_.push_back(cartesianIdx);
             }
+        }
 
-            if (!this->dewPointPressure_.empty()) {
-                try {
-                    this->dewPointPressure_[globalDofIdx]
-                        = getValue(FluidSystem::dewPointPressure(fs, intQuants.pvtRegionIndex()));
-                } catch (const NumericalProblem&) {
-                    const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-                    this->failedCellsPd_.push_back(cartesianIdx);
-                }
+        if (!this->dewPointPressure_.empty()) {
+            try {
+                this->dewPointPressure_[globalDofIdx]
+                    = getValue(FluidSystem::dewPointPressure(fs, intQuants.pvtRegionIndex()));
+            } catch (const NumericalProblem&) {
+                const auto cartesianIdx = simulator_.vanguard().cartesianIndex(globalDofIdx);
+#ifdef _OPENMP
+#pragma omp critical (failedCellsPd)
+#endif
+                this->failedCellsPd_.push_back(cartesianIdx);
             }
+        }
 
-            if (!this->minimumOilPressure_.empty())
-                this->minimumOilPressure_[globalDofIdx]
-                    = std::min(getValue(fs.pressure(oilPhaseIdx)), problem.minOilPressure(globalDofIdx));
+        if (!this->minimumOilPressure_.empty())
+            this->minimumOilPressure_[globalDofIdx]
+                = std::min(getValue(fs.pressure(oilPhaseIdx)), problem.minOilPressure(globalDofIdx));
 
-            if (!this->overburdenPressure_.empty())
-                this->overburdenPressure_[globalDofIdx] = problem.overburdenPressure(globalDofIdx);
+        if (!this->overburdenPressure_.empty())
+            this->overburdenPressure_[globalDofIdx] = problem.overburdenPressure(globalDofIdx);
 
-            if (!this->rockCompPorvMultiplier_.empty())
-                this->rockCompPorvMultiplier_[globalDofIdx]
-                    = problem.template rockCompPoroMultiplier<Scalar>(intQuants, globalDofIdx);
+        if (!this->rockCompPorvMultiplier_.empty())
+            this->rockCompPorvMultiplier_[globalDofIdx]
+                = problem.template rockCompPoroMultiplier<Scalar>(intQuants, globalDofIdx);
 
-            if (!this->rockCompTransMultiplier_.empty())
-                this->rockCompTransMultiplier_[globalDofIdx]
-                    = problem.template rockCompTransMultiplier<Scalar>(intQuants, globalDofIdx);
+        if (!this->rockCompTransMultiplier_.empty())
+            this->rockCompTransMultiplier_[globalDofIdx]
+                = problem.template rockCompTransMultiplier<Scalar>(intQuants, globalDofIdx);
 
-            const auto& matLawManager = problem.materialLawManager();
-            if (matLawManager->enableHysteresis()) {
-                if (FluidSystem::phaseIsActive(oilPhaseIdx) 
-                    && FluidSystem::phaseIsActive(waterPhaseIdx)) {
-                        Scalar somax;
-                        Scalar swmax;
-                        Scalar swmin;
+        const auto& matLawManager = problem.materialLawManager();
+        if (matLawManager->enableHysteresis()) {
+            if (FluidSystem::phaseIsActive(oilPhaseIdx) 
+                && FluidSystem::phaseIsActive(waterPhaseIdx)) {
+                    Scalar somax;
+                    Scalar swmax;
+                    Scalar swmin;
 
-                        matLawManager->oilWaterHysteresisParams(
-                            somax, swmax, swmin, globalDofIdx);
-                
-                    if (matLawManager->enableNonWettingHysteresis()) {
-                        if (!this->soMax_.empty()) {
-                            this->soMax_[globalDofIdx] = somax;
-                        }
+                    matLawManager->oilWaterHysteresisParams(
+                        somax, swmax, swmin, globalDofIdx);
+            
+                if (matLawManager->enableNonWettingHysteresis()) {
+                    if (!this->soMax_.empty()) {
+                        this->soMax_[globalDofIdx] = somax;
                     }
-                    if (matLawManager->enableWettingHysteresis()) {
-                        if (!this->swMax_.empty()) {
-                            this->swMax_[globalDofIdx] = swmax;
-                        }
+                }
+                if (matLawManager->enableWettingHysteresis()) {
+                    if (!this->swMax_.empty()) {
+                        this->swMax_[globalDofIdx] = swmax;
                     }
-                    if (matLawManager->enablePCHysteresis()) {
-                        if (!this->swmin_.empty()) {
-                            this->swmin_[globalDofIdx] = swmin;
-                        }
+                }
+                if (matLawManager->enablePCHysteresis()) {
+                    if (!this->swmin_.empty()) {
+                        this->swmin_[globalDofIdx] = swmin;
                     }
                 }
+            }
 
-                if (FluidSystem::phaseIsActive(oilPhaseIdx) 
-                    && FluidSystem::phaseIsActive(gasPhaseIdx)) {
-                        Scalar sgmax;
-                        Scalar shmax;
-                        Scalar somin;
-                        matLawManager->gasOilHysteresisParams(
-                            sgmax, shmax, somin, globalDofIdx);
-                
-                    if (matLawManager->enableNonWettingHysteresis()) {
-                        if (!this->sgmax_.empty()) {
-                            this->sgmax_[globalDofIdx] = sgmax;
-                        }
+            if (FluidSystem::phaseIsActive(oilPhaseIdx) 
+                && FluidSystem::phaseIsActive(gasPhaseIdx)) {
+                    Scalar sgmax;
+                    Scalar shmax;
+                    Scalar somin;
+                    matLawManager->gasOilHysteresisParams(
+                        sgmax, shmax, somin, globalDofIdx);
+            
+                if (matLawManager->enableNonWettingHysteresis()) {
+                    if (!this->sgmax_.empty()) {
+                        this->sgmax_[globalDofIdx] = sgmax;
                     }
-                    if (matLawManager->enableWettingHysteresis()) {
-                        if (!this->shmax_.empty()) {
-                            this->shmax_[globalDofIdx] = shmax;
-                        }
+                }
+                if (matLawManager->enableWettingHysteresis()) {
+                    if (!this->shmax_.empty()) {
+                        this->shmax_[globalDofIdx] = shmax;
                     }
-                    if (matLawManager->enablePCHysteresis()) {
-                        if (!this->somin_.empty()) {
-                            this->somin_[globalDofIdx] = somin;
-                        }
+                }
+                if (matLawManager->enablePCHysteresis()) {
+                    if (!this->somin_.empty()) {
+                        this->somin_[globalDofIdx] = somin;
                     }
                 }
-            } else {
-                
-                if (!this->soMax_.empty())
-                    this->soMax_[globalDofIdx]
-                        = std::max(getValue(fs.saturation(oilPhaseIdx)), problem.maxOilSaturation(globalDofIdx));
+            }
+        } else {
+            
+            if (!this->soMax_.empty())
+                this->soMax_[globalDofIdx]
+                    = std::max(getValue(fs.saturation(oilPhaseIdx)), problem.maxOilSaturation(globalDofIdx));
 
-                if (!this->swMax_.empty())
-                    this->swMax_[globalDofIdx]
-                        = std::max(getValue(fs.saturation(waterPhaseIdx)), problem.maxWaterSaturation(globalDofIdx));
+            if (!this->swMax_.empty())
+                this->swMax_[globalDofIdx]
+                    = std::max(getValue(fs.saturation(waterPhaseIdx)), problem.maxWaterSaturation(globalDofIdx));
 
-            }
-            if (!this->ppcw_.empty()) {
-                this->ppcw_[globalDofIdx] = matLawManager->oilWaterScaledEpsInfoDrainage(globalDofIdx).maxPcow;
-                // printf("ppcw_[%d] = %lg\n", globalDofIdx, ppcw_[globalDofIdx]);
-            }
+        }
+        if (!this->ppcw_.empty()) {
+            this->ppcw_[globalDofIdx] = matLawManager->oilWaterScaledEpsInfoDrainage(globalDofIdx).maxPcow;
+            // printf("ppcw_[%d] = %lg\n", globalDofIdx, ppcw_[globalDofIdx]);
+        }
 
-            // hack to make the intial output of rs and rv Ecl compatible.
-            // For cells with swat == 1 Ecl outputs; rs = rsSat and rv=rvSat, in all but the initial step
-            // where it outputs rs and rv values calculated by the initialization. To be compatible we overwrite
-            // rs and rv with the values computed in the initially.
-            // Volume factors, densities and viscosities need to be recalculated with the updated rs and rv values.
-            if ((elemCtx.simulator().episodeIndex() < 0) &&
-                FluidSystem::phaseIsActive(oilPhaseIdx) &&
-                FluidSystem::phaseIsActive(gasPhaseIdx))
-            {
-                const auto& fsInitial = problem.initialFluidState(globalDofIdx);
-
-                // use initial rs and rv values
-                if (!this->rv_.empty())
-                    this->rv_[globalDofIdx] = fsInitial.Rv();
-
-                if (!this->rs_.empty())
-                    this->rs_[globalDofIdx] = fsInitial.Rs();
-
-                if (!this->rsw_.empty())
-                    this->rsw_[globalDofIdx] = fsInitial.Rsw();
-
-                if (!this->rvw_.empty())
-                    this->rvw_[globalDofIdx] = fsInitial.Rvw();
-
-                // re-compute the volume factors, viscosities and densities if asked for
-                if (!this->density_[oilPhaseIdx].empty())
-                    this->density_[oilPhaseIdx][globalDofIdx]
-                        = FluidSystem::density(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
-
-                if (!this->density_[gasPhaseIdx].empty())
-                    this->density_[gasPhaseIdx][globalDofIdx]
-                        = FluidSystem::density(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
-
-                if (!this->invB_[oilPhaseIdx].empty())
-                    this->invB_[oilPhaseIdx][globalDofIdx]
-                        = FluidSystem::inverseFormationVolumeFactor(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
-
-                if (!this->invB_[gasPhaseIdx].empty())
-                    this->invB_[gasPhaseIdx][globalDofIdx]
-                        = FluidSystem::inverseFormationVolumeFactor(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
-
-                if (!this->viscosity_[oilPhaseIdx].empty())
-                    this->viscosity_[oilPhaseIdx][globalDofIdx]
-                        = FluidSystem::viscosity(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
-
-                if (!this->viscosity_[gasPhaseIdx].empty())
-                    this->viscosity_[gasPhaseIdx][globalDofIdx]
-                        = FluidSystem::viscosity(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
-            }
+        // hack to make the intial output of rs and rv Ecl compatible.
+        // For cells with swat == 1 Ecl outputs; rs = rsSat and rv=rvSat, in all but the initial step
+        // where it outputs rs and rv values calculated by the initialization. To be compatible we overwrite
+        // rs and rv with the values computed in the initially.
+        // Volume factors, densities and viscosities need to be recalculated with the updated rs and rv values.
+        if ((simulator_.episodeIndex() < 0) &&
+            FluidSystem::phaseIsActive(oilPhaseIdx) &&
+            FluidSystem::phaseIsActive(gasPhaseIdx))
+        {
+            const auto& fsInitial = problem.initialFluidState(globalDofIdx);
 
-            // Adding Well RFT data
-            const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-            if (this->oilConnectionPressures_.count(cartesianIdx) > 0) {
-                this->oilConnectionPressures_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
-            }
-            if (this->waterConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->waterConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(waterPhaseIdx));
-            }
-            if (this->gasConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->gasConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(gasPhaseIdx));
-            }
+            // use initial rs and rv values
+            if (!this->rv_.empty())
+                this->rv_[globalDofIdx] = fsInitial.Rv();
 
-            // tracers
-            const auto& tracerModel = simulator_.problem().tracerModel();
-            if (! this->freeTracerConcentrations_.empty()) {
-                for (int tracerIdx = 0; tracerIdx < tracerModel.numTracers(); ++tracerIdx) {
-                    if (this->freeTracerConcentrations_[tracerIdx].empty()) {
-                        continue;
-                    }
-                    this->freeTracerConcentrations_[tracerIdx][globalDofIdx] =
-                        tracerModel.freeTracerConcentration(tracerIdx, globalDofIdx);
+            if (!this->rs_.empty())
+                this->rs_[globalDofIdx] = fsInitial.Rs();
+
+            if (!this->rsw_.empty())
+                this->rsw_[globalDofIdx] = fsInitial.Rsw();
+
+            if (!this->rvw_.empty())
+                this->rvw_[globalDofIdx] = fsInitial.Rvw();
+
+            // re-compute the volume factors, viscosities and densities if asked for
+            if (!this->density_[oilPhaseIdx].empty())
+                this->density_[oilPhaseIdx][globalDofIdx]
+                    = FluidSystem::density(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
+
+            if (!this->density_[gasPhaseIdx].empty())
+                this->density_[gasPhaseIdx][globalDofIdx]
+                    = FluidSystem::density(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
+
+            if (!this->invB_[oilPhaseIdx].empty())
+                this->invB_[oilPhaseIdx][globalDofIdx]
+                    = FluidSystem::inverseFormationVolumeFactor(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
+
+            if (!this->invB_[gasPhaseIdx].empty())
+                this->invB_[gasPhaseIdx][globalDofIdx]
+                    = FluidSystem::inverseFormationVolumeFactor(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
+
+            if (!this->viscosity_[oilPhaseIdx].empty())
+                this->viscosity_[oilPhaseIdx][globalDofIdx]
+                    = FluidSystem::viscosity(fsInitial, oilPhaseIdx, intQuants.pvtRegionIndex());
+
+            if (!this->viscosity_[gasPhaseIdx].empty())
+                this->viscosity_[gasPhaseIdx][globalDofIdx]
+                    = FluidSystem::viscosity(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
+        }
+
+        // Adding Well RFT data
+        const auto cartesianIdx = simulator_.vanguard().cartesianIndex(globalDofIdx);
+        // Only existing entries are modified, so concurrent calls for
+        // different cells do not modify the maps themselves.
+        if (auto it = this->oilConnectionPressures_.find(cartesianIdx);
+            it != this->oilConnectionPressures_.end()) {
+            it->second = getValue(fs.pressure(oilPhaseIdx));
+        }
+        if (auto it = this->waterConnectionSaturations_.find(cartesianIdx);
+            it != this->waterConnectionSaturations_.end()) {
+            it->second = getValue(fs.saturation(waterPhaseIdx));
+        }
+        if (auto it = this->gasConnectionSaturations_.find(cartesianIdx);
+            it != this->gasConnectionSaturations_.end()) {
+            it->second = getValue(fs.saturation(gasPhaseIdx));
+        }
+
+        // tracers
+        const auto& tracerModel = simulator_.problem().tracerModel();
+        if (! this->freeTracerConcentrations_.empty()) {
+            for (int tracerIdx = 0; tracerIdx < tracerModel.numTracers(); ++tracerIdx) {
+                if (this->freeTracerConcentrations_[tracerIdx].empty()) {
+                    continue;
                 }
+                this->freeTracerConcentrations_[tracerIdx][globalDofIdx] =
+                    tracerModel.freeTracerConcentration(tracerIdx, globalDofIdx);
             }
-            if (! this->solTracerConcentrations_.empty()) {
-                for (int tracerIdx = 0; tracerIdx < tracerModel.numTracers(); ++tracerIdx) {
-                    if (this->solTracerConcentrations_[tracerIdx].empty()) {
-                        continue;
-                    }
-                    this->solTracerConcentrations_[tracerIdx][globalDofIdx] =
-                        tracerModel.solTracerConcentration(tracerIdx, globalDofIdx);
-                    
+        }
+        if (! this->solTracerConcentrations_.empty()) {
+            for (int tracerIdx = 0; tracerIdx < tracerModel.numTracers(); ++tracerIdx) {
+                if (this->solTracerConcentrations_[tracerIdx].empty()) {
+                    continue;
                 }
+                this->solTracerConcentrations_[tracerIdx][globalDofIdx] =
+                    tracerModel.solTracerConcentration(tracerIdx, globalDofIdx);
+                
             }
+        }
 
-            // output residual
-            for ( int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx )
-            {
-                if (!this->residual_[phaseIdx].empty()) {
-                    const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-                    this->residual_[phaseIdx][globalDofIdx] = modelResid[globalDofIdx][activeCompIdx];
-                }
+        // output residual
+        for ( int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx )
+        {
+            if (!this->residual_[phaseIdx].empty()) {
+                const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
+                this->residual_[phaseIdx][globalDofIdx] = modelResid[globalDofIdx][activeCompIdx];
             }
         }
     }
@@ -731,84 +756,97 @@ public:
         if (!std::is_same_v<Discretization, EcfvDiscretization<TypeTag>>)
             return;
 
-        const auto& problem = elemCtx.simulator().problem();
         for (unsigned dofIdx = 0; dofIdx < elemCtx.numPrimaryDof(/*timeIdx=*/0); ++dofIdx) {
+            this->processCellFlows(elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0));
+        }
+    }
 
-            unsigned globalDofIdx = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
-            if (!problem.model().linearizer().getFlowsInfo().empty()) {
-                const auto& flowsInf = problem.model().linearizer().getFlowsInfo();
-                auto flowsInfos = flowsInf[globalDofIdx];
-                for (auto& flowsInfo : flowsInfos) {
-                    if (flowsInfo.faceId >= 0) {
-                        if (!this->flows_[flowsInfo.faceId][gasCompIdx].empty()) {
-                            this->flows_[flowsInfo.faceId][gasCompIdx][globalDofIdx]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
-                        }
-                        if (!this->flows_[flowsInfo.faceId][oilCompIdx].empty()) {
-                            this->flows_[flowsInfo.faceId][oilCompIdx][globalDofIdx]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
-                        }
-                        if (!this->flows_[flowsInfo.faceId][waterCompIdx].empty()) {
-                            this->flows_[flowsInfo.faceId][waterCompIdx][globalDofIdx]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
-                        }
+    /*!
+     * \brief Copy the flows and flores of the faces of a single cell to
+     *        the output buffers
+     *
+     * May be called concurrently for different cells. A non-neighbouring
+     * connection is only stored in the flow info of one of its cells.
+     */
+    void processCellFlows(const unsigned globalDofIdx)
+    {
+        if (!std::is_same_v<Discretization, EcfvDiscretization<TypeTag>>)
+            return;
+
+        const auto& problem = simulator_.problem();
+        if (!problem.model().linearizer().getFlowsInfo().empty()) {
+            const auto& flowsInf = problem.model().linearizer().getFlowsInfo();
+            auto flowsInfos = flowsInf[globalDofIdx];
+            for (auto& flowsInfo : flowsInfos) {
+                if (flowsInfo.faceId >= 0) {
+                    if (!this->flows_[flowsInfo.faceId][gasCompIdx].empty()) {
+                        this->flows_[flowsInfo.faceId][gasCompIdx][globalDofIdx]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
                     }
-                    if (flowsInfo.faceId == -2) {
-                        if (!this->flowsn_[gasCompIdx].indices.empty()) {
-                            this->flowsn_[gasCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
-                            this->flowsn_[gasCompIdx].values[flowsInfo.nncId]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
-                        }
-                        if (!this->flowsn_[oilCompIdx].indices.empty()) {
-                            this->flowsn_[oilCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
-                            this->flowsn_[oilCompIdx].values[flowsInfo.nncId]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
-                        }
-                        if (!this->flowsn_[waterCompIdx].indices.empty()) {
-                            this->flowsn_[waterCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
-                            this->flowsn_[waterCompIdx].values[flowsInfo.nncId]
-                                = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
-                        }
+                    if (!this->flows_[flowsInfo.faceId][oilCompIdx].empty()) {
+                        this->flows_[flowsInfo.faceId][oilCompIdx][globalDofIdx]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
+                    }
+                    if (!this->flows_[flowsInfo.faceId][waterCompIdx].empty()) {
+                        this->flows_[flowsInfo.faceId][waterCompIdx][globalDofIdx]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
+                    }
+                }
+                if (flowsInfo.faceId == -2) {
+                    if (!this->flowsn_[gasCompIdx].indices.empty()) {
+                        this->flowsn_[gasCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
+                        this->flowsn_[gasCompIdx].values[flowsInfo.nncId]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
+                    }
+                    if (!this->flowsn_[oilCompIdx].indices.empty()) {
+                        this->flowsn_[oilCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
+                        this->flowsn_[oilCompIdx].values[flowsInfo.nncId]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
+                    }
+                    if (!this->flowsn_[waterCompIdx].indices.empty()) {
+                        this->flowsn_[waterCompIdx].indices[flowsInfo.nncId] = flowsInfo.nncId;
+                        this->flowsn_[waterCompIdx].values[flowsInfo.nncId]
+                            = flowsInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
                     }
                 }
             }
+        }
 
-            // flores
-            if (!problem.model().linearizer().getFloresInfo().empty()) {
-                const auto& floresInf = problem.model().linearizer().getFloresInfo();
-                auto floresInfos =floresInf[globalDofIdx];
-                for (auto& floresInfo : floresInfos) {
-                    if (floresInfo.faceId >= 0) {
-                        if (!this->flores_[floresInfo.faceId][gasCompIdx].empty()) {
-                            this->flores_[floresInfo.faceId][gasCompIdx][globalDofIdx]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
-                        }
-                        if (!this->flores_[floresInfo.faceId][oilCompIdx].empty()) {
-                            this->flores_[floresInfo.faceId][oilCompIdx][globalDofIdx]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
-                        }
-                        if (!this->flores_[floresInfo.faceId][waterCompIdx].empty()) {
-                            this->flores_[floresInfo.faceId][waterCompIdx][globalDofIdx]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
-                        }
+        // flores
+        if (!problem.model().linearizer().getFloresInfo().empty()) {
+            const auto& floresInf = problem.model().linearizer().getFloresInfo();
+            auto floresInfos =floresInf[globalDofIdx];
+            for (auto& floresInfo : floresInfos) {
+                if (floresInfo.faceId >= 0) {
+                    if (!this->flores_[floresInfo.faceId][gasCompIdx].empty()) {
+                        this->flores_[floresInfo.faceId][gasCompIdx][globalDofIdx]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
                     }
-                   
-                    if (floresInfo.faceId == -2) {
-                        if (!this->floresn_[gasCompIdx].indices.empty()) {
-                            this->floresn_[gasCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
-                            this->floresn_[gasCompIdx].values[floresInfo.nncId]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
-                        }
-                        if (!this->floresn_[oilCompIdx].indices.empty()) {
-                            this->floresn_[oilCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
-                            this->floresn_[oilCompIdx].values[floresInfo.nncId]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
-                        }
-                        if (!this->floresn_[waterCompIdx].indices.empty()) {
-                            this->floresn_[waterCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
-                            this->floresn_[waterCompIdx].values[floresInfo.nncId]
-                                = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
-                        }
+                    if (!this->flores_[floresInfo.faceId][oilCompIdx].empty()) {
+                        this->flores_[floresInfo.faceId][oilCompIdx][globalDofIdx]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
+                    }
+                    if (!this->flores_[floresInfo.faceId][waterCompIdx].empty()) {
+                        this->flores_[floresInfo.faceId][waterCompIdx][globalDofIdx]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
+                    }
+                }
+               
+                if (floresInfo.faceId == -2) {
+                    if (!this->floresn_[gasCompIdx].indices.empty()) {
+                        this->floresn_[gasCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
+                        this->floresn_[gasCompIdx].values[floresInfo.nncId]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(gasCompIdx)];
+                    }
+                    if (!this->floresn_[oilCompIdx].indices.empty()) {
+                        this->floresn_[oilCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
+                        this->floresn_[oilCompIdx].values[floresInfo.nncId]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(oilCompIdx)];
+                    }
+                    if (!this->floresn_[waterCompIdx].indices.empty()) {
+                        this->floresn_[waterCompIdx].indices[floresInfo.nncId] = floresInfo.nncId;
+                        this->floresn_[waterCompIdx].values[floresInfo.nncId]
+                            = floresInfo.flow[conti0EqIdx + Indices::canonicalToActiveComponentIndex(waterCompIdx)];
                     }
                 }
             }
@@ -821,219 +859,235 @@ public:
         if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
             return;
 
-        const auto& problem = elemCtx.simulator().problem();
         for (unsigned dofIdx = 0; dofIdx < elemCtx.numPrimaryDof(/*timeIdx=*/0); ++dofIdx) {
-            // Adding block data
-            const auto globalDofIdx = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
-            const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-            const auto& intQuants = elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0);
-            const auto& fs = intQuants.fluidState();
-            for (auto& val : this->blockData_) {
-                const auto& key = val.first;
-                assert(key.second > 0);
-
-                const auto cartesianIdxBlock = static_cast<std::remove_cv_t<
-                    std::remove_reference_t<decltype(cartesianIdx)>>>(key.second - 1);
-
-                if (cartesianIdx == cartesianIdxBlock) {
-                    if ((key.first == "BWSAT") || (key.first == "BSWAT"))
-                        val.second = getValue(fs.saturation(waterPhaseIdx));
-                    else if ((key.first == "BGSAT") || (key.first == "BSGAS"))
-                        val.second = getValue(fs.saturation(gasPhaseIdx));
-                    else if ((key.first == "BOSAT") || (key.first == "BSOIL"))
-                        val.second = getValue(fs.saturation(oilPhaseIdx));
-                    else if (key.first == "BNSAT")
-                        val.second = intQuants.solventSaturation().value();
-                    else if ((key.first == "BPR") || (key.first == "BPRESSUR")) {
-                        if (FluidSystem::phaseIsActive(oilPhaseIdx))
-                            val.second = getValue(fs.pressure(oilPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(gasPhaseIdx))
-                            val.second = getValue(fs.pressure(gasPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(waterPhaseIdx))
-                            val.second = getValue(fs.pressure(waterPhaseIdx));
+            this->processCellBlockData(elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0),
+                                       elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0));
+        }
+    }
+
+    /*!
+     * \brief Update the block data (summary keywords B*) of a single cell
+     *
+     * May be called concurrently for different cells, every block entry
+     * is only written by the thread processing its cell.
+     */
+    void processCellBlockData(const unsigned globalDofIdx, const IntensiveQuantities& intQuants)
+    {
+        if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
+            return;
+
+        const auto& problem = simulator_.problem();
+        // Adding block data
+        const auto cartesianIdx = simulator_.vanguard().cartesianIndex(globalDofIdx);
+        const auto& fs = intQuants.fluidState();
+        for (auto& val : this->blockData_) {
+            const auto& key = val.first;
+            assert(key.second > 0);
+
+            const auto cartesianIdxBlock = static_cast<std::remove_cv_t<
+                std::remove_reference_t<decltype(cartesianIdx)>>>(key.second - 1);
+
+            if (cartesianIdx == cartesianIdxBlock) {
+                if ((key.first == "BWSAT") || (key.first == "BSWAT"))
+                    val.second = getValue(fs.saturation(waterPhaseIdx));
+                else if ((key.first == "BGSAT") || (key.first == "BSGAS"))
+                    val.second = getValue(fs.saturation(gasPhaseIdx));
+                else if ((key.first == "BOSAT") || (key.first == "BSOIL"))
+                    val.second = getValue(fs.saturation(oilPhaseIdx));
+                else if (key.first == "BNSAT")
+                    val.second = intQuants.solventSaturation().value();
+                else if ((key.first == "BPR") || (key.first == "BPRESSUR")) {
+                    if (FluidSystem::phaseIsActive(oilPhaseIdx))
+                        val.second = getValue(fs.pressure(oilPhaseIdx));
+                    else if (FluidSystem::phaseIsActive(gasPhaseIdx))
+                        val.second = getValue(fs.pressure(gasPhaseIdx));
+                    else if (FluidSystem::phaseIsActive(waterPhaseIdx))
+                        val.second = getValue(fs.pressure(waterPhaseIdx));
+                }
+                else if ((key.first == "BTCNFHEA") || (key.first == "BTEMP")) {
+                    if (FluidSystem::phaseIsActive(oilPhaseIdx))
+                        val.second = getValue(fs.temperature(oilPhaseIdx));
+                    else if (FluidSystem::phaseIsActive(gasPhaseIdx))
+                        val.second = getValue(fs.temperature(gasPhaseIdx));
+                    else if (FluidSystem::phaseIsActive(waterPhaseIdx))
+                        val.second = getValue(fs.temperature(waterPhaseIdx));
+                }
+                else if (key.first == "BWKR" || key.first == "BKRW")
+                    val.second = getValue(intQuants.relativePermeability(waterPhaseIdx));
+                else if (key.first == "BGKR" || key.first == "BKRG")
+                    val.second = getValue(intQuants.relativePermeability(gasPhaseIdx));
+                else if (key.first == "BOKR" || key.first == "BKRO")
+                    val.second = getValue(intQuants.relativePermeability(oilPhaseIdx));
+                else if (key.first == "BKROG") {
+                    const auto& materialParams = problem.materialLawParams(globalDofIdx);
+                    const auto krog
+                        = MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs);
+                    val.second = getValue(krog);
+                }
+                else if (key.first == "BKROW") {
+                    const auto& materialParams = problem.materialLawParams(globalDofIdx);
+                    const auto krow
+                        = MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs);
+                    val.second = getValue(krow);
+                }
+                else if (key.first == "BWPC")
+                    val.second = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
+                else if (key.first == "BGPC")
+                    val.second = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
+                else if (key.first == "BWPR")
+                    val.second = getValue(fs.pressure(waterPhaseIdx));
+                else if (key.first == "BGPR")
+                    val.second = getValue(fs.pressure(gasPhaseIdx));
+                else if (key.first == "BVWAT" || key.first == "BWVIS")
+                    val.second = getValue(fs.viscosity(waterPhaseIdx));
+                else if (key.first == "BVGAS" || key.first == "BGVIS")
+                    val.second = getValue(fs.viscosity(gasPhaseIdx));
+                else if (key.first == "BVOIL" || key.first == "BOVIS")
+                    val.second = getValue(fs.viscosity(oilPhaseIdx));
+                else if ((key.first == "BODEN") || (key.first == "BDENO"))
+                    val.second = getValue(fs.density(oilPhaseIdx));
+                else if ((key.first == "BGDEN") || (key.first == "BDENG"))
+                    val.second = getValue(fs.density(gasPhaseIdx));
+                else if ((key.first == "BWDEN") || (key.first == "BDENW"))
+                    val.second = getValue(fs.density(waterPhaseIdx));
+                else if ((key.first == "BRPV") ||
+                         (key.first == "BOPV") ||
+                         (key.first == "BWPV") ||
+                         (key.first == "BGPV"))
+                {
+                    if (key.first == "BRPV") {
+                        val.second = 1.0;
                     }
-                    else if ((key.first == "BTCNFHEA") || (key.first == "BTEMP")) {
-                        if (FluidSystem::phaseIsActive(oilPhaseIdx))
-                            val.second = getValue(fs.temperature(oilPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(gasPhaseIdx))
-                            val.second = getValue(fs.temperature(gasPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(waterPhaseIdx))
-                            val.second = getValue(fs.temperature(waterPhaseIdx));
+                    else if (key.first == "BOPV") {
+                        val.second = getValue(fs.saturation(oilPhaseIdx));
                     }
-                    else if (key.first == "BWKR" || key.first == "BKRW")
-                        val.second = getValue(intQuants.relativePermeability(waterPhaseIdx));
-                    else if (key.first == "BGKR" || key.first == "BKRG")
-                        val.second = getValue(intQuants.relativePermeability(gasPhaseIdx));
-                    else if (key.first == "BOKR" || key.first == "BKRO")
-                        val.second = getValue(intQuants.relativePermeability(oilPhaseIdx));
-                    else if (key.first == "BKROG") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krog
-                            = MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krog);
+                    else if (key.first == "BWPV") {
+                        val.second = getValue(fs.saturation(waterPhaseIdx));
                     }
-                    else if (key.first == "BKROW") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krow
-                            = MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krow);
+                    else {
+                        val.second = getValue(fs.saturation(gasPhaseIdx));
                     }
-                    else if (key.first == "BWPC")
-                        val.second = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPC")
-                        val.second = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BWPR")
-                        val.second = getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPR")
-                        val.second = getValue(fs.pressure(gasPhaseIdx));
-                    else if (key.first == "BVWAT" || key.first == "BWVIS")
-                        val.second = getValue(fs.viscosity(waterPhaseIdx));
-                    else if (key.first == "BVGAS" || key.first == "BGVIS")
-                        val.second = getValue(fs.viscosity(gasPhaseIdx));
-                    else if (key.first == "BVOIL" || key.first == "BOVIS")
-                        val.second = getValue(fs.viscosity(oilPhaseIdx));
-                    else if ((key.first == "BODEN") || (key.first == "BDENO"))
-                        val.second = getValue(fs.density(oilPhaseIdx));
-                    else if ((key.first == "BGDEN") || (key.first == "BDENG"))
-                        val.second = getValue(fs.density(gasPhaseIdx));
-                    else if ((key.first == "BWDEN") || (key.first == "BDENW"))
-                        val.second = getValue(fs.density(waterPhaseIdx));
-                    else if ((key.first == "BRPV") ||
-                             (key.first == "BOPV") ||
-                             (key.first == "BWPV") ||
-                             (key.first == "BGPV"))
-                    {
-                        if (key.first == "BRPV") {
-                            val.second = 1.0;
-                        }
-                        else if (key.first == "BOPV") {
-                            val.second = getValue(fs.saturation(oilPhaseIdx));
-                        }
-                        else if (key.first == "BWPV") {
-                            val.second = getValue(fs.saturation(waterPhaseIdx));
-                        }
-                        else {
-                            val.second = getValue(fs.saturation(gasPhaseIdx));
-                        }
 
-                        // Include active pore-volume.
-                        val.second *= getValue(intQuants.porosity())
-                            * elemCtx.simulator().model().dofTotalVolume(globalDofIdx);
-                    }
-                    else if (key.first == "BRS")
-                        val.second = getValue(fs.Rs());
-                    else if (key.first == "BRV")
-                        val.second = getValue(fs.Rv());
-                    else if ((key.first == "BOIP") || (key.first == "BOIPL") || (key.first == "BOIPG") ||
-                             (key.first == "BGIP") || (key.first == "BGIPL") || (key.first == "BGIPG") ||
-                             (key.first == "BWIP"))
-                    {
-                        if ((key.first == "BOIP") || (key.first == "BOIPL")) {
-                            val.second = getValue(fs.invB(oilPhaseIdx)) * getValue(fs.saturation(oilPhaseIdx));
-
-                            if (key.first == "BOIP") {
-                                val.second += getValue(fs.Rv()) * getValue(fs.invB(gasPhaseIdx))
-                                    * getValue(fs.saturation(gasPhaseIdx));
-                            }
-                        }
-                        else if (key.first == "BOIPG") {
-                            val.second = getValue(fs.Rv()) * getValue(fs.invB(gasPhaseIdx))
+                    // Include active pore-volume.
+                    val.second *= getValue(intQuants.porosity())
+                        * simulator_.model().dofTotalVolume(globalDofIdx);
+                }
+                else if (key.first == "BRS")
+                    val.second = getValue(fs.Rs());
+                else if (key.first == "BRV")
+                    val.second = getValue(fs.Rv());
+                else if ((key.first == "BOIP") || (key.first == "BOIPL") || (key.first == "BOIPG") ||
+                         (key.first == "BGIP") || (key.first == "BGIPL") || (key.first == "BGIPG") ||
+                         (key.first == "BWIP"))
+                {
+                    if ((key.first == "BOIP") || (key.first == "BOIPL")) {
+                        val.second = getValue(fs.invB(oilPhaseIdx)) * getValue(fs.saturation(oilPhaseIdx));
+
+                        if (key.first == "BOIP") {
+                            val.second += getValue(fs.Rv()) * getValue(fs.invB(gasPhaseIdx))
                                 * getValue(fs.saturation(gasPhaseIdx));
                         }
-                        else if ((key.first == "BGIP") || (key.first == "BGIPG")) {
-                            val.second = getValue(fs.invB(gasPhaseIdx)) * getValue(fs.saturation(gasPhaseIdx));
-
-                            if (key.first == "BGIP") {
-                                if (!FluidSystem::phaseIsActive(oilPhaseIdx)) {
-                                    val.second += getValue(fs.Rsw()) * getValue(fs.invB(waterPhaseIdx))
-                                        * getValue(fs.saturation(waterPhaseIdx));
-                                }
-                                else {
-                                    val.second += getValue(fs.Rs()) * getValue(fs.invB(oilPhaseIdx))
-                                        * getValue(fs.saturation(oilPhaseIdx));
-                                }
-                            }
-                        }
-                        else if (key.first == "BGIPL") {
+                    }
+                    else if (key.first == "BOIPG") {
+                        val.second = getValue(fs.Rv()) * getValue(fs.invB(gasPhaseIdx))
+                            * getValue(fs.saturation(gasPhaseIdx));
+                    }
+                    else if ((key.first == "BGIP") || (key.first == "BGIPG")) {
+                        val.second = getValue(fs.invB(gasPhaseIdx)) * getValue(fs.saturation(gasPhaseIdx));
+
+                        if (key.first == "BGIP") {
                             if (!FluidSystem::phaseIsActive(oilPhaseIdx)) {
-                                val.second = getValue(fs.Rsw()) * getValue(fs.invB(waterPhaseIdx))
+                                val.second += getValue(fs.Rsw()) * getValue(fs.invB(waterPhaseIdx))
                                     * getValue(fs.saturation(waterPhaseIdx));
                             }
                             else {
-                                val.second = getValue(fs.Rs()) * getValue(fs.invB(oilPhaseIdx))
+                                val.second += getValue(fs.Rs()) * getValue(fs.invB(oilPhaseIdx))
                                     * getValue(fs.saturation(oilPhaseIdx));
                             }
                         }
-                        else { // BWIP
-                            val.second = getValue(fs.invB(waterPhaseIdx)) * getValue(fs.saturation(waterPhaseIdx));
-                        }
-
-                        // Include active pore-volume.
-                        val.second *= elemCtx.simulator().model().dofTotalVolume(globalDofIdx)
-                            * getValue(intQuants.porosity());
                     }
-                    else if ((key.first == "BPPO") ||
-                             (key.first == "BPPG") ||
-                             (key.first == "BPPW"))
-                    {
-                        auto phase = RegionPhasePoreVolAverage::Phase{};
-
-                        if (key.first == "BPPO") {
-                            phase.ix = oilPhaseIdx;
-                        }
-                        else if (key.first == "BPPG") {
-                            phase.ix = gasPhaseIdx;
+                    else if (key.first == "BGIPL") {
+                        if (!FluidSystem::phaseIsActive(oilPhaseIdx)) {
+                            val.second = getValue(fs.Rsw()) * getValue(fs.invB(waterPhaseIdx))
+                                * getValue(fs.saturation(waterPhaseIdx));
                         }
-                        else { // BPPW
-                            phase.ix = waterPhaseIdx;
+                        else {
+                            val.second = getValue(fs.Rs()) * getValue(fs.invB(oilPhaseIdx))
+                                * getValue(fs.saturation(oilPhaseIdx));
                         }
+                    }
+                    else { // BWIP
+                        val.second = getValue(fs.invB(waterPhaseIdx)) * getValue(fs.saturation(waterPhaseIdx));
+                    }
 
-                        // Note different region handling here.  FIPNUM is
-                        // one-based, but we need zero-based lookup in
-                        // DatumDepth.  On the other hand, pvtRegionIndex is
-                        // zero-based but we need one-based lookup in
-                        // RegionPhasePoreVolAverage.
+                    // Include active pore-volume.
+                    val.second *= simulator_.model().dofTotalVolume(globalDofIdx)
+                        * getValue(intQuants.porosity());
+                }
+                else if ((key.first == "BPPO") ||
+                         (key.first == "BPPG") ||
+                         (key.first == "BPPW"))
+                {
+                    auto phase = RegionPhasePoreVolAverage::Phase{};
+
+                    if (key.first == "BPPO") {
+                        phase.ix = oilPhaseIdx;
+                    }
+                    else if (key.first == "BPPG") {
+                        phase.ix = gasPhaseIdx;
+                    }
+                    else { // BPPW
+                        phase.ix = waterPhaseIdx;
+                    }
 
-                        // Subtract one to convert FIPNUM to region index.
-                        const auto datum = this->eclState_.getSimulationConfig()
-                            .datumDepths()(this->regions_["FIPNUM"][dofIdx] - 1);
+                    // Note different region handling here.  FIPNUM is
+                    // one-based, but we need zero-based lookup in
+                    // DatumDepth.  On the other hand, pvtRegionIndex is
+                    // zero-based but we need one-based lookup in
+                    // RegionPhasePoreVolAverage.
 
-                        // Add one to convert region index to region ID.
-                        const auto region = RegionPhasePoreVolAverage::Region {
-                            elemCtx.primaryVars(dofIdx, /*timeIdx=*/0).pvtRegionIndex() + 1
-                        };
+                    // Subtract one to convert FIPNUM to region index.
+                    const auto datum = this->eclState_.getSimulationConfig()
+                        .datumDepths()(this->regions_.at("FIPNUM")[globalDofIdx] - 1);
 
-                        const auto density = this->regionAvgDensity_
-                            ->value("PVTNUM", phase, region);
+                    // Add one to convert region index to region ID.
+                    const auto region = RegionPhasePoreVolAverage::Region {
+                        intQuants.pvtRegionIndex() + 1
+                    };
 
-                        const auto press = getValue(fs.pressure(phase.ix));
-                        const auto grav =
-                            elemCtx.problem().gravity()[GridView::dimensionworld - 1];
-                        const auto dz = problem.dofCenterDepth(globalDofIdx) - datum;
+                    const auto density = this->regionAvgDensity_
+                        ->value("PVTNUM", phase, region);
 
-                        val.second = press - density*dz*grav;
-                    }
-                    else if ((key.first == "BFLOWI") ||
-                             (key.first == "BFLOWJ") ||
-                             (key.first == "BFLOWK"))
-                    {
-                        auto dir = FaceDir::ToIntersectionIndex(Dir::XPlus);
-
-                        if (key.first == "BFLOWJ") {
-                            dir = FaceDir::ToIntersectionIndex(Dir::YPlus);
-                        }
-                        else if (key.first == "BFLOWK") {
-                            dir = FaceDir::ToIntersectionIndex(Dir::ZPlus);
-                        }
+                    const auto press = getValue(fs.pressure(phase.ix));
+                    const auto grav =
+                        problem.gravity()[GridView::dimensionworld - 1];
+                    const auto dz = problem.dofCenterDepth(globalDofIdx) - datum;
 
-                        val.second = this->flows_[dir][waterCompIdx][globalDofIdx];
+                    val.second = press - density*dz*grav;
+                }
+                else if ((key.first == "BFLOWI") ||
+                         (key.first == "BFLOWJ") ||
+                         (key.first == "BFLOWK"))
+                {
+                    auto dir = FaceDir::ToIntersectionIndex(Dir::XPlus);
+
+                    if (key.first == "BFLOWJ") {
+                        dir = FaceDir::ToIntersectionIndex(Dir::YPlus);
                     }
-                    else {
-                        std::string logstring = "Keyword '";
-                        logstring.append(key.first);
-                        logstring.append("' is unhandled for output to summary file.");
-                        OpmLog::warning("Unhandled output keyword", logstring);
+                    else if (key.first == "BFLOWK") {
+                        dir = FaceDir::ToIntersectionIndex(Dir::ZPlus);
                     }
+
+                    val.second = this->flows_[dir][waterCompIdx][globalDofIdx];
+                }
+                else {
+                    std::string logstring = "Keyword '";
+                    logstring.append(key.first);
+                    logstring.append("' is unhandled for output to summary file.");
+#ifdef _OPENMP
+#pragma omp critical (unhandledBlockKeyword)
+#endif
+                    OpmLog::warning("Unhandled output keyword", logstring);
                 }
             }
         }
@@ -180,55 +180,66 @@ public:
             return;
 
         for (unsigned dofIdx = 0; dofIdx < elemCtx.numPrimaryDof(/*timeIdx=*/0); ++dofIdx) {
-            const auto& intQuants = elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0);
-            const auto& fs = intQuants.fluidState();
+            this->processCell(elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0),
+                              elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0));
+        }
+    }
+
+    /*!
+     * \brief Modify the internal buffers according to the intensive
+     *        quantities of a single cell
+     *
+     * May be called concurrently for different cells.
+     */
+    void processCell(const unsigned globalDofIdx, const IntensiveQuantities& intQuants)
+    {
+        if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
+            return;
 
-            const unsigned globalDofIdx = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
-            // const unsigned pvtRegionIdx = 0; // elemCtx.primaryVars(dofIdx, /*timeIdx=*/0).pvtRegionIndex();
+        const auto& fs = intQuants.fluidState();
 
-            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                if (this->saturation_[phaseIdx].empty())
-                    continue;
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (this->saturation_[phaseIdx].empty())
+                continue;
 
-                this->saturation_[phaseIdx][globalDofIdx] = getValue(fs.saturation(phaseIdx));
-                Valgrind::CheckDefined(this->saturation_[phaseIdx][globalDofIdx]);
-            }
+            this->saturation_[phaseIdx][globalDofIdx] = getValue(fs.saturation(phaseIdx));
+            Valgrind::CheckDefined(this->saturation_[phaseIdx][globalDofIdx]);
+        }
 
-            for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
-                if (this->moleFractions_[compIdx].empty()) continue;
+        for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+            if (this->moleFractions_[compIdx].empty()) continue;
 
-                this->moleFractions_[compIdx][globalDofIdx] = getValue(fs.moleFraction(compIdx));
+            this->moleFractions_[compIdx][globalDofIdx] = getValue(fs.moleFraction(compIdx));
+        }
+        // XMF and YMF
+        for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+            if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
+                if (this->phaseMoleFractions_[oilPhaseIdx][compIdx].empty()) continue;
+                this->phaseMoleFractions_[oilPhaseIdx][compIdx][globalDofIdx] = getValue(fs.moleFraction(oilPhaseIdx, compIdx));
             }
-            // XMF and YMF
-            for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
-                if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
-                    if (this->phaseMoleFractions_[oilPhaseIdx][compIdx].empty()) continue;
-                    this->phaseMoleFractions_[oilPhaseIdx][compIdx][globalDofIdx] = getValue(fs.moleFraction(oilPhaseIdx, compIdx));
-                }
-                if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
-                    if (this->phaseMoleFractions_[gasPhaseIdx][compIdx].empty()) continue;
-                    this->phaseMoleFractions_[gasPhaseIdx][compIdx][globalDofIdx] = getValue(fs.moleFraction(gasPhaseIdx, compIdx));
-                }
+            if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
+                if (this->phaseMoleFractions_[gasPhaseIdx][compIdx].empty()) continue;
+                this->phaseMoleFractions_[gasPhaseIdx][compIdx][globalDofIdx] = getValue(fs.moleFraction(gasPhaseIdx, compIdx));
             }
+        }
 
-            if (!this->fluidPressure_.empty()) {
-                if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
-                    // Output oil pressure as default
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx));
-                } else if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
-                    // Output gas if oil is not present
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx));
-                } else {
-                    // Output water if neither oil nor gas is present
-                    this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(waterPhaseIdx));
-                }
-                Valgrind::CheckDefined(this->fluidPressure_[globalDofIdx]);
+        if (!this->fluidPressure_.empty()) {
+            if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
+                // Output oil pressure as default
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(oilPhaseIdx));
+            } else if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
+                // Output gas if oil is not present
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(gasPhaseIdx));
+            } else {
+                // Output water if neither oil nor gas is present
+                this->fluidPressure_[globalDofIdx] = getValue(fs.pressure(waterPhaseIdx));
             }
+            Valgrind::CheckDefined(this->fluidPressure_[globalDofIdx]);
+        }
 
-            if (!this->temperature_.empty()) {
-                this->temperature_[globalDofIdx] = getValue(fs.temperature(oilPhaseIdx));
-                Valgrind::CheckDefined(this->temperature_[globalDofIdx]);
-            }
+        if (!this->temperature_.empty()) {
+            this->temperature_[globalDofIdx] = getValue(fs.temperature(oilPhaseIdx));
+            Valgrind::CheckDefined(this->temperature_[globalDofIdx]);
         }
     }
 
@@ -246,6 +257,13 @@ public:
             return;
     }
 
+    void processCellFlows(const unsigned /* globalDofIdx */)
+    {}
+
+    void processCellBlockData(const unsigned /* globalDofIdx */,
+                              const IntensiveQuantities& /* intQuants */)
+    {}
+
     /*!
      * \brief Capture connection fluxes, particularly to account for inter-region flows.
      *
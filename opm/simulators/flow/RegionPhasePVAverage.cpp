@@ -28,10 +28,15 @@
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <functional>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace {
     std::vector<std::string> fipRegionNames(const std::vector<std::string>& regionNames)
     {
@@ -111,6 +116,21 @@ value(std::string_view rset, const Phase& p, const Region& r) const
 void Opm::RegionPhasePoreVolAverage::prepareAccumulation()
 {
     std::fill(this->x_.begin(), this->x_.end(), 0.0);
+
+    auto numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+
+    if (numThreads > 1) {
+        this->threadX_.resize(numThreads);
+        for (auto& x : this->threadX_) {
+            x.assign(this->x_.size(), 0.0);
+        }
+    }
+    else {
+        this->threadX_.clear();
+    }
 }
 
 void Opm::RegionPhasePoreVolAverage::
@@ -127,6 +147,12 @@ addCell(const std::size_t activeCell,
 
 void Opm::RegionPhasePoreVolAverage::accumulateParallel()
 {
+    for (const auto& x : this->threadX_) {
+        std::transform(x.begin(), x.end(), this->x_.begin(),
+                       this->x_.begin(), std::plus<>{});
+    }
+    this->threadX_.clear();
+
     this->comm_.get().sum(this->x_.data(), this->x_.size());
 }
 
@@ -183,18 +209,23 @@ void Opm::RegionPhasePoreVolAverage::add(const Ix      start,
                                          const double  x,
                                          const double  w)
 {
-    this->value (start, type) += w * x;
-    this->weight(start, type) += w;
-}
+    auto& sums = this->runningSums();
 
-double& Opm::RegionPhasePoreVolAverage::value(const Ix start, const AvgType type)
-{
-    return this->x_[ this->valueArrayIndex(start, type, Element::Value) ];
+    sums[ this->valueArrayIndex(start, type, Element::Value ) ] += w * x;
+    sums[ this->valueArrayIndex(start, type, Element::Weight) ] += w;
 }
 
-double& Opm::RegionPhasePoreVolAverage::weight(const Ix start, const AvgType type)
+std::vector<double>& Opm::RegionPhasePoreVolAverage::runningSums()
 {
-    return this->x_[ this->valueArrayIndex(start, type, Element::Weight) ];
+#ifdef _OPENMP
+    if (! this->threadX_.empty()) {
+        assert (static_cast<std::size_t>(omp_get_thread_num()) < this->threadX_.size());
+
+        return this->threadX_[omp_get_thread_num()];
+    }
+#endif
+
+    return this->x_;
 }
 
 double Opm::RegionPhasePoreVolAverage::value(const Ix start, const AvgType type) const
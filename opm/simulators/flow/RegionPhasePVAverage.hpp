@@ -113,10 +113,17 @@ namespace Opm {
 
         /// Clear internal arrays in preparation of accumulating
         /// region-level averages from per-cell contributions.
+        ///
+        /// Must be called outside of OpenMP parallel regions.  If more
+        /// than one thread is available, each thread subsequently
+        /// accumulates its contributions in a separate array.
         void prepareAccumulation();
 
         /// Incorporate contributions from a single cell.
         ///
+        /// May be called concurrently by the threads of an OpenMP parallel
+        /// region, provided that each cell is added once.
+        ///
         /// \param[in] activeCell Per-rank active cell ID--typically one of
         ///   the rank's interior cells.
         ///
@@ -125,7 +132,8 @@ namespace Opm {
         /// \param[in] cv Single cell function value contribution.
         void addCell(std::size_t activeCell, const Phase& p, const CellValue& cv);
 
-        /// Accumulate region-level average values across MPI ranks.
+        /// Accumulate region-level average values across threads and MPI
+        /// ranks.
         ///
         /// Typically the last step in calculating the region-level average
         /// values.  It is typically an error to call this function multiple
@@ -189,6 +197,12 @@ namespace Opm {
         /// should be the return value from fieldStartIx() or rsetStartIx().
         std::vector<double> x_{};
 
+        /// Per-thread running sums, laid out like \c x_.  Empty unless
+        /// the contributions are accumulated by more than one thread, in
+        /// which case accumulateParallel() adds them to \c x_ in thread
+        /// order.
+        std::vector<std::vector<double>> threadX_{};
+
         /// Compute final average value for a single region and phase.
         ///
         /// Prefers the average value weighted by phase-filled pore-volume,
@@ -280,31 +294,12 @@ namespace Opm {
         /// \param[in] w Function weight.
         void add(Ix start, AvgType type, double x, double w);
 
-        /// Mutable access to value item of specific average value type
-        ///
-        /// \param[in] start Offset into linearised value array (\c x_)
-        ///   corresponding to the first average value type of a particular
-        ///   phase in a particular region.  Usually calculated by
-        ///   fieldStartIx() or rsetStartIx().
-        ///
-        /// \param[in] type Which kind of average value to accumulate.
-        ///
-        /// \return Reference to mutable element of linearised value array
-        ///   corresponding to the running sum of function values.
-        double& value(Ix start, AvgType type);
-
-        /// Mutable access to weight item of specific average value type
-        ///
-        /// \param[in] start Offset into linearised value array (\c x_)
-        ///   corresponding to the first average value type of a particular
-        ///   phase in a particular region.  Usually calculated by
-        ///   fieldStartIx() or rsetStartIx().
-        ///
-        /// \param[in] type Which kind of average value to accumulate.
+        /// Running sums to which the calling thread adds its per-cell
+        /// contributions.
         ///
-        /// \return Reference to mutable element of linearised value array
-        ///   corresponding to the running sum of function weights.
-        double& weight(Ix start, AvgType type);
+        /// \return Per-thread array in \c threadX_ if contributions are
+        ///   accumulated by multiple threads, \c x_ otherwise.
+        std::vector<double>& runningSums();
 
         /// Read-only access to value item of specific average value type
         ///
@@ -30,9 +30,16 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/grid/utility/SparseTable.hpp>
+
+#include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
+
+#include <opm/models/utils/parametersystem.hpp>
 #include <opm/models/utils/propertysystem.hh>
 
+#include <opm/simulators/flow/FlowProblemParameters.hpp>
 #include <opm/simulators/flow/GenericTracerModel.hpp>
+#include <opm/simulators/flow/NewTranFluxModule.hpp>
 #include <opm/simulators/utils/VectorVectorDataHandle.hpp>
 
 #include <array>
@@ -40,6 +47,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace Opm::Properties {
@@ -81,9 +89,17 @@ class TracerModel : public GenericTracerModel<GetPropType<TypeTag, Properties::G
     using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
     using RateVector = GetPropType<TypeTag, Properties::RateVector>;
     using Indices = GetPropType<TypeTag, Properties::Indices>;
+    using ExtensiveQuantities = GetPropType<TypeTag, Properties::ExtensiveQuantities>;
+    using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
 
     using TracerEvaluation = DenseAd::Evaluation<Scalar,1>;
 
+    // If the fluxes are computed from transmissibilities, the tracer equations
+    // are assembled directly from the cached intensive quantities of the flow
+    // model instead of updating an element context for each element.
+    static constexpr bool enableCachedAssembly =
+        std::is_same_v<GetPropType<TypeTag, Properties::FluxModule>, NewTranFluxModule<TypeTag>>;
+
     using TracerMatrix = typename BaseType::TracerMatrix;
     using TracerVector = typename BaseType::TracerVector;
 
@@ -93,6 +109,18 @@ class TracerModel : public GenericTracerModel<GetPropType<TypeTag, Properties::G
     enum { oilPhaseIdx = FluidSystem::oilPhaseIdx };
     enum { gasPhaseIdx = FluidSystem::gasPhaseIdx };
 
+    // geometric data of a face for assembleTracerEquationsCached_()
+    struct NeighborInfo
+    {
+        unsigned neighbor;
+        Scalar trans;
+        Scalar dZg;
+        Scalar thpres;
+        Scalar Vin;
+        Scalar Vex;
+        FaceDir::DirEnum faceDir;
+    };
+
 public:
     TracerModel(Simulator& simulator)
         : BaseType(simulator.vanguard().gridView(),
@@ -105,7 +133,9 @@ public:
         , wat_(tbatch[0])
         , oil_(tbatch[1])
         , gas_(tbatch[2])
-    { }
+    {
+        this->useUpwindSolver_ = Parameters::Get<Parameters::EnableTracerUpwindSolver>();
+    }
 
 
     /*
@@ -176,6 +206,36 @@ public:
         }
     }
 
+    /*!
+     * \brief Update the transmissibilities and threshold pressures stored
+     *        in the face table of the cached tracer assembly.
+     *
+     * This must be called whenever the transmissibilities of the problem
+     * change, e.g. after MULTX and friends have been applied in the SCHEDULE
+     * section.
+     */
+    void updateStoredTransmissibilities()
+    {
+        if constexpr (enableCachedAssembly) {
+            if (isInteriorCell_.empty()) {
+                // the face table has not been set up yet
+                return;
+            }
+            const auto& problem = simulator_.problem();
+            const int numCells = neighborInfo_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int I = 0; I < numCells; ++I) {
+                auto nbInfos = neighborInfo_[I];
+                for (auto& nbInfo : nbInfos) {
+                    nbInfo.trans = problem.transmissibility(I, nbInfo.neighbor);
+                    nbInfo.thpres = problem.thresholdPressure(I, nbInfo.neighbor);
+                }
+            }
+        }
+    }
+
     void beginTimeStep()
     {
         if (this->numTracers() == 0)
@@ -360,9 +420,68 @@ protected:
         }
     }
 
+    void computeFreeFlux_(TracerEvaluation& freeFlux,
+                          bool& isUp,
+                          const int tracerPhaseIdx,
+                          const unsigned I,
+                          const unsigned J,
+                          const std::array<Scalar, numPhases>& volumeRate,
+                          const std::array<bool, numPhases>& isUpPhase)
+    {
+        isUp = isUpPhase[tracerPhaseIdx];
+        const auto& fs = simulator_.model().intensiveQuantities(isUp ? I : J, /*timeIdx=*/0).fluidState();
+        const Scalar v = volumeRate[tracerPhaseIdx] * decay<Scalar>(fs.invB(tracerPhaseIdx));
+        if (isUp) {
+            freeFlux = v*variable<TracerEvaluation>(1.0, 0);
+        }
+        else {
+            freeFlux = v;
+        }
+    }
+
+    void computeSolFlux_(TracerEvaluation& solFlux,
+                         bool& isUp,
+                         const int tracerPhaseIdx,
+                         const unsigned I,
+                         const unsigned J,
+                         const std::array<Scalar, numPhases>& volumeRate,
+                         const std::array<bool, numPhases>& isUpPhase)
+    {
+        Scalar v;
+
+        // vaporized oil
+        if (tracerPhaseIdx == FluidSystem::oilPhaseIdx && FluidSystem::enableVaporizedOil()) {
+            isUp = isUpPhase[FluidSystem::gasPhaseIdx];
+            const auto& fs = simulator_.model().intensiveQuantities(isUp ? I : J, /*timeIdx=*/0).fluidState();
+            v =
+                decay<Scalar>(fs.invB(FluidSystem::gasPhaseIdx))
+                * volumeRate[FluidSystem::gasPhaseIdx]
+                * decay<Scalar>(fs.Rv());
+        }
+        // dissolved gas
+        else if (tracerPhaseIdx == FluidSystem::gasPhaseIdx && FluidSystem::enableDissolvedGas()) {
+            isUp = isUpPhase[FluidSystem::oilPhaseIdx];
+            const auto& fs = simulator_.model().intensiveQuantities(isUp ? I : J, /*timeIdx=*/0).fluidState();
+            v =
+                decay<Scalar>(fs.invB(FluidSystem::oilPhaseIdx))
+                * volumeRate[FluidSystem::oilPhaseIdx]
+                * decay<Scalar>(fs.Rs());
+        }
+        else {
+            isUp = true;
+            v = 0.0;
+        }
+
+        if (isUp) {
+            solFlux = v*variable<TracerEvaluation>(1.0, 0);
+        }
+        else {
+            solFlux = v;
+        }
+    }
+
     template<class TrRe>
     void assembleTracerEquationVolume(TrRe& tr,
-                                      const ElementContext& elemCtx,
                                       const Scalar scvVolume,
                                       const Scalar dt,
                                       unsigned I,
@@ -376,7 +495,7 @@ protected:
         std::vector<Scalar> storageOfTimeIndex1(tr.numTracer());
         std::vector<Scalar> fStorageOfTimeIndex1(tr.numTracer());
         std::vector<Scalar> sStorageOfTimeIndex1(tr.numTracer());
-        if (elemCtx.enableStorageCache()) {
+        if (simulator_.model().enableStorageCache()) {
             for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
                 fStorageOfTimeIndex1[tIdx] = tr.storageOfTimeIndex1_[tIdx][I][0];
                 sStorageOfTimeIndex1[tIdx] = tr.storageOfTimeIndex1_[tIdx][I][1];
@@ -430,6 +549,19 @@ protected:
         bool isUpS;
         computeFreeFlux_(fFlux, isUpF, tr.phaseIdx_, elemCtx, scvfIdx, 0);
         computeSolFlux_(sFlux, isUpS, tr.phaseIdx_, elemCtx, scvfIdx, 0);
+        assembleTracerEquationFlux(tr, fFlux, sFlux, isUpF, isUpS, I, J, dt);
+    }
+
+    template<class TrRe>
+    void assembleTracerEquationFlux(TrRe& tr,
+                                    const TracerEvaluation& fFlux,
+                                    const TracerEvaluation& sFlux,
+                                    const bool isUpF,
+                                    const bool isUpS,
+                                    unsigned I,
+                                    unsigned J,
+                                    const Scalar dt)
+    {
         dsVol_[tr.phaseIdx_][I] += sFlux.value() * dt;
         dfVol_[tr.phaseIdx_][I] += fFlux.value() * dt;
         int fGlobalUpIdx = isUpF ? I : J;
@@ -603,6 +735,28 @@ protected:
             }
         }
 
+        if constexpr (enableCachedAssembly) {
+            assembleTracerEquationsCached_();
+        }
+        else {
+            assembleTracerEquationsElementContext_();
+        }
+
+        // Communicate overlap using grid Communication
+        for (auto& tr : tbatch) {
+            if (tr.numTracer() == 0)
+                continue;
+            auto handle = VectorVectorDataHandle<GridView, std::vector<TracerVector>>(tr.residual_,
+                                                                                      simulator_.gridView());
+            simulator_.gridView().communicate(handle, Dune::InteriorBorder_All_Interface,
+                                              Dune::ForwardCommunication);
+        }
+    }
+
+    // Assemble the storage, flux and source terms of all tracer batches by
+    // updating an element context for each element.
+    void assembleTracerEquationsElementContext_()
+    {
         ElementContext elemCtx(simulator_);
         for (const auto& elem : elements(simulator_.gridView())) {
             elemCtx.updateStencil(elem);
@@ -636,7 +790,7 @@ protected:
             std::size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timeIdx=*/1);
 
             for (auto& tr : tbatch) {
-                this->assembleTracerEquationVolume(tr, elemCtx, scvVolume, dt, I, I1);
+                this->assembleTracerEquationVolume(tr, scvVolume, dt, I, I1);
             }
 
             std::size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
@@ -655,15 +809,155 @@ protected:
             }
 
         }
+    }
 
-        // Communicate overlap using grid Communication
-        for (auto& tr : tbatch) {
-            if (tr.numTracer() == 0)
+    // Assemble the storage, flux and source terms of all tracer batches in a
+    // single threaded sweep over the cells, reading the intensive quantities
+    // cached by the flow model and the face table set up by
+    // createNeighborInfo_(). The thread handling cell I only writes to row I
+    // of the residuals and the matrices, and to the blocks (J, I) of its
+    // neighbours J, which are not written by any other cell.
+    void assembleTracerEquationsCached_()
+    {
+        createNeighborInfo_();
+
+        const auto& model = simulator_.model();
+        const Scalar dt = simulator_.timeStepSize();
+        const int numCells = neighborInfo_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int I = 0; I < numCells; ++I) {
+            if (!isInteriorCell_[I]) {
+                // Dirichlet boundary conditions needed for the parallel matrix
+                for (auto& tr : tbatch) {
+                    if (tr.numTracer() != 0) {
+                        (*tr.mat)[I][I][0][0] = 1.;
+                        (*tr.mat)[I][I][1][1] = 1.;
+                    }
+                }
                 continue;
-            auto handle = VectorVectorDataHandle<GridView, std::vector<TracerVector>>(tr.residual_,
-                                                                                      simulator_.gridView());
-            simulator_.gridView().communicate(handle, Dune::InteriorBorder_All_Interface,
-                                              Dune::ForwardCommunication);
+            }
+
+            const Scalar scvVolume = model.dofTotalVolume(I)
+                * model.intensiveQuantities(I, /*timeIdx=*/0).extrusionFactor();
+            for (auto& tr : tbatch) {
+                this->assembleTracerEquationVolume(tr, scvVolume, dt, I, I);
+            }
+
+            for (const auto& nbInfo : neighborInfo_[I]) {
+                std::array<Scalar, numPhases> volumeRate;
+                std::array<bool, numPhases> isUp;
+                computeVolumeRates_(volumeRate, isUp, I, nbInfo);
+                for (auto& tr : tbatch) {
+                    if (tr.numTracer() == 0) {
+                        continue;
+                    }
+                    TracerEvaluation fFlux;
+                    TracerEvaluation sFlux;
+                    bool isUpF;
+                    bool isUpS;
+                    computeFreeFlux_(fFlux, isUpF, tr.phaseIdx_, I, nbInfo.neighbor, volumeRate, isUp);
+                    computeSolFlux_(sFlux, isUpS, tr.phaseIdx_, I, nbInfo.neighbor, volumeRate, isUp);
+                    this->assembleTracerEquationFlux(tr, fFlux, sFlux, isUpF, isUpS, I, nbInfo.neighbor, dt);
+                }
+            }
+
+            // Source terms (mass transfer between free and solution tracer)
+            for (auto& tr : tbatch) {
+                this->assembleTracerEquationSource(tr, dt, I);
+            }
+        }
+    }
+
+    // Set up the neighbours and the face data of all cells for
+    // assembleTracerEquationsCached_(). This is done once, the first time
+    // the tracer equations are assembled. The transmissibilities and threshold
+    // pressures are refreshed by updateStoredTransmissibilities().
+    void createNeighborInfo_()
+    {
+        if (!isInteriorCell_.empty()) {
+            return;
+        }
+
+        const auto& problem = simulator_.problem();
+        const auto& model = simulator_.model();
+        const Scalar gravity = problem.gravity()[GridView::dimensionworld - 1];
+        const unsigned numCells = model.numGridDof();
+        std::vector<std::vector<NeighborInfo>> neighbors(numCells);
+        isInteriorCell_.assign(numCells, 0);
+
+        Stencil stencil(simulator_.gridView(), model.dofMapper());
+        for (const auto& elem : elements(simulator_.gridView())) {
+            stencil.update(elem);
+            const unsigned I = stencil.globalSpaceIndex(/*dofIdx=*/0);
+            isInteriorCell_[I] = elem.partitionType() == Dune::InteriorEntity;
+            for (unsigned dofIdx = 1; dofIdx < stencil.numDof(); ++dofIdx) {
+                const unsigned J = stencil.globalSpaceIndex(dofIdx);
+                const auto& scvf = stencil.interiorFace(dofIdx - 1);
+                const auto dirId = scvf.dirId();
+                const auto faceDir = dirId < 0 ? FaceDir::DirEnum::Unknown
+                                               : FaceDir::FromIntersectionIndex(dirId);
+                neighbors[I].push_back(NeighborInfo{J,
+                                                    problem.transmissibility(I, J),
+                                                    (problem.dofCenterDepth(I) - problem.dofCenterDepth(J)) * gravity,
+                                                    problem.thresholdPressure(I, J),
+                                                    model.dofTotalVolume(I),
+                                                    model.dofTotalVolume(J),
+                                                    faceDir});
+            }
+        }
+
+        neighborInfo_.reserve(numCells, 6 * numCells);
+        for (const auto& row : neighbors) {
+            neighborInfo_.appendRow(row.begin(), row.end());
+        }
+    }
+
+    // Compute the volumetric rate of each phase from cell I to its neighbour
+    // and whether cell I is the upstream cell, in the same way as the
+    // extensive quantities of the transmissibility based flux module.
+    void computeVolumeRates_(std::array<Scalar, numPhases>& volumeRate,
+                             std::array<bool, numPhases>& isUp,
+                             const unsigned I,
+                             const NeighborInfo& nbInfo) const
+    {
+        const auto& problem = simulator_.problem();
+        const auto& intQuantsIn = simulator_.model().intensiveQuantities(I, /*timeIdx=*/0);
+        const auto& intQuantsEx = simulator_.model().intensiveQuantities(nbInfo.neighbor, /*timeIdx=*/0);
+        const Scalar transMult = (decay<Scalar>(intQuantsIn.rockCompTransMultiplier())
+                                  + decay<Scalar>(intQuantsEx.rockCompTransMultiplier())) / 2;
+
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            volumeRate[phaseIdx] = 0.0;
+            isUp[phaseIdx] = true;
+            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                continue;
+            }
+
+            short upIdx;
+            short dnIdx;
+            Evaluation pressureDifference;
+            ExtensiveQuantities::calculatePhasePressureDiff_(upIdx,
+                                                             dnIdx,
+                                                             pressureDifference,
+                                                             intQuantsIn,
+                                                             intQuantsEx,
+                                                             phaseIdx,
+                                                             /*interiorDofIdx=*/0,
+                                                             /*exteriorDofIdx=*/1,
+                                                             nbInfo.Vin,
+                                                             nbInfo.Vex,
+                                                             I,
+                                                             nbInfo.neighbor,
+                                                             nbInfo.dZg,
+                                                             nbInfo.thpres,
+                                                             problem.moduleParams());
+            isUp[phaseIdx] = (upIdx == 0);
+            const auto& up = isUp[phaseIdx] ? intQuantsIn : intQuantsEx;
+            volumeRate[phaseIdx] = decay<Scalar>(pressureDifference)
+                * decay<Scalar>(up.mobility(phaseIdx, nbInfo.faceDir))
+                * transMult * (-nbInfo.trans);
         }
     }
 
@@ -909,6 +1203,9 @@ protected:
     std::array<std::vector<Scalar>, 3> sVol1_;
     std::array<std::vector<Scalar>, 3> dsVol_;
     std::array<std::vector<Scalar>, 3> dfVol_;
+
+    SparseTable<NeighborInfo> neighborInfo_;
+    std::vector<unsigned char> isInteriorCell_;
 };
 
 } // namespace Opm
@@ -33,12 +33,14 @@
 
 #include <opm/grid/common/CartesianIndexMapper.hpp>
 #include <opm/grid/LookUpData.hh>
+#include <opm/grid/utility/SparseTable.hpp>
 
 
 #include <array>
-#include <functional>
-#include <map>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
@@ -163,6 +165,35 @@ protected:
 
     void removeNonCartesianTransmissibilities_(bool removeAll);
 
+    /// \brief Set up the face tables of the grid.
+    ///
+    /// The neighbors of each element are stored in the order of the
+    /// intersections of the element, i.e., in the order used by the
+    /// ECFV stencil. Each pair of neighboring elements is assigned a
+    /// unique face index which is used to address the face based
+    /// quantities. The boundary quantities are allocated with one
+    /// entry per intersection of an element without a neighbor.
+    ///
+    /// \param allocThermal Whether to allocate the thermal boundary
+    ///   half transmissibilities.
+    void createFaceTables_(bool allocThermal);
+
+    /// \brief Returns the index of the face between two elements or
+    ///        \c invalidFace if the elements are not neighbors.
+    std::uint32_t findFace_(unsigned elemIdx1, unsigned elemIdx2) const;
+
+    /// \brief Returns the index of the face between two elements.
+    ///
+    /// Throws std::out_of_range if the elements are not neighbors.
+    std::uint32_t faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const;
+
+    /// \brief Returns the position of the "half" quantity of the inside
+    ///        element of a face in a vector with two entries per face.
+    static std::size_t halfFaceIndex_(std::uint32_t faceIdx,
+                                      unsigned insideElemIdx,
+                                      unsigned outsideElemIdx)
+    { return 2*std::size_t{faceIdx} + (insideElemIdx < outsideElemIdx ? 0 : 1); }
+
     /// \brief Apply the Multipliers for the case PINCH(4)==TOPBOT
     ///
     /// \param pinchTop Whether PINCH(5) is TOP, otherwise ALL is assumed.
@@ -275,36 +306,42 @@ protected:
                    unsigned elemIdx,
                    const std::vector<double>& ntg) const;
 
+    static constexpr std::uint32_t invalidFace = std::numeric_limits<std::uint32_t>::max();
+
+    struct NeighborFace
+    {
+        std::uint32_t neighbor;
+        std::uint32_t face;
+    };
+
     std::vector<DimMatrix> permeability_;
     std::vector<Scalar> porosity_;
     std::vector<Scalar> dispersion_;
-    std::unordered_map<std::uint64_t, Scalar> trans_;
+    // one row per element with the neighbors in the order of its intersections
+    SparseTable<NeighborFace> neighborFaces_;
+    std::uint32_t numFaces_ = 0;
+    std::vector<Scalar> trans_; // indexed by face
     const EclipseState& eclState_;
     const GridView& gridView_;
     const CartesianIndexMapper& cartMapper_;
     const Grid& grid_;
     std::function<std::array<double,dimWorld>(int)> centroids_;
     Scalar transmissibilityThreshold_;
-    std::map<std::pair<unsigned, unsigned>, Scalar> transBoundary_;
-    std::map<std::pair<unsigned, unsigned>, Scalar> thermalHalfTransBoundary_;
+    // one row per element with an entry for each boundary intersection
+    SparseTable<Scalar> transBoundary_;
+    SparseTable<Scalar> thermalHalfTransBoundary_;
     bool enableEnergy_;
     bool enableDiffusivity_;
     bool enableDispersivity_;
     bool warnEditNNC_ = true;
-    std::unordered_map<std::uint64_t, Scalar> thermalHalfTrans_; //NB this is based on direction map size is ca 2*trans_ (diffusivity_)
-    std::unordered_map<std::uint64_t, Scalar> diffusivity_;
-    std::unordered_map<std::uint64_t, Scalar> dispersivity_;
+    std::vector<Scalar> thermalHalfTrans_; // two entries per face, cf. halfFaceIndex_()
+    std::vector<Scalar> diffusivity_; // indexed by face
+    std::vector<Scalar> dispersivity_; // indexed by face
 
     const LookUpData<Grid,GridView> lookUpData_;
     const LookUpCartesianData<Grid,GridView> lookUpCartesianData_;
 };
 
-namespace details {
-    std::uint64_t isId(std::uint32_t elemIdx1, std::uint32_t elemIdx2);
-    std::pair<std::uint32_t, std::uint32_t> isIdReverse(const std::uint64_t& id);
-    std::uint64_t directionalIsId(std::uint32_t elemIdx1, std::uint32_t elemIdx2);
-}
-
 } // namespace Opm
 
 #endif // OPM_TRANSMISSIBILITY_HPP
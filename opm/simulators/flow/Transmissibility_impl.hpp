@@ -55,35 +55,6 @@
 
 namespace Opm {
 
-namespace details {
-
-    constexpr unsigned elemIdxShift = 32; // bits
-
-    std::uint64_t isId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
-    {
-        std::uint32_t elemAIdx = std::min(elemIdx1, elemIdx2);
-        std::uint64_t elemBIdx = std::max(elemIdx1, elemIdx2);
-
-        return (elemBIdx<<elemIdxShift) + elemAIdx;
-    }
-
-    std::pair<std::uint32_t, std::uint32_t> isIdReverse(const std::uint64_t& id)
-    {
-        // Assigning an unsigned integer to a narrower type discards the most significant bits.
-        // See "The C programming language", section A.6.2.
-        // NOTE that the ordering of element A and B may have changed
-        std::uint32_t elemAIdx = id;
-        std::uint32_t elemBIdx = (id - elemAIdx) >> elemIdxShift;
-
-        return std::make_pair(elemAIdx, elemBIdx);
-    }
-
-    std::uint64_t directionalIsId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
-    {
-        return (std::uint64_t(elemIdx1)<<elemIdxShift) + elemIdx2;
-    }
-}
-
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 Transmissibility(const EclipseState& eclState,
@@ -113,28 +84,31 @@ template<class Grid, class GridView, class ElementMapper, class CartesianIndexMa
 Scalar Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 transmissibility(unsigned elemIdx1, unsigned elemIdx2) const
 {
-    return trans_.at(details::isId(elemIdx1, elemIdx2));
+    return trans_[faceIndex_(elemIdx1, elemIdx2)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 Scalar Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 transmissibilityBoundary(unsigned elemIdx, unsigned boundaryFaceIdx) const
 {
-    return transBoundary_.at(std::make_pair(elemIdx, boundaryFaceIdx));
+    assert(boundaryFaceIdx < transBoundary_[elemIdx].size());
+    return transBoundary_[elemIdx][boundaryFaceIdx];
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 Scalar Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 thermalHalfTrans(unsigned insideElemIdx, unsigned outsideElemIdx) const
 {
-    return thermalHalfTrans_.at(details::directionalIsId(insideElemIdx, outsideElemIdx));
+    const auto faceIdx = faceIndex_(insideElemIdx, outsideElemIdx);
+    return thermalHalfTrans_.at(halfFaceIndex_(faceIdx, insideElemIdx, outsideElemIdx));
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 Scalar Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 thermalHalfTransBoundary(unsigned insideElemIdx, unsigned boundaryFaceIdx) const
 {
-    return thermalHalfTransBoundary_.at(std::make_pair(insideElemIdx, boundaryFaceIdx));
+    assert(boundaryFaceIdx < thermalHalfTransBoundary_[insideElemIdx].size());
+    return thermalHalfTransBoundary_[insideElemIdx][boundaryFaceIdx];
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
@@ -144,7 +118,7 @@ diffusivity(unsigned elemIdx1, unsigned elemIdx2) const
     if (diffusivity_.empty())
         return 0.0;
 
-    return diffusivity_.at(details::isId(elemIdx1, elemIdx2));
+    return diffusivity_[faceIndex_(elemIdx1, elemIdx2)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
@@ -154,7 +128,7 @@ dispersivity(unsigned elemIdx1, unsigned elemIdx2) const
     if (dispersivity_.empty())
         return 0.0;
 
-    return dispersivity_.at(details::isId(elemIdx1, elemIdx2));
+    return dispersivity_[faceIndex_(elemIdx1, elemIdx2)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
@@ -169,7 +143,6 @@ update(bool global, const TransUpdateQuantities update_quantities,
     const auto& comm = gridView_.comm();
     ElementMapper elemMapper(gridView_, Dune::mcmgElementLayout());
 
-    unsigned numElements = elemMapper.size();
     // get the ntg values, the ntg values are modified for the cells merged with minpv
     const std::vector<double>& ntg = this->lookUpData_.assignFieldPropsDoubleOnLeaf(eclState_.fieldProps(), "NTG");
     const bool updateDiffusivity = eclState_.getSimulationConfig().isDiffusive();
@@ -182,34 +155,27 @@ update(bool global, const TransUpdateQuantities update_quantities,
     else
         extractPermeability_();
 
-    // reserving some space in the hashmap upfront saves quite a bit of time because
-    // resizes are costly for hashmaps and there would be quite a few of them if we
-    // would not have a rough idea of how large the final map will be (the rough idea
-    // is a conforming Cartesian grid).
-    trans_.clear();
-    trans_.reserve(numElements*3*1.05);
+    // all face based quantities are addressed by the face index, the boundary
+    // quantities by the element and the index of its boundary intersection.
+    createFaceTables_(enableEnergy_ && !onlyTrans);
+    assert(neighborFaces_.size() == static_cast<int>(elemMapper.size()));
 
-    transBoundary_.clear();
+    trans_.assign(numFaces_, 0.0);
 
     // if energy is enabled, let's do the same for the "thermal half transmissibilities"
     if (enableEnergy_ && !onlyTrans) {
-        thermalHalfTrans_.clear();
-        thermalHalfTrans_.reserve(numElements*6*1.05);
-
-        thermalHalfTransBoundary_.clear();
+        thermalHalfTrans_.assign(2*std::size_t{numFaces_}, 0.0);
     }
 
     // if diffusion is enabled, let's do the same for the "diffusivity"
     if (updateDiffusivity && !onlyTrans) {
-        diffusivity_.clear();
-        diffusivity_.reserve(numElements*3*1.05);
+        diffusivity_.assign(numFaces_, 0.0);
         extractPorosity_();
     }
 
     // if dispersion is enabled, let's do the same for the "dispersivity"
     if (updateDispersivity && !onlyTrans) {
-        dispersivity_.clear();
-        dispersivity_.reserve(numElements*3*1.05);
+        dispersivity_.assign(numFaces_, 0.0);
         extractDispersion_();
     }
 
@@ -243,6 +209,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
         auto isIt = gridView_.ibegin(elem);
         const auto& isEndIt = gridView_.iend(elem);
         unsigned boundaryIsIdx = 0;
+        unsigned neighborIsIdx = 0;
         for (; isIt != isEndIt; ++ isIt) {
             // store intersection, this might be costly
             const auto& intersection = *isIt;
@@ -269,7 +236,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
                 // transmissibility of the interior element.
                 unsigned insideCartElemIdx = cartMapper_.cartesianIndex(elemIdx);
                 applyMultipliers_(transBoundaryIs, intersection.indexInInside(), insideCartElemIdx, transMult);
-                transBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] = transBoundaryIs;
+                transBoundary_[elemIdx][boundaryIsIdx] = transBoundaryIs;
 
                 // for boundary intersections we also need to compute the thermal
                 // half transmissibilities
@@ -280,8 +247,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
                                             distanceVector_(faceCenterInside,
                                                             elemIdx),
                                             1.0);
-                    thermalHalfTransBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] =
-                        transBoundaryEnergyIs;
+                    thermalHalfTransBoundary_[elemIdx][boundaryIsIdx] = transBoundaryEnergyIs;
                 }
 
                 ++ boundaryIsIdx;
@@ -296,7 +262,9 @@ update(bool global, const TransUpdateQuantities update_quantities,
             }
 
             const auto& outsideElem = intersection.outside();
-            unsigned outsideElemIdx = elemMapper.index(outsideElem);  
+            unsigned outsideElemIdx = elemMapper.index(outsideElem);
+            const std::uint32_t faceIdx = neighborFaces_[elemIdx][neighborIsIdx++].face;
+            assert(neighborFaces_[elemIdx][neighborIsIdx - 1].neighbor == outsideElemIdx);
 
             // Get the Cartesian indices of the origen cells (parent or equivalent cell on level zero), for CpGrid with LGRs.
             // For genral grids and no LGRs, get the usual Cartesian Index.
@@ -321,17 +289,17 @@ update(bool global, const TransUpdateQuantities update_quantities,
                 // NNC. Set zero transmissibility, as it will be
                 // *added to* by applyNncToGridTrans_() later.
                 assert(outsideFaceIdx == -1);
-                trans_[details::isId(elemIdx, outsideElemIdx)] = 0.0;
+                trans_[faceIdx] = 0.0;
                 if (enableEnergy_  && !onlyTrans){
-                    thermalHalfTrans_[details::directionalIsId(elemIdx, outsideElemIdx)] = 0.0;
-                    thermalHalfTrans_[details::directionalIsId(outsideElemIdx, elemIdx)] = 0.0;
+                    thermalHalfTrans_[halfFaceIndex_(faceIdx, elemIdx, outsideElemIdx)] = 0.0;
+                    thermalHalfTrans_[halfFaceIndex_(faceIdx, outsideElemIdx, elemIdx)] = 0.0;
                 }
 
                 if (updateDiffusivity && !onlyTrans) {
-                    diffusivity_[details::isId(elemIdx, outsideElemIdx)] = 0.0;
+                    diffusivity_[faceIdx] = 0.0;
                 }
                 if (updateDispersivity && !onlyTrans) {
-                    dispersivity_[details::isId(elemIdx, outsideElemIdx)] = 0.0;
+                    dispersivity_[faceIdx] = 0.0;
                 }
                 continue;
             }
@@ -440,7 +408,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
                                                    outsideCartElemIdx,
                                                    faceDir);
 
-            trans_[details::isId(elemIdx, outsideElemIdx)] = trans;
+            trans_[faceIdx] = trans;
 
             // update the "thermal half transmissibility" for the intersection
             if (enableEnergy_ && !onlyTrans) {
@@ -459,8 +427,8 @@ update(bool global, const TransUpdateQuantities update_quantities,
                                                         outsideElemIdx),
                                         1.0);
                 //TODO Add support for multipliers
-                thermalHalfTrans_[details::directionalIsId(elemIdx, outsideElemIdx)] = halfDiffusivity1;
-                thermalHalfTrans_[details::directionalIsId(outsideElemIdx, elemIdx)] = halfDiffusivity2;
+                thermalHalfTrans_[halfFaceIndex_(faceIdx, elemIdx, outsideElemIdx)] = halfDiffusivity1;
+                thermalHalfTrans_[halfFaceIndex_(faceIdx, outsideElemIdx, elemIdx)] = halfDiffusivity2;
            }
 
             // update the "diffusive half transmissibility" for the intersection
@@ -492,7 +460,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
                     diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
 
 
-                diffusivity_[details::isId(elemIdx, outsideElemIdx)] = diffusivity;
+                diffusivity_[faceIdx] = diffusivity;
            }
 
            // update the "dispersivity half transmissibility" for the intersection
@@ -524,7 +492,7 @@ update(bool global, const TransUpdateQuantities update_quantities,
                     dispersivity = 1.0 / (1.0/halfDispersivity1 + 1.0/halfDispersivity2);
 
 
-                dispersivity_[details::isId(elemIdx, outsideElemIdx)] = dispersivity;
+                dispersivity_[faceIdx] = dispersivity;
            }
         }
     }
@@ -694,25 +662,128 @@ void Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 removeNonCartesianTransmissibilities_(bool removeAll)
 {
     const auto& cartDims = cartMapper_.cartesianDimensions();
-    for (auto&& trans: trans_) {
-        //either remove all NNC transmissibilities or those less than the threshold (by default 1e-6 in the deck's unit system)
-        if (removeAll or trans.second < transmissibilityThreshold_) {
-            const auto& id = trans.first;
-            const auto& elements = details::isIdReverse(id);
-            int gc1 = std::min(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-            int gc2 = std::max(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-
-            // only adjust the NNCs
-            // When LGRs, all neighbors in the LGR are cartesian neighbours on the level grid representing the LGR.
-            // When elements on the leaf grid view have the same parent cell, gc1 and gc2 coincide.
-            if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1] || gc2 - gc1 == 0)
+    const unsigned numElements = static_cast<unsigned>(neighborFaces_.size());
+    for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+        for (const auto& nbFace : neighborFaces_[elemIdx]) {
+            // visit each face once (from the element with the smaller index)
+            if (nbFace.neighbor < elemIdx)
                 continue;
 
-            trans.second = 0.0;
+            auto& trans = trans_[nbFace.face];
+            //either remove all NNC transmissibilities or those less than the threshold (by default 1e-6 in the deck's unit system)
+            if (removeAll or trans < transmissibilityThreshold_) {
+                int gc1 = std::min(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(nbFace.neighbor));
+                int gc2 = std::max(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(nbFace.neighbor));
+
+                // only adjust the NNCs
+                // When LGRs, all neighbors in the LGR are cartesian neighbours on the level grid representing the LGR.
+                // When elements on the leaf grid view have the same parent cell, gc1 and gc2 coincide.
+                if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1] || gc2 - gc1 == 0)
+                    continue;
+
+                trans = 0.0;
+            }
         }
     }
 }
 
+template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
+void Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
+createFaceTables_(bool allocThermal)
+{
+    ElementMapper elemMapper(gridView_, Dune::mcmgElementLayout());
+    const unsigned numElements = elemMapper.size();
+
+    // count the neighbors and the boundary intersections of each element. This
+    // needs to classify the intersections exactly like update() does.
+    std::vector<int> numNeighbors(numElements, 0);
+    std::vector<int> numBoundaries(numElements, 0);
+    for (const auto& elem : elements(gridView_)) {
+        const unsigned elemIdx = elemMapper.index(elem);
+        for (const auto& intersection : intersections(gridView_, elem)) {
+            if (intersection.boundary() || !intersection.neighbor())
+                ++numBoundaries[elemIdx];
+            else
+                ++numNeighbors[elemIdx];
+        }
+    }
+
+    neighborFaces_.allocate(numNeighbors.begin(), numNeighbors.end());
+    transBoundary_.allocate(numBoundaries.begin(), numBoundaries.end());
+    if (allocThermal) {
+        thermalHalfTransBoundary_.allocate(numBoundaries.begin(), numBoundaries.end());
+    }
+
+    for (const auto& elem : elements(gridView_)) {
+        const unsigned elemIdx = elemMapper.index(elem);
+        auto nbFaces = neighborFaces_[elemIdx];
+        unsigned neighborIsIdx = 0;
+        for (const auto& intersection : intersections(gridView_, elem)) {
+            if (intersection.boundary() || !intersection.neighbor())
+                continue;
+            nbFaces[neighborIsIdx++] = NeighborFace{static_cast<std::uint32_t>(elemMapper.index(intersection.outside())),
+                                                    invalidFace};
+        }
+    }
+
+    // assign the face indices. The face between two elements gets its index
+    // when the element with the smaller index is visited, the other element
+    // (which comes later) takes it over.
+    numFaces_ = 0;
+    for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+        auto nbFaces = neighborFaces_[elemIdx];
+        const int numNbFaces = nbFaces.size();
+        for (int i = 0; i < numNbFaces; ++i) {
+            auto& nbFace = nbFaces[i];
+            if (nbFace.neighbor < elemIdx) {
+                for (const auto& otherFace : neighborFaces_[nbFace.neighbor]) {
+                    if (otherFace.neighbor == elemIdx) {
+                        nbFace.face = otherFace.face;
+                        break;
+                    }
+                }
+            }
+            else {
+                // multiple intersections with the same neighbor share the face
+                for (int j = 0; j < i; ++j) {
+                    if (nbFaces[j].neighbor == nbFace.neighbor) {
+                        nbFace.face = nbFaces[j].face;
+                        break;
+                    }
+                }
+            }
+            if (nbFace.face == invalidFace)
+                nbFace.face = numFaces_++;
+        }
+    }
+}
+
+template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
+std::uint32_t Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
+findFace_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    if (elemIdx1 >= static_cast<unsigned>(neighborFaces_.size()))
+        return invalidFace;
+
+    for (const auto& nbFace : neighborFaces_[elemIdx1]) {
+        if (nbFace.neighbor == elemIdx2)
+            return nbFace.face;
+    }
+    return invalidFace;
+}
+
+template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
+std::uint32_t Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
+faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    const auto faceIdx = findFace_(elemIdx1, elemIdx2);
+    if (faceIdx == invalidFace) {
+        throw std::out_of_range(fmt::format("No face between elements {} and {}",
+                                            elemIdx1, elemIdx2));
+    }
+    return faceIdx;
+}
+
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 void Transmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper, Scalar>::
 applyAllZMultipliers_(Scalar& trans,
@@ -839,7 +910,7 @@ createTransmissibilityArrays_(const std::array<bool,3>& is_tran)
                 // are ordered last
                 continue;
 
-            auto isID = details::isId(c1, c2);
+            const auto faceIdx = faceIndex_(c1, c2);
 
             // For CpGrid with LGRs, when leaf grid view cells with indices c1 and c2
             // have the same parent cell on level zero, then gc2 - gc1 == 0. In that case,
@@ -849,19 +920,19 @@ createTransmissibilityArrays_(const std::array<bool,3>& is_tran)
                 && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                     trans[0][c1] = trans_[isID];
+                     trans[0][c1] = trans_[faceIdx];
             }
             else if ((gc2 - gc1 == cartDims[0] || (gc2 == gc1 && (intersection.indexInInside() == 2 || intersection.indexInInside() == 3)))
                      && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                     trans[1][c1] = trans_[isID];
+                     trans[1][c1] = trans_[faceIdx];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1] ||
                      (gc2 == gc1 && (intersection.indexInInside() == 4 || intersection.indexInInside() == 5))) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                    trans[2][c1] = trans_[isID];
+                    trans[2][c1] = trans_[faceIdx];
             }
 
             //else.. We don't support modification of NNC at the moment.
@@ -907,7 +978,7 @@ resetTransmissibilityFromArrays_(const std::array<bool,3>& is_tran,
                 // are ordered last
                 continue;
 
-            auto isID = details::isId(c1, c2);
+            const auto faceIdx = faceIndex_(c1, c2);
 
             // For CpGrid with LGRs, when leaf grid view cells with indices c1 and c2
             // have the same parent cell on level zero, then gc2 - gc1 == 0. In that case,
@@ -917,19 +988,19 @@ resetTransmissibilityFromArrays_(const std::array<bool,3>& is_tran,
                  && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                    trans_[isID] = trans[0][c1];
+                    trans_[faceIdx] = trans[0][c1];
             }
             else if ((gc2 - gc1 == cartDims[0] || (gc2 == gc1 && (intersection.indexInInside() == 2|| intersection.indexInInside() == 3)))
                      && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                    trans_[isID] = trans[1][c1];
+                    trans_[faceIdx] = trans[1][c1];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1] ||
                      (gc2 == gc1 && (intersection.indexInInside() == 4 || intersection.indexInInside() == 5))) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                    trans_[isID] = trans[2][c1];
+                    trans_[faceIdx] = trans[2][c1];
             }
 
             //else.. We don't support modification of NNC at the moment.
@@ -1055,11 +1126,11 @@ applyPinchNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianTo
         }
 
         {
-            auto candidate = trans_.find(details::isId(low, high));
-            if (candidate != trans_.end()) {
+            const auto faceIdx = findFace_(low, high);
+            if (faceIdx != invalidFace) {
                 // the correctly calculated transmissibility is stored in
                 // the NNC. Overwrite previous value with it.
-               candidate->second = nncEntry.trans;
+               trans_[faceIdx] = nncEntry.trans;
             }
         }
     }
@@ -1098,12 +1169,12 @@ applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompr
         }
 
         {
-            auto candidate = trans_.find(details::isId(low, high));
-            if (candidate != trans_.end()) {
+            const auto faceIdx = findFace_(low, high);
+            if (faceIdx != invalidFace) {
                 // NNC is represented by the grid and might be a neighboring connection
                 // In this case the transmissibilty is added to the value already
                 // set or computed.
-                candidate->second += nncEntry.trans;
+                trans_[faceIdx] += nncEntry.trans;
             }
         }
         // if (enableEnergy_) {
@@ -1216,16 +1287,18 @@ applyEditNncToGridTransHelper_(const std::unordered_map<std::size_t,int>& global
         if (low > high)
             std::swap(low, high);
 
-        auto candidate = trans_.find(details::isId(low, high));
-        if (candidate == trans_.end() && warnEditNNC_) {
-            print_warning(*nnc);
+        const auto faceIdx = findFace_(low, high);
+        if (faceIdx == invalidFace) {
+            if (warnEditNNC_) {
+                print_warning(*nnc);
+                warning_count++;
+            }
             ++nnc;
-            warning_count++;
         }
         else {
             // NNC exists
             while (nnc!= end && c1==nnc->cell1 && c2==nnc->cell2) {
-                apply(candidate->second, nnc->trans);
+                apply(trans_[faceIdx], nnc->trans);
                 ++nnc;
             }
         }
@@ -1279,9 +1352,9 @@ applyNncMultreg_(const std::unordered_map<std::size_t,int>& cartesianToCompresse
                 std::swap(low, high);
             }
 
-            auto candidate = this->trans_.find(details::isId(low, high));
-            if (candidate != this->trans_.end()) {
-                candidate->second *= transMult.getRegionMultiplierNNC(c1, c2);
+            const auto faceIdx = this->findFace_(low, high);
+            if (faceIdx != invalidFace) {
+                this->trans_[faceIdx] *= transMult.getRegionMultiplierNNC(c1, c2);
             }
         }
     }
@@ -0,0 +1,208 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_AMGCLPRECONDITIONER_HEADER_INCLUDED
+#define OPM_AMGCLPRECONDITIONER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <amgcl/adapter/crs_tuple.hpp>
+#include <amgcl/backend/builtin.hpp>
+#include <amgcl/preconditioner/runtime.hpp>
+#include <amgcl/util.hpp>
+#include <amgcl/value_type/static_matrix.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Dune
+{
+
+/*! \brief Sequential preconditioner using amgcl with its builtin backend.
+
+   The setup and the application are parallelized by amgcl with OpenMP.
+   The optional child "amgcl" of the property tree is handed to
+   amgcl::runtime::preconditioner, e.g.
+   { "class": "amg", "coarsening": { "type": "smoothed_aggregation" },
+     "relax": { "type": "ilu0" } }.
+   Without it amgcl uses smoothed aggregation AMG with spai0 smoothing.
+
+   The sparsity pattern of the matrix is converted once. update() copies
+   the values and rebuilds the amgcl preconditioner, hence the pattern of
+   the matrix must not change. hasPerfectUpdate() is true as the result
+   equals a newly constructed preconditioner, but the update is not cheap:
+   it sets up the whole amgcl hierarchy again, i.e. the coarsening, the
+   transfer operators and the smoothers of all levels.
+
+   \tparam M The matrix type to operate on
+   \tparam X Type of the update
+   \tparam Y Type of the defect
+*/
+template <class M, class X, class Y>
+class AmgclPreconditioner : public PreconditionerWithUpdate<X, Y>
+{
+public:
+    //! \brief The matrix type the preconditioner is for.
+    using matrix_type = M;
+    //! \brief The domain type of the preconditioner.
+    using domain_type = X;
+    //! \brief The range type of the preconditioner.
+    using range_type = Y;
+    //! \brief The field type of the preconditioner.
+    using field_type = typename X::field_type;
+
+    static constexpr int blockSize = M::block_type::rows;
+
+    /*! \brief Constructor.
+       \param A The matrix to operate on.
+       \param prm The parameters of the preconditioner.
+    */
+    AmgclPreconditioner(const M& A, const Opm::PropertyTree& prm)
+        : A_(A)
+    {
+        OPM_TIMEBLOCK(amgclConstruct);
+        if (const auto amgclPrm = prm.get_child_optional("amgcl")) {
+            std::stringstream json;
+            amgclPrm->write_json(json, false);
+            boost::property_tree::read_json(json, amgclPrm_);
+        }
+
+        numRows_ = A_.N();
+        ptr_.reserve(A_.N() + 1);
+        col_.reserve(A_.nonzeroes());
+        ptr_.push_back(0);
+        for (auto row = A_.begin(); row != A_.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                col_.push_back(col.index());
+            }
+            ptr_.push_back(col_.size());
+        }
+        values_.resize(col_.size());
+        update();
+    }
+
+    /*!
+       \brief Prepare the preconditioner.
+       \copydoc Preconditioner::pre(X&,Y&)
+     */
+    void pre([[maybe_unused]] X& x, [[maybe_unused]] Y& b) override
+    {
+    }
+
+    /*!
+       \brief Apply the preconditioner.
+       \copydoc Preconditioner::apply(X&,const Y&)
+     */
+    void apply(X& v, const Y& d) override
+    {
+        OPM_TIMEBLOCK(amgclApply);
+        if (numRows_ == 0) {
+            return;
+        }
+        // The blocks of Dune::BlockVector are stored contiguously and
+        // have the layout of the amgcl vector blocks.
+        const auto* rhs = reinterpret_cast<const VectorValueType*>(&d[0][0]);
+        auto* x = reinterpret_cast<VectorValueType*>(&v[0][0]);
+        precond_->apply(amgcl::make_iterator_range(rhs, rhs + d.size()),
+                        amgcl::make_iterator_range(x, x + v.size()));
+    }
+
+    /*!
+       \brief Clean up.
+       \copydoc Preconditioner::post(X&)
+     */
+    void post([[maybe_unused]] X& x) override
+    {
+    }
+
+    //! Category of the preconditioner (see SolverCategory::Category)
+    SolverCategory::Category category() const override
+    {
+        return SolverCategory::sequential;
+    }
+
+    //! \brief Copy the values of the matrix and rebuild the preconditioner.
+    //!
+    //! This rebuilds the whole amgcl hierarchy and costs as much as the
+    //! setup in the constructor, apart from converting the pattern.
+    void update() override
+    {
+        OPM_TIMEBLOCK(amgclUpdate);
+        const std::ptrdiff_t numRows = numRows_;
+#if HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (std::ptrdiff_t row = 0; row < numRows; ++row) {
+            std::ptrdiff_t index = ptr_[row];
+            for (const auto& block : A_[row]) {
+                copyBlock_(block, values_[index++]);
+            }
+        }
+        precond_ = std::make_unique<Precond>(std::tie(numRows_, ptr_, col_, values_), amgclPrm_);
+    }
+
+    bool hasPerfectUpdate() const override
+    {
+        return true;
+    }
+
+private:
+    using ValueType = std::conditional_t<blockSize == 1, field_type,
+                                         amgcl::static_matrix<field_type, blockSize, blockSize>>;
+    using VectorValueType = std::conditional_t<blockSize == 1, field_type,
+                                               amgcl::static_matrix<field_type, blockSize, 1>>;
+    using Backend = amgcl::backend::builtin<ValueType>;
+    using Precond = amgcl::runtime::preconditioner<Backend>;
+
+    template <class Block>
+    static void copyBlock_(const Block& block, ValueType& value)
+    {
+        if constexpr (blockSize == 1) {
+            value = block[0][0];
+        } else {
+            for (int i = 0; i < blockSize; ++i) {
+                for (int j = 0; j < blockSize; ++j) {
+                    value(i, j) = block[i][j];
+                }
+            }
+        }
+    }
+
+    //! \brief The matrix we operate on.
+    const M& A_;
+    boost::property_tree::ptree amgclPrm_;
+    std::ptrdiff_t numRows_;
+    //! \brief The sparsity pattern of A_ in CSR format.
+    std::vector<std::ptrdiff_t> ptr_;
+    std::vector<std::ptrdiff_t> col_;
+    //! \brief The values of A_ in the order of col_.
+    std::vector<ValueType> values_;
+    std::unique_ptr<Precond> precond_;
+};
+
+} // namespace Dune
+
+#endif // OPM_AMGCLPRECONDITIONER_HEADER_INCLUDED
@@ -20,6 +20,7 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/TimingMacros.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/unused.hh>
@@ -197,7 +198,9 @@ private:
                 // if A[i, j] != 0 and A[j, i] != 0
                 if (a_ji != A_[col_j].end()) {
                     // Dinv_temp -= A[i, j] * d[j] * A[j, i]
-                    Dinv_temp -= (*a_ij) * Dune::FieldMatrix(Dinv_[col_j]) * (*a_ji);
+                    auto d_a_ji = Dinv_[col_j];
+                    Opm::detail::rightMultiplyBlock(d_a_ji, *a_ji);
+                    Opm::detail::mmmBlock(*a_ij, d_a_ji, Dinv_temp);
                 }
             }
             Dinv_temp.invert();
@@ -239,7 +242,9 @@ private:
                     const auto a_ji = (*A_reordered_)[col_j].find(row_i);
                     if (a_ji != (*A_reordered_)[col_j].end()) {
                         // Dinv_temp -= A[i, j] * d[j] * A[j, i]
-                        Dinv_temp -= (*a_ij) * Dune::FieldMatrix(Dinv_[col_j]) * (*a_ji);
+                        auto d_a_ji = Dinv_[col_j];
+                        Opm::detail::rightMultiplyBlock(d_a_ji, *a_ji);
+                        Opm::detail::mmmBlock(*a_ij, d_a_ji, Dinv_temp);
                     }
                 }
                 Dinv_temp.invert();
@@ -271,11 +276,11 @@ private:
                     // if  A[i][j] != 0
                     // rhs -= A[i][j]* y[j], where v_j stores y_j
                     const auto col_j = a_ij.index();
-                    a_ij->mmv(v[col_j], rhs);
+                    Opm::detail::mmvBlock(*a_ij, v[col_j], rhs);
                 }
                 // y_i = Dinv_i * rhs
                 // storing y_i in v_i
-                Dinv_[row_i].mv(rhs, v[row_i]); // (D + L_A)_ii = D_i
+                Opm::detail::mvBlock(Dinv_[row_i], rhs, v[row_i]); // (D + L_A)_ii = D_i
             }
         }
 
@@ -292,12 +297,12 @@ private:
                     // if A[i][j] != 0
                     // rhs += A[i][j]*v[j]
                     const auto col_j = a_ij.index();
-                    a_ij->umv(v[col_j], rhs);
+                    Opm::detail::umvBlock(*a_ij, v[col_j], rhs);
                 }
                 // calculate update v = M^-1*d
                 // v_i = y_i - Dinv_i*rhs
                 // before update v_i is y_i
-                Dinv_[row_i].mmv(rhs, v[row_i]);
+                Opm::detail::mmvBlock(Dinv_[row_i], rhs, v[row_i]);
             }
         }
     }
@@ -323,11 +328,11 @@ private:
                         // if  A[i][j] != 0
                         // rhs -= A[i][j]* y[j], where v_j stores y_j
                         const auto col_j = a_ij.index();
-                        a_ij->mmv(v[col_j], rhs);
+                        Opm::detail::mmvBlock(*a_ij, v[col_j], rhs);
                     }
                     // y_i = Dinv_i * rhs
                     // storing y_i in v_i
-                    Dinv_[level_start_idx + row_idx_in_level].mv(rhs, v[row_i]); // (D + L_A)_ii = D_i
+                    Opm::detail::mvBlock(Dinv_[level_start_idx + row_idx_in_level], rhs, v[row_i]); // (D + L_A)_ii = D_i
                 }
                 level_start_idx += num_of_rows_in_level;
             }
@@ -349,12 +354,12 @@ private:
                     for (auto a_ij = (*row).beforeEnd(); a_ij.index() > row_i; --a_ij) {
                         // rhs += A[i][j]*v[j]
                         const auto col_j = a_ij.index();
-                        a_ij->umv(v[col_j], rhs);
+                        Opm::detail::umvBlock(*a_ij, v[col_j], rhs);
                     }
                     // calculate update v = M^-1*d
                     // v_i = y_i - Dinv_i*rhs
                     // before update v_i is y_i
-                    Dinv_[level_start_idx + row_idx_in_level].mmv(rhs, v[row_i]);
+                    Opm::detail::mmvBlock(Dinv_[level_start_idx + row_idx_in_level], rhs, v[row_i]);
                 }
             }
         }
@@ -22,6 +22,7 @@
 #ifndef OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 #define OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/HaloExchange.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
 
 #include <dune/istl/solver.hh>
@@ -91,6 +92,9 @@ private:
 
     void recreateDirectSolver();
 
+    // Finish pending halo exchanges and update the ghost entries of x.
+    void makeConsistent(VectorType& x);
+
     // Main initialization routine.
     // Call with Comm == Dune::Amg::SequentialInformation to get a serial solver.
     template <class Comm>
@@ -104,6 +108,9 @@ private:
     std::shared_ptr<AbstractPrecondType> preconditioner_;
     std::shared_ptr<AbstractScalarProductType> scalarproduct_;
     std::shared_ptr<AbstractSolverType> linsolver_;
+    // Shared by the preconditioner and the operator if the update of the
+    // ghost entries is overlapped with the operator application.
+    std::shared_ptr<Opm::HaloExchange<VectorType>> haloExchange_;
     bool direct_solver_ = false;
 };
 
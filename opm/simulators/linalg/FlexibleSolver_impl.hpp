@@ -26,6 +26,10 @@
 #include <opm/simulators/linalg/matrixblock.hh>
 #include <opm/simulators/linalg/ilufirstelement.hh>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/GcroDrSolver.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
+#include <opm/simulators/linalg/PipelinedGMResSolver.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/WellOperators.hpp>
@@ -37,6 +41,11 @@
 #include <dune/istl/owneroverlapcopy.hh>
 #include <dune/istl/paamg/pinfo.hh>
 
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 #if HAVE_CUDA
 #if USE_HIP
 #include <opm/simulators/linalg/gpuistl_hip/SolverAdapter.hpp>
@@ -45,6 +54,19 @@
 #endif
 #endif
 
+namespace Opm::detail
+{
+    /// True if the operator can finish the halo exchange started by the
+    /// preconditioner, see GhostLastMatrixAdapter::setHaloExchange().
+    template <class Operator, class = void>
+    struct SupportsHaloExchange : std::false_type {};
+
+    template <class Operator>
+    struct SupportsHaloExchange<Operator,
+                                std::void_t<decltype(std::declval<Operator&>().setHaloExchange(nullptr))>>
+        : std::true_type {};
+} // namespace Opm::detail
+
 namespace Dune
 {
     /// Create a sequential solver.
@@ -81,6 +103,7 @@ namespace Dune
             recreateDirectSolver();
         }
         linsolver_->apply(x, rhs, res);
+        makeConsistent(x);
     }
 
     template <class Operator>
@@ -92,6 +115,20 @@ namespace Dune
             recreateDirectSolver();
         }
         linsolver_->apply(x, rhs, reduction, res);
+        makeConsistent(x);
+    }
+
+    template <class Operator>
+    void
+    FlexibleSolver<Operator>::
+    makeConsistent(VectorType& x)
+    {
+        // The solvers may have combined vectors whose ghost entries were
+        // still in transfer, e.g. in the update of x in the LoopSolver.
+        if (haloExchange_) {
+            haloExchange_->start(x);
+            haloExchange_->finish();
+        }
     }
 
     /// Access the contained preconditioner.
@@ -131,6 +168,30 @@ namespace Dune
                                                                              comm,
                                                                              pressureIndex);
         scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, op.category());
+
+        // Let the ILU0 preconditioner only start the update of the ghost
+        // entries, which the operator finishes after multiplying the
+        // interior rows. This requires a solver which applies the operator
+        // to the output of the preconditioner before using it otherwise,
+        // which is not the case for the left preconditioned gmres.
+        haloExchange_.reset();
+        if constexpr (Opm::detail::SupportsHaloExchange<Operator>::value) {
+            using ILU0 = Opm::ParallelOverlappingILU0<typename Operator::matrix_type,
+                                                      VectorType, VectorType, Comm>;
+            const std::string solver_type = prm.get<std::string>("solver", "bicgstab");
+            const bool overlapSolver = solver_type == "bicgstab" || solver_type == "loopsolver"
+                || solver_type == "flexgmres" || solver_type == "pbicgstab"
+                || solver_type == "pgmres" || solver_type == "gcrodr";
+            auto ilu = std::dynamic_pointer_cast<ILU0>(preconditioner_);
+            if (ilu && overlapSolver && op.category() == Dune::SolverCategory::overlapping) {
+                auto exchange = std::make_shared<Opm::HaloExchange<VectorType>>(comm);
+                if (!exchange->empty()) {
+                    haloExchange_ = std::move(exchange);
+                    ilu->setHaloExchange(haloExchange_);
+                }
+            }
+            op.setHaloExchange(haloExchange_);
+        }
     }
 
     template <class Operator>
@@ -195,6 +256,35 @@ namespace Dune
                                                                                           restart,
                                                                                           maxiter, // maximum number of iterations
                                                                                           verbosity);
+        } else if (solver_type == "pbicgstab") {
+            linsolver_ = std::make_shared<Opm::PipelinedBiCGSTABSolver<VectorType>>(*linearoperator_for_solver_,
+                                                                                    *scalarproduct_,
+                                                                                    *preconditioner_,
+                                                                                    comm,
+                                                                                    tol, // desired residual reduction factor
+                                                                                    maxiter, // maximum number of iterations
+                                                                                    verbosity);
+        } else if (solver_type == "pgmres") {
+            int restart = prm.get<int>("restart", 15);
+            linsolver_ = std::make_shared<Opm::PipelinedGMResSolver<VectorType>>(*linearoperator_for_solver_,
+                                                                                 *scalarproduct_,
+                                                                                 *preconditioner_,
+                                                                                 comm,
+                                                                                 tol,// desired residual reduction factor
+                                                                                 restart,
+                                                                                 maxiter, // maximum number of iterations
+                                                                                 verbosity);
+        } else if (solver_type == "gcrodr") {
+            int restart = prm.get<int>("restart", 15);
+            int recycle = prm.get<int>("recycle", 5);
+            linsolver_ = std::make_shared<Opm::GcroDrSolver<VectorType>>(*linearoperator_for_solver_,
+                                                                         *scalarproduct_,
+                                                                         *preconditioner_,
+                                                                         tol,// desired residual reduction factor
+                                                                         restart,
+                                                                         recycle,
+                                                                         maxiter, // maximum number of iterations
+                                                                         verbosity);
 #if HAVE_SUITESPARSE_UMFPACK
         } else if (solver_type == "umfpack") {
             if constexpr (std::is_same_v<typename VectorType::field_type,float>) {
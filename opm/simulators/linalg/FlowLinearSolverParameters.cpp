@@ -40,6 +40,7 @@ void FlowLinearSolverParameters::init(bool cprRequestedInDataFile)
     ilu_milu_ = convertString2Milu(Parameters::Get<Parameters::MiluVariant>());
     ilu_redblack_ = Parameters::Get<Parameters::IluRedblack>();
     ilu_reorder_sphere_ = Parameters::Get<Parameters::IluReorderSpheres>();
+    ilu_reorder_rcm_ = Parameters::Get<Parameters::IluReorderRcm>();
     newton_use_gmres_ = Parameters::Get<Parameters::UseGmres>();
     ignoreConvergenceFailure_ = Parameters::Get<Parameters::LinearSolverIgnoreConvergenceFailure>();
     scale_linear_system_ = Parameters::Get<Parameters::ScaleLinearSystem>();
@@ -108,6 +109,12 @@ void FlowLinearSolverParameters::registerParameters()
          "If false the original ordering is preserved in each color. "
          "Otherwise why try to ensure D4 ordering (in a 2D structured grid, "
          "the diagonal elements are consecutive).");
+    Parameters::Register<Parameters::IluReorderRcm>
+        ("Reorder the interior rows by reverse Cuthill-McKee before the ILU "
+         "decomposition to reduce the bandwidth of the factors. "
+         "Only the ILU factors are reordered, the grid, the matrix and the "
+         "vectors keep their ordering. "
+         "Ignored if red-black partitioning is used.");
     Parameters::Register<Parameters::UseGmres>
         ("Use GMRES as the linear solver");
     Parameters::Register<Parameters::LinearSolverIgnoreConvergenceFailure>
@@ -134,7 +141,9 @@ void FlowLinearSolverParameters::registerParameters()
          "1: recreate once every timestep, "
          "2: recreate if last linear solve took more than 10 iterations, "
          "3: never recreate, "
-         "4: recreated every CprReuseInterval");
+         "4: recreated every CprReuseInterval. "
+         "A reused CPR preconditioner keeps the AMG aggregates and updates "
+         "the coarse matrices and the smoothers with the new values");
     Parameters::Register<Parameters::CprReuseInterval>
         ("Reuse preconditioner interval. Used when CprReuseSetup is set to 4, "
          "then the preconditioner will be fully recreated instead of reused "
@@ -166,6 +175,7 @@ void FlowLinearSolverParameters::reset()
     ilu_milu_                 = MILU_VARIANT::ILU;
     ilu_redblack_             = false;
     ilu_reorder_sphere_       = false;
+    ilu_reorder_rcm_          = false;
     newton_use_gmres_         = false;
     ignoreConvergenceFailure_ = false;
     scale_linear_system_      = false;
@@ -0,0 +1,172 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FUSEDREDUCTION_HEADER_INCLUDED
+#define OPM_FUSEDREDUCTION_HEADER_INCLUDED
+
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/solvercategory.hh>
+
+#if HAVE_MPI
+#include <dune/common/parallel/mpitraits.hh>
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/*!
+   \brief Computes several dot products with a single global reduction.
+
+   The Krylov solvers of dune-istl call the scalar product for each dot
+   product, and each call is a blocking allreduce in parallel. This class
+   computes the local parts of all dot products of an iteration in one
+   sweep over the vectors and sums them with a single nonblocking
+   MPI_Iallreduce. The caller can do other work, e.g. apply the
+   preconditioner and the operator, between start() and finish().
+
+   In parallel only the owned entries count, as in the overlapping scalar
+   product of dune-istl, hence the vectors must be consistent on the
+   overlap, which is what the operators and preconditioners ensure.
+ */
+template <class X>
+class FusedReduction
+{
+public:
+    using field_type = typename X::field_type;
+    using Pair = std::pair<const X*, const X*>;
+
+    //! \brief Sequential reductions.
+    FusedReduction() = default;
+
+    //! \brief Sequential reductions.
+    FusedReduction(const Dune::Amg::SequentialInformation&, Dune::SolverCategory::Category)
+    {
+    }
+
+    //! \brief Reductions over the entries owned by comm, if the category is
+    //!        overlapping, otherwise sequential reductions.
+    template <class Comm>
+    FusedReduction(const Comm& comm, Dune::SolverCategory::Category category)
+    {
+        if (category != Dune::SolverCategory::overlapping) {
+            return;
+        }
+        std::size_t size = 0;
+        for (const auto& ind : comm.indexSet()) {
+            size = std::max(size, ind.local().local() + 1);
+        }
+        // Entries which are not in the index set are owned, as in dune-istl.
+        mask_.assign(size, 1.0);
+        for (const auto& ind : comm.indexSet()) {
+            if (!Comm::OwnerSet::contains(ind.local().attribute())) {
+                mask_[ind.local().local()] = 0.0;
+            }
+        }
+#if HAVE_MPI
+        if (comm.communicator().size() > 1) {
+            mpiComm_ = comm.communicator();
+        }
+#endif
+    }
+
+    FusedReduction(const FusedReduction&) = delete;
+    FusedReduction& operator=(const FusedReduction&) = delete;
+
+    ~FusedReduction()
+    {
+#if HAVE_MPI
+        if (request_ != MPI_REQUEST_NULL) {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+        }
+#endif
+    }
+
+    /*!
+       \brief Start the reduction of the dot products (x, y) of the pairs.
+
+       The vectors must not change until finish() is called.
+     */
+    void start(std::initializer_list<Pair> pairs)
+    {
+        start(pairs.begin(), pairs.end());
+    }
+
+    template <class Iterator>
+    void start(Iterator begin, Iterator end)
+    {
+        sums_.assign(std::distance(begin, end), 0.0);
+        if (begin == end) {
+            return;
+        }
+        pairs_.assign(begin, end);
+        const std::size_t n = pairs_.front().first->size();
+        const std::size_t numPairs = pairs_.size();
+        for (const auto& pair : pairs_) {
+            assert(pair.first->size() == n && pair.second->size() == n);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const field_type weight = i < mask_.size() ? mask_[i] : field_type(1.0);
+            if (weight == 0.0) {
+                continue;
+            }
+            for (std::size_t p = 0; p < numPairs; ++p) {
+                sums_[p] += (*pairs_[p].first)[i].dot((*pairs_[p].second)[i]);
+            }
+        }
+#if HAVE_MPI
+        if (mpiComm_ != MPI_COMM_NULL) {
+            MPI_Iallreduce(MPI_IN_PLACE, sums_.data(), sums_.size(),
+                           Dune::MPITraits<field_type>::getType(),
+                           MPI_SUM, mpiComm_, &request_);
+        }
+#endif
+    }
+
+    //! \brief Wait for the reduction and return the dot products in the
+    //!        order of the pairs passed to start().
+    const std::vector<field_type>& finish()
+    {
+#if HAVE_MPI
+        if (request_ != MPI_REQUEST_NULL) {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+        }
+#endif
+        return sums_;
+    }
+
+private:
+    std::vector<field_type> mask_;
+    std::vector<field_type> sums_;
+    std::vector<Pair> pairs_;
+#if HAVE_MPI
+    MPI_Comm mpiComm_ = MPI_COMM_NULL;
+    MPI_Request request_ = MPI_REQUEST_NULL;
+#endif
+};
+
+} // namespace Opm
+
+#endif // OPM_FUSEDREDUCTION_HEADER_INCLUDED
@@ -0,0 +1,441 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GCRODRSOLVER_HEADER_INCLUDED
+#define OPM_GCRODRSOLVER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/*!
+   \brief Restarted flexible GMRES which keeps a recycled subspace between
+   the restart cycles and between calls to apply().
+
+   This is a GCRO-DR method in the spirit of Parks et al. The solver keeps
+   up to k pairs of vectors (u_i, c_i) with c_i = A u_i and C = [c_1 ... c_k]
+   having orthonormal columns. Every apply() first recomputes C for the
+   current operator and removes the components of the residual in the span
+   of C. The inner Krylov subspace of each restart cycle is built for the
+   operator (I - C C^T) A M^{-1}, so the directions in the span of C do not
+   have to be found again. At the end of a cycle the recycled subspace is
+   replaced by the k directions of [U Z], Z holding the preconditioned
+   Krylov vectors of the cycle, which are reduced least by the operator,
+   i.e. those belonging to the smallest singular values of the small
+   matrix G with A [U Z] = [C V] G. The singular value decomposition
+   of G is computed by the one-sided Jacobi method, see
+   updateRecycledSubspace_(). Unlike the harmonic Ritz vectors of the
+   original method, these are singular vectors, which do not need a
+   generalized eigenvalue solver and are real for nonsymmetric A.
+
+   As the Jacobians of consecutive Newton iterations and timesteps are
+   similar, the recycled directions approximate the slowly converging
+   modes of the next system as well. Recomputing C costs k operator
+   applications per call to apply().
+
+   The preconditioner is applied from the right and may change between
+   iterations, e.g. an AMG cycle with a Krylov coarse solver.
+ */
+template <class X>
+class GcroDrSolver : public Dune::IterativeSolver<X, X>
+{
+public:
+    using typename Dune::IterativeSolver<X, X>::domain_type;
+    using typename Dune::IterativeSolver<X, X>::range_type;
+    using typename Dune::IterativeSolver<X, X>::field_type;
+    using typename Dune::IterativeSolver<X, X>::real_type;
+    using typename Dune::IterativeSolver<X, X>::scalar_real_type;
+
+    /*!
+       \param restart The maximum dimension m of the inner Krylov subspaces
+       \param recycle The maximum number k of recycled vectors
+     */
+    GcroDrSolver(Dune::LinearOperator<X, X>& op,
+                Dune::ScalarProduct<X>& sp,
+                Dune::Preconditioner<X, X>& prec,
+                scalar_real_type reduction,
+                int restart,
+                int recycle,
+                int maxit,
+                int verbose)
+        : Dune::IterativeSolver<X, X>(op, sp, prec, reduction, maxit, verbose)
+        , restart_(restart)
+        , recycle_(recycle)
+    {
+    }
+
+    using Dune::IterativeSolver<X, X>::apply;
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        OPM_TIMEBLOCK(gcrodrApply);
+        Dune::Timer watch;
+        res.clear();
+
+        if (!u_.empty() && u_.front().size() != x.size()) {
+            u_.clear();
+            c_.clear();
+        }
+
+        this->_prec->pre(x, b);
+        this->_op->applyscaleadd(-1.0, x, b);
+        const real_type def0 = this->_sp->norm(b);
+        real_type def = def0;
+
+        if (this->_verbose > 0) {
+            std::cout << "=== " << name() << std::endl;
+            if (this->_verbose > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0, def0);
+            }
+        }
+
+        auto converged = [&def0, this](const real_type d)
+        {
+            return d < def0 * this->_reduction || d < real_type(1e-30);
+        };
+
+        if (!converged(def)) {
+            projectRecycledSubspace_(x, b);
+            def = this->_sp->norm(b);
+        }
+
+        int iterations = 0;
+        while (!converged(def) && iterations < this->_maxit) {
+            def = cycle_(x, b, iterations, def0, def);
+        }
+
+        this->_prec->post(x);
+
+        res.iterations = iterations;
+        res.reduction = def0 > 0.0 ? static_cast<double>(def / def0) : 0.0;
+        res.converged = converged(def);
+        res.conv_rate = iterations > 0 ? std::pow(res.reduction, 1.0 / iterations) : 0.0;
+        res.elapsed = watch.elapsed();
+
+        if (this->_verbose > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / std::max(1, iterations)
+                      << ", IT=" << iterations
+                      << ", recycled=" << u_.size() << std::endl;
+        }
+    }
+
+    //! \brief The current number of recycled vectors.
+    std::size_t recycledSize() const
+    {
+        return u_.size();
+    }
+
+    std::string name() const
+    {
+        return "GcroDrSolver";
+    }
+
+private:
+    // Recompute C = A U for the current operator, orthonormalize C by
+    // modified Gram-Schmidt applying the same transformation to U, and
+    // remove the components of the residual in the span of C.
+    void projectRecycledSubspace_(X& x, X& b)
+    {
+        std::size_t j = 0;
+        while (j < u_.size()) {
+            this->_op->apply(u_[j], c_[j]);
+            const real_type norm0 = this->_sp->norm(c_[j]);
+            for (std::size_t i = 0; i < j; ++i) {
+                const field_type r = this->_sp->dot(c_[i], c_[j]);
+                c_[j].axpy(-r, c_[i]);
+                u_[j].axpy(-r, u_[i]);
+            }
+            const real_type norm = this->_sp->norm(c_[j]);
+            if (!(norm > 1e-10 * norm0)) {
+                // linearly dependent on the previous vectors for this operator
+                u_.erase(u_.begin() + j);
+                c_.erase(c_.begin() + j);
+                continue;
+            }
+            c_[j] *= 1.0 / norm;
+            u_[j] *= 1.0 / norm;
+            const field_type alpha = this->_sp->dot(c_[j], b);
+            x.axpy(alpha, u_[j]);
+            b.axpy(-alpha, c_[j]);
+            ++j;
+        }
+    }
+
+    // One restart cycle. On entry b is the residual, orthogonal to C.
+    // Returns the norm of the new residual.
+    real_type cycle_(X& x, X& b, int& iterations, const real_type def0, const real_type def)
+    {
+        const int m = restart_;
+        const std::size_t k = c_.size();
+        v_.resize(m + 1, b);
+        z_.resize(m, x);
+
+        // H is the (m+1) x m Hessenberg matrix, stored by columns, R its
+        // triangularization by Givens rotations.
+        std::vector<field_type> H((m + 1) * m, 0.0);
+        std::vector<field_type> R((m + 1) * m, 0.0);
+        std::vector<field_type> B(k * m, 0.0);
+        std::vector<field_type> cs(m, 0.0);
+        std::vector<field_type> sn(m, 0.0);
+        std::vector<field_type> s(m + 1, 0.0);
+        auto h = [m](std::vector<field_type>& M, int i, int j) -> field_type&
+        { return M[j * (m + 1) + i]; };
+
+        const real_type beta = def;
+        v_[0] = b;
+        v_[0] *= 1.0 / beta;
+        s[0] = beta;
+
+        real_type resid = beta;
+        int j = 0;
+        while (j < m && iterations < this->_maxit) {
+            z_[j] = 0.0;
+            this->_prec->apply(z_[j], v_[j]);
+            X& w = v_[j + 1];
+            this->_op->apply(z_[j], w);
+            for (std::size_t i = 0; i < k; ++i) {
+                B[j * k + i] = this->_sp->dot(c_[i], w);
+                w.axpy(-B[j * k + i], c_[i]);
+            }
+            for (int i = 0; i <= j; ++i) {
+                h(H, i, j) = this->_sp->dot(v_[i], w);
+                w.axpy(-h(H, i, j), v_[i]);
+            }
+            h(H, j + 1, j) = this->_sp->norm(w);
+            const bool breakdown = !(std::abs(h(H, j + 1, j)) > 0.0);
+            if (!breakdown) {
+                w *= 1.0 / h(H, j + 1, j);
+            }
+
+            for (int i = 0; i <= j + 1; ++i) {
+                h(R, i, j) = h(H, i, j);
+            }
+            for (int i = 0; i < j; ++i) {
+                const field_type tmp = cs[i] * h(R, i, j) + sn[i] * h(R, i + 1, j);
+                h(R, i + 1, j) = -sn[i] * h(R, i, j) + cs[i] * h(R, i + 1, j);
+                h(R, i, j) = tmp;
+            }
+            const field_type a = h(R, j, j);
+            const field_type c = h(R, j + 1, j);
+            const field_type rho = std::sqrt(a * a + c * c);
+            cs[j] = rho > 0.0 ? a / rho : 1.0;
+            sn[j] = rho > 0.0 ? c / rho : 0.0;
+            h(R, j, j) = rho;
+            h(R, j + 1, j) = 0.0;
+            s[j + 1] = -sn[j] * s[j];
+            s[j] = cs[j] * s[j];
+
+            ++j;
+            ++iterations;
+            const real_type previous = resid;
+            resid = std::abs(s[j]);
+            if (this->_verbose > 1) {
+                this->printOutput(std::cout, iterations, resid, previous);
+            }
+            if (breakdown || resid < def0 * this->_reduction || resid < real_type(1e-30)) {
+                break;
+            }
+        }
+
+        // Solve R y = s by back substitution.
+        std::vector<field_type> y(j, 0.0);
+        for (int i = j - 1; i >= 0; --i) {
+            field_type sum = s[i];
+            for (int l = i + 1; l < j; ++l) {
+                sum -= h(R, i, l) * y[l];
+            }
+            y[i] = sum / h(R, i, i);
+        }
+
+        // The correction is d = Z y - U B y with A d = V H y, as A Z = C B + V H.
+        X d(x);
+        d = 0.0;
+        X Ad(b);
+        Ad = 0.0;
+        for (int l = 0; l < j; ++l) {
+            d.axpy(y[l], z_[l]);
+        }
+        for (std::size_t i = 0; i < k; ++i) {
+            field_type by = 0.0;
+            for (int l = 0; l < j; ++l) {
+                by += B[l * k + i] * y[l];
+            }
+            d.axpy(-by, u_[i]);
+        }
+        for (int i = 0; i <= j; ++i) {
+            field_type hy = 0.0;
+            for (int l = std::max(i - 1, 0); l < j; ++l) {
+                hy += h(H, i, l) * y[l];
+            }
+            Ad.axpy(hy, v_[i]);
+        }
+        x += d;
+        b -= Ad;
+
+        if (recycle_ > 0) {
+            updateRecycledSubspace_(j, H, B);
+        }
+
+        return this->_sp->norm(b);
+    }
+
+    // Replace U and C by the directions of [U Z] which are reduced least by
+    // the operator. With G = [I B; 0 H] it holds A [U Z] = [C V] G, where
+    // [C V] has orthonormal columns. The one-sided Jacobi method computes
+    // the singular value decomposition G D^{-1} P = W diag(sigma) with the
+    // column norms D of [U Z] and orthonormal W. The k smallest singular
+    // values give the new vectors u = [U Z] D^{-1} p / sigma and c = [C V] w,
+    // so C keeps orthonormal columns. The new residual is orthogonal to the
+    // range of G, hence to the new C.
+    void updateRecycledSubspace_(const int j,
+                                 const std::vector<field_type>& H,
+                                 const std::vector<field_type>& B)
+    {
+        const int m = restart_;
+        const int k = c_.size();
+        const int n = k + j;
+        const int rows = n + 1;
+        std::vector<field_type> G(rows * n, 0.0);
+        std::vector<field_type> P(n * n, 0.0);
+        auto g = [rows](std::vector<field_type>& M, int i, int l) -> field_type&
+        { return M[l * rows + i]; };
+        for (int i = 0; i < k; ++i) {
+            g(G, i, i) = 1.0;
+            for (int l = 0; l < j; ++l) {
+                g(G, i, k + l) = B[l * k + i];
+            }
+        }
+        for (int l = 0; l < j; ++l) {
+            for (int i = 0; i <= l + 1; ++i) {
+                g(G, k + i, k + l) = H[l * (m + 1) + i];
+            }
+        }
+        // Scale the columns by the norms of the vectors of [U Z], such that
+        // the singular values approximate |A x| / |x|.
+        std::vector<field_type> scale(n);
+        for (int l = 0; l < n; ++l) {
+            scale[l] = this->_sp->norm(l < k ? u_[l] : z_[l - k]);
+            for (int i = 0; i < rows; ++i) {
+                g(G, i, l) /= scale[l];
+            }
+            P[l * n + l] = 1.0;
+        }
+
+        for (int sweep = 0; sweep < 30; ++sweep) {
+            bool rotated = false;
+            for (int p = 0; p < n; ++p) {
+                for (int q = p + 1; q < n; ++q) {
+                    field_type alpha = 0.0;
+                    field_type beta = 0.0;
+                    field_type gamma = 0.0;
+                    for (int i = 0; i < rows; ++i) {
+                        alpha += g(G, i, p) * g(G, i, p);
+                        beta += g(G, i, q) * g(G, i, q);
+                        gamma += g(G, i, p) * g(G, i, q);
+                    }
+                    if (!(std::abs(gamma) > 1e-14 * std::sqrt(alpha * beta))) {
+                        continue;
+                    }
+                    rotated = true;
+                    const field_type zeta = (beta - alpha) / (2.0 * gamma);
+                    const field_type t = (zeta >= 0.0 ? 1.0 : -1.0)
+                        / (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                    const field_type cs = 1.0 / std::sqrt(1.0 + t * t);
+                    const field_type sn = cs * t;
+                    for (int i = 0; i < rows; ++i) {
+                        const field_type gp = g(G, i, p);
+                        g(G, i, p) = cs * gp - sn * g(G, i, q);
+                        g(G, i, q) = sn * gp + cs * g(G, i, q);
+                    }
+                    for (int i = 0; i < n; ++i) {
+                        const field_type pp = P[p * n + i];
+                        P[p * n + i] = cs * pp - sn * P[q * n + i];
+                        P[q * n + i] = sn * pp + cs * P[q * n + i];
+                    }
+                }
+            }
+            if (!rotated) {
+                break;
+            }
+        }
+
+        std::vector<field_type> sigma(n, 0.0);
+        for (int l = 0; l < n; ++l) {
+            for (int i = 0; i < rows; ++i) {
+                sigma[l] += g(G, i, l) * g(G, i, l);
+            }
+            sigma[l] = std::sqrt(sigma[l]);
+        }
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&sigma](const int a, const int b) { return sigma[a] < sigma[b]; });
+        const field_type sigmaMax = sigma[order.back()];
+
+        std::vector<X> u;
+        std::vector<X> c;
+        for (int l : order) {
+            if (static_cast<int>(u.size()) == recycle_) {
+                break;
+            }
+            if (!(sigma[l] > 1e-12 * sigmaMax)) {
+                continue;
+            }
+            X& ul = u.emplace_back(z_[0]);
+            X& cl = c.emplace_back(v_[0]);
+            ul = 0.0;
+            cl = 0.0;
+            for (int i = 0; i < n; ++i) {
+                const field_type coeff = P[l * n + i] / (scale[i] * sigma[l]);
+                ul.axpy(coeff, i < k ? u_[i] : z_[i - k]);
+            }
+            for (int i = 0; i < rows; ++i) {
+                const field_type coeff = g(G, i, l) / sigma[l];
+                cl.axpy(coeff, i < k ? c_[i] : v_[i - k]);
+            }
+        }
+        u_ = std::move(u);
+        c_ = std::move(c);
+    }
+
+    int restart_;
+    int recycle_;
+    std::vector<X> u_;
+    std::vector<X> c_;
+    std::vector<X> v_;
+    std::vector<X> z_;
+};
+
+} // namespace Opm
+
+#endif // OPM_GCRODRSOLVER_HEADER_INCLUDED
@@ -223,6 +223,138 @@ reorderVerticesSpheres(const std::vector<int>& colors,
     return indices;
 }
 
+namespace Detail {
+/// \brief Breadth first search from root over the vertices below noVertices
+///        which are not numbered yet.
+/// \return The number of levels and a vertex of minimal degree in the last level.
+template <class Graph>
+std::tuple<std::size_t, typename Graph::VertexDescriptor>
+lastLevelMinDegree(const Graph& graph,
+                   typename Graph::VertexDescriptor root,
+                   std::size_t noVertices,
+                   const std::vector<std::size_t>& degrees,
+                   const std::vector<bool>& numbered,
+                   std::vector<std::size_t>& depth)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    std::vector<Vertex> visited{root};
+    depth[root] = 0;
+    std::size_t levelStart = 0;
+    for (std::size_t current = 0; current < visited.size(); ++current) {
+        const Vertex vertex = visited[current];
+        if (depth[vertex] > depth[visited[levelStart]]) {
+            levelStart = current;
+        }
+        for (auto edge = graph.beginEdges(vertex),
+                  endEdge = graph.endEdges(vertex); edge != endEdge; ++edge) {
+            const auto target = edge.target();
+            if (static_cast<std::size_t>(target) < noVertices && !numbered[target]
+                && depth[target] == std::numeric_limits<std::size_t>::max()) {
+                depth[target] = depth[vertex] + 1;
+                visited.push_back(target);
+            }
+        }
+    }
+    const auto last = *std::min_element(visited.begin() + levelStart, visited.end(),
+                                        [&degrees](const Vertex& v1, const Vertex& v2)
+                                        { return degrees[v1] < degrees[v2]; });
+    const std::size_t noLevels = depth[visited.back()] + 1;
+    for (const auto vertex : visited) {
+        depth[vertex] = std::numeric_limits<std::size_t>::max();
+    }
+    return std::make_tuple(noLevels, last);
+}
+} // end namespace Detail
+
+/// \brief Reorder the vertices by the reverse Cuthill-McKee algorithm.
+///
+/// Each connected component is numbered breadth first starting at a
+/// pseudo-peripheral vertex, visiting the neighbours by ascending degree,
+/// and the resulting numbering is reversed. This reduces the bandwidth of
+/// a matrix stored in the new ordering.
+/// Only the vertices with index below noVertices are reordered, the others
+/// keep their index, such that the ghost rows can stay at the end.
+/// \param graph The graph to reorder. Must adhere to the graph interface of dune-istl.
+/// \param noVertices The number of leading vertices to reorder.
+/// \return The new index of each vertex.
+template <class Graph>
+std::vector<std::size_t>
+reorderVerticesRCM(const Graph& graph, std::size_t noVertices)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    const std::size_t noAllVertices = graph.maxVertex() + 1;
+    noVertices = std::min(noVertices, noAllVertices);
+
+    std::vector<std::size_t> degrees(noVertices, 0);
+    for (std::size_t vertex = 0; vertex < noVertices; ++vertex) {
+        for (auto edge = graph.beginEdges(vertex),
+                  endEdge = graph.endEdges(vertex); edge != endEdge; ++edge) {
+            const auto target = static_cast<std::size_t>(edge.target());
+            if (target < noVertices && target != vertex) {
+                ++degrees[vertex];
+            }
+        }
+    }
+    // Candidates for the roots of the components by ascending degree.
+    std::vector<Vertex> roots(noVertices);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::stable_sort(roots.begin(), roots.end(),
+                     [&degrees](const Vertex& v1, const Vertex& v2)
+                     { return degrees[v1] < degrees[v2]; });
+
+    std::vector<bool> numbered(noVertices, false);
+    std::vector<std::size_t> depth(noVertices, std::numeric_limits<std::size_t>::max());
+    std::vector<Vertex> order;
+    order.reserve(noVertices);
+    std::vector<Vertex> neighbours;
+    auto nextRoot = roots.begin();
+
+    while (order.size() < noVertices) {
+        while (numbered[*nextRoot]) {
+            ++nextRoot;
+        }
+        // Move the root towards the periphery of its component.
+        Vertex root = *nextRoot;
+        auto [noLevels, candidate] = Detail::lastLevelMinDegree(graph, root, noVertices,
+                                                                degrees, numbered, depth);
+        while (true) {
+            const auto [candidateLevels, next] = Detail::lastLevelMinDegree(graph, candidate, noVertices,
+                                                                            degrees, numbered, depth);
+            if (candidateLevels <= noLevels) {
+                break;
+            }
+            root = candidate;
+            noLevels = candidateLevels;
+            candidate = next;
+        }
+
+        numbered[root] = true;
+        order.push_back(root);
+        for (std::size_t current = order.size() - 1; current < order.size(); ++current) {
+            neighbours.clear();
+            for (auto edge = graph.beginEdges(order[current]),
+                      endEdge = graph.endEdges(order[current]); edge != endEdge; ++edge) {
+                const auto target = edge.target();
+                if (static_cast<std::size_t>(target) < noVertices && !numbered[target]) {
+                    numbered[target] = true;
+                    neighbours.push_back(target);
+                }
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(),
+                             [&degrees](const Vertex& v1, const Vertex& v2)
+                             { return degrees[v1] < degrees[v2]; });
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    std::vector<std::size_t> indices(noAllVertices);
+    std::iota(indices.begin() + noVertices, indices.end(), noVertices);
+    for (std::size_t i = 0; i < noVertices; ++i) {
+        indices[order[i]] = noVertices - 1 - i;
+    }
+    return indices;
+}
+
 /// \brief Specify coloring type.
 /// \details The coloring types have been implemented initially to parallelize DILU
 ///          preconditioner and parallel sparse triangular solves.
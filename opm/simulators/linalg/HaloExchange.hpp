@@ -0,0 +1,188 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HALOEXCHANGE_HEADER_INCLUDED
+#define OPM_HALOEXCHANGE_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+
+#if HAVE_MPI
+#include <dune/common/enumset.hh>
+#include <dune/common/parallel/interface.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+
+/*!
+   \brief Nonblocking copy of the owned entries of a vector to the copies
+   of these entries on the other processes.
+
+   This does the same as copyOwnerToAll of Dune::OwnerOverlapCopyCommunication,
+   but split into start() and finish(), such that computations which do
+   not read the overlap entries can run while the messages are in flight.
+   The send and receive lists are computed once from the remote indices
+   of the communication object.
+
+   Only one exchange can be pending at a time. The vector passed to
+   start() must neither be destroyed nor resized before finish() is
+   called, and its overlap entries must not be read in between.
+   Without MPI or on a single process all operations are no-ops.
+
+   \tparam X The vector type (a Dune::BlockVector)
+ */
+template <class X>
+class HaloExchange
+{
+public:
+    using block_type = typename X::block_type;
+
+    //! \brief Set up the exchange for the owner to all interface of comm,
+    //!        whose remote indices must be up to date.
+    template <class Comm>
+    explicit HaloExchange([[maybe_unused]] const Comm& comm)
+    {
+#if HAVE_MPI
+        if (comm.communicator().size() < 2) {
+            return;
+        }
+        using AttributeSet = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+        Dune::Interface interface;
+        interface.build(comm.remoteIndices(),
+                        Dune::EnumItem<AttributeSet, Dune::OwnerOverlapCopyAttributeSet::owner>(),
+                        Dune::AllSet<AttributeSet>());
+        for (const auto& [rank, info] : interface.interfaces()) {
+            Neighbor& neighbor = neighbors_.emplace_back();
+            neighbor.rank = rank;
+            for (std::size_t i = 0; i < info.first.size(); ++i) {
+                neighbor.sendIndices.push_back(info.first[i]);
+            }
+            for (std::size_t i = 0; i < info.second.size(); ++i) {
+                neighbor.recvIndices.push_back(info.second[i]);
+            }
+            neighbor.sendBuffer.resize(neighbor.sendIndices.size());
+            neighbor.recvBuffer.resize(neighbor.recvIndices.size());
+        }
+        mpiComm_ = comm.communicator();
+#endif
+    }
+
+    HaloExchange(const HaloExchange&) = delete;
+    HaloExchange& operator=(const HaloExchange&) = delete;
+
+    ~HaloExchange()
+    {
+#if HAVE_MPI
+        if (!requests_.empty()) {
+            MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+        }
+#endif
+    }
+
+    //! \brief Post the messages which update the overlap entries of x,
+    //!        after finishing a pending exchange.
+    void start([[maybe_unused]] X& x)
+    {
+        finish();
+#if HAVE_MPI
+        if (neighbors_.empty()) {
+            return;
+        }
+        OPM_TIMEBLOCK(haloExchangeStart);
+        requests_.clear();
+        for (auto& neighbor : neighbors_) {
+            MPI_Request& request = requests_.emplace_back();
+            MPI_Irecv(neighbor.recvBuffer.data(), neighbor.recvBuffer.size() * sizeof(block_type),
+                      MPI_BYTE, neighbor.rank, tag, mpiComm_, &request);
+        }
+        for (auto& neighbor : neighbors_) {
+            for (std::size_t i = 0; i < neighbor.sendIndices.size(); ++i) {
+                neighbor.sendBuffer[i] = x[neighbor.sendIndices[i]];
+            }
+            MPI_Request& request = requests_.emplace_back();
+            MPI_Isend(neighbor.sendBuffer.data(), neighbor.sendBuffer.size() * sizeof(block_type),
+                      MPI_BYTE, neighbor.rank, tag, mpiComm_, &request);
+        }
+        pending_ = &x;
+#endif
+    }
+
+    //! \brief Wait for the pending exchange, if any, and store the
+    //!        received values in the overlap entries.
+    void finish()
+    {
+#if HAVE_MPI
+        if (!pending_) {
+            return;
+        }
+        OPM_TIMEBLOCK(haloExchangeFinish);
+        MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+        requests_.clear();
+        for (const auto& neighbor : neighbors_) {
+            for (std::size_t i = 0; i < neighbor.recvIndices.size(); ++i) {
+                (*pending_)[neighbor.recvIndices[i]] = neighbor.recvBuffer[i];
+            }
+        }
+        pending_ = nullptr;
+#endif
+    }
+
+    //! \brief Returns true if the exchange of x is started but not finished.
+    bool isPending(const X& x) const
+    {
+        return pending_ == &x;
+    }
+
+    //! \brief Returns true if there is nothing to exchange.
+    bool empty() const
+    {
+#if HAVE_MPI
+        return neighbors_.empty();
+#else
+        return true;
+#endif
+    }
+
+private:
+    X* pending_ = nullptr;
+#if HAVE_MPI
+    // Differs from the tag of the buffered communicator of dune-common.
+    static constexpr int tag = 517;
+
+    struct Neighbor
+    {
+        int rank;
+        std::vector<std::size_t> sendIndices;
+        std::vector<std::size_t> recvIndices;
+        std::vector<block_type> sendBuffer;
+        std::vector<block_type> recvBuffer;
+    };
+
+    std::vector<Neighbor> neighbors_;
+    std::vector<MPI_Request> requests_;
+    MPI_Comm mpiComm_ = MPI_COMM_NULL;
+#endif
+};
+
+} // namespace Opm
+
+#endif // OPM_HALOEXCHANGE_HEADER_INCLUDED
@@ -29,6 +29,7 @@
 #include <opm/common/ErrorMacros.hpp>
 
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
 
 #include <array>
 
@@ -71,85 +72,99 @@ namespace detail
 {
 
 template<class M>
-void milu0_decomposition(M& A, FieldFunct<M> absFunctor, FieldFunct<M> signFunctor,
-                         std::vector<typename M::block_type>* diagonal)
+void milu0_decompose_row(M& A, std::size_t i, const FieldFunct<M>& absFunctor,
+                         const FieldFunct<M>& signFunctor,
+                         typename M::block_type* diagonal)
 {
-    if( diagonal )
-    {
-        diagonal->reserve(A.N());
-    }
-
-    for ( auto irow = A.begin(), iend = A.end(); irow != iend; ++irow)
-    {
-        auto a_i_end = irow->end();
-        auto a_ik    = irow->begin();
+    auto irow    = A.begin() + i;
+    auto a_i_end = irow->end();
+    auto a_ik    = irow->begin();
 
-        std::array<typename M::field_type, M::block_type::rows> sum_dropped{};
+    std::array<typename M::field_type, M::block_type::rows> sum_dropped{};
 
-        // Eliminate entries in lower triangular matrix
-        // and store factors for L
-        for ( ; a_ik.index() < irow.index(); ++a_ik )
+    // Eliminate entries in lower triangular matrix
+    // and store factors for L
+    for ( ; a_ik.index() < irow.index(); ++a_ik )
+    {
+        auto k = a_ik.index();
+        auto a_kk = A[k].find(k);
+        // L_ik = A_ik * A_kk^-1
+        rightMultiplyBlock(*a_ik, *a_kk);
+
+        // modify the rest of the row, everything right of a_ik
+        // a_i* -=a_ik * a_k*
+        auto a_k_end = A[k].end();
+        auto a_kj = a_kk, a_ij = a_ik;
+        ++a_kj; ++a_ij;
+
+        while ( a_kj != a_k_end)
         {
-            auto k = a_ik.index();
-            auto a_kk = A[k].find(k);
-            // L_ik = A_kk^-1 * A_ik
-            a_ik->rightmultiply(*a_kk);
-
-            // modify the rest of the row, everything right of a_ik
-            // a_i* -=a_ik * a_k*
-            auto a_k_end = A[k].end();
-            auto a_kj = a_kk, a_ij = a_ik;
-            ++a_kj; ++a_ij;
-
-            while ( a_kj != a_k_end)
-            {
-                auto modifier = *a_kj;
-                modifier.leftmultiply(*a_ik);
+            auto modifier = *a_kj;
+            modifier.leftmultiply(*a_ik);
 
-                while( a_ij != a_i_end && a_ij.index() < a_kj.index())
-                {
-                    ++a_ij;
-                }
+            while( a_ij != a_i_end && a_ij.index() < a_kj.index())
+            {
+                ++a_ij;
+            }
 
-                if ( a_ij != a_i_end && a_ij.index() == a_kj.index() )
-                {
-                    // Value is not dropped
-                    *a_ij -= modifier;
-                    ++a_ij; ++a_kj;
-                }
-                else
+            if ( a_ij != a_i_end && a_ij.index() == a_kj.index() )
+            {
+                // Value is not dropped
+                *a_ij -= modifier;
+                ++a_ij; ++a_kj;
+            }
+            else
+            {
+                auto entry = sum_dropped.begin();
+                for( const auto& row: modifier )
                 {
-                    auto entry = sum_dropped.begin();
-                    for( const auto& row: modifier )
+                    for( const auto& colEntry: row )
                     {
-                        for( const auto& colEntry: row )
-                        {
-                            *entry += absFunctor(-colEntry);
-                        }
-                        ++entry;
+                        *entry += absFunctor(-colEntry);
                     }
-                    ++a_kj;
+                    ++entry;
                 }
+                ++a_kj;
             }
         }
+    }
 
-        if ( a_ik.index() != irow.index() )
-            OPM_THROW(std::logic_error,
-                      "Matrix is missing diagonal for row " + std::to_string(irow.index()));
+    if ( a_ik.index() != irow.index() )
+        OPM_THROW(std::logic_error,
+                  "Matrix is missing diagonal for row " + std::to_string(irow.index()));
 
-        int index = 0;
-        for(const auto& entry: sum_dropped)
-        {
-            auto& bdiag = (*a_ik)[index][index];
-            bdiag += signFunctor(bdiag) * entry;
-            ++index;
-        }
+    int index = 0;
+    for(const auto& entry: sum_dropped)
+    {
+        auto& bdiag = (*a_ik)[index][index];
+        bdiag += signFunctor(bdiag) * entry;
+        ++index;
+    }
+
+    if ( diagonal )
+    {
+        *diagonal = *a_ik;
+    }
+    a_ik->invert();   // compute inverse of diagonal block
+}
 
+template<class M>
+void milu0_decomposition(M& A, FieldFunct<M> absFunctor, FieldFunct<M> signFunctor,
+                         std::vector<typename M::block_type>* diagonal)
+{
+    if( diagonal )
+    {
+        diagonal->reserve(A.N());
+    }
+
+    for ( std::size_t i = 0, iend = A.N(); i != iend; ++i)
+    {
+        typename M::block_type* diag = nullptr;
         if ( diagonal )
         {
-            diagonal->push_back(*a_ik);
+            diag = &diagonal->emplace_back();
         }
-        a_ik->invert();   // compute inverse of diagonal block
+        milu0_decompose_row(A, i, absFunctor, signFunctor, diag);
     }
 }
 
@@ -254,7 +269,10 @@ void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
 #define INSTANTIATE(T, ...)                                               \
     template void milu0_decomposition<__VA_ARGS__>                        \
     (__VA_ARGS__&,std::function<T(const T&)>, std::function<T(const T&)>, \
-    std::vector<typename __VA_ARGS__::block_type>*);
+    std::vector<typename __VA_ARGS__::block_type>*);                      \
+    template void milu0_decompose_row<__VA_ARGS__>                        \
+    (__VA_ARGS__&, std::size_t, const std::function<T(const T&)>&,        \
+    const std::function<T(const T&)>&, typename __VA_ARGS__::block_type*);
 
 #define INSTANTIATE_ILUN(...)                                                \
     template void milun_decomposition(const __VA_ARGS__&, int, MILU_VARIANT, \
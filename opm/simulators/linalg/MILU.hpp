@@ -101,6 +101,17 @@ void milu0_decomposition(M& A, FieldFunct<M> absFunctor = signFunctor<typename M
                          FieldFunct<M> signFunctor = oneFunctor<typename M::field_type>,
                          std::vector<typename M::block_type>* diagonal = nullptr);
 
+/// \brief Compute row i of the MILU0 decomposition in place.
+///
+/// Only row i is written, rows k < i it depends on must already be
+/// decomposed. Hence rows without dependencies among each other may be
+/// processed concurrently. If diagonal is not null, the modified diagonal
+/// block is stored there before it is inverted.
+template <typename M>
+void milu0_decompose_row(M& A, std::size_t i, const FieldFunct<M>& absFunctor,
+                         const FieldFunct<M>& signFunctor,
+                         typename M::block_type* diagonal = nullptr);
+
 template<class M>
 void  milu0_decomposition(M& A, std::vector<typename M::block_type>* diagonal)
 {
@@ -0,0 +1,247 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
+#define OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace Opm
+{
+
+namespace detail
+{
+
+//! \brief The type T with float as field type.
+template <class T>
+struct ToFloat
+{
+    using type = float;
+};
+
+template <class K, int n, int m>
+struct ToFloat<Dune::FieldMatrix<K, n, m>>
+{
+    using type = Dune::FieldMatrix<float, n, m>;
+};
+
+template <class K, int n, int m>
+struct ToFloat<MatrixBlock<K, n, m>>
+{
+    using type = MatrixBlock<float, n, m>;
+};
+
+template <class K, int n>
+struct ToFloat<Dune::FieldVector<K, n>>
+{
+    using type = Dune::FieldVector<float, n>;
+};
+
+template <class B, class A>
+struct ToFloat<Dune::BCRSMatrix<B, A>>
+{
+    using type = Dune::BCRSMatrix<typename ToFloat<B>::type>;
+};
+
+template <class B, class A>
+struct ToFloat<Dune::BlockVector<B, A>>
+{
+    using type = Dune::BlockVector<typename ToFloat<B>::type>;
+};
+
+//! \brief Copy the entries of a block vector to one of another field type.
+template <class VectorFrom, class VectorTo>
+void convertVector(const VectorFrom& from, VectorTo& to)
+{
+    using FieldTo = typename VectorTo::field_type;
+    to.resize(from.size());
+    const int size = from.size();
+#if HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < size; ++i) {
+        for (std::size_t k = 0; k < from[i].size(); ++k) {
+            to[i][k] = static_cast<FieldTo>(from[i][k]);
+        }
+    }
+}
+
+} // namespace detail
+
+/*!
+   \brief Preconditioner for a double precision solver which stores the
+   matrix and the preconditioner in single precision.
+
+   The preconditioners used in the linear solvers are limited by memory
+   bandwidth, storing the matrix, the factorizations or the AMG hierarchy
+   in float halves the number of bytes read per application. The Krylov
+   solver, the operator and the residuals stay in double precision, only
+   the vectors passed to the preconditioner are converted.
+
+   The float copy of the matrix has the sparsity pattern of the original
+   matrix, the pattern must not change for the lifetime of the object. On
+   update() the values are copied and the underlying preconditioner is
+   updated.
+
+   \tparam MatrixD The double precision matrix type
+   \tparam VectorD The double precision vector type
+   \tparam OperatorF The float linear operator the underlying preconditioner
+                     is created for
+ */
+template <class MatrixD, class VectorD, class OperatorF>
+class MixedPrecisionPreconditioner : public Dune::PreconditionerWithUpdate<VectorD, VectorD>
+{
+public:
+    using matrix_type = MatrixD;
+    using domain_type = VectorD;
+    using range_type = VectorD;
+    using field_type = typename VectorD::field_type;
+
+    using MatrixF = typename OperatorF::matrix_type;
+    using VectorF = typename OperatorF::domain_type;
+    using PreconditionerF = Dune::PreconditionerWithUpdate<VectorF, VectorF>;
+
+    /*!
+       \brief Create the float copy of A and the underlying preconditioner.
+
+       \param createOperator Returns a std::unique_ptr<OperatorF> for the
+                             float matrix.
+       \param createPreconditioner Returns a std::shared_ptr<PreconditionerF>
+                                   for the float operator.
+     */
+    template <class OperatorCreator, class PreconditionerCreator>
+    MixedPrecisionPreconditioner(const MatrixD& A,
+                                 OperatorCreator&& createOperator,
+                                 PreconditionerCreator&& createPreconditioner)
+        : A_(A)
+        , matrixF_(createMatrix_(A))
+        , operatorF_(createOperator(matrixF_))
+        , preconditionerF_(createPreconditioner(*operatorF_))
+    {
+    }
+
+    MixedPrecisionPreconditioner(const MixedPrecisionPreconditioner&) = delete;
+    MixedPrecisionPreconditioner& operator=(const MixedPrecisionPreconditioner&) = delete;
+
+    // The modifications of x and b done by the underlying preconditioner
+    // (e.g. AMG for isolated rows) are not copied back, as they would
+    // truncate the double precision vectors.
+    void pre(VectorD& x, VectorD& b) override
+    {
+        detail::convertVector(x, vF_);
+        detail::convertVector(b, dF_);
+        preconditionerF_->pre(vF_, dF_);
+    }
+
+    void apply(VectorD& v, const VectorD& d) override
+    {
+        OPM_TIMEBLOCK(mixedPrecisionApply);
+        detail::convertVector(d, dF_);
+        vF_.resize(dF_.size());
+        vF_ = 0.0;
+        preconditionerF_->apply(vF_, dF_);
+        detail::convertVector(vF_, v);
+    }
+
+    void post(VectorD& x) override
+    {
+        detail::convertVector(x, vF_);
+        preconditionerF_->post(vF_);
+    }
+
+    void update() override
+    {
+        OPM_TIMEBLOCK(mixedPrecisionUpdate);
+        copyValues_(A_, matrixF_);
+        preconditionerF_->update();
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return preconditionerF_->category();
+    }
+
+    bool hasPerfectUpdate() const override
+    {
+        return preconditionerF_->hasPerfectUpdate();
+    }
+
+    //! \brief The single precision copy of the matrix.
+    const MatrixF& floatMatrix() const
+    {
+        return matrixF_;
+    }
+
+private:
+    static MatrixF createMatrix_(const MatrixD& A)
+    {
+        MatrixF matrixF(A.N(), A.M(), A.nonzeroes(), MatrixF::row_wise);
+        auto rowIn = A.begin();
+        for (auto rowOut = matrixF.createbegin(); rowOut != matrixF.createend(); ++rowOut, ++rowIn) {
+            for (auto col = rowIn->begin(); col != rowIn->end(); ++col) {
+                rowOut.insert(col.index());
+            }
+        }
+        copyValues_(A, matrixF);
+        return matrixF;
+    }
+
+    static void copyValues_(const MatrixD& A, MatrixF& matrixF)
+    {
+        using BlockF = typename MatrixF::block_type;
+        const int numRows = A.N();
+#if HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            auto colOut = matrixF[row].begin();
+            for (auto col = A[row].begin(); col != A[row].end(); ++col, ++colOut) {
+                for (int i = 0; i < BlockF::rows; ++i) {
+                    for (int j = 0; j < BlockF::cols; ++j) {
+                        (*colOut)[i][j] = static_cast<typename MatrixF::field_type>((*col)[i][j]);
+                    }
+                }
+            }
+        }
+    }
+
+    const MatrixD& A_;
+    MatrixF matrixF_;
+    std::unique_ptr<OperatorF> operatorF_;
+    std::shared_ptr<PreconditionerF> preconditionerF_;
+    VectorF vF_;
+    VectorF dF_;
+};
+
+} // namespace Opm
+
+#endif // OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
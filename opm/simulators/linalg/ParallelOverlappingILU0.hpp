@@ -20,13 +20,17 @@
 #ifndef OPM_PARALLELOVERLAPPINGILU0_HEADER_INCLUDED
 #define OPM_PARALLELOVERLAPPINGILU0_HEADER_INCLUDED
 #include <opm/common/TimingMacros.hpp>
+#include <opm/grid/utility/SparseTable.hpp>
+#include <opm/simulators/linalg/HaloExchange.hpp>
 #include <opm/simulators/linalg/MILU.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
 #include <dune/istl/paamg/smoother.hh>
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include <type_traits>
+#include <utility>
 
 namespace Opm
 {
@@ -120,6 +124,10 @@ namespace Opm
 /// make sure that x is consistent.
 /// In contrast for ParallelRestrictedOverlappingSchwarz we solve (LU)x = d for x
 /// without forcing consistency between the two steps.
+/// If more than one OpenMP thread is available, the rows are grouped into
+/// level sets once per sparsity pattern, and the (M)ILU0 decomposition and
+/// the triangular solves process the rows of each level concurrently. The
+/// fill-in of ILU(n) is still computed sequentially.
 /// \tparam Matrix The type of the Matrix.
 /// \tparam Domain The type of the Vector representing the domain.
 /// \tparam Range The type of the Vector representing the range.
@@ -216,11 +224,16 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm If true and redblack is false, the interior rows are ordered
+                         by reverse Cuthill-McKee to reduce the bandwidth of the factors.
+                         Only the factors are stored in this ordering, the vectors
+                         are permuted in each apply().
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor gets all parameters to operate the prec.
       \param A The matrix to operate on.
@@ -233,11 +246,16 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm If true and redblack is false, the interior rows are ordered
+                         by reverse Cuthill-McKee to reduce the bandwidth of the factors.
+                         Only the factors are stored in this ordering, the vectors
+                         are permuted in each apply().
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -250,11 +268,16 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param reorder_rcm If true and redblack is false, the interior rows are ordered
+                         by reverse Cuthill-McKee to reduce the bandwidth of the factors.
+                         Only the factors are stored in this ordering, the vectors
+                         are permuted in each apply().
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const field_type w, MILU_VARIANT milu,
                              bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -268,11 +291,16 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm If true and redblack is false, the interior rows are ordered
+                         by reverse Cuthill-McKee to reduce the bandwidth of the factors.
+                         Only the factors are stored in this ordering, the vectors
+                         are permuted in each apply().
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -287,12 +315,17 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm If true and redblack is false, the interior rows are ordered
+                         by reverse Cuthill-McKee to reduce the bandwidth of the factors.
+                         Only the factors are stored in this ordering, the vectors
+                         are permuted in each apply().
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm,
                              const field_type w, MILU_VARIANT milu,
                              size_type interiorSize, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*!
       \brief Prepare the preconditioner.
@@ -312,6 +345,18 @@ public:
     template <class V>
     void copyOwnerToAll( V& v ) const;
 
+    /*!
+      \brief Only start the update of the overlap entries at the end of
+      apply() with the given exchange instead of waiting for it.
+
+      The operator applied to the result next must finish the exchange,
+      see GhostLastMatrixAdapter::setHaloExchange().
+    */
+    void setHaloExchange(std::shared_ptr<HaloExchange<Domain>> haloExchange)
+    {
+        haloExchange_ = std::move(haloExchange);
+    }
+
     /*!
       \brief Clean up.
 
@@ -331,6 +376,14 @@ protected:
 
     void reorderBack(const Range& reorderedV, Range& v);
 
+    /// \brief Compute the level sets of ILU_ for the lower and upper
+    ///        triangular solves, unless already done.
+    void computeLevelSets();
+
+    /// \brief Compute the (M)ILU0 decomposition of ILU_ level by level
+    ///        with OpenMP threads.
+    void levelScheduledDecomposition();
+
     //! \brief The ILU0 decomposition of the matrix.
     std::unique_ptr<Matrix> ILU_;
     CRS lower_;
@@ -344,6 +397,8 @@ protected:
     Domain reorderedV_;
 
     const ParallelInfo* comm_;
+    //! \brief Nonblocking exchange used instead of copyOwnerToAll, if set.
+    std::shared_ptr<HaloExchange<Domain>> haloExchange_;
     //! \brief The relaxation factor to use.
     const field_type w_;
     const bool relaxation_;
@@ -353,6 +408,15 @@ protected:
     MILU_VARIANT milu_;
     bool redBlack_;
     bool reorderSphere_;
+    bool reorderRCM_;
+    //! \brief Whether the decomposition and the triangular solves are
+    //!        level scheduled over OpenMP threads.
+    bool useMultithreading_{false};
+    //! \brief Rows of ILU_ grouped by level for the lower triangular part.
+    //!        Rows of a level only depend on rows of lower levels.
+    SparseTable<std::size_t> lowerLevelSets_;
+    //! \brief Rows of ILU_ grouped by level for the upper triangular part.
+    SparseTable<std::size_t> upperLevelSets_;
 };
 
 } // end namespace Opm
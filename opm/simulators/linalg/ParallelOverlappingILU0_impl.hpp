@@ -30,66 +30,118 @@
 
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
+
+#include <exception>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
 
 namespace Opm
 {
 namespace detail
 {
 
-//! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
+//! Compute row i of the blocked ILU0 decomposition of A in place.
+//! Rows j < i that row i depends on must already be decomposed.
 template<class M>
-void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
+void bilu0_decompose_row (M& A, typename M::size_type i)
 {
     // iterator types
-    using rowiterator = typename M::RowIterator;
     using coliterator = typename M::ColIterator;
-    using block = typename M::block_type;
 
     // implement left looking variant with stored inverse
-    for (rowiterator i = A.begin(); i.index() < interiorSize; ++i)
+    auto& row = A[i];
+    // coliterator is diagonal after the following loop
+    coliterator endij=row.end();           // end of row i
+    coliterator ij;
+
+    // eliminate entries left of diagonal; store L factor
+    for (ij=row.begin(); ij.index()<i; ++ij)
     {
-        // coliterator is diagonal after the following loop
-        coliterator endij=(*i).end();           // end of row i
-        coliterator ij;
+        // find A_jj which eliminates A_ij
+        coliterator jj = A[ij.index()].find(ij.index());
+
+        // compute L_ij = A_ij * A_jj^-1
+        rightMultiplyBlock(*ij, *jj);
+
+        // modify row
+        coliterator endjk=A[ij.index()].end();    // end of row j
+        coliterator jk=jj; ++jk;
+        coliterator ik=ij; ++ik;
+        while (ik!=endij && jk!=endjk)
+            if (ik.index()==jk.index())
+            {
+                mmmBlock(*ij, *jk, *ik);
+                ++ik; ++jk;
+            }
+            else
+            {
+                if (ik.index()<jk.index())
+                    ++ik;
+                else
+                    ++jk;
+            }
+    }
+
+    // invert pivot and store it in A
+    if (ij.index()!=i)
+        DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
+    try {
+        (*ij).invert();   // compute inverse of diagonal block
+    }
+    catch (Dune::FMatrixError & e) {
+        DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+    }
+}
 
-        // eliminate entries left of diagonal; store L factor
-        for (ij=(*i).begin(); ij.index()<i.index(); ++ij)
+//! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
+template<class M>
+void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
+{
+    for (std::size_t i = 0; i < interiorSize; ++i)
+    {
+        bilu0_decompose_row(A, i);
+    }
+}
+
+//! Call kernel(row) for all rows row < numRows of the level sets. The
+//! levels are processed one after the other, the rows of a level
+//! concurrently by OpenMP threads. Exceptions must not escape the parallel
+//! region, the first one caught is rethrown after the level is done.
+template<class Kernel>
+void forEachRowInLevels (const SparseTable<std::size_t>& levelSets,
+                         std::size_t numRows, Kernel&& kernel)
+{
+    for (int level = 0; level < static_cast<int>(levelSets.size()); ++level)
+    {
+        const auto rows = levelSets[level];
+        const int numRowsInLevel = rows.size();
+        std::exception_ptr exception;
+#if HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int k = 0; k < numRowsInLevel; ++k)
         {
-            // find A_jj which eliminates A_ij
-            coliterator jj = A[ij.index()].find(ij.index());
-
-            // compute L_ij = A_jj^-1 * A_ij
-            (*ij).rightmultiply(*jj);
-
-            // modify row
-            coliterator endjk=A[ij.index()].end();    // end of row j
-            coliterator jk=jj; ++jk;
-            coliterator ik=ij; ++ik;
-            while (ik!=endij && jk!=endjk)
-                if (ik.index()==jk.index())
-                {
-                    block B(*jk);
-                    B.leftmultiply(*ij);
-                    *ik -= B;
-                    ++ik; ++jk;
-                }
-                else
-                {
-                    if (ik.index()<jk.index())
-                        ++ik;
-                    else
-                        ++jk;
+            const std::size_t row = *(rows.begin() + k);
+            if (row >= numRows) {
+                continue;
+            }
+            try {
+                kernel(row);
+            }
+            catch (...) {
+#if HAVE_OPENMP
+#pragma omp critical (iluLevelException)
+#endif
+                if (!exception) {
+                    exception = std::current_exception();
                 }
+            }
         }
-
-        // invert pivot and store it in A
-        if (ij.index()!=i.index())
-            DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
-        try {
-            (*ij).invert();   // compute inverse of diagonal block
-        }
-        catch (Dune::FMatrixError & e) {
-            DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+        if (exception) {
+            std::rethrow_exception(exception);
         }
     }
 }
@@ -230,14 +282,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(nullptr), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -250,14 +303,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -269,8 +323,8 @@ template<class Matrix, class Domain, class Range, class ParallelInfoT>
 ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const field_type w, MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
-    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                        bool reorder_sphere, bool reorder_rcm)
+    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, reorder_rcm )
 {}
 
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
@@ -278,14 +332,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -299,7 +354,7 @@ ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm,
                         const field_type w, MILU_VARIANT milu,
                         size_type interiorSize, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
@@ -307,7 +362,8 @@ ParallelOverlappingILU0(const Matrix& A,
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       interiorSize_(interiorSize),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     // BlockMatrix is a Subclass of FieldMatrix that just adds
     // methods. Therefore this cast should be safe.
@@ -335,8 +391,7 @@ apply (Domain& v, const Range& d)
         OPM_THROW(std::logic_error,"ILU: number of lower and upper rows must be the same");
     }
 
-    // lower triangular solve
-    for (size_type i = 0; i < lowerLoopEnd; ++i)
+    auto lowerSolveRow = [this, &md, &mv](const size_type i)
     {
         dblock rhs( md[ i ] );
         const size_type rowI     = lower_.rows_[ i ];
@@ -344,13 +399,14 @@ apply (Domain& v, const Range& d)
 
         for (size_type col = rowI; col < rowINext; ++col)
         {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
+            detail::mmvBlock( lower_.values_[ col ], mv[ lower_.cols_[ col ] ], rhs );
         }
 
         mv[ i ] = rhs;  // Lii = I
-    }
+    };
 
-    for (size_type i = upperLoopStart; i < iEnd; ++i)
+    // upper_ and inv_ store the rows in reverse order
+    auto upperSolveRow = [this, &mv, lastRow](const size_type i)
     {
         vblock& vBlock = mv[ lastRow - i ];
         vblock rhs ( vBlock );
@@ -359,11 +415,46 @@ apply (Domain& v, const Range& d)
 
         for (size_type col = rowI; col < rowINext; ++col)
         {
-            upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+            detail::mmvBlock( upper_.values_[ col ], mv[ upper_.cols_[ col ] ], rhs );
         }
 
         // apply inverse and store result
-        inv_[ i ].mv( rhs, vBlock);
+        detail::mvBlock( inv_[ i ], rhs, vBlock );
+    };
+
+    if (useMultithreading_)
+    {
+        // lower triangular solve
+        detail::forEachRowInLevels(lowerLevelSets_, lowerLoopEnd, lowerSolveRow);
+
+        // upper triangular solve, the level sets hold matrix rows
+        detail::forEachRowInLevels(upperLevelSets_, interiorSize_,
+                                   [&upperSolveRow, lastRow](const size_type row)
+                                   { upperSolveRow(lastRow - row); });
+    }
+    else
+    {
+        // lower triangular solve
+        for (size_type i = 0; i < lowerLoopEnd; ++i)
+        {
+            lowerSolveRow(i);
+        }
+
+        for (size_type i = upperLoopStart; i < iEnd; ++i)
+        {
+            upperSolveRow(i);
+        }
+    }
+
+    if (haloExchange_)
+    {
+        if( relaxation_ ) {
+            mv *= w_;
+        }
+        reorderBack(mv, v);
+        // the consumer of v finishes the exchange
+        haloExchange_->start(v);
+        return;
     }
 
     copyOwnerToAll( mv );
@@ -405,10 +496,16 @@ update()
         }
     }
 
+#if HAVE_OPENMP
+    useMultithreading_ = omp_get_max_threads() > 1;
+#endif
+
     int ilu_setup_successful = 1;
     std::string message;
     const int rank = comm_ ? comm_->communicator().rank() : 0;
 
+    // Whether the reordered copy ILU_ of the matrix must be set up anew.
+    bool newOrdering = false;
     if (redBlack_)
     {
         using Graph = Dune::Amg::MatrixGraph<const Matrix>;
@@ -417,16 +514,31 @@ update()
         const auto& colors = std::get<0>(colorsTuple);
         const auto& verticesPerColor = std::get<2>(colorsTuple);
         auto noColors = std::get<1>(colorsTuple);
+        std::vector<std::size_t> ordering;
         if ( reorderSphere_ )
         {
-            ordering_ = reorderVerticesSpheres(colors, noColors, verticesPerColor,
-                                               graph, 0);
+            ordering = reorderVerticesSpheres(colors, noColors, verticesPerColor,
+                                              graph, 0);
         }
         else
         {
-            ordering_ = reorderVerticesPreserving(colors, noColors, verticesPerColor,
-                                                  graph);
+            ordering = reorderVerticesPreserving(colors, noColors, verticesPerColor,
+                                                 graph);
         }
+        newOrdering = ordering != ordering_;
+        ordering_ = std::move(ordering);
+    }
+    else if (reorderRCM_ && ordering_.size() != A_->N())
+    {
+        // The sparsity pattern does not change between updates, hence the
+        // ordering is only computed once. Only the interior rows are
+        // reordered such that the ghost rows stay at the end.
+        using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+        Graph graph(*A_);
+        const auto noInterior = comm_ ? detail::set_interiorSize(A_->N(), interiorSize_, *comm_)
+                                      : interiorSize_;
+        ordering_ = reorderVerticesRCM(graph, noInterior);
+        newOrdering = true;
     }
 
     std::vector<std::size_t> inverseOrdering(ordering_.size());
@@ -453,7 +565,11 @@ update()
                     // The ILU_ matrix is already a copy with the same
                     // sparse structure as A_, but the values of A_ may
                     // have changed, so we must copy all elements.
-                    for (std::size_t row = 0; row < A_->N(); ++row) {
+                    const int numRows = A_->N();
+#if HAVE_OPENMP
+#pragma omp parallel for if (useMultithreading_)
+#endif
+                    for (int row = 0; row < numRows; ++row) {
                         const auto& Arow = (*A_)[row];
                         auto& ILUrow = (*ILU_)[row];
                         auto Ait = Arow.begin();
@@ -469,52 +585,73 @@ update()
             }
             else
             {
-                ILU_ = std::make_unique<Matrix>(A_->N(), A_->M(),
-                                                A_->nonzeroes(), Matrix::row_wise);
-                auto& newA = *ILU_;
-                // Create sparsity pattern
-                for (auto iter = newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
+                if (!ILU_ || newOrdering)
                 {
-                    const auto& row = (*A_)[inverseOrdering[iter.index()]];
-                    for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                    OPM_TIMEBLOCK(iluDecompositionMakeMatrix);
+                    // the level sets belong to the previous ordering
+                    lowerLevelSets_ = SparseTable<std::size_t>();
+                    upperLevelSets_ = SparseTable<std::size_t>();
+                    ILU_ = std::make_unique<Matrix>(A_->N(), A_->M(),
+                                                    A_->nonzeroes(), Matrix::row_wise);
+                    auto& newA = *ILU_;
+                    // Create sparsity pattern
+                    for (auto iter = newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
                     {
-                        iter.insert(ordering_[col.index()]);
+                        const auto& row = (*A_)[inverseOrdering[iter.index()]];
+                        for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                        {
+                            iter.insert(ordering_[col.index()]);
+                        }
                     }
                 }
-                // Copy values
-                for (auto iter = A_->begin(), iend = A_->end(); iter != iend; ++iter)
+                // Copy values. The reordered sparsity pattern is the same
+                // as long as the ordering does not change, so ILU_ is reused.
+                const int numRows = A_->N();
+#if HAVE_OPENMP
+#pragma omp parallel for if (useMultithreading_)
+#endif
+                for (int row = 0; row < numRows; ++row)
                 {
-                    auto& newRow = newA[ordering_[iter.index()]];
-                    for (auto col = iter->begin(), cend = iter->end(); col != cend; ++col)
+                    const auto& Arow = (*A_)[row];
+                    auto& newRow = (*ILU_)[ordering_[row]];
+                    for (auto col = Arow.begin(), cend = Arow.end(); col != cend; ++col)
                     {
                         newRow[ordering_[col.index()]] = *col;
                     }
                 }
             }
 
-            switch (milu_)
+            if (useMultithreading_)
             {
-            case MILU_VARIANT::MILU_1:
-                detail::milu0_decomposition ( *ILU_);
-                break;
-            case MILU_VARIANT::MILU_2:
-                detail::milu0_decomposition ( *ILU_, detail::identityFunctor<typename Matrix::field_type>,
-                                              detail::signFunctor<typename Matrix::field_type> );
-                break;
-            case MILU_VARIANT::MILU_3:
-                detail::milu0_decomposition ( *ILU_, detail::absFunctor<typename Matrix::field_type>,
-                                              detail::signFunctor<typename Matrix::field_type> );
-                break;
-            case MILU_VARIANT::MILU_4:
-                detail::milu0_decomposition ( *ILU_, detail::identityFunctor<typename Matrix::field_type>,
-                                              detail::isPositiveFunctor<typename Matrix::field_type> );
-                break;
-            default:
-                if (interiorSize_ == A_->N())
-                    Dune::ILU::blockILU0Decomposition( *ILU_ );
-                else
-                    detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
-                break;
+                computeLevelSets();
+                levelScheduledDecomposition();
+            }
+            else
+            {
+                switch (milu_)
+                {
+                case MILU_VARIANT::MILU_1:
+                    detail::milu0_decomposition ( *ILU_);
+                    break;
+                case MILU_VARIANT::MILU_2:
+                    detail::milu0_decomposition ( *ILU_, detail::identityFunctor<typename Matrix::field_type>,
+                                                  detail::signFunctor<typename Matrix::field_type> );
+                    break;
+                case MILU_VARIANT::MILU_3:
+                    detail::milu0_decomposition ( *ILU_, detail::absFunctor<typename Matrix::field_type>,
+                                                  detail::signFunctor<typename Matrix::field_type> );
+                    break;
+                case MILU_VARIANT::MILU_4:
+                    detail::milu0_decomposition ( *ILU_, detail::identityFunctor<typename Matrix::field_type>,
+                                                  detail::isPositiveFunctor<typename Matrix::field_type> );
+                    break;
+                default:
+                    if (interiorSize_ == A_->N())
+                        Dune::ILU::blockILU0Decomposition( *ILU_ );
+                    else
+                        detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
+                    break;
+                }
             }
         }
         else {
@@ -533,6 +670,13 @@ update()
             }
 
             milun_decomposition( *A_, iluIteration_, milu_, *ILU_, *reorderer, *inverseReorderer );
+
+            // The fill-in is computed sequentially, but the triangular
+            // solves can still be level scheduled.
+            if (useMultithreading_)
+            {
+                computeLevelSets();
+            }
         }
     }
     catch (const Dune::MatrixBlockError& error)
@@ -556,6 +700,56 @@ update()
     detail::convertToCRS(*ILU_, lower_, upper_, inv_);
 }
 
+template<class Matrix, class Domain, class Range, class ParallelInfoT>
+void ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
+computeLevelSets()
+{
+    // The sparsity pattern of ILU_ does not change between updates, hence
+    // the level sets are only computed once.
+    if (lowerLevelSets_.empty())
+    {
+        OPM_TIMEBLOCK(iluLevelSets);
+        lowerLevelSets_ = getMatrixRowColoring(*ILU_, ColoringType::LOWER);
+        upperLevelSets_ = getMatrixRowColoring(*ILU_, ColoringType::UPPER);
+    }
+}
+
+template<class Matrix, class Domain, class Range, class ParallelInfoT>
+void ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
+levelScheduledDecomposition()
+{
+    using Field = typename Matrix::field_type;
+    auto milu0 = [this](const detail::FieldFunct<Matrix>& absFunctor,
+                        const detail::FieldFunct<Matrix>& signFunctor)
+    {
+        detail::forEachRowInLevels(lowerLevelSets_, ILU_->N(),
+                                   [this, &absFunctor, &signFunctor](const size_type row)
+                                   { detail::milu0_decompose_row(*ILU_, row, absFunctor, signFunctor); });
+    };
+
+    switch (milu_)
+    {
+    case MILU_VARIANT::MILU_1:
+        milu0(detail::signFunctor<Field>, detail::oneFunctor<Field>);
+        break;
+    case MILU_VARIANT::MILU_2:
+        milu0(detail::identityFunctor<Field>, detail::signFunctor<Field>);
+        break;
+    case MILU_VARIANT::MILU_3:
+        milu0(detail::absFunctor<Field>, detail::signFunctor<Field>);
+        break;
+    case MILU_VARIANT::MILU_4:
+        milu0(detail::identityFunctor<Field>, detail::isPositiveFunctor<Field>);
+        break;
+    default:
+        // rows after interiorSize_ are ghost rows and left untouched
+        detail::forEachRowInLevels(lowerLevelSets_, interiorSize_,
+                                   [this](const size_type row)
+                                   { detail::bilu0_decompose_row(*ILU_, row); });
+        break;
+    }
+}
+
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
 Range& ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 reorderD(const Range& d)
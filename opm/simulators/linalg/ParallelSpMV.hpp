@@ -0,0 +1,271 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLELSPMV_HEADER_INCLUDED
+#define OPM_PARALLELSPMV_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace Opm
+{
+
+/*!
+   \brief OpenMP thread parallel product of a block compressed row
+   storage (BCRS) matrix with a vector.
+
+   The first numRows rows of the matrix are split into one contiguous
+   range per thread, such that all ranges contain about the same number
+   of nonzero blocks. The partition is computed once and does not change
+   for the lifetime of the object, hence a row is always processed by the
+   same thread and the threads keep working on the same parts of the
+   matrix and of the vectors.
+
+   Each thread accumulates the product of a row in a local block and
+   writes it to the result vector once. Rows after numRows are not
+   touched. If only one thread is available or the matrix is too small to
+   benefit from threading, the product is computed sequentially.
+
+   The rows can additionally be split into inner rows, which only couple
+   to owned columns, and border rows, see splitBorderRows(). This allows
+   computing the inner rows while the overlap entries of x are still
+   being communicated.
+
+   The sparsity pattern of the matrix must not change after the object
+   has been created, the values may.
+
+   \tparam M The matrix type (a Dune::BCRSMatrix)
+ */
+template <class M>
+class ParallelSpMV
+{
+public:
+    using matrix_type = M;
+
+    //! \brief Do not use more threads than rows / minRowsPerThread.
+    static constexpr std::size_t minRowsPerThread = 1000;
+
+    //! \brief Set up the row partition for the first numRows rows of A.
+    //! \param numThreads The number of row ranges, 0 means the maximum
+    //!                   number of OpenMP threads.
+    ParallelSpMV(const M& A, std::size_t numRows, int numThreads = 0)
+        : A_(A)
+    {
+        assert(numRows <= A.N());
+        if (numThreads <= 0) {
+            numThreads = 1;
+#if HAVE_OPENMP
+            numThreads = omp_get_max_threads();
+#endif
+        }
+        const std::size_t maxParts = std::max<std::size_t>(1, numRows / minRowsPerThread);
+        const std::size_t numParts = std::min<std::size_t>(numThreads, maxParts);
+        partition_(numRows, numParts);
+    }
+
+    explicit ParallelSpMV(const M& A)
+        : ParallelSpMV(A, A.N())
+    {}
+
+    //! \brief Returns true if more than one thread is used.
+    bool isParallel() const
+    { return numParts() > 1; }
+
+    //! \brief The number of row ranges, i.e. the number of threads used.
+    int numParts() const
+    { return rowBegin_.size() - 1; }
+
+    //! \brief The first row of each range, followed by numRows.
+    const std::vector<std::size_t>& rowBegin() const
+    { return rowBegin_; }
+
+    //! \brief y = A x
+    template <class X, class Y>
+    void mv(const X& x, Y& y) const
+    {
+        forEachRow_([this, &x, &y](const std::size_t rowIdx)
+        {
+            y[rowIdx] = rowProduct_<Y>(rowIdx, x);
+        });
+    }
+
+    //! \brief y += alpha A x
+    template <class F, class X, class Y>
+    void usmv(const F& alpha, const X& x, Y& y) const
+    {
+        forEachRow_([this, &alpha, &x, &y](const std::size_t rowIdx)
+        {
+            y[rowIdx].axpy(alpha, rowProduct_<Y>(rowIdx, x));
+        });
+    }
+
+    /*!
+       \brief Mark the rows with a column index of at least numOwnedColumns
+       as border rows. All other rows are inner rows.
+     */
+    void splitBorderRows(const std::size_t numOwnedColumns)
+    {
+        const std::size_t numRows = rowBegin_.back();
+        isBorderRow_.assign(numRows, false);
+        borderRows_.clear();
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            const auto& row = A_[rowIdx];
+            for (auto col = row.begin(); col != row.end(); ++col) {
+                if (col.index() >= numOwnedColumns) {
+                    isBorderRow_[rowIdx] = true;
+                    borderRows_.push_back(rowIdx);
+                    break;
+                }
+            }
+        }
+    }
+
+    //! \brief The border rows in increasing order, empty unless
+    //!        splitBorderRows() has been called.
+    const std::vector<std::size_t>& borderRows() const
+    { return borderRows_; }
+
+    //! \brief y = A x for the inner rows only, requires splitBorderRows().
+    template <class X, class Y>
+    void mvInner(const X& x, Y& y) const
+    {
+        assert(isBorderRow_.size() == rowBegin_.back());
+        forEachRow_([this, &x, &y](const std::size_t rowIdx)
+        {
+            if (!isBorderRow_[rowIdx]) {
+                y[rowIdx] = rowProduct_<Y>(rowIdx, x);
+            }
+        });
+    }
+
+    //! \brief y = A x for the border rows only.
+    template <class X, class Y>
+    void mvBorder(const X& x, Y& y) const
+    {
+        forEachBorderRow_([this, &x, &y](const std::size_t rowIdx)
+        {
+            y[rowIdx] = rowProduct_<Y>(rowIdx, x);
+        });
+    }
+
+    //! \brief y += alpha A x for the inner rows only, requires splitBorderRows().
+    template <class F, class X, class Y>
+    void usmvInner(const F& alpha, const X& x, Y& y) const
+    {
+        assert(isBorderRow_.size() == rowBegin_.back());
+        forEachRow_([this, &alpha, &x, &y](const std::size_t rowIdx)
+        {
+            if (!isBorderRow_[rowIdx]) {
+                y[rowIdx].axpy(alpha, rowProduct_<Y>(rowIdx, x));
+            }
+        });
+    }
+
+    //! \brief y += alpha A x for the border rows only.
+    template <class F, class X, class Y>
+    void usmvBorder(const F& alpha, const X& x, Y& y) const
+    {
+        forEachBorderRow_([this, &alpha, &x, &y](const std::size_t rowIdx)
+        {
+            y[rowIdx].axpy(alpha, rowProduct_<Y>(rowIdx, x));
+        });
+    }
+
+private:
+    // Split the rows into numParts ranges of about the same number of
+    // nonzero blocks.
+    void partition_(const std::size_t numRows, const std::size_t numParts)
+    {
+        std::size_t nnz = 0;
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            nnz += A_[rowIdx].getsize();
+        }
+
+        rowBegin_.assign(numParts + 1, numRows);
+        rowBegin_[0] = 0;
+        std::size_t part = 1;
+        std::size_t count = 0;
+        for (std::size_t rowIdx = 0; rowIdx < numRows && part < numParts; ++rowIdx) {
+            // start the next range at the first row after which the
+            // previous ranges hold part/numParts of the nonzeros
+            if (count * numParts >= part * nnz) {
+                rowBegin_[part++] = rowIdx;
+            }
+            count += A_[rowIdx].getsize();
+        }
+    }
+
+    template <class Kernel>
+    void forEachRow_(Kernel&& kernel) const
+    {
+        const int parts = numParts();
+        // schedule(static, 1) hands range i to thread i if the team is
+        // complete, but also processes all ranges in a smaller team.
+#if HAVE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(parts) if (parts > 1)
+#endif
+        for (int part = 0; part < parts; ++part) {
+            const std::size_t endRow = rowBegin_[part + 1];
+            for (std::size_t rowIdx = rowBegin_[part]; rowIdx < endRow; ++rowIdx) {
+                kernel(rowIdx);
+            }
+        }
+    }
+
+    template <class Y, class X>
+    typename Y::block_type rowProduct_(const std::size_t rowIdx, const X& x) const
+    {
+        typename Y::block_type yi(0.0);
+        const auto& row = A_[rowIdx];
+        const auto endc = row.end();
+        for (auto col = row.begin(); col != endc; ++col) {
+            detail::umvBlock(*col, x[col.index()], yi);
+        }
+        return yi;
+    }
+
+    template <class Kernel>
+    void forEachBorderRow_(Kernel&& kernel) const
+    {
+        const std::ptrdiff_t numBorderRows = borderRows_.size();
+        const int parts = std::min<std::ptrdiff_t>(numParts(),
+                                                   std::max<std::ptrdiff_t>(1, numBorderRows / minRowsPerThread));
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(parts) if (parts > 1)
+#endif
+        for (std::ptrdiff_t i = 0; i < numBorderRows; ++i) {
+            kernel(borderRows_[i]);
+        }
+    }
+
+    const M& A_;
+    std::vector<std::size_t> rowBegin_;
+    std::vector<bool> isBorderRow_;
+    std::vector<std::size_t> borderRows_;
+};
+
+} // namespace Opm
+
+#endif // OPM_PARALLELSPMV_HEADER_INCLUDED
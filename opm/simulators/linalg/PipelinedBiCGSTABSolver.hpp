@@ -0,0 +1,265 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PIPELINEDBICGSTABSOLVER_HEADER_INCLUDED
+#define OPM_PIPELINEDBICGSTABSOLVER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/FusedReduction.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace Opm
+{
+
+/*!
+   \brief Pipelined BiCGSTAB with right preconditioning.
+
+   This is the preconditioned p-BiCGStab method of Cools and Vanroose
+   (Parallel Computing 65, 2017). Each iteration has two global reductions
+   instead of the four to five of Dune::BiCGSTABSolver, and each of them
+   is started before and finished after an application of the
+   preconditioner and the operator, so the latency of the allreduce is
+   hidden behind the computation. The residual norm used for the
+   convergence test is part of the second reduction.
+
+   The price is a number of additional vector updates per iteration, more
+   storage and a recurrence for the residual which may lose some accuracy
+   compared to BiCGSTAB. The preconditioner must be linear, i.e. must not
+   change between iterations.
+ */
+template <class X>
+class PipelinedBiCGSTABSolver : public Dune::IterativeSolver<X, X>
+{
+public:
+    using typename Dune::IterativeSolver<X, X>::domain_type;
+    using typename Dune::IterativeSolver<X, X>::range_type;
+    using typename Dune::IterativeSolver<X, X>::field_type;
+    using typename Dune::IterativeSolver<X, X>::real_type;
+    using typename Dune::IterativeSolver<X, X>::scalar_real_type;
+
+    /*!
+       \param comm The communication object used for the reductions,
+                   Dune::Amg::SequentialInformation for a serial solver
+     */
+    template <class Comm>
+    PipelinedBiCGSTABSolver(Dune::LinearOperator<X, X>& op,
+                            Dune::ScalarProduct<X>& sp,
+                            Dune::Preconditioner<X, X>& prec,
+                            const Comm& comm,
+                            scalar_real_type reduction,
+                            int maxit,
+                            int verbose)
+        : Dune::IterativeSolver<X, X>(op, sp, prec, reduction, maxit, verbose)
+        , reductions_(comm, op.category())
+    {
+    }
+
+    using Dune::IterativeSolver<X, X>::apply;
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        OPM_TIMEBLOCK(pipelinedBiCGSTABApply);
+        Dune::Timer watch;
+        res.clear();
+
+        this->_prec->pre(x, b);
+
+        // The residual is stored in b. A hat denotes a preconditioned vector.
+        X& r = b;
+        this->_op->applyscaleadd(-1.0, x, r);
+        X rHat(x);
+        X w(b);
+        X wHat(x);
+        X t(b);
+        applyPreconditioner_(rHat, r);
+        this->_op->apply(rHat, w);
+        applyPreconditioner_(wHat, w);
+        this->_op->apply(wHat, t);
+
+        const X r0(r);
+        reductions_.start({{&r0, &r}, {&r0, &w}, {&r, &r}});
+        const auto& initial = reductions_.finish();
+        field_type rho = initial[0];
+        const real_type def0 = std::sqrt(std::max(real_type(initial[2]), real_type(0.0)));
+        real_type def = def0;
+
+        if (this->_verbose > 0) {
+            std::cout << "=== " << name() << std::endl;
+            if (this->_verbose > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0, def0);
+            }
+        }
+
+        auto converged = [&def0, this](const real_type d)
+        {
+            return d < def0 * this->_reduction || d < real_type(1e-30);
+        };
+
+        field_type alpha = 0.0;
+        if (!converged(def)) {
+            if (!(std::abs(initial[1]) > 0.0)) {
+                DUNE_THROW(Dune::SolverAbort, name() << ": breakdown in alpha");
+            }
+            alpha = rho / initial[1];
+        }
+
+        X pHat(x);
+        X s(b);
+        X sHat(x);
+        X z(b);
+        X zHat(x);
+        X v(b);
+        X q(b);
+        X qHat(x);
+        X y(b);
+        field_type beta = 0.0;
+        field_type omega = 0.0;
+
+        int iterations = 0;
+        while (!converged(def) && iterations < this->_maxit) {
+            if (iterations == 0) {
+                pHat = rHat;
+                s = w;
+                sHat = wHat;
+                z = t;
+            } else {
+                updateDirection_(pHat, rHat, sHat, beta, omega);
+                updateDirection_(s, w, z, beta, omega);
+                updateDirection_(sHat, wHat, zHat, beta, omega);
+                updateDirection_(z, t, v, beta, omega);
+            }
+            q = r;
+            q.axpy(-alpha, s);
+            qHat = rHat;
+            qHat.axpy(-alpha, sHat);
+            y = w;
+            y.axpy(-alpha, z);
+
+            reductions_.start({{&q, &y}, {&y, &y}, {&q, &q}});
+            applyPreconditioner_(zHat, z);
+            this->_op->apply(zHat, v);
+            const auto& first = reductions_.finish();
+            if (!(std::abs(first[1]) > 0.0)) {
+                // y = A M^{-1} q vanishes, which is fine if the residual q
+                // after the first half step does so as well.
+                x.axpy(alpha, pHat);
+                r = q;
+                ++iterations;
+                const real_type previous = def;
+                def = std::sqrt(std::max(real_type(first[2]), real_type(0.0)));
+                if (this->_verbose > 1) {
+                    this->printOutput(std::cout, iterations, def, previous);
+                }
+                if (converged(def)) {
+                    break;
+                }
+                DUNE_THROW(Dune::SolverAbort, name() << ": breakdown in omega");
+            }
+            omega = first[0] / first[1];
+
+            x.axpy(alpha, pHat);
+            x.axpy(omega, qHat);
+            r = q;
+            r.axpy(-omega, y);
+            // rHat = qHat - omega (wHat - alpha zHat)
+            rHat = qHat;
+            rHat.axpy(-omega, wHat);
+            rHat.axpy(omega * alpha, zHat);
+            // w = y - omega (t - alpha v)
+            w = y;
+            w.axpy(-omega, t);
+            w.axpy(omega * alpha, v);
+
+            reductions_.start({{&r0, &r}, {&r0, &w}, {&r0, &s}, {&r0, &z}, {&r, &r}});
+            applyPreconditioner_(wHat, w);
+            this->_op->apply(wHat, t);
+            const auto& second = reductions_.finish();
+
+            ++iterations;
+            const real_type previous = def;
+            def = std::sqrt(std::max(real_type(second[4]), real_type(0.0)));
+            if (this->_verbose > 1) {
+                this->printOutput(std::cout, iterations, def, previous);
+            }
+            if (converged(def)) {
+                break;
+            }
+
+            if (!(std::abs(rho) > 0.0) || !(std::abs(omega) > 0.0)) {
+                DUNE_THROW(Dune::SolverAbort, name() << ": breakdown in beta");
+            }
+            beta = (alpha / omega) * (second[0] / rho);
+            const field_type denominator = second[1] + beta * second[2] - beta * omega * second[3];
+            if (!(std::abs(denominator) > 0.0)) {
+                DUNE_THROW(Dune::SolverAbort, name() << ": breakdown in alpha");
+            }
+            alpha = second[0] / denominator;
+            rho = second[0];
+        }
+
+        this->_prec->post(x);
+
+        res.iterations = iterations;
+        res.reduction = def0 > 0.0 ? static_cast<double>(def / def0) : 0.0;
+        res.converged = converged(def);
+        res.conv_rate = iterations > 0 ? std::pow(res.reduction, 1.0 / iterations) : 0.0;
+        res.elapsed = watch.elapsed();
+
+        if (this->_verbose > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / std::max(1, iterations)
+                      << ", IT=" << iterations << std::endl;
+        }
+    }
+
+    std::string name() const
+    {
+        return "PipelinedBiCGSTABSolver";
+    }
+
+private:
+    void applyPreconditioner_(X& hat, const X& vec)
+    {
+        hat = 0.0;
+        this->_prec->apply(hat, vec);
+    }
+
+    // p = r + beta (p - omega s)
+    static void updateDirection_(X& p, const X& r, const X& s,
+                                 const field_type beta, const field_type omega)
+    {
+        p.axpy(-omega, s);
+        p *= beta;
+        p += r;
+    }
+
+    FusedReduction<X> reductions_;
+};
+
+} // namespace Opm
+
+#endif // OPM_PIPELINEDBICGSTABSOLVER_HEADER_INCLUDED
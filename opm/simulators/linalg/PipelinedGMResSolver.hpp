@@ -0,0 +1,288 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PIPELINEDGMRESSOLVER_HEADER_INCLUDED
+#define OPM_PIPELINEDGMRESSOLVER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/FusedReduction.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/*!
+   \brief Restarted GMRES with one global reduction per iteration, which
+   overlaps with the application of the preconditioner and the operator.
+
+   The new Krylov vector w = A M^{-1} v_j is orthogonalized by classical
+   Gram-Schmidt. All the dot products (v_i, w) and (w, w) are computed by
+   one reduction, and the norm of the orthogonalized vector follows from
+   Pythagoras. If that subtraction cancels too many digits, the vector is
+   orthogonalized a second time, which costs one more reduction.
+
+   While the reduction is in flight, M^{-1} w and A M^{-1} w are computed.
+   As the preconditioner is linear, the preconditioned next basis vector
+   and its product with A follow from these by the same linear combination
+   which gives the next basis vector, see p(1)-GMRES of Ghysels et al.
+   (SIAM J. Sci. Comput. 35, 2013). Hence each iteration applies the
+   preconditioner and the operator once, as in Dune::RestartedGMResSolver,
+   while that solver needs j + 2 reductions in iteration j.
+
+   The residual is recomputed from the solution at each restart. The
+   preconditioner must be linear, i.e. must not change between
+   iterations.
+ */
+template <class X>
+class PipelinedGMResSolver : public Dune::IterativeSolver<X, X>
+{
+public:
+    using typename Dune::IterativeSolver<X, X>::domain_type;
+    using typename Dune::IterativeSolver<X, X>::range_type;
+    using typename Dune::IterativeSolver<X, X>::field_type;
+    using typename Dune::IterativeSolver<X, X>::real_type;
+    using typename Dune::IterativeSolver<X, X>::scalar_real_type;
+
+    /*!
+       \param comm The communication object used for the reductions,
+                   Dune::Amg::SequentialInformation for a serial solver
+       \param restart The maximum dimension of the Krylov subspace
+     */
+    template <class Comm>
+    PipelinedGMResSolver(Dune::LinearOperator<X, X>& op,
+                         Dune::ScalarProduct<X>& sp,
+                         Dune::Preconditioner<X, X>& prec,
+                         const Comm& comm,
+                         scalar_real_type reduction,
+                         int restart,
+                         int maxit,
+                         int verbose)
+        : Dune::IterativeSolver<X, X>(op, sp, prec, reduction, maxit, verbose)
+        , reductions_(comm, op.category())
+        , restart_(std::max(restart, 1))
+    {
+    }
+
+    using Dune::IterativeSolver<X, X>::apply;
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        OPM_TIMEBLOCK(pipelinedGMResApply);
+        Dune::Timer watch;
+        res.clear();
+
+        this->_prec->pre(x, b);
+        const X rhs(b);
+        this->_op->applyscaleadd(-1.0, x, b);
+        const real_type def0 = norm_(b);
+        real_type def = def0;
+
+        if (this->_verbose > 0) {
+            std::cout << "=== " << name() << std::endl;
+            if (this->_verbose > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0, def0);
+            }
+        }
+
+        auto converged = [&def0, this](const real_type d)
+        {
+            return d < def0 * this->_reduction || d < real_type(1e-30);
+        };
+
+        int iterations = 0;
+        while (!converged(def) && iterations < this->_maxit) {
+            cycle_(x, b, iterations, def0, def);
+            // Recompute the residual to avoid the drift of the recurrences.
+            b = rhs;
+            this->_op->applyscaleadd(-1.0, x, b);
+            def = norm_(b);
+        }
+
+        this->_prec->post(x);
+
+        res.iterations = iterations;
+        res.reduction = def0 > 0.0 ? static_cast<double>(def / def0) : 0.0;
+        res.converged = converged(def);
+        res.conv_rate = iterations > 0 ? std::pow(res.reduction, 1.0 / iterations) : 0.0;
+        res.elapsed = watch.elapsed();
+
+        if (this->_verbose > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / std::max(1, iterations)
+                      << ", IT=" << iterations << std::endl;
+        }
+    }
+
+    std::string name() const
+    {
+        return "PipelinedGMResSolver";
+    }
+
+private:
+    real_type norm_(const X& vec)
+    {
+        reductions_.start({{&vec, &vec}});
+        return std::sqrt(std::max(real_type(reductions_.finish()[0]), real_type(0.0)));
+    }
+
+    // One restart cycle starting from the residual b with norm beta.
+    void cycle_(X& x, const X& b, int& iterations, const real_type def0, const real_type beta)
+    {
+        const int m = restart_;
+        // v are the orthonormal basis vectors, z = M^{-1} v and w = A z.
+        v_.resize(m + 1, b);
+        z_.resize(m + 1, x);
+        w_.resize(m + 1, b);
+        X zNext(x);
+        X wNext(b);
+
+        // H is the (m+1) x m Hessenberg matrix stored by columns, which is
+        // triangularized by Givens rotations.
+        std::vector<field_type> H((m + 1) * m, 0.0);
+        std::vector<field_type> cs(m, 0.0);
+        std::vector<field_type> sn(m, 0.0);
+        std::vector<field_type> s(m + 1, 0.0);
+        auto h = [&H, m](int i, int j) -> field_type& { return H[j * (m + 1) + i]; };
+
+        v_[0] = b;
+        v_[0] *= 1.0 / beta;
+        z_[0] = 0.0;
+        this->_prec->apply(z_[0], v_[0]);
+        this->_op->apply(z_[0], w_[0]);
+        s[0] = beta;
+
+        std::vector<typename FusedReduction<X>::Pair> pairs;
+        real_type resid = beta;
+        int j = 0;
+        while (j < m && iterations < this->_maxit) {
+            pairs.clear();
+            for (int i = 0; i <= j; ++i) {
+                pairs.emplace_back(&v_[i], &w_[j]);
+            }
+            pairs.emplace_back(&w_[j], &w_[j]);
+            reductions_.start(pairs.begin(), pairs.end());
+            const bool last = j + 1 == m || iterations + 1 == this->_maxit;
+            if (!last) {
+                zNext = 0.0;
+                this->_prec->apply(zNext, w_[j]);
+                this->_op->apply(zNext, wNext);
+            }
+            const auto& dots = reductions_.finish();
+
+            // v_{j+1} h_{j+1,j} = w_j - sum_i h_ij v_i
+            X& vNext = v_[j + 1];
+            vNext = w_[j];
+            field_type hh = dots[j + 1];
+            for (int i = 0; i <= j; ++i) {
+                h(i, j) = dots[i];
+                hh -= dots[i] * dots[i];
+                vNext.axpy(-dots[i], v_[i]);
+            }
+            if (!(hh > 1e-8 * dots[j + 1])) {
+                // Cancellation, orthogonalize once more.
+                pairs.back() = {&vNext, &vNext};
+                for (int i = 0; i <= j; ++i) {
+                    pairs[i] = {&v_[i], &vNext};
+                }
+                reductions_.start(pairs.begin(), pairs.end());
+                const auto& corr = reductions_.finish();
+                hh = corr[j + 1];
+                for (int i = 0; i <= j; ++i) {
+                    h(i, j) += corr[i];
+                    hh -= corr[i] * corr[i];
+                    vNext.axpy(-corr[i], v_[i]);
+                }
+            }
+            h(j + 1, j) = std::sqrt(std::max(hh, field_type(0.0)));
+
+            const bool breakdown = !(h(j + 1, j) > 0.0);
+            if (!last && !breakdown) {
+                const field_type scale = 1.0 / h(j + 1, j);
+                vNext *= scale;
+                z_[j + 1] = zNext;
+                w_[j + 1] = wNext;
+                for (int i = 0; i <= j; ++i) {
+                    z_[j + 1].axpy(-h(i, j), z_[i]);
+                    w_[j + 1].axpy(-h(i, j), w_[i]);
+                }
+                z_[j + 1] *= scale;
+                w_[j + 1] *= scale;
+            }
+
+            // Apply the Givens rotations to the new column of H.
+            for (int i = 0; i < j; ++i) {
+                const field_type tmp = cs[i] * h(i, j) + sn[i] * h(i + 1, j);
+                h(i + 1, j) = -sn[i] * h(i, j) + cs[i] * h(i + 1, j);
+                h(i, j) = tmp;
+            }
+            const field_type a = h(j, j);
+            const field_type c = h(j + 1, j);
+            const field_type rho = std::sqrt(a * a + c * c);
+            cs[j] = rho > 0.0 ? a / rho : 1.0;
+            sn[j] = rho > 0.0 ? c / rho : 0.0;
+            h(j, j) = rho;
+            h(j + 1, j) = 0.0;
+            s[j + 1] = -sn[j] * s[j];
+            s[j] = cs[j] * s[j];
+
+            ++j;
+            ++iterations;
+            const real_type previous = resid;
+            resid = std::abs(s[j]);
+            if (this->_verbose > 1) {
+                this->printOutput(std::cout, iterations, resid, previous);
+            }
+            if (breakdown || resid < def0 * this->_reduction || resid < real_type(1e-30)) {
+                break;
+            }
+        }
+
+        // Solve the triangular system and update the solution with z = M^{-1} v.
+        std::vector<field_type> y(j, 0.0);
+        for (int i = j - 1; i >= 0; --i) {
+            field_type sum = s[i];
+            for (int l = i + 1; l < j; ++l) {
+                sum -= h(i, l) * y[l];
+            }
+            y[i] = sum / h(i, i);
+        }
+        for (int l = 0; l < j; ++l) {
+            x.axpy(y[l], z_[l]);
+        }
+    }
+
+    FusedReduction<X> reductions_;
+    int restart_;
+    std::vector<X> v_;
+    std::vector<X> z_;
+    std::vector<X> w_;
+};
+
+} // namespace Opm
+
+#endif // OPM_PIPELINEDGMRESSOLVER_HEADER_INCLUDED
@@ -38,6 +38,11 @@
 #include <opm/simulators/linalg/amgcpr.hh>
 #include <opm/simulators/linalg/ilufirstelement.hh>
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/MixedPrecisionPreconditioner.hpp>
+
+#if HAVE_AMGCL
+#include <opm/simulators/linalg/AmgclPreconditioner.hpp>
+#endif
 
 #include <dune/common/unused.hh>
 #include <dune/istl/owneroverlapcopy.hh>
@@ -178,6 +183,12 @@ struct StandardPreconditioners {
             DUNE_UNUSED_PARAMETER(prm);
             return wrapBlockPreconditioner<MultithreadDILU<M, V, V>>(comm, op.getmat());
         });
+#if HAVE_AMGCL
+        // amgcl on the local matrix of each process, i.e. block Jacobi.
+        F::addCreator("amgcl", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+            return wrapBlockPreconditioner<AmgclPreconditioner<M, V, V>>(comm, op.getmat(), prm);
+        });
+#endif
         F::addCreator("Jac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
@@ -384,14 +395,15 @@ struct StandardPreconditioners {
         const double w = prm.get<double>("relaxation", 1.0);
         const bool redblack = prm.get<bool>("redblack", false);
         const bool reorder_spheres = prm.get<bool>("reorder_spheres", false);
+        const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
         // Already a parallel preconditioner. Need to pass comm, but no need to wrap it in a BlockPreconditioner.
         if (ilulevel == 0) {
             const std::size_t num_interior = interiorIfGhostLast(comm);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, w, MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres);
+                op.getmat(), comm, w, MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres, reorder_rcm);
         } else {
             return std::make_shared<ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, ilulevel, w, MILU_VARIANT::ILU, redblack, reorder_spheres);
+                op.getmat(), comm, ilulevel, w, MILU_VARIANT::ILU, redblack, reorder_spheres, reorder_rcm);
         }
     }
 
@@ -431,8 +443,9 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
         using P = PropertyTree;
         F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
+            const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), 0, w, MILU_VARIANT::ILU);
+                op.getmat(), 0, w, MILU_VARIANT::ILU, false, false, reorder_rcm);
         });
         F::addCreator("DuneILU", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
@@ -443,19 +456,26 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
         F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
             const int n = prm.get<int>("ilulevel", 0);
+            const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), n, w, MILU_VARIANT::ILU);
+                op.getmat(), n, w, MILU_VARIANT::ILU, false, false, reorder_rcm);
         });
         F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const int n = prm.get<int>("ilulevel", 0);
             const double w = prm.get<double>("relaxation", 1.0);
+            const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), n, w, MILU_VARIANT::ILU);
+                op.getmat(), n, w, MILU_VARIANT::ILU, false, false, reorder_rcm);
         });
         F::addCreator("DILU", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             DUNE_UNUSED_PARAMETER(prm);
             return std::make_shared<MultithreadDILU<M, V, V>>(op.getmat());
         });
+#if HAVE_AMGCL
+        F::addCreator("amgcl", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+            return std::make_shared<AmgclPreconditioner<M, V, V>>(op.getmat(), prm);
+        });
+#endif
         F::addCreator("Jac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
@@ -655,6 +675,85 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
     }
 };
 
+/// Creates the preconditioner described by prm for a float copy of the
+/// matrix of op, see MixedPrecisionPreconditioner. The float
+/// preconditioners are taken from the float instances of the factory,
+/// hence this requires the float variants to be built.
+template <class Operator, class Comm>
+struct MixedPrecisionPreconditioners
+{
+    using Matrix = typename Operator::matrix_type;
+    using Vector = typename Operator::domain_type;
+    using PrecPtr = std::shared_ptr<Dune::PreconditionerWithUpdate<Vector, Vector>>;
+    using MatrixF = typename detail::ToFloat<Matrix>::type;
+    using VectorF = typename detail::ToFloat<Vector>::type;
+
+    static PrecPtr createSequential(const Operator& op,
+                                    const PropertyTree& prm,
+                                    const std::function<Vector()>& weightsCalculator,
+                                    std::size_t pressureIndex)
+    {
+#if FLOW_INSTANTIATE_FLOAT
+        using OperatorF = Dune::MatrixAdapter<MatrixF, VectorF, VectorF>;
+        using FactoryF = PreconditionerFactory<OperatorF, Comm>;
+        const auto weightsF = convertWeights(weightsCalculator);
+        return std::make_shared<MixedPrecisionPreconditioner<Matrix, Vector, OperatorF>>(
+            op.getmat(),
+            [](const MatrixF& A) { return std::make_unique<OperatorF>(A); },
+            [&prm, &weightsF, pressureIndex](const OperatorF& opF) {
+                return FactoryF::create(opF, prm, weightsF, pressureIndex);
+            });
+#else
+        DUNE_UNUSED_PARAMETER(op);
+        DUNE_UNUSED_PARAMETER(prm);
+        DUNE_UNUSED_PARAMETER(weightsCalculator);
+        DUNE_UNUSED_PARAMETER(pressureIndex);
+        OPM_THROW(std::invalid_argument,
+                  "Preconditioners with mixed_precision require the float variants "
+                  "(BUILD_FLOW_FLOAT_VARIANTS=ON).");
+#endif
+    }
+
+    static PrecPtr createParallel(const Operator& op,
+                                  const PropertyTree& prm,
+                                  const std::function<Vector()>& weightsCalculator,
+                                  std::size_t pressureIndex,
+                                  const Comm& comm)
+    {
+        if constexpr (std::is_same_v<Comm, Dune::Amg::SequentialInformation>) {
+            return createSequential(op, prm, weightsCalculator, pressureIndex);
+        } else {
+#if FLOW_INSTANTIATE_FLOAT
+            using OperatorF = Dune::OverlappingSchwarzOperator<MatrixF, VectorF, VectorF, Comm>;
+            using FactoryF = PreconditionerFactory<OperatorF, Comm>;
+            const auto weightsF = convertWeights(weightsCalculator);
+            return std::make_shared<MixedPrecisionPreconditioner<Matrix, Vector, OperatorF>>(
+                op.getmat(),
+                [&comm](const MatrixF& A) { return std::make_unique<OperatorF>(A, comm); },
+                [&prm, &weightsF, pressureIndex, &comm](const OperatorF& opF) {
+                    return FactoryF::create(opF, prm, weightsF, comm, pressureIndex);
+                });
+#else
+            DUNE_UNUSED_PARAMETER(comm);
+            return createSequential(op, prm, weightsCalculator, pressureIndex);
+#endif
+        }
+    }
+
+private:
+    static std::function<VectorF()> convertWeights(const std::function<Vector()>& weightsCalculator)
+    {
+        if (!weightsCalculator) {
+            return {};
+        }
+        return [weightsCalculator]() {
+            VectorF weights;
+            detail::convertVector(weightsCalculator(), weights);
+            return weights;
+        };
+    }
+};
+
 template <class Operator, class Comm>
 PreconditionerFactory<Operator, Comm>::PreconditionerFactory()
 {
@@ -680,6 +779,12 @@ PreconditionerFactory<Operator, Comm>::doCreate(const Operator& op,
         StandardPreconditioners<Operator, Comm>::add();
         defAdded_ = true;
     }
+    if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+        if (prm.get<bool>("mixed_precision", false)) {
+            return MixedPrecisionPreconditioners<Operator, Comm>::createSequential(op, prm, weightsCalculator,
+                                                                                   pressureIndex);
+        }
+    }
     const std::string& type = prm.get<std::string>("type", "ParOverILU0");
     auto it = creators_.find(type);
     if (it == creators_.end()) {
@@ -706,6 +811,12 @@ PreconditionerFactory<Operator, Comm>::doCreate(const Operator& op,
         StandardPreconditioners<Operator, Comm>::add();
         defAdded_ = true;
     }
+    if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+        if (prm.get<bool>("mixed_precision", false)) {
+            return MixedPrecisionPreconditioners<Operator, Comm>::createParallel(op, prm, weightsCalculator,
+                                                                                 pressureIndex, comm);
+        }
+    }
     const std::string& type = prm.get<std::string>("type", "ParOverILU0");
     auto it = parallel_creators_.find(type);
     if (it == parallel_creators_.end()) {
@@ -22,6 +22,10 @@
 #define OPM_SMALL_DENSE_MATRIX_UTILS_HEADER_INCLUDED
 
 #include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+
+#include <cassert>
+#include <type_traits>
 
 namespace Opm
 {
@@ -137,6 +141,119 @@ namespace detail
         }
     }
 
+    //! True for Dune::FieldMatrix and the classes derived from it, e.g.
+    //! MatrixBlock, whose dimensions are known at compile time.
+    template <class Block, class = void>
+    struct IsFixedSizeBlock : std::false_type {};
+
+    template <class Block>
+    struct IsFixedSizeBlock<Block,
+                            std::enable_if_t<std::is_base_of_v<Dune::FieldMatrix<typename Block::field_type,
+                                                                                 Block::rows, Block::cols>,
+                                                               Block>>>
+        : std::true_type {};
+
+    // The kernels below are used for the blocks of the sparse matrices in
+    // the triangular solves and decompositions of the ILU and DILU
+    // preconditioners and in the sparse matrix-vector product. The loops
+    // have compile time bounds and accumulate each result in a local
+    // variable, so the compiler unrolls and vectorizes them completely,
+    // which it does not for the generic DenseMatrix implementations of
+    // dune-common. Other block types use the member functions.
+
+    //! calculates y = A * x
+    template <class Block, class X, class Y>
+    static inline void mvBlock(const Block& A, const X& x, Y& y)
+    {
+        if constexpr (IsFixedSizeBlock<Block>::value) {
+            assert(static_cast<const void*>(&x) != static_cast<const void*>(&y));
+            for (int i = 0; i < Block::rows; ++i) {
+                typename Y::field_type sum = 0;
+                for (int j = 0; j < Block::cols; ++j) {
+                    sum += A[i][j] * x[j];
+                }
+                y[i] = sum;
+            }
+        } else {
+            A.mv(x, y);
+        }
+    }
+
+    //! calculates y += A * x
+    template <class Block, class X, class Y>
+    static inline void umvBlock(const Block& A, const X& x, Y& y)
+    {
+        if constexpr (IsFixedSizeBlock<Block>::value) {
+            for (int i = 0; i < Block::rows; ++i) {
+                typename Y::field_type sum = 0;
+                for (int j = 0; j < Block::cols; ++j) {
+                    sum += A[i][j] * x[j];
+                }
+                y[i] += sum;
+            }
+        } else {
+            A.umv(x, y);
+        }
+    }
+
+    //! calculates y -= A * x
+    template <class Block, class X, class Y>
+    static inline void mmvBlock(const Block& A, const X& x, Y& y)
+    {
+        if constexpr (IsFixedSizeBlock<Block>::value) {
+            for (int i = 0; i < Block::rows; ++i) {
+                typename Y::field_type sum = 0;
+                for (int j = 0; j < Block::cols; ++j) {
+                    sum += A[i][j] * x[j];
+                }
+                y[i] -= sum;
+            }
+        } else {
+            A.mmv(x, y);
+        }
+    }
+
+    //! calculates C -= A * B
+    template <class BlockA, class BlockB, class BlockC>
+    static inline void mmmBlock(const BlockA& A, const BlockB& B, BlockC& C)
+    {
+        static_assert(IsFixedSizeBlock<BlockA>::value && IsFixedSizeBlock<BlockB>::value &&
+                      IsFixedSizeBlock<BlockC>::value, "mmmBlock requires fixed size blocks");
+        static_assert(BlockA::cols == BlockB::rows && BlockA::rows == BlockC::rows &&
+                      BlockB::cols == BlockC::cols, "mmmBlock: block dimensions do not match");
+        assert(static_cast<const void*>(&A) != static_cast<const void*>(&C) &&
+               static_cast<const void*>(&B) != static_cast<const void*>(&C));
+        for (int i = 0; i < BlockC::rows; ++i) {
+            for (int j = 0; j < BlockC::cols; ++j) {
+                typename BlockC::field_type sum = 0;
+                for (int k = 0; k < BlockA::cols; ++k) {
+                    sum += A[i][k] * B[k][j];
+                }
+                C[i][j] -= sum;
+            }
+        }
+    }
+
+    //! calculates A = A * B for a square block B
+    template <class BlockA, class BlockB>
+    static inline void rightMultiplyBlock(BlockA& A, const BlockB& B)
+    {
+        static_assert(IsFixedSizeBlock<BlockA>::value && IsFixedSizeBlock<BlockB>::value,
+                      "rightMultiplyBlock requires fixed size blocks");
+        static_assert(BlockA::cols == BlockB::rows && BlockB::rows == BlockB::cols,
+                      "rightMultiplyBlock: block dimensions do not match");
+        for (int i = 0; i < BlockA::rows; ++i) {
+            const auto row = A[i];
+            for (int j = 0; j < BlockA::cols; ++j) {
+                typename BlockA::field_type sum = 0;
+                for (int k = 0; k < BlockA::cols; ++k) {
+                    sum += row[k] * B[k][j];
+                }
+                A[i][j] = sum;
+            }
+        }
+    }
+
 } // namespace detail
 } // namespace Opm
 
@@ -0,0 +1,318 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_UPWINDORDEREDSOLVER_HEADER_INCLUDED
+#define OPM_UPWINDORDEREDSOLVER_HEADER_INCLUDED
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/*!
+   \brief Direct solver for block matrices which are block lower triangular
+   after a symmetric permutation, such as the upwind discretization of
+   transport equations.
+
+   Row i of the matrix depends on row j if the block (i, j) is nonzero.
+   For an upwind discretization this is the case if j is an upstream
+   neighbour of i, so the dependencies are given by the flux directions
+   and the values of the matrix, not by its sparsity pattern alone.
+
+   On construction the strongly connected components of the dependency
+   graph are computed with Tarjan's algorithm. The algorithm yields the
+   components in an order where every component comes after all the
+   components it depends on, hence the system can be solved by a single
+   forward substitution in that order. Components of a single cell are
+   solved by inverting the diagonal block. Components containing more than
+   one cell are the result of cyclic flow, these are solved by a restarted
+   GMRES with ILU0 preconditioning on the submatrix of the component.
+
+   The matrix must not change as long as the object is in use.
+
+   \tparam M The matrix type (a Dune::BCRSMatrix)
+   \tparam V The vector type (a Dune::BlockVector)
+ */
+template <class M, class V>
+class UpwindOrderedSolver
+{
+public:
+    using matrix_type = M;
+    using vector_type = V;
+    using block_type = typename M::block_type;
+    using field_type = typename M::field_type;
+
+    /*!
+       \brief Compute the ordering of the rows of A.
+
+       \param A The system matrix
+       \param reduction Residual reduction of the solves in cyclic components
+       \param maxIter Maximum number of iterations of these solves
+     */
+    UpwindOrderedSolver(const M& A, field_type reduction, int maxIter)
+        : A_(A)
+        , reduction_(reduction)
+        , maxIter_(maxIter)
+    {
+        computeOrdering_();
+        setupComponents_();
+    }
+
+    //! \brief The number of strongly connected components.
+    std::size_t numComponents() const
+    { return componentBegin_.size() - 1; }
+
+    //! \brief The number of rows in the largest strongly connected component.
+    std::size_t largestComponentSize() const
+    {
+        std::size_t largest = 0;
+        for (std::size_t comp = 0; comp < numComponents(); ++comp) {
+            largest = std::max(largest, componentBegin_[comp + 1] - componentBegin_[comp]);
+        }
+        return largest;
+    }
+
+    //! \brief The rows in solution order, grouped by component.
+    const std::vector<int>& ordering() const
+    { return order_; }
+
+    //! \brief The position of the first row of each component in ordering(),
+    //!        followed by the number of rows.
+    const std::vector<std::size_t>& componentBegin() const
+    { return componentBegin_; }
+
+    /*!
+       \brief Solve A x = b.
+
+       \return false if the solve of a cyclic component did not converge
+     */
+    bool apply(V& x, const V& b) const
+    {
+        x = 0.0;
+        bool converged = true;
+        std::size_t cyclicIdx = 0;
+        for (std::size_t comp = 0; comp < numComponents(); ++comp) {
+            const std::size_t begin = componentBegin_[comp];
+            const std::size_t end = componentBegin_[comp + 1];
+            if (end - begin == 1) {
+                const int row = order_[begin];
+                diagInv_[row].mv(residual_(row, x, b), x[row]);
+            }
+            else {
+                converged = solveComponent_(cyclic_[cyclicIdx++], x, b) && converged;
+            }
+        }
+        return converged;
+    }
+
+private:
+    using Operator = Dune::MatrixAdapter<M, V, V>;
+    using Preconditioner = Dune::SeqILU<M, V, V>;
+
+    // Submatrix and preconditioner of a component with more than one row.
+    struct CyclicComponent
+    {
+        std::vector<int> rows;
+        std::unique_ptr<M> matrix;
+        std::unique_ptr<Operator> op;
+        std::unique_ptr<Preconditioner> precond;
+    };
+
+    static bool isCoupling_(const block_type& block)
+    {
+        return block.infinity_norm() != 0.0;
+    }
+
+    // b_row - sum_j A_(row, j) x_j, where x is zero in the rows which are
+    // not solved yet.
+    typename V::block_type residual_(const int row, const V& x, const V& b) const
+    {
+        auto r = b[row];
+        const auto endc = A_[row].end();
+        for (auto col = A_[row].begin(); col != endc; ++col) {
+            if (static_cast<int>(col.index()) != row) {
+                col->mmv(x[col.index()], r);
+            }
+        }
+        return r;
+    }
+
+    // Tarjan's strongly connected components algorithm. The depth first
+    // search uses an explicit stack, as the depth of the recursion would be
+    // bounded by the number of rows only.
+    void computeOrdering_()
+    {
+        const int n = A_.N();
+        constexpr int unvisited = -1;
+        std::vector<int> index(n, unvisited);
+        std::vector<int> lowLink(n, 0);
+        std::vector<char> onStack(n, false);
+        std::vector<int> stack;
+        std::vector<std::pair<int, typename M::ConstColIterator>> callStack;
+        int nextIndex = 0;
+
+        order_.clear();
+        order_.reserve(n);
+        componentBegin_.assign(1, 0);
+
+        auto visit = [&](const int row)
+        {
+            index[row] = lowLink[row] = nextIndex++;
+            stack.push_back(row);
+            onStack[row] = true;
+            callStack.emplace_back(row, A_[row].begin());
+        };
+
+        for (int root = 0; root < n; ++root) {
+            if (index[root] != unvisited) {
+                continue;
+            }
+            visit(root);
+            while (!callStack.empty()) {
+                const int row = callStack.back().first;
+                auto& col = callStack.back().second;
+                const auto endc = A_[row].end();
+                int next = unvisited;
+                for (; col != endc; ++col) {
+                    const int dep = col.index();
+                    if (dep == row || !isCoupling_(*col)) {
+                        continue;
+                    }
+                    if (index[dep] == unvisited) {
+                        next = dep;
+                        ++col;
+                        break;
+                    }
+                    if (onStack[dep]) {
+                        lowLink[row] = std::min(lowLink[row], index[dep]);
+                    }
+                }
+                if (next != unvisited) {
+                    visit(next);
+                    continue;
+                }
+
+                // all dependencies of row are visited
+                if (lowLink[row] == index[row]) {
+                    int member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        onStack[member] = false;
+                        order_.push_back(member);
+                    } while (member != row);
+                    componentBegin_.push_back(order_.size());
+                }
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    const int parent = callStack.back().first;
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[row]);
+                }
+            }
+        }
+    }
+
+    void setupComponents_()
+    {
+        diagInv_.resize(A_.N());
+        std::vector<int> localIdx(A_.N(), -1);
+        for (std::size_t comp = 0; comp < numComponents(); ++comp) {
+            const std::size_t begin = componentBegin_[comp];
+            const std::size_t end = componentBegin_[comp + 1];
+            if (end - begin == 1) {
+                const int row = order_[begin];
+                diagInv_[row] = A_[row][row];
+                diagInv_[row].invert();
+                continue;
+            }
+
+            CyclicComponent& cyclic = cyclic_.emplace_back();
+            cyclic.rows.assign(order_.begin() + begin, order_.begin() + end);
+            std::sort(cyclic.rows.begin(), cyclic.rows.end());
+            for (std::size_t i = 0; i < cyclic.rows.size(); ++i) {
+                localIdx[cyclic.rows[i]] = i;
+            }
+
+            const std::size_t size = cyclic.rows.size();
+            cyclic.matrix = std::make_unique<M>(size, size, M::row_wise);
+            for (auto row = cyclic.matrix->createbegin(); row != cyclic.matrix->createend(); ++row) {
+                const auto& globalRow = A_[cyclic.rows[row.index()]];
+                for (auto col = globalRow.begin(); col != globalRow.end(); ++col) {
+                    if (localIdx[col.index()] >= 0) {
+                        row.insert(localIdx[col.index()]);
+                    }
+                }
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto& globalRow = A_[cyclic.rows[i]];
+                for (auto col = globalRow.begin(); col != globalRow.end(); ++col) {
+                    if (localIdx[col.index()] >= 0) {
+                        (*cyclic.matrix)[i][localIdx[col.index()]] = *col;
+                    }
+                }
+            }
+            for (const int row : cyclic.rows) {
+                localIdx[row] = -1;
+            }
+
+            cyclic.op = std::make_unique<Operator>(*cyclic.matrix);
+            cyclic.precond = std::make_unique<Preconditioner>(*cyclic.matrix, 0, 1); // results in ILU0
+        }
+    }
+
+    bool solveComponent_(const CyclicComponent& cyclic, V& x, const V& b) const
+    {
+        const std::size_t size = cyclic.rows.size();
+        V localX(size);
+        V localB(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            localB[i] = residual_(cyclic.rows[i], x, b);
+        }
+        localX = 0.0;
+
+        const int restart = std::min<int>(maxIter_, 30);
+        Dune::RestartedGMResSolver<V> solver(*cyclic.op, *cyclic.precond,
+                                             reduction_, restart, maxIter_, 0);
+        Dune::InverseOperatorResult result;
+        solver.apply(localX, localB, result);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            x[cyclic.rows[i]] = localX[i];
+        }
+        return result.converged;
+    }
+
+    const M& A_;
+    field_type reduction_;
+    int maxIter_;
+    std::vector<int> order_;
+    std::vector<std::size_t> componentBegin_;
+    std::vector<block_type> diagInv_;
+    std::vector<CyclicComponent> cyclic_;
+};
+
+} // namespace Opm
+
+#endif // OPM_UPWINDORDEREDSOLVER_HEADER_INCLUDED
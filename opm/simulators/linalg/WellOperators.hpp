@@ -28,11 +28,15 @@
 
 #include <opm/common/TimingMacros.hpp>
 
+#include <opm/simulators/linalg/HaloExchange.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/ParallelSpMV.hpp>
 #include <dune/common/shared_ptr.hh>
 #include <dune/istl/paamg/smoother.hh>
 
 #include <cstddef>
+#include <memory>
+#include <utility>
 
 namespace Opm {
 
@@ -199,13 +203,13 @@ public:
     WellModelMatrixAdapter (const M& A,
                             const LinearOperatorExtra<X, Y>& wellOper,
                             const std::shared_ptr<communication_type>& comm = {})
-        : A_( A ), wellOper_( wellOper ), comm_(comm)
+        : A_( A ), wellOper_( wellOper ), comm_(comm), spmv_( A )
     {}
 
     void apply( const X& x, Y& y ) const override
     {
       OPM_TIMEBLOCK(apply);
-      A_.mv(x, y);
+      spmv_.mv(x, y);
 
       // add well model modification to y
       wellOper_.apply(x, y);
@@ -221,7 +225,7 @@ public:
     void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
       OPM_TIMEBLOCK(applyscaleadd);
-      A_.usmv(alpha, x, y);
+      spmv_.usmv(alpha, x, y);
 
       // add scaled well model modification to y
       wellOper_.applyscaleadd(alpha, x, y);
@@ -258,6 +262,7 @@ protected:
     const matrix_type& A_ ;
     const LinearOperatorExtra<X, Y>& wellOper_;
     std::shared_ptr<communication_type> comm_;
+    ParallelSpMV<matrix_type> spmv_;
 };
 
 /*!
@@ -294,17 +299,20 @@ public:
                                      const LinearOperatorExtra<X, Y>& wellOper,
                                      const std::size_t interiorSize )
         : A_( A ), wellOper_( wellOper ), interiorSize_(interiorSize)
+        , spmv_( A, interiorSize )
     {}
 
     void apply(const X& x, Y& y) const override
     {
         OPM_TIMEBLOCK(apply);
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
-        {
-            y[row.index()]=0;
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).umv(x[col.index()], y[row.index()]);
+        if (haloExchange_ && haloExchange_->isPending(x)) {
+            // multiply the inner rows while the ghost entries of x arrive
+            spmv_.mvInner(x, y);
+            haloExchange_->finish();
+            spmv_.mvBorder(x, y);
+        } else {
+            finishHaloExchange();
+            spmv_.mv(x, y);
         }
 
         // add well model modification to y
@@ -317,11 +325,13 @@ public:
     void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
         OPM_TIMEBLOCK(applyscaleadd);
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
-        {
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).usmv(alpha, x[col.index()], y[row.index()]);
+        if (haloExchange_ && haloExchange_->isPending(x)) {
+            spmv_.usmvInner(alpha, x, y);
+            haloExchange_->finish();
+            spmv_.usmvBorder(alpha, x, y);
+        } else {
+            finishHaloExchange();
+            spmv_.usmv(alpha, x, y);
         }
         // add scaled well model modification to y
         wellOper_.applyscaleadd(alpha, x, y);
@@ -350,6 +360,16 @@ public:
         return wellOper_.getNumberOfExtraEquations();
     }
 
+    //! \brief Use the given exchange to complete the ghost entries of the
+    //!        vectors passed to apply(), see GhostLastMatrixAdapter.
+    void setHaloExchange(std::shared_ptr<HaloExchange<X>> haloExchange)
+    {
+        haloExchange_ = std::move(haloExchange);
+        if (haloExchange_) {
+            spmv_.splitBorderRows(interiorSize_);
+        }
+    }
+
 protected:
     void ghostLastProject(Y& y) const
     {
@@ -358,9 +378,18 @@ protected:
             y[i] = 0;
     }
 
+    void finishHaloExchange() const
+    {
+        if (haloExchange_) {
+            haloExchange_->finish();
+        }
+    }
+
     const matrix_type& A_ ;
     const LinearOperatorExtra<X, Y>& wellOper_;
     std::size_t interiorSize_;
+    ParallelSpMV<matrix_type> spmv_;
+    std::shared_ptr<HaloExchange<X>> haloExchange_;
 };
 
 /*!
@@ -392,25 +421,27 @@ public:
     GhostLastMatrixAdapter (const M& A,
                             const communication_type& comm)
         : A_( Dune::stackobject_to_shared_ptr(A) ), comm_(comm)
+        , interiorSize_( setInteriorSize(comm_) ), spmv_( *A_, interiorSize_ )
     {
-        interiorSize_ = setInteriorSize(comm_);
     }
 
     GhostLastMatrixAdapter (const std::shared_ptr<M> A,
                             const communication_type& comm)
         : A_( A ), comm_(comm)
+        , interiorSize_( setInteriorSize(comm_) ), spmv_( *A_, interiorSize_ )
     {
-        interiorSize_ = setInteriorSize(comm_);
     }
 
     virtual void apply( const X& x, Y& y ) const override
     {
-        for (auto row = A_->begin(); row.index() < interiorSize_; ++row)
-        {
-            y[row.index()]=0;
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).umv(x[col.index()], y[row.index()]);
+        if (haloExchange_ && haloExchange_->isPending(x)) {
+            // multiply the inner rows while the ghost entries of x arrive
+            spmv_.mvInner(x, y);
+            haloExchange_->finish();
+            spmv_.mvBorder(x, y);
+        } else {
+            finishHaloExchange();
+            spmv_.mv(x, y);
         }
 
         ghostLastProject( y );
@@ -419,11 +450,13 @@ public:
     // y += \alpha * A * x
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
-        for (auto row = A_->begin(); row.index() < interiorSize_; ++row)
-        {
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).usmv(alpha, x[col.index()], y[row.index()]);
+        if (haloExchange_ && haloExchange_->isPending(x)) {
+            spmv_.usmvInner(alpha, x, y);
+            haloExchange_->finish();
+            spmv_.usmvBorder(alpha, x, y);
+        } else {
+            finishHaloExchange();
+            spmv_.usmv(alpha, x, y);
         }
 
         ghostLastProject( y );
@@ -433,7 +466,32 @@ public:
 
     size_t getInteriorSize() const { return interiorSize_;}
 
+    /*!
+       \brief Use the given exchange to complete the ghost entries of the
+       vectors passed to apply().
+
+       If the exchange of x has been started but not finished, e.g. by the
+       preconditioner which computed x, the rows which only couple to
+       interior entries are multiplied first, then the exchange is finished
+       and the remaining rows are multiplied. Other pending exchanges are
+       finished before the product.
+     */
+    void setHaloExchange(std::shared_ptr<HaloExchange<X>> haloExchange)
+    {
+        haloExchange_ = std::move(haloExchange);
+        if (haloExchange_) {
+            spmv_.splitBorderRows(interiorSize_);
+        }
+    }
+
 private:
+    void finishHaloExchange() const
+    {
+        if (haloExchange_) {
+            haloExchange_->finish();
+        }
+    }
+
     void ghostLastProject(Y& y) const
     {
         size_t end = y.size();
@@ -463,6 +521,8 @@ private:
     const std::shared_ptr<const matrix_type> A_ ;
     const communication_type&  comm_;
     size_t interiorSize_;
+    ParallelSpMV<matrix_type> spmv_;
+    std::shared_ptr<HaloExchange<X>> haloExchange_;
 };
 
 } // namespace Opm
@@ -23,6 +23,7 @@
 #include <dune/common/exceptions.hh>
 
 #include <memory>
+#include <type_traits>
 
 namespace Dune
 {
@@ -280,6 +281,16 @@ namespace Dune
 
       void setupCoarseSolver();
 
+      /**
+       * @brief Update the smoothers of all levels with the values of the
+       *        recalculated matrix hierarchy.
+       *
+       * This is only possible if the smoother can update itself from the
+       * values of its matrix without loss, e.g. ILU0 and DILU.
+       * @return false if the smoothers have to be recreated.
+       */
+      bool updateSmoothers();
+
       /**
        * @brief A struct that holds the context of the current level.
        *
@@ -476,15 +487,18 @@ namespace Dune
     {
       OPM_TIMEBLOCK(update);
       Timer watch;
-      smoothers_.reset(new Hierarchy<Smoother,A>);
       solver_.reset();
       coarseSmoother_.reset();
       scalarProduct_.reset();
       buildHierarchy_= true;
       coarsesolverconverged = true;
-      smoothers_.reset(new Hierarchy<Smoother,A>);
+      // The aggregates are kept, only the values of the coarse matrices
+      // and of the smoothers change.
       recalculateHierarchy();
-      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      if (!updateSmoothers()) {
+        smoothers_.reset(new Hierarchy<Smoother,A>);
+        matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      }
       setupCoarseSolver();
       if (verbosity_>0 && matrices_->parallelInformation().finest()->communicator().rank()==0) {
         std::cout << "Recalculating galerkin and coarse smoothers "<< matrices_->maxlevels() << " levels "
@@ -492,6 +506,31 @@ namespace Dune
       }
     }
 
+    template<class M, class X, class S, class PI, class A>
+    bool AMGCPR<M,X,S,PI,A>::updateSmoothers()
+    {
+      if constexpr (std::is_base_of_v<Dune::PreconditionerWithUpdate<X,X>, Smoother>) {
+        if (smoothers_->levels() == 0)
+          return false;
+        using Iterator = typename Hierarchy<Smoother,A>::Iterator;
+        const Iterator coarsest = smoothers_->coarsest();
+        for (Iterator smoother = smoothers_->finest(); ; ++smoother) {
+          if (!smoother->hasPerfectUpdate())
+            return false;
+          if (smoother == coarsest)
+            break;
+        }
+        for (Iterator smoother = smoothers_->finest(); ; ++smoother) {
+          smoother->update();
+          if (smoother == coarsest)
+            break;
+        }
+        return true;
+      } else {
+        return false;
+      }
+    }
+
     template<class M, class X, class S, class PI, class A>
     template<class C>
     void AMGCPR<M,X,S,PI,A>::createHierarchies(C& criterion, std::shared_ptr< Operator > matrix,
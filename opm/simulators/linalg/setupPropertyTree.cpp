@@ -145,6 +145,9 @@ setupCPRW(const std::string& /*conf*/, const FlowLinearSolverParameters& p)
     prm.put("preconditioner.weight_type", "trueimpes"s);
     prm.put("preconditioner.finesmoother.type", "ParOverILU0"s);
     prm.put("preconditioner.finesmoother.relaxation", 1.0);
+    if (p.ilu_reorder_rcm_) {
+        prm.put("preconditioner.finesmoother.reorder_rcm", true);
+    }
     prm.put("preconditioner.verbosity", 0);
     prm.put("preconditioner.coarsesolver.maxiter", 1);
     prm.put("preconditioner.coarsesolver.tol", 1e-1);
@@ -193,6 +196,9 @@ setupCPR(const std::string& conf, const FlowLinearSolverParameters& p)
     }
     prm.put("preconditioner.finesmoother.type", "ParOverILU0"s);
     prm.put("preconditioner.finesmoother.relaxation", 1.0);
+    if (p.ilu_reorder_rcm_) {
+        prm.put("preconditioner.finesmoother.reorder_rcm", true);
+    }
     prm.put("preconditioner.verbosity", 0);
     prm.put("preconditioner.coarsesolver.maxiter", 1);
     prm.put("preconditioner.coarsesolver.tol", 1e-1);
@@ -269,6 +275,9 @@ setupILU([[maybe_unused]] const std::string& conf, const FlowLinearSolverParamet
     prm.put("preconditioner.type", "ParOverILU0"s);
     prm.put("preconditioner.relaxation", p.ilu_relaxation_);
     prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
+    if (p.ilu_reorder_rcm_) {
+        prm.put("preconditioner.reorder_rcm", true);
+    }
     return prm;
 }
 
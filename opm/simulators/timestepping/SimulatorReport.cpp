@@ -33,9 +33,9 @@ namespace Opm
     SimulatorReportSingle SimulatorReportSingle::serializationTestObject()
     {
         return SimulatorReportSingle{1.0, 2.0, 3.0, 4.0, 5.0, 6.0,
-                                     7.0, 8.0, 9.0, 10.0, 11.0,
-                                     12, 13, 14, 15, 16, 17,
-                                     true, false, 18, 19.0, 20.0};
+                                     7.0, 8.0, 9.0, 10.0, 11.0, 12.0,
+                                     13, 14, 15, 16, 17, 18,
+                                     true, false, 19, 20.0, 21.0};
     }
 
     bool SimulatorReportSingle::operator==(const SimulatorReportSingle& rhs) const
@@ -46,6 +46,7 @@ namespace Opm
                this->solver_time == rhs.solver_time &&
                this->assemble_time == rhs.assemble_time &&
                this->pre_post_time == rhs.pre_post_time &&
+               this->well_potentials_time == rhs.well_potentials_time &&
                this->assemble_time_well == rhs.assemble_time_well &&
                this->linear_solve_setup_time == rhs.linear_solve_setup_time &&
                this->linear_solve_time == rhs.linear_solve_time &&
@@ -73,6 +74,7 @@ namespace Opm
         solver_time += sr.solver_time;
         assemble_time += sr.assemble_time;
         pre_post_time += sr.pre_post_time;
+        well_potentials_time += sr.well_potentials_time;
         assemble_time_well += sr.assemble_time_well;
         update_time += sr.update_time;
         output_write_time += sr.output_write_time;
@@ -177,6 +179,15 @@ namespace Opm
             }
             os << std::endl;
 
+            t = well_potentials_time + (failureReport ? failureReport->well_potentials_time : 0.0);
+            os << fmt::format("    Well potentials:          {:7.2f} s", t);
+            if (failureReport) {
+              os << fmt::format(" (Wasted: {:2.1f} s; {:2.1f}%)",
+                                failureReport->well_potentials_time,
+                                100*failureReport->well_potentials_time/noZero(t));
+            }
+            os << std::endl;
+
             os << fmt::format("  Output write time:          {:7.2f} s",
                               output_write_time + (failureReport ? failureReport->output_write_time : 0.0));
             os << std::endl;
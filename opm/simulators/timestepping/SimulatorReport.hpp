@@ -38,6 +38,7 @@ namespace Opm
         double solver_time = 0.0;
         double assemble_time = 0.0;
         double pre_post_time = 0.0;
+        double well_potentials_time = 0.0;
         double assemble_time_well = 0.0;
         double linear_solve_setup_time = 0.0;
         double linear_solve_time = 0.0;
@@ -77,6 +78,7 @@ namespace Opm
             serializer(solver_time);
             serializer(assemble_time);
             serializer(pre_post_time);
+            serializer(well_potentials_time);
             serializer(assemble_time_well);
             serializer(linear_solve_setup_time);
             serializer(linear_solve_time);
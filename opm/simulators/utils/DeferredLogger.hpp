@@ -87,6 +87,10 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Add the messages of another logger (e.g. a thread-local
+        /// one) to the end of the message container.
+        void append(const DeferredLogger& other);
+
     private:
         std::vector<Message> messages_;
         friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger,
@@ -27,6 +27,7 @@
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <cstddef>
+#include <exception>
 #include <map>
 #include <memory>
 #include <optional>
@@ -214,7 +215,12 @@ template<class Scalar> class WellContributions;
             }
 
             void endIteration()
-            { }
+            {
+                // complete the sums started after assembling the wells
+                if (this->well_comm_batch_.pending()) {
+                    this->well_comm_batch_.finish();
+                }
+            }
 
             void endTimeStep()
             {
@@ -444,6 +450,8 @@ template<class Scalar> class WellContributions;
 
             // used to better efficiency of calcuation
             mutable BVector scaleAddRes_{};
+            // the same for each domain, sized to the domain
+            mutable std::vector<BVector> domain_scale_add_res_{};
 
             std::vector<Scalar> B_avg_{};
 
@@ -527,12 +535,19 @@ template<class Scalar> class WellContributions;
 
             void updateAverageFormationFactor();
 
-            void computePotentials(const std::size_t widx,
+            void computePotentials(const std::vector<std::size_t>& well_indices,
                                    const WellState<Scalar>& well_state_copy,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
                                    DeferredLogger& deferred_logger) override;
 
+            void computePotentials(const std::size_t widx,
+                                   const WellState<Scalar>& well_state_copy,
+                                   std::vector<Scalar>& potentials,
+                                   std::string& exc_msg,
+                                   ExceptionType::ExcEnum& exc_type,
+                                   DeferredLogger& deferred_logger) const;
+
             const std::vector<Scalar>& wellPerfEfficiencyFactors() const;
 
             void calculateProductivityIndexValuesShutWells(const int reportStepIdx, DeferredLogger& deferred_logger) override;
@@ -553,6 +568,17 @@ template<class Scalar> class WellContributions;
             // TODO: finding a better naming
             void assembleWellEqWithoutIteration(const double dt, DeferredLogger& deferred_logger);
 
+            // Call func(wellIdx, deferred_logger) for all wells in well_container_.
+            // With threaded wells, the wells are distributed over the OpenMP threads
+            // and each well gets its own deferred logger. The messages are appended
+            // to deferred_logger and exceptions are rethrown in the order of the wells.
+            // Wells which are distributed over several processes are processed
+            // sequentially, as they communicate.
+            template<class Func>
+            void forEachWell(Func&& func, DeferredLogger& deferred_logger) const;
+
+            bool useThreadedWells() const;
+
             bool maybeDoGasLiftOptimize(DeferredLogger& deferred_logger);
 
             void gasLiftOptimizationStage1(DeferredLogger& deferred_logger,
@@ -605,6 +631,16 @@ template<class Scalar> class WellContributions;
             mutable BVector Ax_local_;
             mutable BVector res_local_;
             mutable GlobalEqVector linearize_res_local_;
+
+            // Per well buffers of the threaded apply() and
+            // recoverWellSolutionAndUpdateWellState().
+            mutable std::vector<BVector> well_x_local_;
+            mutable std::vector<BVector> well_Ax_local_;
+
+            // Per well loggers and exceptions of forEachWell(), reused such
+            // that e.g. apply() does not allocate them for every call.
+            mutable std::vector<DeferredLogger> well_loggers_;
+            mutable std::vector<std::exception_ptr> well_exceptions_;
         };
 
 
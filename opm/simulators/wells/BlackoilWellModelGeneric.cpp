@@ -25,6 +25,7 @@
 #include <opm/simulators/wells/BlackoilWellModelGeneric.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <opm/output/data/GuideRateValue.hpp>
 #include <opm/output/data/Groups.hpp>
@@ -49,12 +50,15 @@
 
 #include <opm/input/eclipse/Units/Units.hpp>
 
+#include <opm/models/parallel/threadmanager.hpp>
+
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/wells/BlackoilWellModelConstraints.hpp>
 #include <opm/simulators/wells/BlackoilWellModelGuideRates.hpp>
 #include <opm/simulators/wells/BlackoilWellModelRestart.hpp>
 #include <opm/simulators/wells/GasLiftStage2.hpp>
 #include <opm/simulators/wells/GroupEconomicLimitsChecker.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
 #include <opm/simulators/wells/VFPProperties.hpp>
 #include <opm/simulators/wells/WellFilterCake.hpp>
@@ -69,6 +73,8 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <initializer_list>
+#include <memory>
 #include <stack>
 #include <stdexcept>
 #include <string_view>
@@ -78,6 +84,8 @@
 #include <utility>
 #include <vector>
 
+#include <dune/common/timer.hh>
+
 #include <fmt/format.h>
 
 namespace Opm {
@@ -95,6 +103,7 @@ BlackoilWellModelGeneric(Schedule& schedule,
     , comm_(comm)
     , phase_usage_(phase_usage)
     , wbpCalculationService_ { eclState.gridDims(), comm_ }
+    , well_comm_batch_ { comm_ }
     , guideRate_(schedule)
     , active_wgstate_(phase_usage)
     , last_valid_wgstate_(phase_usage)
@@ -316,6 +325,59 @@ initializeWellProdIndCalculators()
     }
 }
 
+template<class Scalar>
+void BlackoilWellModelGeneric<Scalar>::
+initializeWellCommunicationBatch(const int reportStepIdx)
+{
+    std::vector<int> distributed_wells;
+    for (std::size_t w = 0; w < wells_ecl_.size(); ++w) {
+        if (local_parallel_well_info_[w].get().communication().size() > 1) {
+            distributed_wells.push_back(wells_ecl_[w].seqIndex());
+        }
+    }
+    well_comm_batch_.setWells(schedule().numWells(reportStepIdx), distributed_wells);
+}
+
+template<class Scalar>
+void BlackoilWellModelGeneric<Scalar>::
+collectBhpAtThpLimitCounts()
+{
+    for (const auto* well : well_container_generic_) {
+        auto& cache = well->bhpAtThpLimitCache();
+        bhp_at_thp_limit_counts_[0] += cache.hits;
+        bhp_at_thp_limit_counts_[1] += cache.warm_starts;
+        bhp_at_thp_limit_counts_[2] += cache.misses;
+        cache.hits = 0;
+        cache.warm_starts = 0;
+        cache.misses = 0;
+    }
+}
+
+template<class Scalar>
+void BlackoilWellModelGeneric<Scalar>::
+logBhpAtThpLimitCounts()
+{
+    collectBhpAtThpLimitCounts();
+    auto counts = bhp_at_thp_limit_counts_;
+    comm_.sum(counts.data(), counts.size());
+    bhp_at_thp_limit_counts_.fill(0);
+    if (terminal_output_ && counts[0] + counts[1] + counts[2] > 0) {
+        OpmLog::debug(fmt::format("BHP at THP limit solves in this report step: "
+                                  "{} skipped, {} warm started, {} from scratch",
+                                  counts[0], counts[1], counts[2]));
+    }
+}
+
+template<class Scalar>
+void BlackoilWellModelGeneric<Scalar>::
+updateGroupTree(const int reportStepIdx)
+{
+    auto tree = std::make_shared<const GroupTree>(schedule(), reportStepIdx);
+    for (auto* wgstate : {&active_wgstate_, &last_valid_wgstate_, &nupcol_wgstate_}) {
+        wgstate->group_state.setGroupTree(tree);
+    }
+}
+
 template<class Scalar>
 void BlackoilWellModelGeneric<Scalar>::
 initializeWellPerfData()
@@ -1523,14 +1585,22 @@ template<class Scalar>
 void BlackoilWellModelGeneric<Scalar>::
 calculateEfficiencyFactors(const int reportStepIdx)
 {
+    const GroupTree* group_tree = this->groupState().groupTree(reportStepIdx);
     for (auto& well : well_container_generic_) {
         const Well& wellEcl = well->wellEcl();
         Scalar well_efficiency_factor = wellEcl.getEfficiencyFactor();
-        WellGroupHelpers<Scalar>::accumulateGroupEfficiencyFactor(schedule().getGroup(wellEcl.groupName(),
-                                                                                      reportStepIdx),
-                                                                  schedule(),
-                                                                  reportStepIdx,
-                                                                  well_efficiency_factor);
+        const int group = group_tree ? group_tree->groupIndex(wellEcl.groupName()) : -1;
+        if (group >= 0) {
+            WellGroupHelpers<Scalar>::accumulateGroupEfficiencyFactor(*group_tree,
+                                                                      group,
+                                                                      well_efficiency_factor);
+        } else {
+            WellGroupHelpers<Scalar>::accumulateGroupEfficiencyFactor(schedule().getGroup(wellEcl.groupName(),
+                                                                                          reportStepIdx),
+                                                                      schedule(),
+                                                                      reportStepIdx,
+                                                                      well_efficiency_factor);
+        }
         well->setWellEfficiencyFactor(well_efficiency_factor);
     }
 }
@@ -1626,11 +1696,14 @@ updateWellPotentials(const int reportStepIdx,
                      const SummaryConfig& summaryConfig,
                      DeferredLogger& deferred_logger)
 {
+    Dune::Timer perfTimer;
+    perfTimer.start();
     auto well_state_copy = this->wellState();
 
     const bool write_restart_file = schedule().write_rst_file(reportStepIdx);
     auto exc_type = ExceptionType::NONE;
     std::string exc_msg;
+    std::vector<std::size_t> well_indices;
     std::size_t widx = 0;
     for (const auto& well : well_container_generic_) {
         const bool needed_for_summary =
@@ -1671,15 +1744,59 @@ updateWellPotentials(const int reportStepIdx,
         const bool compute_potential = needPotentialsForOutput || needPotentialsForGuideRates;
         if (compute_potential)
         {
-            this->computePotentials(widx, well_state_copy, exc_msg, exc_type, deferred_logger);
+            well_indices.push_back(widx);
         }
         ++widx;
     }
+
+    // The scratch copies are made on first use by each thread.
+    scratch_well_states_.clear();
+    scratch_well_states_.resize(ThreadManager::maxThreads());
+    this->computePotentials(well_indices, well_state_copy, exc_msg, exc_type, deferred_logger);
+    scratch_well_states_.clear();
+    well_potentials_time_ += perfTimer.stop();
+
     logAndCheckForProblemsAndThrow(deferred_logger, exc_type,
                                    "updateWellPotentials() failed: " + exc_msg,
                                    terminal_output_, comm_);
 }
 
+template<class Scalar>
+WellState<Scalar>* BlackoilWellModelGeneric<Scalar>::
+acquireScratchWellState(const std::size_t well_index) const
+{
+    const std::size_t thread = ThreadManager::threadId();
+    if (thread >= scratch_well_states_.size()) {
+        return nullptr;
+    }
+    auto& scratch = scratch_well_states_[thread];
+    if (scratch.in_use) {
+        return nullptr;
+    }
+    if (!scratch.state.has_value()) {
+        scratch.state.emplace(this->wellState());
+    } else {
+        // Only the entries of the wells of this thread may differ from the
+        // active well state, reset the one of the previous well.
+        if (scratch.last_well.has_value() && *scratch.last_well != well_index) {
+            scratch.state->well(*scratch.last_well) = this->wellState().well(*scratch.last_well);
+        }
+        scratch.state->well(well_index) = this->wellState().well(well_index);
+    }
+    scratch.last_well = well_index;
+    scratch.in_use = true;
+    return &*scratch.state;
+}
+
+template<class Scalar>
+void BlackoilWellModelGeneric<Scalar>::
+releaseScratchWellState() const
+{
+    const std::size_t thread = ThreadManager::threadId();
+    assert(thread < scratch_well_states_.size());
+    scratch_well_states_[thread].in_use = false;
+}
+
 template<class Scalar>
 void BlackoilWellModelGeneric<Scalar>::
 runWellPIScaling(const int reportStepIdx,
@@ -36,10 +36,12 @@
 #include <opm/simulators/wells/ParallelPAvgDynamicSourceData.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
+#include <opm/simulators/wells/WellCommunicationBatch.hpp>
 #include <opm/simulators/wells/WellFilterCake.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
 #include <opm/simulators/wells/WGState.hpp>
 
+#include <array>
 #include <cstddef>
 #include <functional>
 #include <map>
@@ -134,6 +136,21 @@ public:
         return this->active_wgstate_.well_state;
     }
 
+    /*
+      Copy of the active well state for calculations of a single well which
+      must not change the active one, e.g. the well potentials. Only the
+      entry of the given well is brought up to date. Returns nullptr outside
+      of updateWellPotentials() or if the copy of the calling thread is
+      already in use, then the caller has to copy the well state itself.
+      The copy must be handed back with releaseScratchWellState().
+    */
+    WellState<Scalar>* acquireScratchWellState(const std::size_t well_index) const;
+    void releaseScratchWellState() const;
+
+    //! \brief Accumulated wall time of updateWellPotentials().
+    double wellPotentialsTime() const
+    { return well_potentials_time_; }
+
     /*
       Will return the currently active nupcolWellState; must initialize
       the internal nupcol wellstate with initNupcolWellState() first.
@@ -142,6 +159,11 @@ public:
     {
         return this->nupcol_wgstate_.well_state;
     }
+
+    //! \brief Batch summing per well quantities of all distributed wells.
+    WellCommunicationBatch<Scalar>& wellCommunicationBatch() const
+    { return well_comm_batch_; }
+
     GroupState<Scalar>& groupState() { return this->active_wgstate_.group_state; }
 
     WellTestState& wellTestState() { return this->active_wgstate_.well_test_state; }
@@ -329,6 +351,19 @@ protected:
 
     void initializeWellProdIndCalculators();
     void initializeWellPerfData();
+    void initializeWellCommunicationBatch(const int reportStepIdx);
+
+    /// \brief Add the counters of the BHP at THP limit solves of the wells
+    ///        to the ones of the report step and reset them.
+    void collectBhpAtThpLimitCounts();
+
+    /// \brief Log the counters of the BHP at THP limit solves of the
+    ///        report step and reset them.
+    void logBhpAtThpLimitCounts();
+
+    /// \brief Build the group tree of a report step and set it in the
+    ///        group states.
+    void updateGroupTree(const int reportStepIdx);
 
     bool wasDynamicallyShutThisTimeStep(const int well_index) const;
 
@@ -398,7 +433,7 @@ protected:
                                    GLiftWellStateMap& map,
                                    const int episodeIndex);
 
-    virtual void computePotentials(const std::size_t widx,
+    virtual void computePotentials(const std::vector<std::size_t>& well_indices,
                                    const WellState<Scalar>& well_state_copy,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
@@ -566,6 +601,11 @@ protected:
 
     std::vector<WellProdIndexCalculator<Scalar>> prod_index_calc_;
     mutable ParallelWBPCalculation<Scalar> wbpCalculationService_;
+    //! \brief Sums per well quantities of all distributed wells at once.
+    mutable WellCommunicationBatch<Scalar> well_comm_batch_;
+    //! \brief Skipped, warm started and cold BHP at THP limit solves
+    //!        collected from the wells in this report step.
+    std::array<std::size_t, 3> bhp_at_thp_limit_counts_{};
 
     std::vector<int> pvt_region_idx_;
 
@@ -595,6 +635,17 @@ protected:
 
     double last_glift_opt_time_ = -1.0;
 
+    // Per-thread copies of the well state used by the potential
+    // calculations, see acquireScratchWellState().
+    struct ScratchWellState
+    {
+        std::optional<WellState<Scalar>> state;
+        std::optional<std::size_t> last_well;
+        bool in_use = false;
+    };
+    mutable std::vector<ScratchWellState> scratch_well_states_;
+    double well_potentials_time_ = 0.0;
+
     bool wellStructureChangedDynamically_{false};
 
     // Store maps of group name and new group controls for output
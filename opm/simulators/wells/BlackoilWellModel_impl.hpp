@@ -37,9 +37,12 @@
 
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
+#include <opm/models/parallel/threadmanager.hpp>
+
 #include <opm/simulators/wells/BlackoilWellModelConstraints.hpp>
 #include <opm/simulators/wells/ParallelPAvgDynamicSourceData.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
+#include <opm/simulators/wells/ThreadedWellLoop.hpp>
 #include <opm/simulators/wells/VFPProperties.hpp>
 #include <opm/simulators/wells/WellBhpThpCalculator.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
@@ -58,7 +61,9 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <exception>
 #include <iomanip>
 #include <utility>
 #include <optional>
@@ -382,6 +387,8 @@ namespace Opm {
         OPM_END_PARALLEL_TRY_CATCH_LOG(local_deferredLogger,
                                        "Failed to initialize local well structure: ",
                                        this->terminal_output_, comm)
+
+        this->initializeWellCommunicationBatch(reportStepIdx);
     }
 
 
@@ -399,6 +406,8 @@ namespace Opm {
 
         OPM_BEGIN_PARALLEL_TRY_CATCH()
         {
+            this->updateGroupTree(reportStepIdx);
+
             const auto& fieldGroup =
                 this->schedule().getGroup("FIELD", reportStepIdx);
 
@@ -437,6 +446,11 @@ namespace Opm {
     {
         OPM_TIMEBLOCK(beginTimeStep);
 
+        // complete the sums of a failed iteration before the wells change
+        if (this->well_comm_batch_.pending()) {
+            this->well_comm_batch_.finish();
+        }
+
         this->updateAverageFormationFactor();
 
         DeferredLogger local_deferredLogger;
@@ -485,7 +499,9 @@ namespace Opm {
             // test wells
             wellTesting(reportStepIdx, simulationTime, local_deferredLogger);
 
-            // create the well container
+            // create the well container, the solve counters of the old
+            // wells are kept for the report step
+            this->collectBhpAtThpLimitCounts();
             createWellContainer(reportStepIdx);
 
             // Wells are active if they are active wells on at least one process.
@@ -695,6 +711,18 @@ namespace Opm {
         {
             pinfo.get().clear();
         }
+
+        this->logBhpAtThpLimitCounts();
+
+        // Every process takes part in each collective, hence the counts
+        // are not summed over the processes.
+        const auto batched_sums = this->comm_.max(this->well_comm_batch_.numBatchedSums());
+        const auto collectives = this->comm_.max(this->well_comm_batch_.numCollectives());
+        if (this->terminal_output_ && batched_sums > 0) {
+            OpmLog::debug(fmt::format("Batched communication of distributed wells: "
+                                      "{} well sums in {} collectives so far",
+                                      batched_sums, collectives));
+        }
     }
 
 
@@ -1724,17 +1752,69 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     assembleWellEqWithoutIteration(const double dt, DeferredLogger& deferred_logger)
     {
-        // We make sure that all processes throw in case there is an exception
-        // on one of them (WetGasPvt::saturationPressure might throw if not converged)
-        OPM_BEGIN_PARALLEL_TRY_CATCH();
+        // The distributed wells add their dissolved and vaporized rates to
+        // the batch, which sums them for all wells at once while the
+        // reservoir is assembled. They are complete after endIteration().
+        using MixingRates = decltype(SingleWellState<Scalar>::phase_mixing_rates);
+        this->well_comm_batch_.begin(std::tuple_size_v<MixingRates>);
+
+        try {
+            // We make sure that all processes throw in case there is an exception
+            // on one of them (WetGasPvt::saturationPressure might throw if not converged)
+            OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-        for (auto& well: well_container_) {
-            well->assembleWellEqWithoutIteration(simulator_, dt, this->wellState(), this->groupState(),
-                                                 deferred_logger);
+            forEachWell([this, dt](const int wellIdx, DeferredLogger& well_logger)
+            {
+                well_container_[wellIdx]->assembleWellEqWithoutIteration(simulator_, dt, this->wellState(),
+                                                                         this->groupState(), well_logger);
+            }, deferred_logger);
+
+            OPM_END_PARALLEL_TRY_CATCH_LOG(deferred_logger, "BlackoilWellModel::assembleWellEqWithoutIteration failed: ",
+                                           this->terminal_output_, grid().comm());
         }
-        OPM_END_PARALLEL_TRY_CATCH_LOG(deferred_logger, "BlackoilWellModel::assembleWellEqWithoutIteration failed: ",
-                                       this->terminal_output_, grid().comm());
+        catch (...) {
+            // all processes throw, hence none of them sums
+            this->well_comm_batch_.cancel();
+            throw;
+        }
+
+        this->well_comm_batch_.start();
+    }
+
 
+    template<typename TypeTag>
+    bool
+    BlackoilWellModel<TypeTag>::
+    useThreadedWells() const
+    {
+        return param_.threaded_wells_
+            && ThreadManager::maxThreads() > 1
+            && well_container_.size() > 1;
+    }
+
+
+    template<typename TypeTag>
+    template<class Func>
+    void
+    BlackoilWellModel<TypeTag>::
+    forEachWell(Func&& func, DeferredLogger& deferred_logger) const
+    {
+        const int nw = well_container_.size();
+        if (!useThreadedWells()) {
+            for (int wellIdx = 0; wellIdx < nw; ++wellIdx) {
+                func(wellIdx, deferred_logger);
+            }
+            return;
+        }
+
+        threadedWellLoop(nw,
+                         [this](const int wellIdx)
+                         {
+                             return well_container_[wellIdx]->parallelWellInfo()
+                                 .communication().size() > 1;
+                         },
+                         std::forward<Func>(func), deferred_logger,
+                         well_loggers_, well_exceptions_);
     }
 
     // Ax = A x - C D^-1 B x
@@ -1743,6 +1823,39 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     apply(const BVector& x, BVector& Ax) const
     {
+        if (useThreadedWells()) {
+            // Each well computes its contribution - C D^-1 B x to its own
+            // buffer. The contributions are then added to Ax in the order of
+            // the wells, hence the result does not depend on the number of
+            // threads even if a cell is perforated by several wells.
+            const int nw = well_container_.size();
+            well_x_local_.resize(nw);
+            well_Ax_local_.resize(nw);
+            DeferredLogger unused_logger;
+            forEachWell([this, &x](const int wellIdx, DeferredLogger&)
+            {
+                const auto& cells = well_container_[wellIdx]->cells();
+                auto& x_local = well_x_local_[wellIdx];
+                auto& Ax_local = well_Ax_local_[wellIdx];
+                x_local.resize(cells.size());
+                Ax_local.resize(cells.size());
+                for (size_t i = 0; i < cells.size(); ++i) {
+                    x_local[i] = x[cells[i]];
+                }
+                Ax_local = 0.0;
+                well_container_[wellIdx]->apply(x_local, Ax_local);
+            }, unused_logger);
+
+            for (int wellIdx = 0; wellIdx < nw; ++wellIdx) {
+                const auto& cells = well_container_[wellIdx]->cells();
+                const auto& Ax_local = well_Ax_local_[wellIdx];
+                for (size_t i = 0; i < cells.size(); ++i) {
+                    Ax[cells[i]] += Ax_local[i];
+                }
+            }
+            return;
+        }
+
         for (auto& well : well_container_) {
             // Well equations B and C uses only the perforated cells, so need to apply on local vectors
             const auto& cells = well->cells();
@@ -1769,25 +1882,29 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     applyDomain(const BVector& x, BVector& Ax, const int domainIndex) const
     {
+        // Note: the domains may be solved concurrently, so the member
+        // buffers x_local_ and Ax_local_ cannot be used here.
+        BVector x_local;
+        BVector Ax_local;
         for (size_t well_index = 0; well_index < well_container_.size(); ++well_index) {
             auto& well = well_container_[well_index];
             if (well_domain_.at(well->name()) == domainIndex) {
                 // Well equations B and C uses only the perforated cells, so need to apply on local vectors
                 // transfer global cells index to local subdomain cells index
                 const auto& local_cells = well_local_cells_[well_index];
-                x_local_.resize(local_cells.size());
-                Ax_local_.resize(local_cells.size());
+                x_local.resize(local_cells.size());
+                Ax_local.resize(local_cells.size());
 
                 for (size_t i = 0; i < local_cells.size(); ++i) {
-                    x_local_[i] = x[local_cells[i]];
-                    Ax_local_[i] = Ax[local_cells[i]];
+                    x_local[i] = x[local_cells[i]];
+                    Ax_local[i] = Ax[local_cells[i]];
                 }
 
-                well->apply(x_local_, Ax_local_);
+                well->apply(x_local, Ax_local);
 
                 for (size_t i = 0; i < local_cells.size(); ++i) {
                     // only need to update Ax
-                    Ax[local_cells[i]] = Ax_local_[i];
+                    Ax[local_cells[i]] = Ax_local[i];
                 }
             }
         }
@@ -1862,15 +1979,17 @@ namespace Opm {
             return;
         }
 
-        if( scaleAddRes_.size() != Ax.size() ) {
-            scaleAddRes_.resize( Ax.size() );
+        // The domains may be solved concurrently, each one has its own buffer.
+        auto& scaleAddRes = domain_scale_add_res_[domainIndex];
+        if (scaleAddRes.size() != Ax.size()) {
+            scaleAddRes.resize(Ax.size());
         }
 
-        scaleAddRes_ = 0.0;
-        // scaleAddRes_  = - C D^-1 B x
-        applyDomain(x, scaleAddRes_, domainIndex);
-        // Ax = Ax + alpha * scaleAddRes_
-        Ax.axpy( alpha, scaleAddRes_ );
+        scaleAddRes = 0.0;
+        // scaleAddRes  = - C D^-1 B x
+        applyDomain(x, scaleAddRes, domainIndex);
+        // Ax = Ax + alpha * scaleAddRes
+        Ax.axpy( alpha, scaleAddRes );
     }
 
     template<typename TypeTag>
@@ -1985,15 +2104,19 @@ namespace Opm {
         DeferredLogger local_deferredLogger;
         OPM_BEGIN_PARALLEL_TRY_CATCH();
         {
-            for (auto& well : well_container_) {
+            well_x_local_.resize(well_container_.size());
+            forEachWell([this, &x](const int wellIdx, DeferredLogger& well_logger)
+            {
+                auto& well = well_container_[wellIdx];
                 const auto& cells = well->cells();
-                x_local_.resize(cells.size());
+                auto& x_local = well_x_local_[wellIdx];
+                x_local.resize(cells.size());
 
                 for (size_t i = 0; i < cells.size(); ++i) {
-                    x_local_[i] = x[cells[i]];
+                    x_local[i] = x[cells[i]];
                 }
-                well->recoverWellSolutionAndUpdateWellState(simulator_, x_local_, this->wellState(), local_deferredLogger);
-            }
+                well->recoverWellSolutionAndUpdateWellState(simulator_, x_local, this->wellState(), well_logger);
+            }, local_deferredLogger);
         }
         OPM_END_PARALLEL_TRY_CATCH_LOG(local_deferredLogger,
                                        "recoverWellSolutionAndUpdateWellState() failed: ",
@@ -2544,34 +2667,64 @@ namespace Opm {
 
     template<typename TypeTag>
     void
-    BlackoilWellModel<TypeTag>::computePotentials(const std::size_t widx,
+    BlackoilWellModel<TypeTag>::computePotentials(const std::vector<std::size_t>& well_indices,
                                                   const WellState<Scalar>& well_state_copy,
                                                   std::string& exc_msg,
                                                   ExceptionType::ExcEnum& exc_type,
                                                   DeferredLogger& deferred_logger)
     {
+        // The wells are processed in parallel. Each one reads the active
+        // well state only, the potentials are stored after all are done.
+        const int nw = well_container_.size();
+        std::vector<char> compute(nw, false);
+        for (const auto widx : well_indices) {
+            compute[widx] = true;
+        }
+        std::vector<std::vector<Scalar>> potentials(nw);
+        std::vector<std::string> well_exc_msg(nw);
+        std::vector<ExceptionType::ExcEnum> well_exc_type(nw, ExceptionType::NONE);
+        forEachWell([&](const int widx, DeferredLogger& well_logger)
+        {
+            if (compute[widx]) {
+                computePotentials(widx, well_state_copy, potentials[widx],
+                                  well_exc_msg[widx], well_exc_type[widx], well_logger);
+            }
+        }, deferred_logger);
+
         const int np = this->numPhases();
-        std::vector<Scalar> potentials;
+        for (const auto widx : well_indices) {
+            const auto& well = well_container_[widx];
+            if (well_exc_type[widx] != ExceptionType::NONE) {
+                exc_msg += fmt::format("\nFor well {}: {}", well->name(), well_exc_msg[widx]);
+            }
+            exc_type = std::max(exc_type, well_exc_type[widx]);
+            // Store it in the well state
+            // potentials is resized and set to zero in the beginning of well->ComputeWellPotentials
+            // and updated only if sucessfull. i.e. the potentials are zero for exceptions
+            potentials[widx].resize(np, 0.0);
+            auto& ws = this->wellState().well(well->indexOfWell());
+            for (int p = 0; p < np; ++p) {
+                // make sure the potentials are positive
+                ws.well_potentials[p] = std::max(Scalar{0.0}, potentials[widx][p]);
+            }
+        }
+    }
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::computePotentials(const std::size_t widx,
+                                                  const WellState<Scalar>& well_state_copy,
+                                                  std::vector<Scalar>& potentials,
+                                                  std::string& exc_msg,
+                                                  ExceptionType::ExcEnum& exc_type,
+                                                  DeferredLogger& deferred_logger) const
+    {
         const auto& well = well_container_[widx];
-        std::string cur_exc_msg;
-        auto cur_exc_type = ExceptionType::NONE;
         try {
             well->computeWellPotentials(simulator_, well_state_copy, potentials, deferred_logger);
         }
         // catch all possible exception and store type and message.
-        OPM_PARALLEL_CATCH_CLAUSE(cur_exc_type, cur_exc_msg);
-        if (cur_exc_type != ExceptionType::NONE) {
-            exc_msg += fmt::format("\nFor well {}: {}", well->name(), cur_exc_msg);
-        }
-        exc_type = std::max(exc_type, cur_exc_type);
-        // Store it in the well state
-        // potentials is resized and set to zero in the beginning of well->ComputeWellPotentials
-        // and updated only if sucessfull. i.e. the potentials are zero for exceptions
-        auto& ws = this->wellState().well(well->indexOfWell());
-        for (int p = 0; p < np; ++p) {
-            // make sure the potentials are positive
-            ws.well_potentials[p] = std::max(Scalar{0.0}, potentials[p]);
-        }
+        OPM_PARALLEL_CATCH_CLAUSE(exc_type, exc_msg);
     }
 
 
@@ -2857,28 +3010,30 @@ namespace Opm {
         if (!has_energy_)
             return;
 
-        int np = this->numPhases();
-        Scalar cellInternalEnergy;
-        Scalar cellBinv;
-        Scalar cellDensity;
-        Scalar perfPhaseRate;
+        const int np = this->numPhases();
         const int nw = this->numLocalWells();
-        for (auto wellID = 0*nw; wellID < nw; ++wellID) {
+
+        // The temperature of injectors is given unless they are stopped.
+        // Returns true if the temperature of a well was set this way.
+        const auto setInjectionTemperature = [this](const int wellID)
+        {
             const Well& well = this->wells_ecl_[wellID];
             auto& ws = this->wellState().well(wellID);
-            if (well.isInjector()){
-                if( !(ws.status == WellStatus::STOP)){
-                    this->wellState().well(wellID).temperature = well.inj_temperature();
-                    continue;
-                }
+            if (well.isInjector() && !(ws.status == WellStatus::STOP)) {
+                ws.temperature = well.inj_temperature();
+                return true;
             }
+            return false;
+        };
 
+        // The sum of the weighted temperatures of the local perforations of
+        // a well and the sum of their weights.
+        const auto weightedTemperature = [this, np](const int wellID)
+        {
             std::array<Scalar,2> weighted{0.0,0.0};
             auto& [weighted_temperature, total_weight] = weighted;
 
-            auto& well_info = this->local_parallel_well_info_[wellID].get();
-            auto& perf_data = ws.perf_data;
-            auto& perf_phase_rate = perf_data.phase_rates;
+            const auto& perf_phase_rate = this->wellState().well(wellID).perf_data.phase_rates;
 
             using int_type = decltype(this->well_perf_data_[wellID].size());
             for (int_type perf = 0, end_perf = this->well_perf_data_[wellID].size(); perf < end_perf; ++perf) {
@@ -2895,19 +3050,47 @@ namespace Opm {
                     if (!FluidSystem::phaseIsActive(phaseIdx)) {
                         continue;
                     }
-                    cellInternalEnergy = fs.enthalpy(phaseIdx).value() - fs.pressure(phaseIdx).value() / fs.density(phaseIdx).value();
-                    cellBinv = fs.invB(phaseIdx).value();
-                    cellDensity = fs.density(phaseIdx).value();
-                    perfPhaseRate = perf_phase_rate[ perf*np + phaseIdx ];
+                    const Scalar cellInternalEnergy = fs.enthalpy(phaseIdx).value() - fs.pressure(phaseIdx).value() / fs.density(phaseIdx).value();
+                    const Scalar cellBinv = fs.invB(phaseIdx).value();
+                    const Scalar cellDensity = fs.density(phaseIdx).value();
+                    const Scalar perfPhaseRate = perf_phase_rate[ perf*np + phaseIdx ];
                     weight_factor += cellDensity  * perfPhaseRate/cellBinv * cellInternalEnergy/cellTemperatures;
                 }
                 weight_factor = std::abs(weight_factor)+1e-13;
                 total_weight += weight_factor;
                 weighted_temperature += weight_factor * cellTemperatures;
             }
-            well_info.communication().sum(weighted.data(), 2);
-            this->wellState().well(wellID).temperature = weighted_temperature/total_weight;
+            return weighted;
+        };
+
+        const auto isDistributed = [this](const int wellID)
+        {
+            return this->local_parallel_well_info_[wellID].get().communication().size() > 1;
+        };
+
+        // The sums over the processes sharing a well are done for all
+        // distributed wells at once, while the temperatures of the other
+        // wells are computed.
+        this->well_comm_batch_.begin(2);
+        for (int wellID = 0; wellID < nw; ++wellID) {
+            if (!isDistributed(wellID) || setInjectionTemperature(wellID)) {
+                continue;
+            }
+            auto& ws = this->wellState().well(wellID);
+            const auto weighted = weightedTemperature(wellID);
+            this->well_comm_batch_.add(this->wells_ecl_[wellID].seqIndex(), weighted.data(),
+                                       [&ws](const Scalar* sum)
+                                       { ws.temperature = sum[0] / sum[1]; });
+        }
+        this->well_comm_batch_.start();
+        for (int wellID = 0; wellID < nw; ++wellID) {
+            if (isDistributed(wellID) || setInjectionTemperature(wellID)) {
+                continue;
+            }
+            const auto [weighted_temperature, total_weight] = weightedTemperature(wellID);
+            this->wellState().well(wellID).temperature = weighted_temperature / total_weight;
         }
+        this->well_comm_batch_.finish();
     }
 
 
@@ -3042,5 +3225,10 @@ namespace Opm {
             }
             well_local_cells_.appendRow(local_cells.begin(), local_cells.end());
         }
+
+        domain_scale_add_res_.resize(domains.size());
+        for (const auto& domain : domains) {
+            domain_scale_add_res_[domain.index].resize(domain.cells.size());
+        }
     }
 } // namespace Opm
@@ -25,6 +25,7 @@
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
 
 #include <opm/simulators/wells/GroupState.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
@@ -47,6 +48,7 @@ FractionCalculator(const Schedule& schedule,
     , well_state_(well_state)
     , group_state_(group_state)
     , report_step_(report_step)
+    , group_tree_(group_state.groupTree(report_step))
     , guide_rate_(guide_rate)
     , target_(target)
     , pu_(pu)
@@ -76,8 +78,7 @@ localFraction(const std::string& name,
               const std::string& always_included_child)
 {
     const Scalar my_guide_rate = guideRate(name, always_included_child);
-    const Group& parent_group = schedule_.getGroup(parent(name), report_step_);
-    const Scalar total_guide_rate = guideRateSum(parent_group, always_included_child);
+    const Scalar total_guide_rate = guideRateSum(parent(name), always_included_child);
 
     // the total guide gate is the same as my_guide rate
     // the well/group is probably on its own, i.e. return 1
@@ -94,6 +95,9 @@ template<class Scalar>
 std::string FractionCalculator<Scalar>::
 parent(const std::string& name)
 {
+    if (group_tree_) {
+        return group_tree_->parentName(name);
+    }
     if (schedule_.hasWell(name)) {
         return schedule_.getWell(name, report_step_).groupName();
     } else {
@@ -103,11 +107,12 @@ parent(const std::string& name)
 
 template<class Scalar>
 Scalar FractionCalculator<Scalar>::
-guideRateSum(const Group& group,
+guideRateSum(const std::string& group_name,
              const std::string& always_included_child)
 {
     Scalar total_guide_rate = 0.0;
-    for (const std::string& child_group : group.groups()) {
+    auto addChildGroup = [&](const std::string& child_group)
+    {
         bool included = (child_group == always_included_child);
         if (is_producer_) {
             const auto ctrl = this->group_state_.production_control(child_group);
@@ -122,8 +127,9 @@ guideRateSum(const Group& group,
         if (included) {
             total_guide_rate += guideRate(child_group, always_included_child);
         }
-    }
-    for (const std::string& child_well : group.wells()) {
+    };
+    auto addChildWell = [&](const std::string& child_well)
+    {
         bool included = (child_well == always_included_child);
         if (is_producer_) {
             included |= well_state_.isProductionGrup(child_well);
@@ -134,6 +140,24 @@ guideRateSum(const Group& group,
         if (included) {
             total_guide_rate += guideRate(child_well, always_included_child);
         }
+    };
+
+    const int group = group_tree_ ? group_tree_->groupIndex(group_name) : -1;
+    if (group >= 0) {
+        for (const int child : group_tree_->childGroups(group)) {
+            addChildGroup(group_tree_->groupName(child));
+        }
+        for (const int child : group_tree_->childWells(group)) {
+            addChildWell(group_tree_->wellName(child));
+        }
+    } else {
+        const Group& parent_group = schedule_.getGroup(group_name, report_step_);
+        for (const std::string& child_group : parent_group.groups()) {
+            addChildGroup(child_group);
+        }
+        for (const std::string& child_well : parent_group.wells()) {
+            addChildWell(child_well);
+        }
     }
     return total_guide_rate;
 }
@@ -143,7 +167,9 @@ Scalar FractionCalculator<Scalar>::
 guideRate(const std::string& name,
           const std::string& always_included_child)
 {
-    if (schedule_.hasWell(name, report_step_)) {
+    const bool is_well = group_tree_ ? group_tree_->hasWell(name)
+                                     : schedule_.hasWell(name, report_step_);
+    if (is_well) {
         return WellGroupHelpers<Scalar>::getGuideRate(name, schedule_, well_state_, group_state_,
                                                       report_step_, guide_rate_, target_, pu_);
     } else {
@@ -155,9 +181,10 @@ guideRate(const std::string& name,
             } else {
                 // We are a group, with default guide rate.
                 // Compute guide rate by accumulating our children's guide rates.
-                const Group& group = schedule_.getGroup(name, report_step_);
-                const double eff = group.getGroupEfficiencyFactor();
-                return eff * guideRateSum(group, always_included_child);
+                const double eff = group_tree_
+                    ? group_tree_->efficiencyFactor(group_tree_->groupIndex(name))
+                    : schedule_.getGroup(name, report_step_).getGroupEfficiencyFactor();
+                return eff * guideRateSum(name, always_included_child);
             }
         } else {
             // No group-controlled subordinate wells.
@@ -27,6 +27,7 @@
 
 namespace Opm {
 template<class Scalar> class GroupState;
+class GroupTree;
 struct PhaseUsage;
 class Schedule;
 template<class Scalar> class WellState;
@@ -55,7 +56,7 @@ public:
 
 private:
     std::string parent(const std::string& name);
-    Scalar guideRateSum(const Group& group,
+    Scalar guideRateSum(const std::string& group_name,
                         const std::string& always_included_child);
     Scalar guideRate(const std::string& name,
                      const std::string& always_included_child);
@@ -66,6 +67,8 @@ private:
     const WellState<Scalar>& well_state_;
     const GroupState<Scalar>& group_state_;
     int report_step_;
+    //! \brief Group tree of the report step, nullptr if not available.
+    const GroupTree* group_tree_;
     const GuideRate* guide_rate_;
     GuideRateModel::Target target_;
     const PhaseUsage& pu_;
@@ -20,6 +20,7 @@
 #ifndef OPM_GLOBAL_WELL_INFO_HEADER_INCLUDED
 #define OPM_GLOBAL_WELL_INFO_HEADER_INCLUDED
 
+#include <algorithm>
 #include <cstddef>
 #include <map>
 #include <string>
@@ -60,10 +61,18 @@ public:
     */
     template <typename Comm>
     void communicate(const Comm& comm) {
+        // The three vectors are summed with a single collective.
         auto size = this->m_in_injecting_group.size();
-        comm.sum( this->m_in_injecting_group.data(), size);
-        comm.sum( this->m_in_producing_group.data(), size);
-        comm.sum( this->m_is_open.data(), size);
+        std::vector<int> data;
+        data.reserve(3 * size);
+        data.insert(data.end(), this->m_in_injecting_group.begin(), this->m_in_injecting_group.end());
+        data.insert(data.end(), this->m_in_producing_group.begin(), this->m_in_producing_group.end());
+        data.insert(data.end(), this->m_is_open.begin(), this->m_is_open.end());
+        comm.sum( data.data(), data.size());
+        auto pos = data.begin();
+        std::copy(pos, pos + size, this->m_in_injecting_group.begin());
+        std::copy(pos + size, pos + 2 * size, this->m_in_producing_group.begin());
+        std::copy(pos + 2 * size, pos + 3 * size, this->m_is_open.begin());
     }
 
 
@@ -27,6 +27,7 @@
 #include <opm/input/eclipse/Schedule/Group/GConSump.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/simulators/wells/GroupState.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 
 
 namespace Opm {
@@ -396,6 +397,15 @@ GPMaint::State& GroupState<Scalar>::gpmaint(const std::string& gname)
     return this->gpmaint_state[gname];
 }
 
+template<class Scalar>
+const GroupTree* GroupState<Scalar>::groupTree(const int report_step) const
+{
+    if (this->group_tree_ && this->group_tree_->reportStep() == report_step) {
+        return this->group_tree_.get();
+    }
+    return nullptr;
+}
+
 
 //-------------------------------------------------------------------------
 
@@ -30,12 +30,14 @@
 #include <opm/simulators/utils/BlackoilPhases.hpp>
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <utility>
 
 namespace Opm {
 
     class GConSump;
+    class GroupTree;
     class Schedule;
     class SummaryState;
 
@@ -110,6 +112,15 @@ public:
 
     GPMaint::State& gpmaint(const std::string& gname);
 
+    /// The group tree is not part of the state: it is neither compared
+    /// nor serialized, and copies of the state share it.
+    void setGroupTree(std::shared_ptr<const GroupTree> tree)
+    { group_tree_ = std::move(tree); }
+
+    /// \brief The group tree of a report step, nullptr if it is not set
+    ///        for that step.
+    const GroupTree* groupTree(const int report_step) const;
+
     template<class Comm>
     void communicate_rates(const Comm& comm)
     {
@@ -219,6 +230,7 @@ private:
     WellContainer<GPMaint::State> gpmaint_state;
     std::map<std::string, std::pair<Scalar, Scalar>> m_gconsump_rates; // Pair with {consumption_rate, import_rate} for each group
     static constexpr std::pair<Scalar, Scalar> zero_pair = {0.0, 0.0};
+    std::shared_ptr<const GroupTree> group_tree_;
 };
 
 }
@@ -0,0 +1,127 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/wells/GroupTree.hpp>
+
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Opm {
+
+GroupTree::GroupTree(const Schedule& schedule, const int report_step)
+    : report_step_(report_step)
+{
+    this->group_names_ = schedule.groupNames(report_step);
+    const int num_groups = this->group_names_.size();
+    for (int g = 0; g < num_groups; ++g) {
+        this->group_index_.emplace(this->group_names_[g], g);
+    }
+
+    this->well_names_ = schedule.wellNames(report_step);
+    const int num_wells = this->well_names_.size();
+    for (int w = 0; w < num_wells; ++w) {
+        this->well_index_.emplace(this->well_names_[w], w);
+    }
+
+    this->parent_.resize(num_groups, -1);
+    this->efficiency_factor_.resize(num_groups, 1.0);
+    this->child_group_offsets_.reserve(num_groups + 1);
+    this->child_well_offsets_.reserve(num_groups + 1);
+    this->child_group_offsets_.push_back(0);
+    this->child_well_offsets_.push_back(0);
+    for (int g = 0; g < num_groups; ++g) {
+        const Group& group = schedule.getGroup(this->group_names_[g], report_step);
+        this->parent_[g] = this->groupIndex(group.parent());
+        this->efficiency_factor_[g] = group.getGroupEfficiencyFactor();
+        // Keep the order of the children, it is the order of summation.
+        for (const std::string& child : group.groups()) {
+            const int child_index = this->groupIndex(child);
+            if (child_index >= 0) {
+                this->child_groups_.push_back(child_index);
+            }
+        }
+        for (const std::string& child : group.wells()) {
+            const int child_index = this->wellIndex(child);
+            if (child_index >= 0) {
+                this->child_wells_.push_back(child_index);
+            }
+        }
+        this->child_group_offsets_.push_back(this->child_groups_.size());
+        this->child_well_offsets_.push_back(this->child_wells_.size());
+    }
+
+    this->well_group_.resize(num_wells, -1);
+    for (int w = 0; w < num_wells; ++w) {
+        const auto& well = schedule.getWell(this->well_names_[w], report_step);
+        this->well_group_[w] = this->groupIndex(well.groupName());
+    }
+}
+
+int GroupTree::groupIndex(const std::string& name) const
+{
+    const auto it = this->group_index_.find(name);
+    return it == this->group_index_.end() ? -1 : it->second;
+}
+
+int GroupTree::wellIndex(const std::string& name) const
+{
+    const auto it = this->well_index_.find(name);
+    return it == this->well_index_.end() ? -1 : it->second;
+}
+
+const std::string& GroupTree::parentName(const std::string& name) const
+{
+    static const std::string none;
+    const int well = this->wellIndex(name);
+    const int parent = well >= 0
+        ? this->well_group_[well]
+        : this->parent_.at(this->groupIndex(name));
+    return parent >= 0 ? this->group_names_[parent] : none;
+}
+
+std::vector<std::string> GroupTree::chainTopBot(const std::string& bottom,
+                                                const std::string& top) const
+{
+    const int well = this->wellIndex(bottom);
+    int parent = well >= 0 ? this->well_group_[well] : this->groupIndex(bottom);
+    if (well < 0 && parent >= 0) {
+        parent = this->parent_[parent];
+    }
+
+    // Build the chain from bottom to top.
+    std::vector<std::string> chain;
+    chain.push_back(bottom);
+    while (parent >= 0 && this->group_names_[parent] != top) {
+        chain.push_back(this->group_names_[parent]);
+        parent = this->parent_[parent];
+    }
+    if (parent < 0) {
+        throw std::invalid_argument("Group " + top + " is not above " + bottom);
+    }
+    chain.push_back(top);
+
+    // Reverse order and return.
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+} // namespace Opm
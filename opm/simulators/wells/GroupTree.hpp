@@ -0,0 +1,143 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GROUP_TREE_HEADER_INCLUDED
+#define OPM_GROUP_TREE_HEADER_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Opm {
+
+class Schedule;
+
+/*
+  The group hierarchy of one report step with integer indices.
+
+  The group and well control code walks the hierarchy by name, where each
+  step is a lookup of a Group or Well object in the Schedule. This class
+  resolves the names once per report step into flat arrays of parents and
+  children, such that walking the tree only needs the name lookup of the
+  start node. It also holds the group efficiency factors.
+
+  Groups and wells are numbered in the order of the Schedule. The parent
+  of FIELD is -1.
+*/
+class GroupTree
+{
+public:
+    //! \brief A range of group or well indices.
+    class IndexRange
+    {
+    public:
+        IndexRange(const int* first, const int* last)
+            : first_(first), last_(last)
+        {}
+
+        const int* begin() const { return first_; }
+        const int* end() const { return last_; }
+        std::size_t size() const { return last_ - first_; }
+        bool empty() const { return first_ == last_; }
+
+    private:
+        const int* first_;
+        const int* last_;
+    };
+
+    GroupTree(const Schedule& schedule, const int report_step);
+
+    int reportStep() const
+    { return report_step_; }
+
+    std::size_t numGroups() const
+    { return group_names_.size(); }
+
+    std::size_t numWells() const
+    { return well_names_.size(); }
+
+    //! \brief Index of a group, -1 if there is none with that name.
+    int groupIndex(const std::string& name) const;
+
+    //! \brief Index of a well, -1 if there is none with that name.
+    int wellIndex(const std::string& name) const;
+
+    bool hasGroup(const std::string& name) const
+    { return groupIndex(name) >= 0; }
+
+    bool hasWell(const std::string& name) const
+    { return wellIndex(name) >= 0; }
+
+    const std::string& groupName(const int group) const
+    { return group_names_[group]; }
+
+    const std::string& wellName(const int well) const
+    { return well_names_[well]; }
+
+    //! \brief Parent group of a group, -1 for FIELD.
+    int parent(const int group) const
+    { return parent_[group]; }
+
+    //! \brief Group of a well.
+    int wellGroup(const int well) const
+    { return well_group_[well]; }
+
+    IndexRange childGroups(const int group) const
+    {
+        return {child_groups_.data() + child_group_offsets_[group],
+                child_groups_.data() + child_group_offsets_[group + 1]};
+    }
+
+    IndexRange childWells(const int group) const
+    {
+        return {child_wells_.data() + child_well_offsets_[group],
+                child_wells_.data() + child_well_offsets_[group + 1]};
+    }
+
+    //! \brief Efficiency factor of a group.
+    double efficiencyFactor(const int group) const
+    { return efficiency_factor_[group]; }
+
+    //! \brief Name of the group of a well or of the parent of a group.
+    const std::string& parentName(const std::string& name) const;
+
+    //! \brief Names of the groups from top down to bottom, which is
+    //!        either a well or a group, see WellGroupHelpers::groupChainTopBot().
+    std::vector<std::string> chainTopBot(const std::string& bottom,
+                                         const std::string& top) const;
+
+private:
+    int report_step_;
+
+    std::vector<std::string> group_names_;
+    std::unordered_map<std::string, int> group_index_;
+    std::vector<int> parent_;
+    std::vector<int> child_group_offsets_;
+    std::vector<int> child_groups_;
+    std::vector<int> child_well_offsets_;
+    std::vector<int> child_wells_;
+    std::vector<double> efficiency_factor_;
+
+    std::vector<std::string> well_names_;
+    std::unordered_map<std::string, int> well_index_;
+    std::vector<int> well_group_;
+};
+
+} // namespace Opm
+
+#endif // OPM_GROUP_TREE_HEADER_INCLUDED
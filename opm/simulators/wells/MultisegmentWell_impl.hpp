@@ -403,7 +403,8 @@ namespace Opm
         well_copy.debug_cost_counter_ = 0;
 
         // store a copy of the well state, we don't want to update the real well state
-        WellState<Scalar> well_state_copy = simulator.problem().wellModel().wellState();
+        typename Base::WellStateCopy state_copy(*this, simulator);
+        WellState<Scalar>& well_state_copy = state_copy.get();
         const auto& group_state = simulator.problem().wellModel().groupState();
         auto& ws = well_state_copy.well(this->index_of_well_);
 
@@ -520,13 +521,14 @@ namespace Opm
                                   DeferredLogger& deferred_logger) const
     {
         // Create a copy of the well.
-        // TODO: check if we can avoid taking multiple copies. Call from updateWellPotentials 
-        // is allready a copy, but not from other calls. 
+        // Only the well object is copied, the well state copy below refreshes
+        // just the entry of this well when called from updateWellPotentials.
         MultisegmentWell<TypeTag> well_copy(*this);
         well_copy.debug_cost_counter_ = 0;
 
         // store a copy of the well state, we don't want to update the real well state
-        WellState<Scalar> well_state_copy = simulator.problem().wellModel().wellState();
+        typename Base::WellStateCopy state_copy(*this, simulator);
+        WellState<Scalar>& well_state_copy = state_copy.get();
         const auto& group_state = simulator.problem().wellModel().groupState();
         auto& ws = well_state_copy.well(this->index_of_well_);
         
@@ -1338,8 +1340,7 @@ namespace Opm
                 }
             }
         }
-        this->parallel_well_info_.communication().sum(this->ipr_a_.data(), this->ipr_a_.size());
-        this->parallel_well_info_.communication().sum(this->ipr_b_.data(), this->ipr_b_.size());
+        this->communicateIPR();
     }
 
     template<typename TypeTag>
@@ -437,10 +437,24 @@ namespace Opm
         this->connectionRates_ = connectionRates;
 
         // Accumulate dissolved gas and vaporized oil flow rates across all
-        // ranks sharing this well (this->index_of_well_).
+        // ranks sharing this well (this->index_of_well_). The well equations
+        // do not need them, hence the well model sums them for all wells at
+        // once while it assembles them. This is only done for its own well
+        // state, as the sum is completed after this function returns.
         {
             const auto& comm = this->parallel_well_info_.communication();
-            comm.sum(ws.phase_mixing_rates.data(), ws.phase_mixing_rates.size());
+            const auto& well_model = simulator.problem().wellModel();
+            auto& batch = well_model.wellCommunicationBatch();
+            if (comm.size() > 1 && batch.collecting() && &well_state == &well_model.wellState()) {
+                batch.add(this->well_ecl_.seqIndex(), ws.phase_mixing_rates.data(),
+                          [&well_state, well = this->index_of_well_](const Scalar* sum)
+                          {
+                              auto& rates = well_state.well(well).phase_mixing_rates;
+                              std::copy(sum, sum + rates.size(), rates.begin());
+                          });
+            } else {
+                comm.sum(ws.phase_mixing_rates.data(), ws.phase_mixing_rates.size());
+            }
         }
 
         // accumulate resWell_ and duneD_ in parallel to get effects of all perforations (might be distributed)
@@ -848,8 +862,7 @@ namespace Opm
                 this->ipr_b_[comp_idx] += ipr_b_perf[comp_idx];
             }
         }
-        this->parallel_well_info_.communication().sum(this->ipr_a_.data(), this->ipr_a_.size());
-        this->parallel_well_info_.communication().sum(this->ipr_b_.data(), this->ipr_b_.size());
+        this->communicateIPR();
     }
 
     template<typename TypeTag>
@@ -1525,7 +1538,8 @@ namespace Opm
         // iterate to get a more accurate well density
         // create a copy of the well_state to use. If the operability checking is sucessful, we use this one
         // to replace the original one
-        WellState<Scalar> well_state_copy = simulator.problem().wellModel().wellState();
+        typename Base::WellStateCopy state_copy(*this, simulator);
+        WellState<Scalar>& well_state_copy = state_copy.get();
         const auto& group_state  = simulator.problem().wellModel().groupState();
 
         // Get the current controls.
@@ -1618,12 +1632,13 @@ namespace Opm
                                   DeferredLogger& deferred_logger) const
     {
         // Create a copy of the well.
-        // TODO: check if we can avoid taking multiple copies. Call from updateWellPotentials
-        // is allready a copy, but not from other calls.
+        // Only the well object is copied, the well state copy below refreshes
+        // just the entry of this well when called from updateWellPotentials.
         StandardWell<TypeTag> well_copy(*this);
 
         // store a copy of the well state, we don't want to update the real well state
-        WellState<Scalar> well_state_copy = simulator.problem().wellModel().wellState();
+        typename Base::WellStateCopy state_copy(*this, simulator);
+        WellState<Scalar>& well_state_copy = state_copy.get();
         const auto& group_state = simulator.problem().wellModel().groupState();
         auto& ws = well_state_copy.well(this->index_of_well_);
 
@@ -0,0 +1,107 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_THREADED_WELL_LOOP_HEADER_INCLUDED
+#define OPM_THREADED_WELL_LOOP_HEADER_INCLUDED
+
+#include <opm/simulators/utils/DeferredLogger.hpp>
+
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/// \brief Call func(wellIdx, logger) for all wells 0 <= wellIdx < num_wells
+///        with the wells distributed over the OpenMP threads.
+///
+/// Each well gets its own deferred logger. The messages are appended to
+/// deferred_logger and exceptions are rethrown in the order of the wells.
+/// Wells for which is_distributed(wellIdx) is true communicate with other
+/// processes. They are called sequentially and in the order of the wells
+/// after the threaded loop, such that all processes sharing a well reach its
+/// collectives in the same order.
+///
+/// The per well loggers and exceptions are kept in well_loggers and
+/// well_exceptions, which are reused by the next call without allocating.
+template<class IsDistributed, class Func>
+void threadedWellLoop(const int num_wells,
+                      IsDistributed&& is_distributed,
+                      Func&& func,
+                      DeferredLogger& deferred_logger,
+                      std::vector<DeferredLogger>& well_loggers,
+                      std::vector<std::exception_ptr>& well_exceptions)
+{
+    well_loggers.resize(num_wells);
+    for (auto& well_logger : well_loggers) {
+        well_logger.clearMessages();
+    }
+    // exceptions must not escape the parallel region, they are
+    // collected per well and the first one is rethrown afterwards.
+    well_exceptions.assign(num_wells, nullptr);
+    const auto call = [&func, &well_loggers, &well_exceptions](const int wellIdx)
+    {
+        try {
+            func(wellIdx, well_loggers[wellIdx]);
+        }
+        catch (...) {
+            well_exceptions[wellIdx] = std::current_exception();
+        }
+    };
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int wellIdx = 0; wellIdx < num_wells; ++wellIdx) {
+        if (!is_distributed(wellIdx)) {
+            call(wellIdx);
+        }
+    }
+    for (int wellIdx = 0; wellIdx < num_wells; ++wellIdx) {
+        if (is_distributed(wellIdx)) {
+            call(wellIdx);
+        }
+    }
+
+    for (const auto& well_logger : well_loggers) {
+        deferred_logger.append(well_logger);
+    }
+    for (const auto& well_exception : well_exceptions) {
+        if (well_exception) {
+            std::rethrow_exception(well_exception);
+        }
+    }
+}
+
+/// \brief Same as above with buffers which only live for this call.
+template<class IsDistributed, class Func>
+void threadedWellLoop(const int num_wells,
+                      IsDistributed&& is_distributed,
+                      Func&& func,
+                      DeferredLogger& deferred_logger)
+{
+    std::vector<DeferredLogger> well_loggers;
+    std::vector<std::exception_ptr> well_exceptions;
+    threadedWellLoop(num_wells,
+                     std::forward<IsDistributed>(is_distributed),
+                     std::forward<Func>(func),
+                     deferred_logger, well_loggers, well_exceptions);
+}
+
+} // namespace Opm
+
+#endif // OPM_THREADED_WELL_LOOP_HEADER_INCLUDED
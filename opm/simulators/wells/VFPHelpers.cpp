@@ -28,6 +28,7 @@
 #include <opm/input/eclipse/Schedule/VFPInjTable.hpp>
 #include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
@@ -82,6 +83,15 @@ namespace Opm {
 template<class Scalar>
 detail::InterpData<Scalar> VFPHelpers<Scalar>::findInterpData(const Scalar value_in,
                                                               const std::vector<double>& values)
+{
+    int hint = -1;
+    return findInterpData(value_in, values, hint);
+}
+
+template<class Scalar>
+detail::InterpData<Scalar> VFPHelpers<Scalar>::findInterpData(const Scalar value_in,
+                                                              const std::vector<double>& values,
+                                                              int& hint)
 {
     detail::InterpData<Scalar> retval;
 
@@ -97,29 +107,43 @@ detail::InterpData<Scalar> VFPHelpers<Scalar>::findInterpData(const Scalar value
         retval.ind_[1] = 0;
         retval.inv_dist_ = 0.0;
         retval.factor_ = 0.0;
+        hint = 0;
     }
     // Else search in the vector
     else {
+        // Whether value lies in the interior interval starting at i,
+        // i.e. whether i is the last index with values[i] < value
+        auto inInterval = [&values, value, nvalues](const int i)
+        {
+            return i >= 0 && i < nvalues - 1
+                && (i == 0 || values[i] < value) && value <= values[i+1];
+        };
+
+        int lower = 0;
         //If value is less than all values, use first interval
         if (value < values.front()) {
-            retval.ind_[0] = 0;
-            retval.ind_[1] = 1;
+            lower = 0;
         }
         //If value is greater than all values, use last interval
         else if (value >= values.back()) {
-            retval.ind_[0] = nvalues-2;
-            retval.ind_[1] = nvalues-1;
+            lower = nvalues-2;
+        }
+        //Search internal intervals, starting at the one of the previous lookup
+        else if (inInterval(hint)) {
+            lower = hint;
+        }
+        else if (inInterval(hint+1)) {
+            lower = hint+1;
+        }
+        else if (inInterval(hint-1)) {
+            lower = hint-1;
         }
         else {
-            //Search internal intervals
-            for (int i=1; i<nvalues; ++i) {
-                if (values[i] >= value) {
-                    retval.ind_[0] = i-1;
-                    retval.ind_[1] = i;
-                    break;
-                }
-            }
+            lower = std::lower_bound(values.begin() + 1, values.end(), value) - values.begin() - 1;
         }
+        retval.ind_[0] = lower;
+        retval.ind_[1] = lower+1;
+        hint = lower;
 
         const Scalar start = values[retval.ind_[0]];
         const Scalar end   = values[retval.ind_[1]];
@@ -304,6 +328,42 @@ interpolate(const VFPInjTable& table,
     return nn[0][0];
 }
 
+template<class Scalar>
+void VFPHelpers<Scalar>::
+interpolate(const VFPProdTable& table,
+            const detail::VFPProdPoints<Scalar>& points,
+            std::vector<detail::VFPEvaluation<Scalar>>& result,
+            detail::VFPBrackets& brackets)
+{
+    const std::size_t n = points.size();
+    assert(points.thp.size() == n && points.wfr.size() == n &&
+           points.gfr.size() == n && points.alq.size() == n);
+
+    // Search the intervals one axis at a time, which walks through
+    // contiguous memory and keeps the axis in cache.
+    auto findAll = [n](const std::vector<Scalar>& values,
+                       const std::vector<double>& axis,
+                       int& hint,
+                       std::vector<detail::InterpData<Scalar>>& interp)
+    {
+        interp.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            interp[i] = findInterpData(values[i], axis, hint);
+        }
+    };
+    std::vector<detail::InterpData<Scalar>> flo_i, thp_i, wfr_i, gfr_i, alq_i;
+    findAll(points.flo, table.getFloAxis(), brackets.flo, flo_i);
+    findAll(points.thp, table.getTHPAxis(), brackets.thp, thp_i);
+    findAll(points.wfr, table.getWFRAxis(), brackets.wfr, wfr_i);
+    findAll(points.gfr, table.getGFRAxis(), brackets.gfr, gfr_i);
+    findAll(points.alq, table.getALQAxis(), brackets.alq, alq_i);
+
+    result.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        result[i] = interpolate(table, flo_i[i], thp_i[i], wfr_i[i], gfr_i[i], alq_i[i]);
+    }
+}
+
 template<class Scalar>
 detail::VFPEvaluation<Scalar> VFPHelpers<Scalar>::
 bhp(const VFPProdTable& table,
@@ -314,7 +374,8 @@ bhp(const VFPProdTable& table,
     const Scalar alq,
     const Scalar explicit_wfr,
     const Scalar explicit_gfr,
-    const bool   use_vfpexplicit)
+    const bool   use_vfpexplicit,
+    detail::VFPBrackets* brackets)
 {
     //Find interpolation variables
     Scalar flo = detail::getFlo(table, aqua, liquid, vapour);
@@ -327,11 +388,13 @@ bhp(const VFPProdTable& table,
 
     //First, find the values to interpolate between
     //Recall that flo is negative in Opm, so switch sign.
-    auto flo_i = findInterpData(-flo, table.getFloAxis());
-    auto thp_i = findInterpData( thp, table.getTHPAxis());
-    auto wfr_i = findInterpData( wfr, table.getWFRAxis());
-    auto gfr_i = findInterpData( gfr, table.getGFRAxis());
-    auto alq_i = findInterpData( alq, table.getALQAxis());
+    detail::VFPBrackets no_brackets{-1, -1, -1, -1, -1};
+    detail::VFPBrackets& hint = brackets ? *brackets : no_brackets;
+    auto flo_i = findInterpData(-flo, table.getFloAxis(), hint.flo);
+    auto thp_i = findInterpData( thp, table.getTHPAxis(), hint.thp);
+    auto wfr_i = findInterpData( wfr, table.getWFRAxis(), hint.wfr);
+    auto gfr_i = findInterpData( gfr, table.getGFRAxis(), hint.gfr);
+    auto alq_i = findInterpData( alq, table.getALQAxis(), hint.alq);
 
     detail::VFPEvaluation retval = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
 
@@ -344,14 +407,17 @@ bhp(const VFPInjTable& table,
     const Scalar aqua,
     const Scalar liquid,
     const Scalar vapour,
-    const Scalar thp)
+    const Scalar thp,
+    detail::VFPBrackets* brackets)
 {
     //Find interpolation variables
     Scalar flo = detail::getFlo(table, aqua, liquid, vapour);
 
     //First, find the values to interpolate between
-    auto flo_i = findInterpData(flo, table.getFloAxis());
-    auto thp_i = findInterpData(thp, table.getTHPAxis());
+    detail::VFPBrackets no_brackets{-1, -1, -1, -1, -1};
+    detail::VFPBrackets& hint = brackets ? *brackets : no_brackets;
+    auto flo_i = findInterpData(flo, table.getFloAxis(), hint.flo);
+    auto thp_i = findInterpData(thp, table.getTHPAxis(), hint.thp);
 
     //Then perform the interpolation itself
     detail::VFPEvaluation retval = interpolate(table, flo_i, thp_i);
@@ -527,8 +593,9 @@ getMinimumBHPCoordinate(const VFPProdTable& table,
     detail::VFPEvaluation bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
     Scalar bhp_min = bhp_i.value;
     const std::vector<double>& flos = table.getFloAxis();
+    int flo_hint = 0;
     for (size_t i = 0; i < flos.size(); ++i) {
-        flo_i = findInterpData(flos[i], flos);
+        flo_i = findInterpData(flos[i], flos, flo_hint);
         bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
         if (bhp_i.value < bhp_min){
             bhp_min = bhp_i.value;
@@ -580,9 +647,10 @@ intersectWithIPR(const VFPProdTable& table,
     y0 = adjust_bhp(bhp_i.value) - ipr_a/ipr_b; // +0.0/ipr_b
 
     const std::vector<double>& flos = table.getFloAxis();
+    int flo_hint = 0;
     for (size_t i = 0; i < flos.size(); ++i) {
         flo1 = flos[i];
-        flo_i = findInterpData(flo1, flos);
+        flo_i = findInterpData(flo1, flos, flo_hint);
         bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
         y1 = adjust_bhp(bhp_i.value) + (flo1 - ipr_a)/ipr_b;
         if (y0 < 0 && y1 >= 0){
@@ -21,10 +21,11 @@
 #ifndef OPM_AUTODIFF_VFPHELPERS_HPP_
 #define OPM_AUTODIFF_VFPHELPERS_HPP_
 
+#include <cstddef>
 #include <functional>
 #include <map>
-#include <vector>
 #include <optional>
+#include <vector>
 
 /**
  * This file contains a set of helper functions used by VFPProd / VFPInj.
@@ -70,6 +71,46 @@ struct InterpData
     Scalar factor_; // Interpolation factor
 };
 
+/**
+ * Lower indices of the axis intervals found by the last table lookup.
+ * Successive lookups for the same well mostly fall into the same or a
+ * neighbouring interval, hence the search starts there. Each well
+ * keeps its own brackets, such that wells can be evaluated in parallel.
+ */
+struct VFPBrackets
+{
+    int flo = 0;
+    int thp = 0;
+    int wfr = 0;
+    int gfr = 0;
+    int alq = 0;
+};
+
+/**
+ * A batch of evaluation points of a production table, stored by axis.
+ * The rates are given as positive table values.
+ */
+template<class Scalar>
+struct VFPProdPoints
+{
+    std::vector<Scalar> flo;
+    std::vector<Scalar> thp;
+    std::vector<Scalar> wfr;
+    std::vector<Scalar> gfr;
+    std::vector<Scalar> alq;
+
+    std::size_t size() const { return flo.size(); }
+
+    void resize(const std::size_t n)
+    {
+        flo.resize(n);
+        thp.resize(n);
+        wfr.resize(n);
+        gfr.resize(n);
+        alq.resize(n);
+    }
+};
+
 /**
  * Computes the flo parameter according to the flo_type_
  * for production tables
@@ -147,6 +188,16 @@ public:
     static detail::InterpData<Scalar> findInterpData(const Scalar value_in,
                                                      const std::vector<double>& values);
 
+    /**
+     * As above, but first checks the interval starting at hint and its
+     * neighbours before falling back to a binary search.
+     *  @param hint Lower index of the interval found by the previous lookup
+     *              on the same axis, updated to the one found now.
+     */
+    static detail::InterpData<Scalar> findInterpData(const Scalar value_in,
+                                                     const std::vector<double>& values,
+                                                     int& hint);
+
     /**
      * Helper function which interpolates data using the indices etc. given in the inputs.
      */
@@ -165,6 +216,18 @@ public:
                                                      const detail::InterpData<Scalar>& flo_i,
                                                      const detail::InterpData<Scalar>& thp_i);
 
+    /**
+     * Interpolates the values and derivatives for a batch of points.
+     * The intervals are searched axis by axis, each search starting from
+     * the interval of the previous point, before the points are interpolated.
+     * @param brackets Intervals to start the searches at, updated to the
+     *                 ones of the last point.
+     */
+    static void interpolate(const VFPProdTable& table,
+                            const detail::VFPProdPoints<Scalar>& points,
+                            std::vector<detail::VFPEvaluation<Scalar>>& result,
+                            detail::VFPBrackets& brackets);
+
     static detail::VFPEvaluation<Scalar> bhp(const VFPProdTable& table,
                                              const Scalar aqua,
                                              const Scalar liquid,
@@ -173,13 +236,15 @@ public:
                                              const Scalar alq,
                                              const Scalar explicit_wfr,
                                              const Scalar explicit_gfr,
-                                             const bool   use_vfpexplicit);
+                                             const bool   use_vfpexplicit,
+                                             detail::VFPBrackets* brackets = nullptr);
 
     static detail::VFPEvaluation<Scalar> bhp(const VFPInjTable& table,
                                              const Scalar aqua,
                                              const Scalar liquid,
                                              const Scalar vapour,
-                                             const Scalar thp);
+                                             const Scalar thp,
+                                             detail::VFPBrackets* brackets = nullptr);
 
     /**
      * This function finds the value of THP given a specific BHP.
@@ -37,11 +37,13 @@ bhp(const int    table_id,
     const Scalar aqua,
     const Scalar liquid,
     const Scalar vapour,
-    const Scalar thp_arg) const
+    const Scalar thp_arg,
+    detail::VFPBrackets* brackets) const
 {
     const VFPInjTable& table = detail::getTable(m_tables, table_id);
 
-    detail::VFPEvaluation retval = VFPHelpers<Scalar>::bhp(table, aqua, liquid, vapour, thp_arg);
+    detail::VFPEvaluation retval = VFPHelpers<Scalar>::bhp(table, aqua, liquid, vapour,
+                                                           thp_arg, brackets);
     return retval.value;
 }
 
@@ -71,8 +73,9 @@ thp(const int    table_id,
      */
     const auto flo_i = VFPHelpers<Scalar>::findInterpData(flo, table.getFloAxis());
     std::vector<Scalar> bhp_array(nthp);
+    int thp_hint = 0;
     for (int i = 0; i < nthp; ++i) {
-        auto thp_i = VFPHelpers<Scalar>::findInterpData(thp_array[i], thp_array);
+        auto thp_i = VFPHelpers<Scalar>::findInterpData(thp_array[i], thp_array, thp_hint);
         bhp_array[i] = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i).value;
     }
 
@@ -104,7 +107,8 @@ EvalWell VFPInjProperties<Scalar>::bhp(const int       table_id,
                                        const EvalWell& aqua,
                                        const EvalWell& liquid,
                                        const EvalWell& vapour,
-                                       const Scalar    thp) const
+                                       const Scalar    thp,
+                                       detail::VFPBrackets* brackets) const
 {
     //Get the table
     const VFPInjTable& table = detail::getTable(m_tables, table_id);
@@ -115,8 +119,10 @@ EvalWell VFPInjProperties<Scalar>::bhp(const int       table_id,
 
     //First, find the values to interpolate between
     //Value of FLO is negative in OPM for producers, but positive in VFP table
-    const auto flo_i = VFPHelpers<Scalar>::findInterpData(flo.value(), table.getFloAxis());
-    const auto thp_i = VFPHelpers<Scalar>::findInterpData(thp, table.getTHPAxis()); // assume constant
+    detail::VFPBrackets no_brackets{-1, -1, -1, -1, -1};
+    detail::VFPBrackets& hint = brackets ? *brackets : no_brackets;
+    const auto flo_i = VFPHelpers<Scalar>::findInterpData(flo.value(), table.getFloAxis(), hint.flo);
+    const auto thp_i = VFPHelpers<Scalar>::findInterpData(thp, table.getTHPAxis(), hint.thp); // assume constant
 
     detail::VFPEvaluation bhp_val = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i);
 
@@ -131,7 +137,8 @@ EvalWell VFPInjProperties<Scalar>::bhp(const int       table_id,
                                  const __VA_ARGS__&, \
                                  const __VA_ARGS__&, \
                                  const __VA_ARGS__&, \
-                                 const T) const;
+                                 const T,            \
+                                 detail::VFPBrackets*) const;
 
 #define INSTANTIATE_TYPE(T)                        \
     template class VFPInjProperties<T>;            \
@@ -20,6 +20,7 @@
 #ifndef OPM_AUTODIFF_VFPINJPROPERTIES_HPP_
 #define OPM_AUTODIFF_VFPINJPROPERTIES_HPP_
 
+#include <opm/simulators/wells/VFPHelpers.hpp>
 
 #include <functional>
 #include <map>
@@ -49,6 +50,8 @@ public:
      * @param liquid Oil phase
      * @param vapour Gas phase
      * @param thp Tubing head pressure
+     * @param brackets Table intervals of the previous lookup for the well,
+     *                 updated by this one. May be nullptr.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table, for each entry in the
@@ -59,7 +62,8 @@ public:
                  const EvalWell& aqua,
                  const EvalWell& liquid,
                  const EvalWell& vapour,
-                 const Scalar    thp) const;
+                 const Scalar    thp,
+                 detail::VFPBrackets* brackets = nullptr) const;
 
     /**
      * Returns the table associated with the ID, or throws an exception if
@@ -87,6 +91,8 @@ public:
      * @param liquid Oil phase
      * @param vapour Gas phase
      * @param thp Tubing head pressure
+     * @param brackets Table intervals of the previous lookup for the well,
+     *                 updated by this one. May be nullptr.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table.
@@ -95,7 +101,8 @@ public:
                const Scalar aqua,
                const Scalar liquid,
                const Scalar vapour,
-               const Scalar thp) const;
+               const Scalar thp,
+               detail::VFPBrackets* brackets = nullptr) const;
 
     /**
      * Linear interpolation of thp as a function of the input parameters
@@ -66,8 +66,9 @@ thp(const int    table_id,
     auto gfr_i = VFPHelpers<Scalar>::findInterpData( gfr, table.getGFRAxis());
     auto alq_i = VFPHelpers<Scalar>::findInterpData( alq, table.getALQAxis());
     std::vector<Scalar> bhp_array(nthp);
+    int thp_hint = 0;
     for (int i = 0; i < nthp; ++i) {
-        auto thp_i = VFPHelpers<Scalar>::findInterpData(thp_array[i], thp_array);
+        auto thp_i = VFPHelpers<Scalar>::findInterpData(thp_array[i], thp_array, thp_hint);
         bhp_array[i] = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i).value;
     }
 
@@ -84,16 +85,31 @@ bhp(const int     table_id,
      const Scalar alq,
      const Scalar explicit_wfr,
      const Scalar explicit_gfr,
-     const bool   use_expvfp) const
+     const bool   use_expvfp,
+     detail::VFPBrackets* brackets) const
 {
     const VFPProdTable& table = detail::getTable(m_tables, table_id);
 
     detail::VFPEvaluation retval = VFPHelpers<Scalar>::bhp(table, aqua, liquid, vapour,
                                                            thp_arg, alq, explicit_wfr,
-                                                           explicit_gfr, use_expvfp);
+                                                           explicit_gfr, use_expvfp,
+                                                           brackets);
     return retval.value;
 }
 
+template<class Scalar>
+void VFPProdProperties<Scalar>::
+bhp(const int table_id,
+    const detail::VFPProdPoints<Scalar>& points,
+    std::vector<detail::VFPEvaluation<Scalar>>& result,
+    detail::VFPBrackets* brackets) const
+{
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+
+    detail::VFPBrackets no_brackets{-1, -1, -1, -1, -1};
+    VFPHelpers<Scalar>::interpolate(table, points, result, brackets ? *brackets : no_brackets);
+}
+
 template<class Scalar>
 const VFPProdTable&
 VFPProdProperties<Scalar>::getTable(const int table_id) const
@@ -118,21 +134,23 @@ bhpwithflo(const std::vector<Scalar>& flos,
            const Scalar alq,
            const Scalar dp) const
 {
-    // Get the table
-    const VFPProdTable& table = detail::getTable(m_tables, table_id);
-    const auto thp_i = VFPHelpers<Scalar>::findInterpData( thp, table.getTHPAxis()); // assume constant
-    const auto wfr_i = VFPHelpers<Scalar>::findInterpData( wfr, table.getWFRAxis());
-    const auto gfr_i = VFPHelpers<Scalar>::findInterpData( gfr, table.getGFRAxis());
-    const auto alq_i = VFPHelpers<Scalar>::findInterpData( alq, table.getALQAxis()); //assume constant
-
-    std::vector<Scalar> bhps(flos.size(), 0.);
+    detail::VFPProdPoints<Scalar> points;
+    points.resize(flos.size());
     for (std::size_t i = 0; i < flos.size(); ++i) {
         // Value of FLO is negative in OPM for producers, but positive in VFP table
-        const auto flo_i = VFPHelpers<Scalar>::findInterpData(-flos[i], table.getFloAxis());
-        const detail::VFPEvaluation bhp_val = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+        points.flo[i] = -flos[i];
+        points.thp[i] = thp;
+        points.wfr[i] = wfr;
+        points.gfr[i] = gfr;
+        points.alq[i] = alq;
+    }
+    std::vector<detail::VFPEvaluation<Scalar>> bhp_vals;
+    this->bhp(table_id, points, bhp_vals);
 
+    std::vector<Scalar> bhps(flos.size(), 0.);
+    for (std::size_t i = 0; i < flos.size(); ++i) {
         // TODO: this kind of breaks the conventions for the functions here by putting dp within the function
-        bhps[i] = bhp_val.value - dp;
+        bhps[i] = bhp_vals[i].value - dp;
     }
 
     return bhps;
@@ -170,7 +188,8 @@ bhp(const int       table_id,
     const Scalar    alq,
     const Scalar    explicit_wfr,
     const Scalar    explicit_gfr,
-    const bool      use_expvfp) const
+    const bool      use_expvfp,
+    detail::VFPBrackets* brackets) const
 {
     //Get the table
     const VFPProdTable& table = detail::getTable(m_tables, table_id);
@@ -187,11 +206,13 @@ bhp(const int       table_id,
 
     //First, find the values to interpolate between
     //Value of FLO is negative in OPM for producers, but positive in VFP table
-    auto flo_i = VFPHelpers<Scalar>::findInterpData(-flo.value(), table.getFloAxis());
-    auto thp_i = VFPHelpers<Scalar>::findInterpData( thp, table.getTHPAxis()); // assume constant
-    auto wfr_i = VFPHelpers<Scalar>::findInterpData( wfr.value(), table.getWFRAxis());
-    auto gfr_i = VFPHelpers<Scalar>::findInterpData( gfr.value(), table.getGFRAxis());
-    auto alq_i = VFPHelpers<Scalar>::findInterpData( alq, table.getALQAxis()); //assume constant
+    detail::VFPBrackets no_brackets{-1, -1, -1, -1, -1};
+    detail::VFPBrackets& hint = brackets ? *brackets : no_brackets;
+    auto flo_i = VFPHelpers<Scalar>::findInterpData(-flo.value(), table.getFloAxis(), hint.flo);
+    auto thp_i = VFPHelpers<Scalar>::findInterpData( thp, table.getTHPAxis(), hint.thp); // assume constant
+    auto wfr_i = VFPHelpers<Scalar>::findInterpData( wfr.value(), table.getWFRAxis(), hint.wfr);
+    auto gfr_i = VFPHelpers<Scalar>::findInterpData( gfr.value(), table.getGFRAxis(), hint.gfr);
+    auto alq_i = VFPHelpers<Scalar>::findInterpData( alq, table.getALQAxis(), hint.alq); //assume constant
 
     detail::VFPEvaluation bhp_val = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i, wfr_i,
                                                                     gfr_i, alq_i);
@@ -211,7 +232,8 @@ bhp(const int       table_id,
                               const T ,           \
                               const T ,           \
                               const T ,           \
-                              const bool) const;
+                              const bool,         \
+                              detail::VFPBrackets*) const;
 
 #define INSTANTIATE_TYPE(T)                        \
     template class VFPProdProperties<T>;           \
@@ -20,6 +20,8 @@
 #ifndef OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 #define OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 
+#include <opm/simulators/wells/VFPHelpers.hpp>
+
 #include <functional>
 #include <map>
 #include <vector>
@@ -54,6 +56,8 @@ public:
      * @param vapour Gas phase
      * @param thp Tubing head pressure
      * @param alq Artificial lift or other parameter
+     * @param brackets Table intervals of the previous lookup for the well,
+     *                 updated by this one. May be nullptr.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table, for each entry in the
@@ -68,7 +72,8 @@ public:
                  const Scalar    alq,
                  const Scalar    explicit_wfr,
                  const Scalar    explicit_gfr,
-                 const bool      use_expvfp) const;
+                 const bool      use_expvfp,
+                 detail::VFPBrackets* brackets = nullptr) const;
 
     /**
      * Linear interpolation of bhp as a function of the input parameters
@@ -78,6 +83,8 @@ public:
      * @param vapour Gas phase
      * @param thp Tubing head pressure
      * @param alq Artificial lift or other parameter
+     * @param brackets Table intervals of the previous lookup for the well,
+     *                 updated by this one. May be nullptr.
      *
      * @return The bottom hole pressure, interpolated/extrapolated linearly using
      * the above parameters from the values in the input table.
@@ -90,7 +97,22 @@ public:
                const Scalar alq,
                const Scalar explicit_wfr,
                const Scalar explicit_gfr,
-               const bool   use_expvfp) const;
+               const bool   use_expvfp,
+               detail::VFPBrackets* brackets = nullptr) const;
+
+    /**
+     * Linear interpolation of bhp and its derivatives for a batch of points,
+     * e.g. the trial points of a root finding.
+     * @param table_id Table number to use
+     * @param points The points to evaluate, with positive rates
+     * @param result The interpolated bhp values and derivatives, one per point
+     * @param brackets Table intervals to start the searches at, updated to the
+     *                 ones of the last point. May be nullptr.
+     */
+    void bhp(const int table_id,
+             const detail::VFPProdPoints<Scalar>& points,
+             std::vector<detail::VFPEvaluation<Scalar>>& result,
+             detail::VFPBrackets* brackets = nullptr) const;
 
     /**
      * Linear interpolation of thp as a function of the input parameters
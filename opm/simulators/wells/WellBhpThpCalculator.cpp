@@ -39,6 +39,7 @@
 #include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <optional>
@@ -251,7 +252,8 @@ computeBhpAtThpLimitProd(const std::function<std::vector<Scalar>(const Scalar)>&
                                                                  alq_value,
                                                                  wfr,
                                                                  gfr,
-                                                                 use_vfpexp);
+                                                                 use_vfpexp,
+                                                                 &well_.vfpBrackets());
         return bhp - dp + getVfpBhpAdjustment(bhp, thp_limit);
     };
 
@@ -260,8 +262,24 @@ computeBhpAtThpLimitProd(const std::function<std::vector<Scalar>(const Scalar)>&
         return detail::getFlo(table, rates[Water], rates[Oil], rates[Gas]);
     };
 
-    // Find the bhp-point where production becomes nonzero.
     auto fflo = [&flo, &frates](Scalar bhp) { return flo(frates(bhp)); };
+
+    // Start at the last solution of the well. This also skips the search
+    // for bhp_max, hence the solution is checked to be producing instead.
+    auto& cache = well_.bhpAtThpLimitCache();
+    cache.setTable(controls.vfp_table_number, /*injector*/ false);
+    const std::array<Scalar, 2> warm_range {static_cast<Scalar>(controls.bhp_limit),
+                                            maxPerfPress + 1.0 * unit::barsa};
+    const auto warm_bhp =
+        warmStartBhpAtThpLimit(cache,
+                               [&fbhp, &frates](Scalar bhp) { return fbhp(frates(bhp)) - bhp; },
+                               [&fflo](Scalar bhp) { return fflo(bhp) < 0.0; },
+                               warm_range, warm_range[0], /*max_iteration*/ 100);
+    if (warm_bhp.has_value()) {
+        return warm_bhp;
+    }
+
+    // Find the bhp-point where production becomes nonzero.
     auto bhp_max = this->bhpMax(fflo,
                                 controls.bhp_limit,
                                 maxPerfPress,
@@ -276,7 +294,11 @@ computeBhpAtThpLimitProd(const std::function<std::vector<Scalar>(const Scalar)>&
         return std::nullopt;
     }
     const std::array<Scalar, 2> range {static_cast<Scalar>(controls.bhp_limit), *bhp_max};
-    return this->computeBhpAtThpLimit(frates, fbhp, range, deferred_logger);
+    const auto bhp = this->computeBhpAtThpLimit(frates, fbhp, range, deferred_logger);
+    if (bhp.has_value()) {
+        cache.bhp = bhp;
+    }
+    return bhp;
 }
 
 template<class Scalar>
@@ -290,15 +312,20 @@ computeBhpAtThpLimitInj(const std::function<std::vector<Scalar>(const Scalar)>&
                         const bool throwOnError,
                         DeferredLogger& deferred_logger) const
 {
+    std::optional<Scalar> bhp;
     if (throwOnError) {
-        return computeBhpAtThpLimitInjImpl<ThrowOnError>(frates, summary_state,
-                                                         rho, flo_rel_tol,
-                                                         max_iteration, deferred_logger);
+        bhp = computeBhpAtThpLimitInjImpl<ThrowOnError>(frates, summary_state,
+                                                        rho, flo_rel_tol,
+                                                        max_iteration, deferred_logger);
     } else {
-        return computeBhpAtThpLimitInjImpl<WarnAndContinueOnError>(frates, summary_state,
-                                                                   rho, flo_rel_tol,
-                                                                   max_iteration, deferred_logger);
+        bhp = computeBhpAtThpLimitInjImpl<WarnAndContinueOnError>(frates, summary_state,
+                                                                  rho, flo_rel_tol,
+                                                                  max_iteration, deferred_logger);
     }
+    if (bhp.has_value()) {
+        well_.bhpAtThpLimitCache().bhp = bhp;
+    }
+    return bhp;
 }
 
 template<class Scalar>
@@ -378,7 +405,8 @@ calculateBhpFromThp(const WellState<Scalar>& well_state,
         const auto& controls = well.injectionControls(summaryState);
         vfp_ref_depth = well_.vfpProperties()->getInj()->getTable(controls.vfp_table_number).getDatumDepth();
         bhp_tab = well_.vfpProperties()->getInj()->bhp(
-               controls.vfp_table_number, aqua, liquid, vapour, thp_limit);
+               controls.vfp_table_number, aqua, liquid, vapour, thp_limit,
+               &well_.vfpBrackets());
     }
     else if (well_.isProducer()) {
         const auto& controls = well.productionControls(summaryState);
@@ -391,7 +419,8 @@ calculateBhpFromThp(const WellState<Scalar>& well_state,
                                                       aqua, liquid, vapour,
                                                       thp_limit,
                                                       well_.getALQ(well_state),
-                                                      wfr, gfr, use_vfpexplicit);
+                                                      wfr, gfr, use_vfpexplicit,
+                                                      &well_.vfpBrackets());
     }
     else {
         OPM_DEFLOG_THROW(std::logic_error, "Expected INJECTOR or PRODUCER for well " + well_.name(), deferred_logger);
@@ -509,7 +538,8 @@ computeBhpAtThpLimitInjImpl(const std::function<std::vector<Scalar>(const Scalar
     auto fbhp = [this, &controls, thp_limit, dp](const std::vector<Scalar>& rates) {
         assert(rates.size() == 3);
         const auto bhp = well_.vfpProperties()->getInj()
-                ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit);
+                ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit,
+                      &well_.vfpBrackets());
         return bhp - dp + getVfpBhpAdjustment(bhp, thp_limit);
     };
 
@@ -518,6 +548,22 @@ computeBhpAtThpLimitInjImpl(const std::function<std::vector<Scalar>(const Scalar
         return detail::getFlo(table, rates[Water], rates[Oil], rates[Gas]);
     };
 
+    // Start at the last solution of the well, the one with the highest
+    // flow is picked if there are two. The lower bhp bound is the one of
+    // the inflow samples below.
+    auto& cache = well_.bhpAtThpLimitCache();
+    cache.setTable(controls.vfp_table_number, /*injector*/ true);
+    const std::array<Scalar, 2> warm_range {10.0 * unit::barsa,
+                                            static_cast<Scalar>(controls.bhp_limit)};
+    const auto warm_bhp =
+        warmStartBhpAtThpLimit(cache,
+                               [&fbhp, &frates](Scalar bhp) { return fbhp(frates(bhp)) - bhp; },
+                               [&flo, &frates](Scalar bhp) { return flo(frates(bhp)) > 0.0; },
+                               warm_range, warm_range[1], max_iteration);
+    if (warm_bhp.has_value()) {
+        return warm_bhp;
+    }
+
     // Get the flo samples, add extra samples at low rates and bhp
     // limit point if necessary.
     std::vector<double> flo_samples = table.getFloAxis();
@@ -787,6 +833,110 @@ computeBhpAtThpLimit(const std::function<std::vector<Scalar>(const Scalar)>& fra
     }
 }
 
+template<class Scalar>
+std::optional<Scalar>
+WellBhpThpCalculator<Scalar>::
+warmStartBhpAtThpLimit(BhpAtThpLimitCache<Scalar>& cache,
+                       const std::function<Scalar(const Scalar)>& eq,
+                       const std::function<bool(const Scalar)>& valid,
+                       const std::array<Scalar, 2>& range,
+                       const Scalar preferred_end,
+                       const int max_iteration)
+{
+    // If eq is still (almost) zero at the last solution x0, the solve is
+    // skipped. Otherwise we step away from x0 with growing steps, first
+    // towards the preferred end of the range, until eq changes sign, and
+    // solve in that bracket. The first step is the residual at x0, which
+    // is a pressure difference. The solution is only accepted if eq has
+    // the same sign at the preferred end as on the preferred side of the
+    // solution, such that the same solution as from scratch is found.
+    bool skipped = false;
+    const auto solution = [&]() -> std::optional<Scalar> {
+        if (!cache.bhp.has_value() || !(range[0] < range[1])) {
+            return std::nullopt;
+        }
+        const Scalar bhp_tolerance = 0.01 * unit::barsa;
+        const Scalar min_interval = 1.0 * unit::barsa;
+        const int max_expansions = 6;
+        const Scalar dir = preferred_end > range[0] ? 1.0 : -1.0;
+        auto clamp = [&range](const Scalar bhp) { return std::clamp(bhp, range[0], range[1]); };
+
+        const Scalar x0 = clamp(*cache.bhp);
+        const Scalar eq_x0 = eq(x0);
+        Scalar bhp = x0;
+        // Point on the preferred side of the solution, and eq there.
+        Scalar inner = x0;
+        Scalar eq_inner = eq_x0;
+        if (std::fabs(eq_x0) <= bhp_tolerance) {
+            inner = clamp(x0 + dir * min_interval);
+            if (inner != x0) {
+                eq_inner = eq(inner);
+                if (std::fabs(eq_inner) <= bhp_tolerance) {
+                    return std::nullopt;
+                }
+            }
+            skipped = true;
+        } else {
+            std::optional<std::array<Scalar, 2>> bracket;
+            Scalar near = x0;
+            Scalar far = x0;
+            Scalar step = std::max(std::fabs(eq_x0), min_interval);
+            for (int i = 0; i < max_expansions && !bracket.has_value(); ++i, step *= 2.0) {
+                const Scalar next_near = clamp(x0 + dir * step);
+                if (next_near != near) {
+                    const Scalar eq_near = eq(next_near);
+                    if (eq_near * eq_x0 <= 0.0) {
+                        bracket = std::array<Scalar, 2>{near, next_near};
+                        inner = next_near;
+                        eq_inner = eq_near;
+                        break;
+                    }
+                    near = next_near;
+                }
+                const Scalar next_far = clamp(x0 - dir * step);
+                if (next_far != far) {
+                    if (eq(next_far) * eq_x0 <= 0.0) {
+                        bracket = std::array<Scalar, 2>{far, next_far};
+                        inner = far;
+                        break;
+                    }
+                    far = next_far;
+                }
+            }
+            if (!bracket.has_value()) {
+                return std::nullopt;
+            }
+            int iteration = 0;
+            try {
+                bhp = RegulaFalsiBisection<ThrowOnError>::
+                    solve(eq, std::min((*bracket)[0], (*bracket)[1]),
+                          std::max((*bracket)[0], (*bracket)[1]),
+                          max_iteration, bhp_tolerance, iteration);
+            }
+            catch (...) {
+                return std::nullopt;
+            }
+        }
+        if (inner != preferred_end && eq(preferred_end) * eq_inner < 0.0) {
+            return std::nullopt;
+        }
+        if (!valid(bhp)) {
+            return std::nullopt;
+        }
+        return bhp;
+    }();
+
+    if (!solution.has_value()) {
+        ++cache.misses;
+    } else if (skipped) {
+        ++cache.hits;
+    } else {
+        ++cache.warm_starts;
+        cache.bhp = solution;
+    }
+    return solution;
+}
+
 template<class Scalar>
 bool WellBhpThpCalculator<Scalar>::
 bisectBracket(const std::function<Scalar(const Scalar)>& eq,
@@ -24,6 +24,8 @@
 #ifndef OPM_WELL_BPH_THP_CALCULATOR_HEADER_INCLUDED
 #define OPM_WELL_BPH_THP_CALCULATOR_HEADER_INCLUDED
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -36,6 +38,29 @@ class Well;
 template<class Scalar> class WellInterfaceGeneric;
 template<class Scalar> class WellState;
 
+//! \brief Solution of the last BHP at THP limit solve of a well,
+//!        from which the next solve is warm started.
+template<class Scalar>
+struct BhpAtThpLimitCache
+{
+    //! \brief Forget the solution if it was found for another VFP table.
+    void setTable(const int table, const bool is_injector)
+    {
+        if (table != table_id || is_injector != injector) {
+            bhp.reset();
+            table_id = table;
+            injector = is_injector;
+        }
+    }
+
+    int table_id = -1;
+    bool injector = false;
+    std::optional<Scalar> bhp; //!< Last solution, if any
+    std::size_t hits = 0;        //!< Solves skipped as the last solution still holds
+    std::size_t warm_starts = 0; //!< Solves in a bracket around the last solution
+    std::size_t misses = 0;      //!< Solves from scratch
+};
+
 //! \brief Class for computing BHP limits.
 template<class Scalar>
 class WellBhpThpCalculator {
@@ -130,6 +155,19 @@ public:
   static bool bruteForceBracketCommonTHP(const std::function<Scalar(const Scalar)>& eq,
                                 Scalar& min_thp, Scalar& max_thp);
 
+    //! \brief Solve eq(bhp) = 0 in a bracket around the last solution in cache.
+    //! \details Returns nullopt if no solution is found this way, or if
+    //!          eq changes sign between the solution and preferred_end,
+    //!          i.e. if the solve from scratch could pick another solution.
+    //!          Updates the solution and the counters of the cache.
+    static std::optional<Scalar>
+    warmStartBhpAtThpLimit(BhpAtThpLimitCache<Scalar>& cache,
+                           const std::function<Scalar(const Scalar)>& eq,
+                           const std::function<bool(const Scalar)>& valid,
+                           const std::array<Scalar, 2>& range,
+                           const Scalar preferred_end,
+                           const int max_iteration);
+
 private:
     //! \brief Compute BHP from THP limit for an injector - implementation.
     template<class ErrorPolicy>
@@ -0,0 +1,154 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+#include <opm/simulators/wells/WellCommunicationBatch.hpp>
+
+#if HAVE_MPI
+#include <dune/common/parallel/mpitraits.hh>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace Opm {
+
+template<class Scalar>
+WellCommunicationBatch<Scalar>::
+WellCommunicationBatch(const Parallel::Communication& comm)
+    : comm_(comm)
+{
+}
+
+template<class Scalar>
+WellCommunicationBatch<Scalar>::
+~WellCommunicationBatch()
+{
+#if HAVE_MPI
+    if (request_ != MPI_REQUEST_NULL) {
+        MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+#endif
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+setWells(const std::size_t num_global_wells,
+         const std::vector<int>& distributed_wells)
+{
+    assert(!started_);
+    slot_.assign(num_global_wells, 0);
+    num_slots_ = 0;
+    if (comm_.size() < 2) {
+        std::fill(slot_.begin(), slot_.end(), -1);
+        return;
+    }
+
+    // A well is distributed if it is so on any process.
+    for (const int well : distributed_wells) {
+        slot_[well] = 1;
+    }
+    comm_.max(slot_.data(), slot_.size());
+    for (auto& slot : slot_) {
+        slot = slot ? num_slots_++ : -1;
+    }
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+begin(const std::size_t values_per_well)
+{
+    if (started_) {
+        finish();
+    }
+    values_per_well_ = values_per_well;
+    buffer_.assign(num_slots_ * values_per_well_, 0.0);
+    callbacks_.assign(num_slots_, Callback{});
+    collecting_ = true;
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+add(const int global_well_index, const Scalar* values, Callback callback)
+{
+    assert(collecting_);
+    const int slot = global_well_index < static_cast<int>(slot_.size())
+        ? slot_[global_well_index] : -1;
+    if (slot < 0) {
+        callback(values);
+        return;
+    }
+    std::copy(values, values + values_per_well_,
+              buffer_.begin() + slot * values_per_well_);
+    if (!callbacks_[slot]) {
+        ++num_batched_sums_;
+    }
+    callbacks_[slot] = std::move(callback);
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+cancel()
+{
+    collecting_ = false;
+    callbacks_.clear();
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+start()
+{
+    assert(collecting_);
+    collecting_ = false;
+    started_ = true;
+    if (buffer_.empty()) {
+        return;
+    }
+    ++num_collectives_;
+#if HAVE_MPI
+    MPI_Iallreduce(MPI_IN_PLACE, buffer_.data(), buffer_.size(),
+                   Dune::MPITraits<Scalar>::getType(), MPI_SUM,
+                   comm_, &request_);
+#endif
+}
+
+template<class Scalar>
+void WellCommunicationBatch<Scalar>::
+finish()
+{
+    assert(started_);
+#if HAVE_MPI
+    if (request_ != MPI_REQUEST_NULL) {
+        MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+#endif
+    started_ = false;
+    for (std::size_t slot = 0; slot < callbacks_.size(); ++slot) {
+        if (callbacks_[slot]) {
+            callbacks_[slot](buffer_.data() + slot * values_per_well_);
+        }
+    }
+    callbacks_.clear();
+}
+
+template class WellCommunicationBatch<double>;
+
+#if FLOW_INSTANTIATE_FLOAT
+template class WellCommunicationBatch<float>;
+#endif
+
+} // namespace Opm
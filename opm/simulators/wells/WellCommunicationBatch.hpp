@@ -0,0 +1,127 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELL_COMMUNICATION_BATCH_HEADER_INCLUDED
+#define OPM_WELL_COMMUNICATION_BATCH_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Opm {
+
+/// \brief Sums values of distributed wells with one collective for all wells.
+///
+/// Summing a per well quantity over the processes sharing the well needs
+/// one collective on the communicator of each distributed well. This class
+/// packs the contributions of all distributed wells into one buffer that
+/// is summed by a single nonblocking allreduce on the global communicator.
+/// Processes not sharing a well contribute zeros to its slot.
+///
+/// A batch is used as
+///
+///     batch.begin(n);
+///     for each well: batch.add(global_index, values, callback);
+///     batch.start();
+///     ... work not depending on the sums ...
+///     batch.finish();
+///
+/// where begin(), start() and finish() are collective on the global
+/// communicator. The callback of a well receives the n summed values. For
+/// wells that are not distributed it is called by add() directly. Adding a
+/// well again replaces its values and callback. A pending batch is
+/// finished by the next begin().
+template<class Scalar>
+class WellCommunicationBatch
+{
+public:
+    using Callback = std::function<void(const Scalar*)>;
+
+    explicit WellCommunicationBatch(const Parallel::Communication& comm);
+
+    WellCommunicationBatch(const WellCommunicationBatch&) = delete;
+    WellCommunicationBatch& operator=(const WellCommunicationBatch&) = delete;
+
+    ~WellCommunicationBatch();
+
+    /// \brief Set up the slots of the distributed wells (collective).
+    /// \param num_global_wells Number of wells in the schedule.
+    /// \param distributed_wells Global indices of the wells of this process
+    ///                          that are shared with other processes.
+    void setWells(std::size_t num_global_wells,
+                  const std::vector<int>& distributed_wells);
+
+    /// \brief Start collecting values_per_well values for each well.
+    void begin(std::size_t values_per_well);
+
+    /// \brief Whether values are collected, i.e. begin() was called but
+    ///        not start().
+    bool collecting() const
+    { return collecting_; }
+
+    /// \brief Whether the summation was started but not finished.
+    bool pending() const
+    { return started_; }
+
+    /// \brief Add the local contribution of a well.
+    void add(int global_well_index, const Scalar* values, Callback callback);
+
+    /// \brief Drop the collected values without summing them.
+    /// \details Used if all processes fail before start().
+    void cancel();
+
+    /// \brief Start the summation of the collected values.
+    void start();
+
+    /// \brief Wait for the sums and call the callbacks of the wells.
+    void finish();
+
+    /// \brief Number of well sums of this process that were part of a batch.
+    std::size_t numBatchedSums() const
+    { return num_batched_sums_; }
+
+    /// \brief Number of collectives used for them, the same on all processes.
+    std::size_t numCollectives() const
+    { return num_collectives_; }
+
+private:
+    const Parallel::Communication& comm_;
+    //! \brief Slot of each global well, -1 if it is not distributed.
+    std::vector<int> slot_;
+    int num_slots_ = 0;
+    std::size_t values_per_well_ = 0;
+    std::vector<Scalar> buffer_;
+    //! \brief Callback of each slot, empty if no well was added to it.
+    std::vector<Callback> callbacks_;
+    bool collecting_ = false;
+    bool started_ = false;
+    std::size_t num_batched_sums_ = 0;
+    std::size_t num_collectives_ = 0;
+#if HAVE_MPI
+    MPI_Request request_ = MPI_REQUEST_NULL;
+#endif
+};
+
+} // namespace Opm
+
+#endif // OPM_WELL_COMMUNICATION_BATCH_HEADER_INCLUDED
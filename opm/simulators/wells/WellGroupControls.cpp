@@ -173,7 +173,8 @@ getGroupInjectionControl(const Group& group,
 
     const Scalar orig_target = tcalc.groupTarget(ctrl, deferred_logger);
     const auto chain = WellGroupHelpers<Scalar>::groupChainTopBot(well_.name(), group.name(),
-                                                                  schedule, well_.currentStep());
+                                                                  schedule, well_.currentStep(),
+                                                                  group_state.groupTree(well_.currentStep()));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     Scalar target = orig_target;
@@ -309,7 +310,8 @@ getGroupInjectionTargetRate(const Group& group,
     const auto chain = WellGroupHelpers<Scalar>::groupChainTopBot(well_.name(),
                                                                   group.name(),
                                                                   schedule,
-                                                                  well_.currentStep());
+                                                                  well_.currentStep(),
+                                                                  group_state.groupTree(well_.currentStep()));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     Scalar target = orig_target;
@@ -423,7 +425,8 @@ getGroupProductionControl(const Group& group,
 
     const Scalar orig_target = tcalc.groupTarget(ctrl, deferred_logger);
     const auto chain = WellGroupHelpers<Scalar>::groupChainTopBot(well_.name(), group.name(),
-                                                                  schedule, well_.currentStep());
+                                                                  schedule, well_.currentStep(),
+                                                                  group_state.groupTree(well_.currentStep()));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     Scalar target = orig_target;
@@ -521,7 +524,8 @@ getGroupProductionTargetRate(const Group& group,
 
     const Scalar orig_target = tcalc.groupTarget(ctrl, deferred_logger);
     const auto chain = WellGroupHelpers<Scalar>::groupChainTopBot(well_.name(), group.name(),
-                                                                  schedule, well_.currentStep());
+                                                                  schedule, well_.currentStep(),
+                                                                  group_state.groupTree(well_.currentStep()));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     Scalar target = orig_target;
@@ -37,6 +37,7 @@
 
 #include <opm/simulators/wells/FractionCalculator.hpp>
 #include <opm/simulators/wells/GroupState.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/RegionAverageCalculator.hpp>
 #include <opm/simulators/wells/TargetCalculator.hpp>
 #include <opm/simulators/wells/VFPProdProperties.hpp>
@@ -75,6 +76,51 @@ namespace {
         return {oilRate, gasRate, waterRate};
     }
 
+    // WellGroupHelpers::groupControlledWells() walking the group tree by index.
+    template<class Scalar>
+    int groupControlledWellsInTree(const Opm::GroupTree& tree,
+                                   const Opm::WellState<Scalar>& well_state,
+                                   const Opm::GroupState<Scalar>& group_state,
+                                   const int group,
+                                   const std::string& always_included_child,
+                                   const bool is_production_group,
+                                   const Opm::Phase injection_phase)
+    {
+        using Opm::Group;
+
+        int num_wells = 0;
+        for (const int child : tree.childGroups(group)) {
+            const std::string& child_group = tree.groupName(child);
+            bool included = (child_group == always_included_child);
+            if (is_production_group) {
+                const auto ctrl = group_state.production_control(child_group);
+                included = included || (ctrl == Group::ProductionCMode::FLD) || (ctrl == Group::ProductionCMode::NONE);
+            } else {
+                const auto ctrl = group_state.injection_control(child_group, injection_phase);
+                included = included || (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
+            }
+
+            if (included) {
+                num_wells += groupControlledWellsInTree(tree, well_state, group_state, child,
+                                                        always_included_child, is_production_group,
+                                                        injection_phase);
+            }
+        }
+        for (const int child : tree.childWells(group)) {
+            const std::string& child_well = tree.wellName(child);
+            bool included = (child_well == always_included_child);
+            if (is_production_group) {
+                included = included || well_state.isProductionGrup(child_well);
+            } else {
+                included = included || well_state.isInjectionGrup(child_well);
+            }
+            if (included) {
+                ++num_wells;
+            }
+        }
+        return num_wells;
+    }
+
 } // namespace Anonymous
 
 namespace Opm {
@@ -207,6 +253,21 @@ accumulateGroupEfficiencyFactor(const Group& group,
             schedule.getGroup(group.parent(), reportStepIdx), schedule, reportStepIdx, factor);
 }
 
+template<class Scalar>
+void WellGroupHelpers<Scalar>::
+accumulateGroupEfficiencyFactor(const GroupTree& group_tree,
+                                const int group,
+                                Scalar& factor)
+{
+    for (int g = group; g >= 0; g = group_tree.parent(g)) {
+        factor *= group_tree.efficiencyFactor(g);
+        const int parent = group_tree.parent(g);
+        if (parent < 0 || group_tree.groupName(parent) == "FIELD") {
+            break;
+        }
+    }
+}
+
 template<class Scalar>
 Scalar WellGroupHelpers<Scalar>::
 sumWellSurfaceRates(const Group& group,
@@ -1092,6 +1153,15 @@ groupControlledWells(const Schedule& schedule,
                      const bool is_production_group,
                      const Phase injection_phase)
 {
+    if (const auto* tree = group_state.groupTree(report_step)) {
+        const int group = tree->groupIndex(group_name);
+        if (group >= 0) {
+            return groupControlledWellsInTree(*tree, well_state, group_state, group,
+                                              always_included_child, is_production_group,
+                                              injection_phase);
+        }
+    }
+
     const Group& group = schedule.getGroup(group_name, report_step);
     int num_wells = 0;
     for (const std::string& child_group : group.groups()) {
@@ -1130,8 +1200,13 @@ WellGroupHelpers<Scalar>::
 groupChainTopBot(const std::string& bottom,
                  const std::string& top,
                  const Schedule& schedule,
-                 const int report_step)
+                 const int report_step,
+                 const GroupTree* group_tree)
 {
+    if (group_tree) {
+        return group_tree->chainTopBot(bottom, top);
+    }
+
     // Get initial parent, 'bottom' can be a well or a group.
     std::string parent;
     if (schedule.hasWell(bottom, report_step)) {
@@ -1267,7 +1342,8 @@ checkGroupConstraintsProd(const std::string& name,
     // TODO finish explanation.
     const Scalar current_rate_available
         = -tcalc.calcModeRateFromRates(rates); // Switch sign since 'rates' are negative for producers.
-    const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx);
+    const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx,
+                                        group_state.groupTree(reportStepIdx));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     // we need to find out the level where the current well is applied to the local reduction
@@ -1443,7 +1519,8 @@ checkGroupConstraintsInj(const std::string& name,
     // TODO finish explanation.
     const Scalar current_rate_available
         = tcalc.calcModeRateFromRates(rates); // Switch sign since 'rates' are negative for producers.
-    const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx);
+    const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx,
+                                        group_state.groupTree(reportStepIdx));
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const std::size_t num_ancestors = chain.size() - 1;
     // we need to find out the level where the current well is applied to the local reduction
@@ -34,6 +34,7 @@ namespace Opm {
 class DeferredLogger;
 class Group;
 template<class Scalar> class GroupState;
+class GroupTree;
 namespace Network { class ExtNetwork; }
 struct PhaseUsage;
 class Schedule;
@@ -67,6 +68,11 @@ public:
                                                 const int reportStepIdx,
                                                 Scalar& factor);
 
+    /// As above, for the group with index group in group_tree.
+    static void accumulateGroupEfficiencyFactor(const GroupTree& group_tree,
+                                                const int group,
+                                                Scalar& factor);
+
     static Scalar sumWellSurfaceRates(const Group& group,
                                       const Schedule& schedule,
                                       const WellState<Scalar>& wellState,
@@ -270,11 +276,13 @@ public:
                              const std::vector<Scalar>& resv_coeff,
                              DeferredLogger& deferred_logger);
 
+    /// The chain is taken from group_tree if given.
     static std::vector<std::string>
     groupChainTopBot(const std::string& bottom,
                      const std::string& top,
                      const Schedule& schedule,
-                     const int report_step);
+                     const int report_step,
+                     const GroupTree* group_tree = nullptr);
 
     static std::pair<bool, Scalar>
     checkGroupConstraintsProd(const std::string& name,
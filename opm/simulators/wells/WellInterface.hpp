@@ -57,6 +57,7 @@ namespace Opm {
 
 #include <opm/material/densead/Evaluation.hpp>
 
+#include <optional>
 #include <vector>
 
 namespace Opm
@@ -388,6 +389,43 @@ public:
                                             const bool fixed_control = false, 
                                             const bool fixed_status = false) = 0;
 protected:
+    // A well state which the calculations of this well can modify without
+    // touching the active well state of the well model. Uses the scratch
+    // well state of the current thread if available, such that only the
+    // entry of this well is refreshed, and copies the whole state otherwise.
+    class WellStateCopy
+    {
+    public:
+        WellStateCopy(const WellInterface& well, const Simulator& simulator)
+            : model_(simulator.problem().wellModel())
+            , scratch_(model_.acquireScratchWellState(well.indexOfWell()))
+        {
+            if (!scratch_) {
+                copy_.emplace(model_.wellState());
+            }
+        }
+
+        WellStateCopy(const WellStateCopy&) = delete;
+        WellStateCopy& operator=(const WellStateCopy&) = delete;
+
+        ~WellStateCopy()
+        {
+            if (scratch_) {
+                model_.releaseScratchWellState();
+            }
+        }
+
+        WellState<Scalar>& get()
+        {
+            return scratch_ ? *scratch_ : *copy_;
+        }
+
+    private:
+        const BlackoilWellModelGeneric<Scalar>& model_;
+        WellState<Scalar>* scratch_ = nullptr;
+        std::optional<WellState<Scalar>> copy_;
+    };
+
     // simulation parameters
     std::vector<RateVector> connectionRates_;
     std::vector<Scalar> B_avg_;
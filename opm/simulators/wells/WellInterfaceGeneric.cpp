@@ -45,6 +45,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -413,6 +414,22 @@ setVFPProperties(const VFPProperties<Scalar>* vfp_properties_arg)
     vfp_properties_ = vfp_properties_arg;
 }
 
+template<class Scalar>
+void WellInterfaceGeneric<Scalar>::
+communicateIPR() const
+{
+    const auto& comm = parallel_well_info_.communication();
+    if (comm.size() < 2) {
+        return;
+    }
+    // Both coefficients with one collective.
+    std::vector<Scalar> ipr(ipr_a_);
+    ipr.insert(ipr.end(), ipr_b_.begin(), ipr_b_.end());
+    comm.sum(ipr.data(), ipr.size());
+    std::copy(ipr.begin(), ipr.begin() + ipr_a_.size(), ipr_a_.begin());
+    std::copy(ipr.begin() + ipr_a_.size(), ipr.end(), ipr_b_.begin());
+}
+
 template<class Scalar>
 void WellInterfaceGeneric<Scalar>::
 setPrevSurfaceRates(WellState<Scalar>& well_state,
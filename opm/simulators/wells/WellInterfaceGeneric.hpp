@@ -26,6 +26,8 @@
 
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
 #include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/wells/VFPHelpers.hpp>
+#include <opm/simulators/wells/WellBhpThpCalculator.hpp>
 
 #include <map>
 #include <optional>
@@ -136,6 +138,13 @@ public:
 
     const VFPProperties<Scalar>* vfpProperties() const { return vfp_properties_; }
 
+    // the table intervals of the last VFP lookup of the well, used as
+    // starting point of the next one
+    detail::VFPBrackets& vfpBrackets() const { return vfp_brackets_; }
+
+    // the last bhp at thp limit solution of the well, with hit/miss counters
+    BhpAtThpLimitCache<Scalar>& bhpAtThpLimitCache() const { return bhp_at_thp_limit_cache_; }
+
     const ParallelWellInfo<Scalar>& parallelWellInfo() const { return parallel_well_info_; }
 
     const std::vector<Scalar>& perfDepth() const { return perf_depth_; }
@@ -225,6 +234,9 @@ protected:
         std::fill(this->inj_multiplier_damp_factor_.begin(), this->inj_multiplier_damp_factor_.end(), 1.0);
     }
 
+    //! \brief Sum ipr_a_ and ipr_b_ over the processes sharing the well.
+    void communicateIPR() const;
+
     // definition of the struct OperabilityStatus
     struct OperabilityStatus
     {
@@ -305,6 +317,9 @@ protected:
     mutable std::vector<Scalar> ipr_a_;
     mutable std::vector<Scalar> ipr_b_;
 
+    mutable detail::VFPBrackets vfp_brackets_;
+    mutable BhpAtThpLimitCache<Scalar> bhp_at_thp_limit_cache_;
+
     // cell index for each well perforation
     std::vector<int> well_cells_;
 
@@ -41,6 +41,55 @@ opm_add_test(test_parallelwellinfo_mpi
     4
     )
 
+foreach(NPROC 2 4)
+  opm_add_test(test_threadedwells_np${NPROC}
+    EXE_NAME
+      test_threadedwells
+    CONDITION
+      MPI_FOUND AND Boost_UNIT_TEST_FRAMEWORK_FOUND
+    DRIVER_ARGS
+      -n ${NPROC}
+      -b ${PROJECT_BINARY_DIR}
+    TEST_ARGS
+      --run_test=Loop*
+    NO_COMPILE
+    PROCESSORS
+      ${NPROC}
+  )
+endforeach()
+
+foreach(NPROC 2 3 4)
+  opm_add_test(test_haloexchange_np${NPROC}
+    EXE_NAME
+      test_haloexchange
+    CONDITION
+      MPI_FOUND AND Boost_UNIT_TEST_FRAMEWORK_FOUND
+    DRIVER_ARGS
+      -n ${NPROC}
+      -b ${PROJECT_BINARY_DIR}
+    NO_COMPILE
+    PROCESSORS
+      ${NPROC}
+  )
+endforeach()
+
+foreach(NPROC 2 4)
+  opm_add_test(test_pipelinedsolvers_np${NPROC}
+    EXE_NAME
+      test_pipelinedsolvers
+    CONDITION
+      MPI_FOUND AND Boost_UNIT_TEST_FRAMEWORK_FOUND
+    DRIVER_ARGS
+      -n ${NPROC}
+      -b ${PROJECT_BINARY_DIR}
+    TEST_ARGS
+      --run_test=FusedReductionParallel
+    NO_COMPILE
+    PROCESSORS
+      ${NPROC}
+  )
+endforeach()
+
 foreach(NPROC 2 3 4)
   opm_add_test(test_parallel_wbp_sourcevalues_np${NPROC}
     EXE_NAME
@@ -0,0 +1,149 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+ * \file
+ *
+ * \brief Benchmark of the small dense block kernels of
+ *        SmallDenseMatrixUtils.hpp against the generic implementations
+ *        of dune-common.
+ *
+ * Usage: benchmark_blockkernels [NUM_BLOCKS] [REPETITIONS]
+ *
+ * For the block sizes 1 to 6 the average wall time of a sweep over
+ * NUM_BLOCKS blocks is reported for the block-vector product y -= A x of
+ * the triangular solves, the update C -= A B and the product A = A B of
+ * the ILU decomposition.
+ */
+#include "config.h"
+
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fvector.hh>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class Fn>
+double timeIt(Fn&& fn, int numRepetitions)
+{
+    fn(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepetitions; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / numRepetitions;
+}
+
+void report(const int n, const std::string& kernel, const double duneTime, const double kernelTime)
+{
+    std::cout << std::setw(5) << n << "  " << std::setw(6) << kernel << "  "
+              << std::scientific << std::setprecision(3) << duneTime << "  " << kernelTime
+              << " " << std::fixed << std::setprecision(2) << std::setw(7)
+              << duneTime / kernelTime << std::endl;
+}
+
+template <int n>
+void benchmark(const std::size_t numBlocks, const int numRepetitions)
+{
+    using Block = Opm::MatrixBlock<double, n, n>;
+    using Vector = Dune::FieldVector<double, n>;
+
+    // Diagonally dominant blocks, such that repeated products stay bounded.
+    std::vector<Block> A(numBlocks + 1);
+    std::vector<Vector> x(numBlocks);
+    for (std::size_t b = 0; b <= numBlocks; ++b) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                A[b][i][j] = (i == j ? 1.0 : 0.1 / n) * (1.0 + 1e-3 * std::sin(1.0 * b + i - j));
+            }
+        }
+    }
+    for (std::size_t b = 0; b < numBlocks; ++b) {
+        x[b] = 1.0 + 1e-3 * b;
+    }
+
+    std::vector<Vector> y(numBlocks, Vector(0.0));
+    const double duneMmv = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            A[b].mmv(x[b], y[b]);
+        }
+    }, numRepetitions);
+    const double kernelMmv = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            Opm::detail::mmvBlock(A[b], x[b], y[b]);
+        }
+    }, numRepetitions);
+    report(n, "mmv", duneMmv, kernelMmv);
+
+    std::vector<Block> C(A.begin(), A.end() - 1);
+    const double duneMmm = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            Block B(A[b + 1]);
+            B.leftmultiply(A[b]);
+            C[b] -= B;
+        }
+    }, numRepetitions);
+    const double kernelMmm = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            Opm::detail::mmmBlock(A[b], A[b + 1], C[b]);
+        }
+    }, numRepetitions);
+    report(n, "mmm", duneMmm, kernelMmm);
+
+    C.assign(A.begin(), A.end() - 1);
+    const double duneRight = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            C[b].rightmultiply(A[b + 1]);
+        }
+    }, numRepetitions);
+    C.assign(A.begin(), A.end() - 1);
+    const double kernelRight = timeIt([&] {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            Opm::detail::rightMultiplyBlock(C[b], A[b + 1]);
+        }
+    }, numRepetitions);
+    report(n, "rmult", duneRight, kernelRight);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t numBlocks = argc > 1 ? std::atol(argv[1]) : 100000;
+    const int numRepetitions = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::cout << "# blocks: " << numBlocks << "\n";
+    std::cout << "# size  kernel     dune[s]  kernel[s] speedup\n";
+    benchmark<1>(numBlocks, numRepetitions);
+    benchmark<2>(numBlocks, numRepetitions);
+    benchmark<3>(numBlocks, numRepetitions);
+    benchmark<4>(numBlocks, numRepetitions);
+    benchmark<5>(numBlocks, numRepetitions);
+    benchmark<6>(numBlocks, numRepetitions);
+
+    return EXIT_SUCCESS;
+}
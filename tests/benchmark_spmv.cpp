@@ -0,0 +1,154 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+ * \file
+ *
+ * \brief Thread-scaling benchmark of the block sparse matrix-vector
+ *        product used by the linear operators.
+ *
+ * Usage: benchmark_spmv [MATRIX_FILE | CELLS_PER_DIRECTION] [REPETITIONS]
+ *
+ * MATRIX_FILE is a system matrix with 3x3 blocks as written by the linear
+ * solver for a verbosity above 10 (the '*matrix_istl.mm' file of
+ * WriteSystemMatrixHelper). If a number is given instead, a 7-point
+ * stencil matrix on a structured grid with that many cells per direction
+ * is used. For each number of threads
+ * (powers of two up to OMP_NUM_THREADS) the average wall time of the
+ * sequential Dune product and of ParallelSpMV is reported.
+ */
+#include "config.h"
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/matrixmarket.hh>
+
+#include <opm/simulators/linalg/MatrixMarketSpecializations.hpp>
+#include <opm/simulators/linalg/ParallelSpMV.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 3, 3>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+
+Matrix createStencilMatrix(const int n)
+{
+    const std::size_t N = static_cast<std::size_t>(n) * n * n;
+    Matrix A(N, N, 7 * N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int idx = row.index();
+        const int i = idx % n;
+        const int j = (idx / n) % n;
+        const int k = idx / (n * n);
+        if (k > 0) row.insert(idx - n * n);
+        if (j > 0) row.insert(idx - n);
+        if (i > 0) row.insert(idx - 1);
+        row.insert(idx);
+        if (i < n - 1) row.insert(idx + 1);
+        if (j < n - 1) row.insert(idx + n);
+        if (k < n - 1) row.insert(idx + n * n);
+    }
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = col.index() == row.index() ? 6.0 : -1.0;
+        }
+    }
+    return A;
+}
+
+template <class Fn>
+double timeIt(Fn&& fn, int numRepetitions)
+{
+    fn(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepetitions; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / numRepetitions;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const std::string input = argc > 1 ? argv[1] : "100";
+    const int numRepetitions = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    Matrix A;
+    if (input.find_first_not_of("0123456789") == std::string::npos) {
+        A = createStencilMatrix(std::atoi(input.c_str()));
+    } else {
+        std::ifstream matrixFile(input);
+        if (!matrixFile) {
+            std::cerr << "Could not open matrix file '" << input << "'\n";
+            return EXIT_FAILURE;
+        }
+        Dune::readMatrixMarket(A, matrixFile);
+    }
+
+    Vector x(A.M());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = 1.0 + std::sin(static_cast<double>(i));
+    }
+    Vector reference(A.N());
+    Vector y(A.N());
+    A.mv(x, reference);
+
+    int maxThreads = 1;
+#if HAVE_OPENMP
+    maxThreads = omp_get_max_threads();
+#endif
+
+    std::cout << "# rows: " << A.N() << ", nonzero blocks: " << A.nonzeroes() << "\n";
+    std::cout << "# threads     dune[s] parallel[s] speedup\n";
+
+    const double duneTime = timeIt([&] { A.mv(x, y); }, numRepetitions);
+
+    int status = EXIT_SUCCESS;
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+#if HAVE_OPENMP
+        omp_set_num_threads(numThreads);
+#endif
+        const Opm::ParallelSpMV<Matrix> spmv(A, A.N(), numThreads);
+        const double parallelTime = timeIt([&] { spmv.mv(x, y); }, numRepetitions);
+
+        y -= reference;
+        if (y.infinity_norm() > 1e-12 * reference.infinity_norm()) {
+            std::cerr << "Result with " << numThreads << " threads differs from the reference\n";
+            status = EXIT_FAILURE;
+        }
+
+        std::cout << std::setw(9) << numThreads << "  " << std::scientific << std::setprecision(3)
+                  << duneTime << "  " << parallelTime << " " << std::fixed << std::setprecision(2)
+                  << std::setw(7) << duneTime / parallelTime << std::endl;
+    }
+
+    return status;
+}
@@ -0,0 +1,153 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+ * \file
+ *
+ * \brief Benchmark of the evaluation of a production VFP table.
+ *
+ * Usage: benchmark_vfp [AXIS_SIZE] [NUM_POINTS] [REPETITIONS]
+ *
+ * A synthetic table with AXIS_SIZE values on each axis is evaluated at
+ * NUM_POINTS points along a slowly varying rate sweep, like the trial
+ * points of a BHP at THP iteration. The average wall time per point is
+ * reported for independent lookups, lookups starting at the intervals of
+ * the previous one, and the batch interface.
+ */
+#include "config.h"
+
+#include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
+
+#include <opm/simulators/wells/VFPHelpers.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class Fn>
+double timeIt(Fn&& fn, int numRepetitions)
+{
+    fn(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepetitions; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / numRepetitions;
+}
+
+void report(const std::string& variant, const double time, const std::size_t numPoints,
+            const double reference)
+{
+    std::cout << std::setw(10) << variant << "  " << std::scientific << std::setprecision(3)
+              << time / numPoints << "  " << std::fixed << std::setprecision(2)
+              << std::setw(7) << reference / time << std::endl;
+}
+
+std::vector<double> makeAxis(const int n, const double max)
+{
+    // Denser at small values, like typical rate and ratio axes.
+    std::vector<double> axis(n);
+    for (int i = 0; i < n; ++i) {
+        const double t = n > 1 ? i / static_cast<double>(n - 1) : 0.0;
+        axis[i] = max * t * t;
+    }
+    return axis;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const int axisSize = argc > 1 ? std::atoi(argv[1]) : 20;
+    const std::size_t numPoints = argc > 2 ? std::atol(argv[2]) : 1000;
+    const int numRepetitions = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    const auto flo_axis = makeAxis(axisSize, 1000.0);
+    const auto thp_axis = makeAxis(axisSize, 200.0);
+    const auto wfr_axis = makeAxis(axisSize, 5.0);
+    const auto gfr_axis = makeAxis(axisSize, 500.0);
+    const auto alq_axis = makeAxis(axisSize, 1.0);
+    std::vector<double> data(flo_axis.size() * thp_axis.size() * wfr_axis.size() *
+                             gfr_axis.size() * alq_axis.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = 100.0 + 1e-3 * i + std::sin(0.01 * i);
+    }
+
+    const Opm::VFPProdTable table(1, 1000.0,
+                                  Opm::VFPProdTable::FLO_TYPE::FLO_OIL,
+                                  Opm::VFPProdTable::WFR_TYPE::WFR_WOR,
+                                  Opm::VFPProdTable::GFR_TYPE::GFR_GOR,
+                                  Opm::VFPProdTable::ALQ_TYPE::ALQ_UNDEF,
+                                  flo_axis, thp_axis, wfr_axis, gfr_axis, alq_axis, data);
+    Opm::VFPProdProperties<double> properties;
+    properties.addTable(table);
+
+    const double thp = 50.0;
+    const double alq = 0.3;
+    const double wfr = 0.8;
+    const double gfr = 120.0;
+    Opm::detail::VFPProdPoints<double> points;
+    points.resize(numPoints);
+    for (std::size_t i = 0; i < numPoints; ++i) {
+        points.flo[i] = 500.0 + 400.0 * std::sin(10.0 * i / numPoints);
+        points.thp[i] = thp;
+        points.wfr[i] = wfr;
+        points.gfr[i] = gfr;
+        points.alq[i] = alq;
+    }
+
+    double sum = 0.0;
+    const double plain = timeIt([&] {
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            const double liquid = -points.flo[i];
+            sum += properties.bhp(1, wfr * liquid, liquid, gfr * liquid,
+                                  thp, alq, 0.0, 0.0, false);
+        }
+    }, numRepetitions);
+
+    Opm::detail::VFPBrackets brackets;
+    const double bracketed = timeIt([&] {
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            const double liquid = -points.flo[i];
+            sum += properties.bhp(1, wfr * liquid, liquid, gfr * liquid,
+                                  thp, alq, 0.0, 0.0, false, &brackets);
+        }
+    }, numRepetitions);
+
+    std::vector<Opm::detail::VFPEvaluation<double>> result;
+    const double batch = timeIt([&] {
+        properties.bhp(1, points, result, &brackets);
+        sum += result.back().value;
+    }, numRepetitions);
+
+    std::cout << "# axis size: " << axisSize << ", points: " << numPoints
+              << ", checksum: " << sum << "\n";
+    std::cout << "#  variant  time/point[s] speedup\n";
+    report("plain", plain, numPoints, plain);
+    report("bracketed", bracketed, numPoints, plain);
+    report("batch", batch, numPoints, plain);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Thread-scaling benchmark comparing the mutex based
+ *        ThreadedEntityIterator with the lock-free ChunkedEntityIterator.
+ *
+ * Usage: benchmark_threadediteration [CELLS_PER_DIRECTION] [WORK_PER_CELL] [CHUNK_SIZE]
+ *
+ * For each number of threads (powers of two up to OMP_NUM_THREADS) the
+ * average wall time of a loop over all elements of a 3D YaspGrid is
+ * reported. WORK_PER_CELL controls the amount of floating point work per
+ * element and should be chosen to resemble the cost of an intensive
+ * quantities update.
+ */
+#include "config.h"
+
+#include <dune/common/fvector.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <opm/models/parallel/chunkedentityiterator.hh>
+#include <opm/models/parallel/chunkscheduler.hpp>
+#include <opm/models/parallel/threadedentityiterator.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Grid = Dune::YaspGrid<3>;
+using GridView = Grid::LeafGridView;
+using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
+
+template <class Element>
+double cellWork(const Element& elem, int workPerCell)
+{
+    const auto center = elem.geometry().center();
+    double value = center[0] + 2.0*center[1] + 3.0*center[2];
+    for (int i = 0; i < workPerCell; ++i) {
+        value = std::sqrt(value*value + 1.0) - 0.5*std::exp(-value);
+    }
+    return value;
+}
+
+double runThreaded(const GridView& gridView,
+                   const ElementMapper& mapper,
+                   std::vector<double>& result,
+                   int workPerCell)
+{
+    Opm::ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        auto elemIt = threadedElemIt.beginParallel();
+        for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+            result[mapper.index(*elemIt)] = cellWork(*elemIt, workPerCell);
+        }
+    }
+    return result[0];
+}
+
+double runChunked(Opm::ChunkedEntityIterator<GridView, /*codim=*/0>& chunkedElemIt,
+                  const ElementMapper& mapper,
+                  std::vector<double>& result,
+                  int workPerCell)
+{
+    chunkedElemIt.reset();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        chunkedElemIt.forEach([&](const auto& elem)
+        {
+            result[mapper.index(elem)] = cellWork(elem, workPerCell);
+        });
+    }
+    return result[0];
+}
+
+template <class Fn>
+double timeIt(Fn&& fn, int numRepetitions)
+{
+    fn(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepetitions; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / numRepetitions;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const int cellsPerDir = argc > 1 ? std::atoi(argv[1]) : 100;
+    const int workPerCell = argc > 2 ? std::atoi(argv[2]) : 20;
+    const std::size_t chunkSize = argc > 3 ? std::atoi(argv[3]) : 64;
+    const int numRepetitions = 5;
+
+    Dune::FieldVector<double, 3> upperRight(1.0);
+    std::array<int, 3> cellRes;
+    cellRes.fill(cellsPerDir);
+    Grid grid(upperRight, cellRes);
+    const auto gridView = grid.leafGridView();
+    const ElementMapper mapper(gridView, Dune::mcmgElementLayout());
+
+    std::vector<double> reference(gridView.size(0));
+    std::vector<double> result(gridView.size(0));
+    runThreaded(gridView, mapper, reference, workPerCell);
+
+    int maxThreads = 1;
+#ifdef _OPENMP
+    maxThreads = omp_get_max_threads();
+#endif
+
+    using Mode = Opm::ChunkScheduler::Mode;
+    const std::array<std::pair<Mode, std::string>, 3> modes{{
+        {Mode::Static, "static"},
+        {Mode::Dynamic, "dynamic"},
+        {Mode::WorkStealing, "stealing"},
+    }};
+
+    std::cout << "# cells: " << gridView.size(0)
+              << ", work per cell: " << workPerCell
+              << ", chunk size: " << chunkSize << "\n";
+    std::cout << "# threads  mutex[s]";
+    for (const auto& mode : modes) {
+        std::cout << "  " << mode.second << "[s] speedup";
+    }
+    std::cout << "\n";
+
+    int status = EXIT_SUCCESS;
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+#ifdef _OPENMP
+        omp_set_num_threads(numThreads);
+#endif
+        const double mutexTime = timeIt([&] { runThreaded(gridView, mapper, result, workPerCell); },
+                                        numRepetitions);
+        std::cout << std::setw(9) << numThreads << "  " << std::scientific << std::setprecision(3)
+                  << mutexTime;
+
+        for (const auto& mode : modes) {
+            Opm::ChunkedEntityIterator<GridView, /*codim=*/0> chunkedElemIt(gridView, chunkSize, mode.first);
+            std::fill(result.begin(), result.end(), 0.0);
+            const double chunkedTime = timeIt([&] { runChunked(chunkedElemIt, mapper, result, workPerCell); },
+                                              numRepetitions);
+            if (result != reference) {
+                std::cerr << "Result of the '" << mode.second << "' iteration differs from the reference\n";
+                status = EXIT_FAILURE;
+            }
+            std::cout << "  " << chunkedTime << " " << std::fixed << std::setprecision(2)
+                      << std::setw(7) << mutexTime / chunkedTime << std::scientific << std::setprecision(3);
+        }
+        std::cout << std::endl;
+    }
+
+    return status;
+}
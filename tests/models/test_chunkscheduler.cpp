@@ -0,0 +1,116 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Checks that the ChunkScheduler hands out every index exactly once.
+ */
+#include <config.h>
+
+#define BOOST_TEST_MODULE ChunkSchedulerTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/models/parallel/chunkscheduler.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+void checkAllIndicesVisitedOnce(std::size_t numItems,
+                                std::size_t chunkSize,
+                                Opm::ChunkScheduler::Mode mode,
+                                unsigned numSlots)
+{
+    Opm::ChunkScheduler scheduler(numItems, chunkSize, mode, numSlots);
+    std::vector<std::atomic<int>> counters(numItems);
+
+    // run the loop twice to check that reset() makes all chunks available again
+    for (int iter = 0; iter < 2; ++iter) {
+        scheduler.reset();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(3)
+#endif
+        {
+            scheduler.run([&counters](std::size_t beginIdx, std::size_t endIdx)
+            {
+                for (std::size_t idx = beginIdx; idx < endIdx; ++idx) {
+                    counters[idx].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+
+    for (const auto& count : counters) {
+        BOOST_CHECK_EQUAL(count.load(), 2);
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(AllModes)
+{
+    using Mode = Opm::ChunkScheduler::Mode;
+    for (const auto mode : {Mode::Static, Mode::Dynamic, Mode::WorkStealing}) {
+        // fewer, equal and more slots than threads
+        for (const unsigned numSlots : {1u, 3u, 8u}) {
+            checkAllIndicesVisitedOnce(1000, 64, mode, numSlots);
+            checkAllIndicesVisitedOnce(1000, 1, mode, numSlots);
+            checkAllIndicesVisitedOnce(7, 64, mode, numSlots);
+            checkAllIndicesVisitedOnce(0, 64, mode, numSlots);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ChunkLayout)
+{
+    Opm::ChunkScheduler scheduler(130, 64, Opm::ChunkScheduler::Mode::Static, 1);
+    BOOST_CHECK_EQUAL(scheduler.numChunks(), 3u);
+
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    scheduler.run([&chunks](std::size_t beginIdx, std::size_t endIdx)
+    { chunks.emplace_back(beginIdx, endIdx); });
+
+    BOOST_REQUIRE_EQUAL(chunks.size(), 3u);
+    BOOST_CHECK_EQUAL(chunks[0].first, 0u);
+    BOOST_CHECK_EQUAL(chunks[0].second, 64u);
+    BOOST_CHECK_EQUAL(chunks[1].first, 64u);
+    BOOST_CHECK_EQUAL(chunks[1].second, 128u);
+    BOOST_CHECK_EQUAL(chunks[2].first, 128u);
+    BOOST_CHECK_EQUAL(chunks[2].second, 130u);
+}
+
+BOOST_AUTO_TEST_CASE(ModeFromString)
+{
+    using Mode = Opm::ChunkScheduler::Mode;
+    BOOST_CHECK(Opm::ChunkScheduler::modeFromString("static") == Mode::Static);
+    BOOST_CHECK(Opm::ChunkScheduler::modeFromString("dynamic") == Mode::Dynamic);
+    BOOST_CHECK(Opm::ChunkScheduler::modeFromString("stealing") == Mode::WorkStealing);
+    BOOST_CHECK_THROW(Opm::ChunkScheduler::modeFromString("guided"), std::invalid_argument);
+}
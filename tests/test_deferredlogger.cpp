@@ -98,3 +98,27 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     BOOST_CHECK_EQUAL(log_stream.str(), expected);
 
 }
+
+BOOST_AUTO_TEST_CASE(deferredlogger_append)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Info, "info 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Warning, "warning 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "info 2") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    auto deferred_logger = Opm::DeferredLogger();
+    auto other_logger = Opm::DeferredLogger();
+    deferred_logger.info("info 1");
+    other_logger.warning("warning 1");
+    other_logger.info("info 2");
+
+    deferred_logger.append(other_logger);
+    deferred_logger.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Warning) );
+    BOOST_CHECK_EQUAL( 2 , counter->numMessages(Log::MessageType::Info) );
+
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
@@ -0,0 +1,191 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE FaceBasedAssembly
+
+#include <opm/models/blackoil/blackoillocalresidualtpfa.hh>
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowProblemBlackoil.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+    namespace TTag {
+        struct TestFaceAssemblyTypeTag {
+            using InheritsFrom = std::tuple<TestTypeTag>;
+        };
+    }
+
+    template<class TypeTag>
+    struct Linearizer<TypeTag, TTag::TestFaceAssemblyTypeTag> { using type = TpfaLinearizer<TypeTag>; };
+
+    template<class TypeTag>
+    struct LocalResidual<TypeTag, TTag::TestFaceAssemblyTypeTag> { using type = BlackOilLocalResidualTPFA<TypeTag>; };
+
+    template<class TypeTag>
+    struct EnableDiffusion<TypeTag, TTag::TestFaceAssemblyTypeTag> { static constexpr bool value = false; };
+}
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename, const bool faceBased)
+{
+    using namespace Opm;
+    using Simulator = GetPropType<TypeTag, Properties::Simulator>;
+
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+    const std::string face_arg = std::string("--face-based-assembly=") + (faceBased ? "true" : "false");
+
+    const char* argv[] = {
+        "test_faceassembly",
+        filename_arg.c_str(),
+        face_arg.c_str()
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Opm::Parameters::SetDefault<Opm::Parameters::ThreadsPerProcess>(2);
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    FlowGenericVanguard::readDeck(filename);
+    return std::make_unique<Simulator>();
+}
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestFaceAssemblyTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using LocalResidual = Opm::GetPropType<TypeTag, Opm::Properties::LocalResidual>;
+using GlobalEqVector = Opm::GetPropType<TypeTag, Opm::Properties::GlobalEqVector>;
+using SparseMatrixAdapter = Opm::GetPropType<TypeTag, Opm::Properties::SparseMatrixAdapter>;
+using Matrix = typename SparseMatrixAdapter::IstlMatrix;
+
+struct FaceAssemblyFixture
+{
+    FaceAssemblyFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+// Linearize the first Newton iteration of the first time step of
+// GLIFT1.DATA with the cell or the face based assembly.
+void linearize(const bool faceBased, GlobalEqVector& residual, Matrix& jacobian)
+{
+    auto simulator = initSimulator<TypeTag>("GLIFT1.DATA", faceBased);
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(43200);  // 12 hours
+    simulator->model().newtonMethod().setIterationIndex(0);
+    auto& well_model = simulator->problem().wellModel();
+    well_model.beginReportStep(/*report_step_idx=*/0);
+    well_model.beginTimeStep();
+    Opm::DeferredLogger deferred_logger;
+    well_model.calculateExplicitQuantities(deferred_logger);
+    well_model.prepareTimeStep(deferred_logger);
+    well_model.updateWellControls(false, deferred_logger);
+    well_model.initPrimaryVariablesEvaluation();
+
+    BOOST_REQUIRE(LocalResidual::faceFluxApplicable(simulator->problem().moduleParams()));
+
+    auto& model = simulator->model();
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    auto& linearizer = model.linearizer();
+    linearizer.linearizeDomain();
+    residual = linearizer.residual();
+    jacobian = linearizer.jacobian().istlMatrix();
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(FaceAssemblyFixture);
+
+BOOST_AUTO_TEST_CASE(AgreesWithCellBasedAssembly)
+{
+    GlobalEqVector refResidual;
+    Matrix refJacobian;
+    linearize(/*faceBased=*/false, refResidual, refJacobian);
+
+    GlobalEqVector residual;
+    Matrix jacobian;
+    linearize(/*faceBased=*/true, residual, jacobian);
+
+    // The flux over a face is evaluated once instead of once from each
+    // side, the results agree up to rounding.
+    const double tol = 1.0e-10;
+    BOOST_REQUIRE_EQUAL(residual.size(), refResidual.size());
+    for (std::size_t row = 0; row < residual.size(); ++row) {
+        for (std::size_t eq = 0; eq < residual[row].size(); ++eq) {
+            const double ref = refResidual[row][eq];
+            BOOST_CHECK_SMALL(residual[row][eq] - ref, tol * std::max(1.0, std::abs(ref)));
+        }
+    }
+    BOOST_REQUIRE_EQUAL(jacobian.nonzeroes(), refJacobian.nonzeroes());
+    for (auto row = refJacobian.begin(); row != refJacobian.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            const auto& block = jacobian[row.index()][col.index()];
+            for (std::size_t i = 0; i < block.N(); ++i) {
+                for (std::size_t j = 0; j < block.M(); ++j) {
+                    const double ref = (*col)[i][j];
+                    BOOST_CHECK_SMALL(block[i][j] - ref, tol * std::max(1.0, std::abs(ref)));
+                }
+            }
+        }
+    }
+}
@@ -33,6 +33,8 @@
 
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 
 template <int bz>
@@ -118,3 +120,55 @@ BOOST_AUTO_TEST_CASE(TestFlexibleSolver)
         }
     }
 }
+
+#if HAVE_AMGCL
+template <int bz>
+void checkAmgclSolution(const Opm::PropertyTree& prm)
+{
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    const std::vector<double> expected {-1.62493, -1.76435e-06, 1.86991e-10,
+                                        -458.542, 2.28308e-06, -2.45341e-07,
+                                        -1.48005, -5.02264e-07, -1.049e-05};
+    BOOST_REQUIRE_EQUAL(sol.size() * bz, expected.size());
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_CLOSE(sol[i][row], expected[i * bz + row], 1e-3);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFlexibleSolverAmgcl)
+{
+    // amgcl as preconditioner of the outer solver.
+    {
+        Opm::PropertyTree prm;
+        prm.put("tol", 1e-10);
+        prm.put("maxiter", 200);
+        prm.put("verbosity", 0);
+        prm.put("solver", std::string("bicgstab"));
+        prm.put("preconditioner.type", std::string("amgcl"));
+        checkAmgclSolution<1>(prm);
+        checkAmgclSolution<3>(prm);
+    }
+
+    // amgcl as preconditioner of the CPR coarse solver.
+    {
+        Opm::PropertyTree prm;
+        prm.put("tol", 1e-10);
+        prm.put("maxiter", 200);
+        prm.put("verbosity", 0);
+        prm.put("solver", std::string("bicgstab"));
+        prm.put("preconditioner.type", std::string("cpr"));
+        prm.put("preconditioner.verbosity", 0);
+        prm.put("preconditioner.finesmoother.type", std::string("ILU0"));
+        prm.put("preconditioner.finesmoother.relaxation", 1.0);
+        prm.put("preconditioner.coarsesolver.tol", 1e-2);
+        prm.put("preconditioner.coarsesolver.maxiter", 20);
+        prm.put("preconditioner.coarsesolver.verbosity", 0);
+        prm.put("preconditioner.coarsesolver.solver", std::string("bicgstab"));
+        prm.put("preconditioner.coarsesolver.preconditioner.type", std::string("amgcl"));
+        checkAmgclSolution<1>(prm);
+        checkAmgclSolution<3>(prm);
+    }
+}
+#endif
@@ -0,0 +1,142 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TestGcroDrSolver
+
+#include <config.h>
+#include <opm/simulators/linalg/GcroDrSolver.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+// Nonsymmetric tridiagonal matrix with a few small diagonal entries, which
+// give eigenvalues close to zero the Krylov solver converges slowly for.
+// The diagonal is perturbed by eps.
+Matrix createMatrix(const int n, const double eps)
+{
+    Matrix A(n, n, 3 * n, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        A[i][i] = (i % 500 == 7) ? 1e-3 * (1 + i / 500) : 4.0 + eps * std::sin(i);
+        if (i > 0) {
+            A[i][i - 1] = -0.3;
+        }
+        if (i < n - 1) {
+            A[i][i + 1] = -0.5;
+        }
+    }
+    return A;
+}
+
+Vector createRhs(const int n, const double shift)
+{
+    Vector b(n);
+    for (int i = 0; i < n; ++i) {
+        b[i] = std::cos(0.1 * i * (1.0 + shift));
+    }
+    return b;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolvesToTolerance)
+{
+    const int n = 1600;
+    Matrix A = createMatrix(n, 0.0);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::Richardson<Vector, Vector> prec(0.25);
+    Opm::GcroDrSolver<Vector> solver(op, sp, prec, 1e-8, 10, 5, 200, 0);
+
+    const Vector b = createRhs(n, 0.0);
+    Vector rhs = b;
+    Vector x(n);
+    x = 0.0;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, rhs, res);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_EQUAL(solver.recycledSize(), std::size_t{5});
+
+    Vector r = b;
+    A.mmv(x, r);
+    BOOST_CHECK_LT(r.two_norm(), 1e-8 * b.two_norm());
+    BOOST_CHECK_CLOSE(res.reduction, r.two_norm() / b.two_norm(), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(RecyclingReducesIterations)
+{
+    const int n = 1600;
+    Matrix A = createMatrix(n, 0.0);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::Richardson<Vector, Vector> prec(0.25);
+    Opm::GcroDrSolver<Vector> recycling(op, sp, prec, 1e-8, 10, 5, 200, 0);
+    Opm::GcroDrSolver<Vector> plain(op, sp, prec, 1e-8, 10, 0, 200, 0);
+
+    // A sequence of systems with the same sparsity pattern and similar
+    // values, as in consecutive Newton iterations.
+    for (int k = 0; k < 4; ++k) {
+        const Matrix perturbed = createMatrix(n, 0.01 * k);
+        A = perturbed;
+        const Vector b = createRhs(n, 0.05 * k);
+
+        Dune::InverseOperatorResult res;
+        Vector x(n);
+        x = 0.0;
+        Vector rhs = b;
+        recycling.apply(x, rhs, res);
+        BOOST_CHECK(res.converged);
+        Vector r = b;
+        A.mmv(x, r);
+        BOOST_CHECK_LT(r.two_norm(), 1e-7 * b.two_norm());
+
+        Dune::InverseOperatorResult plainRes;
+        Vector y(n);
+        y = 0.0;
+        rhs = b;
+        plain.apply(y, rhs, plainRes);
+        BOOST_CHECK(plainRes.converged);
+        BOOST_CHECK_EQUAL(plain.recycledSize(), std::size_t{0});
+
+        BOOST_TEST_MESSAGE("System " << k << ": " << res.iterations << " iterations with, "
+                           << plainRes.iterations << " without recycling");
+        if (k > 0) {
+            BOOST_CHECK_LT(2 * res.iterations, plainRes.iterations);
+        }
+    }
+}
@@ -32,6 +32,7 @@
 #include <opm/input/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Units/Units.hpp>
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/flow/BlackoilModel.hpp>
 #include <opm/simulators/flow/FlowProblemBlackoil.hpp>
@@ -49,6 +50,7 @@
 #include <dune/common/parallel/mpihelper.hh>
 #endif
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -207,3 +209,82 @@ BOOST_AUTO_TEST_CASE(G1)
     BOOST_CHECK(!state->increase().has_value());
 }
 
+
+// Repeat the BHP at THP limit solve of B-1H with unchanged and with changed
+// ALQ, starting from the last solution, and compare with the solves from
+// scratch.
+BOOST_AUTO_TEST_CASE(BhpAtThpLimitWarmStart)
+{
+    using TypeTag = Opm::Properties::TTag::TestGliftTypeTag;
+    using WellModel = Opm::BlackoilWellModel<TypeTag>;
+    using StdWell = Opm::StandardWell<TypeTag>;
+
+    auto simulator = initSimulator<TypeTag>("GLIFT1.DATA");
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(43200);  // 12 hours
+    simulator->model().newtonMethod().setIterationIndex(0);
+    WellModel& well_model = simulator->problem().wellModel();
+    well_model.beginReportStep(/*report_step_idx=*/0);
+    well_model.beginTimeStep();
+    Opm::DeferredLogger deferred_logger;
+    well_model.calculateExplicitQuantities(deferred_logger);
+    well_model.prepareTimeStep(deferred_logger);
+    well_model.updateWellControls(false, deferred_logger);
+    well_model.initPrimaryVariablesEvaluation();
+    const StdWell* std_well = dynamic_cast<const StdWell*>(well_model.getWell("B-1H").get());
+    BOOST_REQUIRE(std_well != nullptr);
+
+    const auto& summary_state = simulator->vanguard().summaryState();
+    auto& cache = std_well->bhpAtThpLimitCache();
+    const auto solve = [&](const double alq)
+    {
+        return std_well->computeBhpAtThpLimitProdWithAlq(*simulator, summary_state, alq, deferred_logger,
+                                                         /*iterate_if_no_solution=*/false);
+    };
+    const auto coldSolve = [&](const double alq)
+    {
+        cache.bhp.reset();
+        return solve(alq);
+    };
+    const auto numSolves = [&cache]()
+    { return cache.hits + cache.warm_starts + cache.misses; };
+    // Both solutions are within the solver tolerance of 0.01 bar of the root.
+    const double tolerance = 2 * 0.01 * Opm::unit::barsa;
+
+    // the well model may have solved already
+    cache.hits = 0;
+    cache.warm_starts = 0;
+    cache.misses = 0;
+
+    // unchanged inputs, the second solve starts at the solution
+    const auto cold = coldSolve(0.0);
+    BOOST_REQUIRE(cold.has_value());
+    BOOST_CHECK_EQUAL(cache.misses, std::size_t{1});
+    const auto hit = solve(0.0);
+    BOOST_REQUIRE(hit.has_value());
+    BOOST_CHECK_EQUAL(cache.misses, std::size_t{1});
+    BOOST_CHECK_EQUAL(cache.hits + cache.warm_starts, std::size_t{1});
+    BOOST_CHECK_SMALL(*hit - *cold, tolerance);
+
+    // shifted ALQ (in sm3/day), starting from the solution of the previous one
+    std::optional<double> previous = cache.bhp;
+    for (const double alq : {5000.0, 20000.0, 50000.0, 40000.0}) {
+        const auto reference = coldSolve(alq / Opm::unit::day);
+        BOOST_REQUIRE(reference.has_value());
+        cache.bhp = previous;
+        const auto solves = numSolves();
+        const auto warm = solve(alq / Opm::unit::day);
+        BOOST_REQUIRE(warm.has_value());
+        BOOST_CHECK_EQUAL(numSolves(), solves + 1);
+        BOOST_CHECK_SMALL(*warm - *reference, tolerance);
+        // also a rejected warm start keeps the solution from scratch
+        BOOST_REQUIRE(cache.bhp.has_value());
+        BOOST_CHECK_EQUAL(*cache.bhp, *warm);
+        previous = cache.bhp;
+    }
+    BOOST_CHECK(cache.warm_starts > 0);
+}
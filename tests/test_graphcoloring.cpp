@@ -89,6 +89,70 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
     checkAllIndices(newOrder);
 }
 
+BOOST_AUTO_TEST_CASE(TestReverseCuthillMcKee)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+    // Two disconnected N x N grids with scattered numbering, followed by
+    // two ghost vertices coupled to the interior.
+    const int N = 10;
+    const int noInterior = 2 * N * N;
+    const int noVertices = noInterior + 2;
+    auto scatter = [noInterior](int index) { return (index * 37) % noInterior; };
+    Matrix matrix(noVertices, noVertices, 5, 0.4, Matrix::implicit);
+    for (int grid = 0; grid < 2; ++grid) {
+        for (int j = 0; j < N; j++) {
+            for (int i = 0; i < N; i++) {
+                const int index = grid * N * N + j * N + i;
+                matrix.entry(scatter(index), scatter(index)) = 1;
+                if (i > 0) {
+                    matrix.entry(scatter(index), scatter(index - 1)) = 1;
+                }
+                if (i < N - 1) {
+                    matrix.entry(scatter(index), scatter(index + 1)) = 1;
+                }
+                if (j > 0) {
+                    matrix.entry(scatter(index), scatter(index - N)) = 1;
+                }
+                if (j < N - 1) {
+                    matrix.entry(scatter(index), scatter(index + N)) = 1;
+                }
+            }
+        }
+    }
+    for (int ghost = noInterior; ghost < noVertices; ++ghost) {
+        matrix.entry(ghost, ghost) = 1;
+        matrix.entry(ghost, 0) = 1;
+        matrix.entry(0, ghost) = 1;
+    }
+    matrix.compress();
+
+    Graph graph(matrix);
+    const auto newOrder = Opm::reorderVerticesRCM(graph, noInterior);
+    BOOST_REQUIRE(newOrder.size() == std::size_t(noVertices));
+    checkAllIndices(newOrder);
+    for (int ghost = noInterior; ghost < noVertices; ++ghost) {
+        BOOST_CHECK(newOrder[ghost] == std::size_t(ghost));
+    }
+
+    // The bandwidth of the interior rows is at most the one of the natural
+    // ordering of a grid.
+    std::size_t bandwidth = 0;
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        if (row.index() >= std::size_t(noInterior)) {
+            continue;
+        }
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            if (col.index() < std::size_t(noInterior)) {
+                const auto newRow = newOrder[row.index()];
+                const auto newCol = newOrder[col.index()];
+                bandwidth = std::max(bandwidth, newRow > newCol ? newRow - newCol : newCol - newRow);
+            }
+        }
+    }
+    BOOST_CHECK(bandwidth <= std::size_t(N));
+}
+
 // The following tests verify the graph coloring in the context of revealing which rows
 // can be operated on at the same time in the DILU preconditioner
 BOOST_AUTO_TEST_CASE(TestColoredDiluParallelisms3x3Matrix)
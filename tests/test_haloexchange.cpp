@@ -0,0 +1,255 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TestHaloExchange
+
+#include <config.h>
+#include <opm/simulators/linalg/HaloExchange.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/WellOperators.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <boost/test/unit_test.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 2, 2>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
+using Operator = Opm::GhostLastMatrixAdapter<Matrix, Vector, Vector, Communication>;
+using ILU0 = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Communication>;
+
+struct MPIFixture
+{
+    MPIFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+        Dune::MPIHelper::instance(argc, argv);
+    }
+};
+
+// A chain of cells distributed over the processes. Each process owns
+// numOwned consecutive cells, which are stored first, followed by the copies
+// of the last cell of the previous and the first cell of the next process.
+// The rows of the copies only hold an identity diagonal block.
+struct DistributedChain
+{
+    static constexpr int numOwned = 50;
+
+    DistributedChain()
+        : comm(MPI_COMM_WORLD)
+    {
+        const int rank = comm.communicator().rank();
+        const int size = comm.communicator().size();
+        const int offset = rank * numOwned;
+        for (int i = 0; i < numOwned; ++i) {
+            globalIndices.push_back(offset + i);
+        }
+        int left = -1;
+        int right = -1;
+        if (rank > 0) {
+            left = globalIndices.size();
+            globalIndices.push_back(offset - 1);
+        }
+        if (rank < size - 1) {
+            right = globalIndices.size();
+            globalIndices.push_back(offset + numOwned);
+        }
+
+        using Attribute = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+        using LocalIndex = Dune::ParallelLocalIndex<Attribute>;
+        comm.indexSet().beginResize();
+        for (std::size_t i = 0; i < globalIndices.size(); ++i) {
+            const Attribute attribute = static_cast<int>(i) < numOwned
+                ? Dune::OwnerOverlapCopyAttributeSet::owner
+                : Dune::OwnerOverlapCopyAttributeSet::copy;
+            comm.indexSet().add(globalIndices[i], LocalIndex(i, attribute, true));
+        }
+        comm.indexSet().endResize();
+        comm.remoteIndices().rebuild<false>();
+
+        const int N = globalIndices.size();
+        A.setBuildMode(Matrix::row_wise);
+        A.setSize(N, N, 3 * N);
+        for (auto row = A.createbegin(); row != A.createend(); ++row) {
+            const int i = row.index();
+            row.insert(i);
+            if (i >= numOwned) {
+                continue;
+            }
+            const int lower = i > 0 ? i - 1 : left;
+            const int upper = i < numOwned - 1 ? i + 1 : right;
+            if (lower >= 0) {
+                row.insert(lower);
+            }
+            if (upper >= 0) {
+                row.insert(upper);
+            }
+        }
+        A = 0.0;
+        for (int i = 0; i < N; ++i) {
+            auto& diag = A[i][i];
+            if (i >= numOwned) {
+                diag[0][0] = 1.0;
+                diag[1][1] = 1.0;
+                continue;
+            }
+            diag[0][0] = 4.0 + 0.01 * globalIndices[i];
+            diag[1][1] = 3.0;
+            diag[0][1] = 0.5;
+            diag[1][0] = -0.3;
+            for (auto col = A[i].begin(); col != A[i].end(); ++col) {
+                if (col.index() != static_cast<std::size_t>(i)) {
+                    const bool lower = globalIndices[col.index()] < globalIndices[i];
+                    (*col)[0][0] = lower ? -1.2 : -0.8;
+                    (*col)[1][1] = lower ? -0.9 : -1.1;
+                }
+            }
+        }
+    }
+
+    // A vector with consistent owned entries and garbage in the copies.
+    Vector createVector(const double shift) const
+    {
+        Vector x(globalIndices.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (static_cast<int>(i) < numOwned) {
+                x[i][0] = std::cos(0.1 * globalIndices[i] + shift);
+                x[i][1] = std::sin(0.2 * globalIndices[i] - shift);
+            } else {
+                x[i] = 1.0e3;
+            }
+        }
+        return x;
+    }
+
+    Communication comm;
+    std::vector<int> globalIndices;
+    Matrix A;
+};
+
+void checkEqual(const Vector& x, const Vector& y)
+{
+    BOOST_REQUIRE_EQUAL(x.size(), y.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_EQUAL(x[i][0], y[i][0]);
+        BOOST_CHECK_EQUAL(x[i][1], y[i][1]);
+    }
+}
+
+} // anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+BOOST_AUTO_TEST_CASE(StartFinishMatchesCopyOwnerToAll)
+{
+    DistributedChain chain;
+    Opm::HaloExchange<Vector> exchange(chain.comm);
+    BOOST_CHECK_EQUAL(exchange.empty(), chain.comm.communicator().size() == 1);
+
+    Vector reference = chain.createVector(0.0);
+    Vector x = reference;
+    chain.comm.copyOwnerToAll(reference, reference);
+
+    exchange.start(x);
+    BOOST_CHECK_EQUAL(exchange.isPending(x), !exchange.empty());
+    exchange.finish();
+    BOOST_CHECK(!exchange.isPending(x));
+    checkEqual(x, reference);
+
+    // a pending exchange is finished by the next one
+    Vector y = chain.createVector(1.0);
+    Vector yReference = y;
+    chain.comm.copyOwnerToAll(yReference, yReference);
+    x = chain.createVector(0.0);
+    exchange.start(x);
+    exchange.start(y);
+    BOOST_CHECK(!exchange.isPending(x));
+    exchange.finish();
+    checkEqual(x, reference);
+    checkEqual(y, yReference);
+}
+
+BOOST_AUTO_TEST_CASE(OperatorFinishesPendingExchange)
+{
+    DistributedChain chain;
+    auto exchange = std::make_shared<Opm::HaloExchange<Vector>>(chain.comm);
+    Operator op(chain.A, chain.comm);
+    op.setHaloExchange(exchange);
+    const Operator referenceOp(chain.A, chain.comm);
+
+    Vector xReference = chain.createVector(0.0);
+    chain.comm.copyOwnerToAll(xReference, xReference);
+    Vector yReference(xReference.size());
+    referenceOp.apply(xReference, yReference);
+    Vector zReference = chain.createVector(2.0);
+    Vector z = zReference;
+    referenceOp.applyscaleadd(-0.5, xReference, zReference);
+
+    Vector x = chain.createVector(0.0);
+    Vector y(x.size());
+    exchange->start(x);
+    op.apply(x, y);
+    BOOST_CHECK(!exchange->isPending(x));
+    checkEqual(x, xReference);
+    checkEqual(y, yReference);
+
+    x = chain.createVector(0.0);
+    exchange->start(x);
+    op.applyscaleadd(-0.5, x, z);
+    BOOST_CHECK(!exchange->isPending(x));
+    checkEqual(z, zReference);
+}
+
+BOOST_AUTO_TEST_CASE(ILU0WithPendingExchange)
+{
+    DistributedChain chain;
+    auto exchange = std::make_shared<Opm::HaloExchange<Vector>>(chain.comm);
+    Operator op(chain.A, chain.comm);
+    op.setHaloExchange(exchange);
+    const Operator referenceOp(chain.A, chain.comm);
+
+    ILU0 ilu(chain.A, chain.comm, /*n=*/0, /*w=*/1.0, Opm::MILU_VARIANT::ILU);
+    ilu.setHaloExchange(exchange);
+    ILU0 referenceIlu(chain.A, chain.comm, /*n=*/0, /*w=*/1.0, Opm::MILU_VARIANT::ILU);
+
+    const Vector d = chain.createVector(0.5);
+    Vector vReference(d.size());
+    referenceIlu.apply(vReference, d);
+    Vector yReference(d.size());
+    referenceOp.apply(vReference, yReference);
+
+    // The preconditioner only starts the exchange of its result, which the
+    // operator finishes after multiplying the interior rows.
+    Vector v(d.size());
+    ilu.apply(v, d);
+    BOOST_CHECK_EQUAL(exchange->isPending(v), !exchange->empty());
+    Vector y(d.size());
+    op.apply(v, y);
+    BOOST_CHECK(!exchange->isPending(v));
+    checkEqual(v, vReference);
+    checkEqual(y, yReference);
+}
@@ -0,0 +1,250 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE IncrementalIntensiveQuantities
+
+#include <opm/models/blackoil/blackoillocalresidualtpfa.hh>
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModel.hpp>
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowProblemBlackoil.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+    namespace TTag {
+        struct TestIncrementalTypeTag {
+            using InheritsFrom = std::tuple<TestTypeTag>;
+        };
+    }
+
+    // the flux terms are only cached by the TPFA linearizer
+    template<class TypeTag>
+    struct Linearizer<TypeTag, TTag::TestIncrementalTypeTag> { using type = TpfaLinearizer<TypeTag>; };
+
+    template<class TypeTag>
+    struct LocalResidual<TypeTag, TTag::TestIncrementalTypeTag> { using type = BlackOilLocalResidualTPFA<TypeTag>; };
+
+    template<class TypeTag>
+    struct EnableDiffusion<TypeTag, TTag::TestIncrementalTypeTag> { static constexpr bool value = false; };
+}
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename)
+{
+    using namespace Opm;
+    using Simulator = GetPropType<TypeTag, Properties::Simulator>;
+
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+
+    const char* argv[] = {
+        "test_incrementaliqupdate",
+        filename_arg.c_str()
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Opm::Parameters::SetDefault<Opm::Parameters::ThreadsPerProcess>(2);
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    FlowGenericVanguard::readDeck(filename);
+    return std::make_unique<Simulator>();
+}
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestIncrementalTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using FluidSystem = Opm::GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+
+struct IncrementalFixture
+{
+    IncrementalFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+// Set up the first time step of GLIFT1.DATA such that the system can be
+// linearized.
+std::unique_ptr<Simulator> initTimeStep()
+{
+    auto simulator = initSimulator<TypeTag>("GLIFT1.DATA");
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(43200);  // 12 hours
+    simulator->model().newtonMethod().setIterationIndex(0);
+    auto& well_model = simulator->problem().wellModel();
+    well_model.beginReportStep(/*report_step_idx=*/0);
+    well_model.beginTimeStep();
+    Opm::DeferredLogger deferred_logger;
+    well_model.calculateExplicitQuantities(deferred_logger);
+    well_model.prepareTimeStep(deferred_logger);
+    well_model.updateWellControls(false, deferred_logger);
+    well_model.initPrimaryVariablesEvaluation();
+    return simulator;
+}
+
+double iqPressure(const Simulator& simulator, const unsigned cell)
+{
+    return simulator.model().intensiveQuantities(cell, /*timeIdx=*/0)
+        .fluidState().pressure(FluidSystem::oilPhaseIdx).value();
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(IncrementalFixture);
+
+BOOST_AUTO_TEST_CASE(FluxCache)
+{
+    auto simulator = initTimeStep();
+    auto& model = simulator->model();
+    auto& linearizer = model.linearizer();
+    model.setTrackIntensiveQuantityChanges(true);
+    BOOST_REQUIRE(model.trackIntensiveQuantityChanges());
+
+    // The first linearization of a time step stores the flux terms.
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    linearizer.linearizeDomain();
+
+    // Change a single cell. Only the flux terms of it and of its neighbors
+    // are recomputed, all other ones are taken from the cache.
+    model.newtonMethod().setIterationIndex(1);
+    const unsigned cell = model.numTotalDof() / 2;
+    model.solution(/*timeIdx=*/0)[cell][Indices::pressureSwitchIdx] += 1.0e4;
+    std::vector<unsigned char> cellChanged(model.numTotalDof(), 0);
+    cellChanged[cell] = 1;
+    const std::size_t numSkipped = model.updateChangedIntensiveQuantities(cellChanged);
+    BOOST_CHECK_EQUAL(numSkipped, model.numTotalDof() - 1);
+    BOOST_REQUIRE(model.changedIntensiveQuantities() != nullptr);
+    linearizer.linearizeDomain();
+    const auto residual = linearizer.residual();
+    const auto jacobian = linearizer.jacobian().istlMatrix();
+
+    // Linearize again from scratch.
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    BOOST_REQUIRE(model.changedIntensiveQuantities() == nullptr);
+    linearizer.linearizeDomain();
+    const auto& refResidual = linearizer.residual();
+    const auto& refJacobian = linearizer.jacobian().istlMatrix();
+
+    const double tol = 1.0e-12;
+    BOOST_REQUIRE_EQUAL(residual.size(), refResidual.size());
+    for (std::size_t row = 0; row < residual.size(); ++row) {
+        for (std::size_t eq = 0; eq < residual[row].size(); ++eq) {
+            const double ref = refResidual[row][eq];
+            BOOST_CHECK_SMALL(residual[row][eq] - ref, tol * std::max(1.0, std::abs(ref)));
+        }
+    }
+    for (auto row = refJacobian.begin(); row != refJacobian.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            const auto& block = jacobian[row.index()][col.index()];
+            for (std::size_t i = 0; i < block.N(); ++i) {
+                for (std::size_t j = 0; j < block.M(); ++j) {
+                    const double ref = (*col)[i][j];
+                    BOOST_CHECK_SMALL(block[i][j] - ref, tol * std::max(1.0, std::abs(ref)));
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalUpdate)
+{
+    auto simulator = initTimeStep();
+    auto& model = simulator->model();
+    auto& well_model = simulator->problem().wellModel();
+
+    Opm::BlackoilModelParameters<double> param;
+    param.incremental_iq_update_ = true;
+    param.incremental_iq_update_tolerance_ = 1.0e-6;
+    Opm::BlackoilModel<TypeTag> blackoil_model(*simulator, param, well_model,
+                                               /*terminal_output=*/false);
+
+    using BVector = Opm::BlackoilModel<TypeTag>::BVector;
+    BVector dx(model.numTotalDof());
+    dx = 0.0;
+
+    // The first iteration of a time step updates all cells.
+    model.newtonMethod().setIterationIndex(0);
+    blackoil_model.updateSolution(dx);
+    const unsigned cell = model.numTotalDof() / 2;
+    const double p0 = model.solution(/*timeIdx=*/0)[cell][Indices::pressureSwitchIdx];
+    BOOST_CHECK_CLOSE(iqPressure(*simulator, cell), p0, 1.0e-10);
+    BOOST_CHECK_EQUAL(blackoil_model.numSkippedIntensiveQuantities(), std::size_t{0});
+
+    // Move the cell by steps which are each below the tolerance. Its
+    // intensive quantities must be updated as soon as the sum of the steps
+    // exceeds the tolerance, and the next steps are measured from there.
+    const double step = 0.4 * param.incremental_iq_update_tolerance_ * p0;
+    dx[cell][Indices::pressureSwitchIdx] = -step;
+    const double expected[] = { p0, p0, p0 + 3*step, p0 + 3*step, p0 + 3*step, p0 + 6*step };
+    const bool updated[] = { false, false, true, false, false, true };
+    for (int iter = 0; iter < 6; ++iter) {
+        model.newtonMethod().setIterationIndex(iter + 1);
+        blackoil_model.updateSolution(dx);
+        BOOST_CHECK_CLOSE(model.solution(/*timeIdx=*/0)[cell][Indices::pressureSwitchIdx],
+                          p0 + (iter + 1)*step, 1.0e-10);
+        BOOST_CHECK_CLOSE(iqPressure(*simulator, cell), expected[iter], 1.0e-10);
+        // all other cells keep their intensive quantities
+        BOOST_CHECK_EQUAL(blackoil_model.numSkippedIntensiveQuantities(),
+                          model.numTotalDof() - (updated[iter] ? 1 : 0));
+    }
+}
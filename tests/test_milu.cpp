@@ -2,11 +2,18 @@
 
 #define BOOST_TEST_MODULE MILU0Test
 
+#include<algorithm>
+#include<cmath>
+#include<numeric>
+#include<random>
 #include<vector>
 #include<memory>
 
 #include<dune/istl/bcrsmatrix.hh>
 #include<dune/istl/bvector.hh>
+#include<dune/istl/operators.hh>
+#include<dune/istl/scalarproducts.hh>
+#include<dune/istl/solvers.hh>
 #include<dune/common/version.hh>
 #include<dune/common/fmatrix.hh>
 #include<dune/common/fvector.hh>
@@ -14,6 +21,10 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #include <boost/test/unit_test.hpp>
 #include <boost/version.hpp>
 #if BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 < 71
@@ -200,3 +211,143 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+template<int bsize>
+void testLevelScheduled(Opm::MILU_VARIANT milu)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector,
+                                             Dune::Amg::SequentialInformation>;
+
+    Matrix A;
+    setupLaplacian(A, 32);
+    Vector d(A.N());
+    for (std::size_t i = 0; i < d.size(); ++i)
+        d[i] = 1.0 + i % 7;
+
+#if HAVE_OPENMP
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    ILU sequential(A, 0, 1.0, milu);
+    Vector vSequential(A.N());
+    sequential.apply(vSequential, d);
+
+#if HAVE_OPENMP
+    omp_set_num_threads(4);
+#endif
+    ILU threaded(A, 0, 1.0, milu);
+    // the level sets are reused in the update
+    threaded.update();
+    Vector vThreaded(A.N());
+    threaded.apply(vThreaded, d);
+#if HAVE_OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+
+    for (std::size_t i = 0; i < d.size(); ++i)
+        for (int k = 0; k < bsize; ++k)
+            BOOST_CHECK_CLOSE(vThreaded[i][k], vSequential[i][k], 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(LevelScheduledILU0)
+{
+    testLevelScheduled<1>(Opm::MILU_VARIANT::ILU);
+    testLevelScheduled<3>(Opm::MILU_VARIANT::ILU);
+}
+
+BOOST_AUTO_TEST_CASE(LevelScheduledMILU)
+{
+    testLevelScheduled<2>(Opm::MILU_VARIANT::MILU_1);
+    testLevelScheduled<2>(Opm::MILU_VARIANT::MILU_2);
+}
+
+// Returns P A P^T, where row i of A becomes row perm[i].
+template<class Matrix>
+Matrix permute(const Matrix& A, const std::vector<std::size_t>& perm)
+{
+    std::vector<std::size_t> inverse(perm.size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+        inverse[perm[i]] = i;
+
+    Matrix B(A.N(), A.M(), A.nonzeroes(), Matrix::row_wise);
+    for (auto row = B.createbegin(); row != B.createend(); ++row)
+        for (auto col = A[inverse[row.index()]].begin(); col != A[inverse[row.index()]].end(); ++col)
+            row.insert(perm[col.index()]);
+    for (auto row = A.begin(); row != A.end(); ++row)
+        for (auto col = row->begin(); col != row->end(); ++col)
+            B[perm[row.index()]][perm[col.index()]] = *col;
+    return B;
+}
+
+template<int bsize>
+void testRCMOrdered()
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector,
+                                             Dune::Amg::SequentialInformation>;
+
+    // A Laplacian whose cells are numbered randomly, as the ILU0 of such
+    // an ordering is a poor preconditioner.
+    Matrix laplacian;
+    setupLaplacian(laplacian, 32);
+    std::vector<std::size_t> perm(laplacian.N());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(42));
+    Matrix A = permute(laplacian, perm);
+
+    Vector b(A.N());
+    for (std::size_t i = 0; i < b.size(); ++i)
+        b[i] = 1.0 + i % 7;
+
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    auto solve = [&op, &sp, &b](ILU& prec, Vector& x)
+    {
+        x = 0.0;
+        Vector rhs = b;
+        Dune::BiCGSTABSolver<Vector> solver(op, sp, prec, 1e-10, 1000, 0);
+        Dune::InverseOperatorResult res;
+        solver.apply(x, rhs, res);
+        BOOST_CHECK(res.converged);
+        return res.iterations;
+    };
+
+    ILU natural(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+                /*redblack=*/false, /*reorder_sphere=*/false, /*reorder_rcm=*/false);
+    ILU rcm(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+            /*redblack=*/false, /*reorder_sphere=*/false, /*reorder_rcm=*/true);
+    Vector xNatural(A.N());
+    Vector xRcm(A.N());
+    const int iterationsNatural = solve(natural, xNatural);
+    const int iterationsRcm = solve(rcm, xRcm);
+
+    // Both solve the system, with fewer iterations in the bandwidth
+    // reduced ordering.
+    for (std::size_t i = 0; i < xRcm.size(); ++i)
+        for (int k = 0; k < bsize; ++k)
+            BOOST_CHECK_SMALL(xRcm[i][k] - xNatural[i][k],
+                              1e-6 * std::max(1.0, std::abs(xNatural[i][k])));
+    BOOST_CHECK_LT(iterationsRcm, iterationsNatural);
+
+    // The reordered copy of the matrix is reused by update().
+    A *= 2.0;
+    rcm.update();
+    ILU fresh(A, 0, 1.0, Opm::MILU_VARIANT::ILU,
+              /*redblack=*/false, /*reorder_sphere=*/false, /*reorder_rcm=*/true);
+    Vector vUpdated(A.N());
+    Vector vFresh(A.N());
+    rcm.apply(vUpdated, b);
+    fresh.apply(vFresh, b);
+    for (std::size_t i = 0; i < vFresh.size(); ++i)
+        for (int k = 0; k < bsize; ++k)
+            BOOST_CHECK_CLOSE(vUpdated[i][k], vFresh[i][k], 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(RCMOrderedILU0)
+{
+    testRCMOrdered<1>();
+    testRCMOrdered<3>();
+}
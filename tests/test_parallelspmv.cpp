@@ -0,0 +1,215 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TestParallelSpMV
+
+#include <config.h>
+#include <opm/simulators/linalg/ParallelSpMV.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int bz = 3;
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+
+// Banded matrix with a varying number of blocks per row and random entries.
+Matrix createMatrix(const std::size_t N)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    Matrix A(N, N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const std::size_t i = row.index();
+        const std::size_t width = 1 + i % 7;
+        for (std::size_t j = (i < width ? 0 : i - width); j <= std::min(N - 1, i + width); ++j) {
+            row.insert(j);
+        }
+    }
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int k = 0; k < bz; ++k) {
+                for (int l = 0; l < bz; ++l) {
+                    (*col)[k][l] = dist(gen);
+                }
+            }
+        }
+    }
+    return A;
+}
+
+Vector createVector(const std::size_t N, const unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Vector x(N);
+    for (auto& block : x) {
+        for (auto& value : block) {
+            value = dist(gen);
+        }
+    }
+    return x;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(PartitionCoversAllRows)
+{
+    const std::size_t N = 10000;
+    const Matrix A = createMatrix(N);
+
+    for (const int numThreads : {1, 2, 3, 7}) {
+        const Opm::ParallelSpMV<Matrix> spmv(A, N, numThreads);
+        const auto& rowBegin = spmv.rowBegin();
+        BOOST_REQUIRE_EQUAL(spmv.numParts(), numThreads);
+        BOOST_CHECK_EQUAL(spmv.isParallel(), numThreads > 1);
+        BOOST_CHECK_EQUAL(rowBegin.front(), std::size_t{0});
+        BOOST_CHECK_EQUAL(rowBegin.back(), N);
+        for (int part = 0; part < numThreads; ++part) {
+            BOOST_CHECK_LT(rowBegin[part], rowBegin[part + 1]);
+        }
+    }
+
+    // small matrices are not split
+    const Matrix B = createMatrix(100);
+    const Opm::ParallelSpMV<Matrix> spmv(B, B.N(), 4);
+    BOOST_CHECK_EQUAL(spmv.numParts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ProductMatchesSequential)
+{
+    const std::size_t N = 5000;
+    const Matrix A = createMatrix(N);
+    const Vector x = createVector(N, 1);
+    const Vector y0 = createVector(N, 2);
+    const double alpha = -0.75;
+
+    Vector yRef(N);
+    A.mv(x, yRef);
+    Vector yScaleAddRef = y0;
+    A.usmv(alpha, x, yScaleAddRef);
+
+    for (const int numThreads : {1, 2, 4}) {
+        const Opm::ParallelSpMV<Matrix> spmv(A, N, numThreads);
+
+        Vector y(N);
+        y = 1.0;
+        spmv.mv(x, y);
+        for (std::size_t i = 0; i < N; ++i) {
+            for (int k = 0; k < bz; ++k) {
+                BOOST_CHECK_CLOSE(y[i][k], yRef[i][k], 1e-12);
+            }
+        }
+
+        Vector yScaleAdd = y0;
+        spmv.usmv(alpha, x, yScaleAdd);
+        for (std::size_t i = 0; i < N; ++i) {
+            for (int k = 0; k < bz; ++k) {
+                BOOST_CHECK_CLOSE(yScaleAdd[i][k], yScaleAddRef[i][k], 1e-12);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TrailingRowsAreNotTouched)
+{
+    const std::size_t N = 5000;
+    const std::size_t numRows = 4321;
+    const Matrix A = createMatrix(N);
+    const Vector x = createVector(N, 3);
+
+    Vector yRef(N);
+    A.mv(x, yRef);
+
+    const Opm::ParallelSpMV<Matrix> spmv(A, numRows, 3);
+    Vector y(N);
+    y = 7.0;
+    spmv.mv(x, y);
+    for (std::size_t i = 0; i < N; ++i) {
+        for (int k = 0; k < bz; ++k) {
+            if (i < numRows) {
+                BOOST_CHECK_CLOSE(y[i][k], yRef[i][k], 1e-12);
+            } else {
+                BOOST_CHECK_EQUAL(y[i][k], 7.0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(InnerAndBorderRows)
+{
+    const std::size_t N = 5000;
+    const std::size_t numRows = 4321;
+    const Matrix A = createMatrix(N);
+    const Vector x = createVector(N, 4);
+    const Vector y0 = createVector(N, 5);
+    const double alpha = 0.5;
+
+    Vector yRef(N);
+    A.mv(x, yRef);
+    Vector yScaleAddRef = y0;
+    A.usmv(alpha, x, yScaleAddRef);
+
+    for (const int numThreads : {1, 3}) {
+        Opm::ParallelSpMV<Matrix> spmv(A, numRows, numThreads);
+        spmv.splitBorderRows(numRows);
+
+        // the rows whose band reaches the columns after numRows
+        std::vector<std::size_t> expectedBorderRows;
+        for (std::size_t i = 0; i < numRows; ++i) {
+            if (i + 1 + i % 7 >= numRows) {
+                expectedBorderRows.push_back(i);
+            }
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(spmv.borderRows().begin(), spmv.borderRows().end(),
+                                      expectedBorderRows.begin(), expectedBorderRows.end());
+
+        Vector y(N);
+        y = 7.0;
+        spmv.mvInner(x, y);
+        for (const std::size_t i : spmv.borderRows()) {
+            BOOST_CHECK_EQUAL(y[i][0], 7.0);
+        }
+        spmv.mvBorder(x, y);
+
+        Vector yScaleAdd = y0;
+        spmv.usmvInner(alpha, x, yScaleAdd);
+        spmv.usmvBorder(alpha, x, yScaleAdd);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            for (int k = 0; k < bz; ++k) {
+                if (i < numRows) {
+                    BOOST_CHECK_CLOSE(y[i][k], yRef[i][k], 1e-12);
+                    BOOST_CHECK_CLOSE(yScaleAdd[i][k], yScaleAddRef[i][k], 1e-12);
+                } else {
+                    BOOST_CHECK_EQUAL(y[i][k], 7.0);
+                    BOOST_CHECK_EQUAL(yScaleAdd[i][k], y0[i][k]);
+                }
+            }
+        }
+    }
+}
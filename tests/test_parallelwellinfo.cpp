@@ -20,10 +20,12 @@
 #include<config.h>
 
 #include<opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/simulators/wells/WellCommunicationBatch.hpp>
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
 #include <dune/common/version.hh>
+#include <array>
 #include<vector>
 #include<string>
 #include<tuple>
@@ -483,3 +485,98 @@ BOOST_AUTO_TEST_CASE(EmptyWell) {
 
     BOOST_CHECK_EQUAL(local_p, global_p);
 }
+
+BOOST_AUTO_TEST_CASE(WellCommunicationBatchSums)
+{
+    auto comm = Opm::Parallel::Communication(Dune::MPIHelper::getCommunicator());
+    const int rank = comm.rank();
+    const int size = comm.size();
+    const bool first_or_last = rank == 0 || rank == size - 1;
+
+    // Well 0 is on all processes, well 1 only on the first one, and well 2
+    // on the first and the last one.
+    std::vector<int> distributed;
+    if (size > 1) {
+        distributed.push_back(0);
+        if (first_or_last) {
+            distributed.push_back(2);
+        }
+    }
+    Opm::WellCommunicationBatch<double> batch(comm);
+    batch.setWells(3, distributed);
+
+    std::vector<double> result(6, -1.0);
+    auto add = [&](const int well)
+    {
+        const std::array<double, 2> values{1.0, rank + 1.0};
+        batch.add(well, values.data(),
+                  [&result, well](const double* sum)
+                  {
+                      result[2 * well] = sum[0];
+                      result[2 * well + 1] = sum[1];
+                  });
+    };
+    batch.begin(2);
+    add(0);
+    if (rank == 0) {
+        add(1);
+    }
+    if (first_or_last) {
+        add(2);
+    }
+    batch.start();
+    batch.finish();
+
+    BOOST_CHECK_EQUAL(result[0], size);
+    BOOST_CHECK_EQUAL(result[1], size * (size + 1) / 2);
+    if (rank == 0) {
+        BOOST_CHECK_EQUAL(result[2], 1.0);
+        BOOST_CHECK_EQUAL(result[3], 1.0);
+    }
+    if (first_or_last) {
+        BOOST_CHECK_EQUAL(result[4], size > 1 ? 2.0 : 1.0);
+        BOOST_CHECK_EQUAL(result[5], size > 1 ? size + 1.0 : 1.0);
+    }
+    BOOST_CHECK_EQUAL(batch.numCollectives(), size > 1 ? 1u : 0u);
+    BOOST_CHECK_EQUAL(batch.numBatchedSums(), size > 1 ? (first_or_last ? 2u : 1u) : 0u);
+}
+
+BOOST_AUTO_TEST_CASE(WellCommunicationBatchPending)
+{
+    auto comm = Opm::Parallel::Communication(Dune::MPIHelper::getCommunicator());
+    const int size = comm.size();
+
+    std::vector<int> distributed;
+    if (size > 1) {
+        distributed.push_back(0);
+    }
+    Opm::WellCommunicationBatch<double> batch(comm);
+    batch.setWells(1, distributed);
+
+    double result = -1.0;
+    int calls = 0;
+    const auto callback = [&result, &calls](const double* sum)
+    {
+        result = *sum;
+        ++calls;
+    };
+    const double one = 1.0;
+    const double two = 2.0;
+    batch.begin(1);
+    BOOST_CHECK(batch.collecting());
+    // adding a well again replaces its values
+    batch.add(0, &one, callback);
+    batch.add(0, &two, callback);
+    batch.start();
+    BOOST_CHECK(!batch.collecting());
+    BOOST_CHECK(batch.pending());
+
+    // the next batch finishes the pending one
+    batch.begin(1);
+    BOOST_CHECK(!batch.pending());
+    BOOST_CHECK_EQUAL(result, 2.0 * size);
+    BOOST_CHECK_EQUAL(calls, size > 1 ? 1 : 2);
+    BOOST_CHECK_EQUAL(batch.numBatchedSums(), size > 1 ? 1u : 0u);
+    batch.start();
+    batch.finish();
+}
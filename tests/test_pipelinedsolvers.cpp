@@ -0,0 +1,302 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TestPipelinedSolvers
+
+#include <config.h>
+#include <opm/simulators/linalg/FusedReduction.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
+#include <opm/simulators/linalg/PipelinedGMResSolver.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <boost/test/unit_test.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvers.hh>
+
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 2, 2>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+
+// Convection-diffusion operator on an n x n grid, with two weakly coupled
+// unknowns per cell.
+Matrix createMatrix(const int n)
+{
+    const int N = n * n;
+    Matrix A(N, N, 5 * N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int idx = row.index();
+        const int i = idx % n;
+        const int j = idx / n;
+        if (j > 0) row.insert(idx - n);
+        if (i > 0) row.insert(idx - 1);
+        row.insert(idx);
+        if (i < n - 1) row.insert(idx + 1);
+        if (j < n - 1) row.insert(idx + n);
+    }
+    A = 0.0;
+    for (int idx = 0; idx < N; ++idx) {
+        const int i = idx % n;
+        const int j = idx / n;
+        auto& diag = A[idx][idx];
+        diag[0][0] = 4.0;
+        diag[1][1] = 4.5;
+        diag[0][1] = 0.3;
+        diag[1][0] = -0.2;
+        auto offDiag = [&A, idx](int col, double value)
+        {
+            A[idx][col][0][0] = value;
+            A[idx][col][1][1] = value;
+        };
+        if (j > 0) offDiag(idx - n, -1.0);
+        if (i > 0) offDiag(idx - 1, -1.3);
+        if (i < n - 1) offDiag(idx + 1, -0.7);
+        if (j < n - 1) offDiag(idx + n, -1.0);
+    }
+    return A;
+}
+
+Vector createRhs(const std::size_t size)
+{
+    Vector b(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        b[i] = {std::cos(0.1 * i), std::sin(0.05 * i)};
+    }
+    return b;
+}
+
+template <class Solver>
+void checkSolve(Solver& solver, const Matrix& A, const int expectedMaxIterations)
+{
+    const Vector b = createRhs(A.N());
+    Vector rhs = b;
+    Vector x(A.N());
+    x = 0.0;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, rhs, res);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_LE(res.iterations, expectedMaxIterations);
+
+    Vector r = b;
+    A.mmv(x, r);
+    BOOST_CHECK_LT(r.two_norm(), 1e-7 * b.two_norm());
+}
+
+struct MPIFixture
+{
+    MPIFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+        Dune::MPIHelper::instance(argc, argv);
+    }
+};
+
+} // anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+BOOST_AUTO_TEST_CASE(FusedReductionSequential)
+{
+    const Vector a = createRhs(100);
+    Vector b = a;
+    b *= 2.0;
+    Opm::FusedReduction<Vector> reduction(Dune::Amg::SequentialInformation(),
+                                          Dune::SolverCategory::sequential);
+    reduction.start({{&a, &a}, {&a, &b}, {&b, &b}});
+    const auto& dots = reduction.finish();
+    BOOST_REQUIRE_EQUAL(dots.size(), std::size_t{3});
+    BOOST_CHECK_CLOSE(dots[0], a.dot(a), 1e-12);
+    BOOST_CHECK_CLOSE(dots[1], a.dot(b), 1e-12);
+    BOOST_CHECK_CLOSE(dots[2], b.dot(b), 1e-12);
+}
+
+#if HAVE_MPI
+// Each process owns numOwned consecutive global indices and has a copy of
+// the last index of the previous and the first index of the next process,
+// which are stored after the owned ones.
+BOOST_AUTO_TEST_CASE(FusedReductionParallel)
+{
+    using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
+    using Attribute = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+    using LocalIndex = Dune::ParallelLocalIndex<Attribute>;
+
+    Communication comm(MPI_COMM_WORLD);
+    const int rank = comm.communicator().rank();
+    const int size = comm.communicator().size();
+    const int numOwned = 10;
+    const int offset = rank * numOwned;
+
+    std::vector<int> globalIndices;
+    for (int i = 0; i < numOwned; ++i) {
+        globalIndices.push_back(offset + i);
+    }
+    if (rank > 0) {
+        globalIndices.push_back(offset - 1);
+    }
+    if (rank < size - 1) {
+        globalIndices.push_back(offset + numOwned);
+    }
+    comm.indexSet().beginResize();
+    for (std::size_t i = 0; i < globalIndices.size(); ++i) {
+        const Attribute attribute = static_cast<int>(i) < numOwned
+            ? Dune::OwnerOverlapCopyAttributeSet::owner
+            : Dune::OwnerOverlapCopyAttributeSet::copy;
+        comm.indexSet().add(globalIndices[i], LocalIndex(i, attribute, true));
+    }
+    comm.indexSet().endResize();
+    comm.remoteIndices().rebuild<false>();
+
+    auto value = [](const int global, const int component)
+    { return std::cos(0.3 * global + component); };
+    Vector a(globalIndices.size());
+    Vector b(globalIndices.size());
+    for (std::size_t i = 0; i < globalIndices.size(); ++i) {
+        for (int c = 0; c < 2; ++c) {
+            a[i][c] = value(globalIndices[i], c);
+            b[i][c] = value(2 * globalIndices[i] + 1, c);
+        }
+    }
+    // The copies must not count, even if they are not consistent.
+    Vector bGhost = b;
+    for (std::size_t i = numOwned; i < bGhost.size(); ++i) {
+        bGhost[i] = 1.0e6;
+    }
+
+    Opm::FusedReduction<Vector> reduction(comm, Dune::SolverCategory::overlapping);
+    reduction.start({{&a, &a}, {&a, &b}, {&a, &bGhost}});
+
+    // The reduction is in flight while the reference values are computed.
+    double aa = 0.0;
+    double ab = 0.0;
+    for (int global = 0; global < size * numOwned; ++global) {
+        for (int c = 0; c < 2; ++c) {
+            aa += value(global, c) * value(global, c);
+            ab += value(global, c) * value(2 * global + 1, c);
+        }
+    }
+    Dune::OverlappingSchwarzScalarProduct<Vector, Communication> sp(comm);
+    const double abIstl = sp.dot(a, b);
+
+    const auto& dots = reduction.finish();
+    BOOST_REQUIRE_EQUAL(dots.size(), std::size_t{3});
+    BOOST_CHECK_CLOSE(dots[0], aa, 1e-10);
+    BOOST_CHECK_CLOSE(dots[1], ab, 1e-10);
+    BOOST_CHECK_CLOSE(dots[2], ab, 1e-10);
+    BOOST_CHECK_CLOSE(dots[1], abIstl, 1e-10);
+}
+#endif // HAVE_MPI
+
+BOOST_AUTO_TEST_CASE(PipelinedBiCGSTABBreakdown)
+{
+    const Matrix A = createMatrix(5);
+    Operator op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+    Opm::PipelinedBiCGSTABSolver<Vector> solver(op, sp, prec, Dune::Amg::SequentialInformation(),
+                                                1e-8, 100, 0);
+
+    // A zero right hand side makes (r0, w) vanish.
+    Vector x(A.N());
+    x = 0.0;
+    Vector rhs(A.N());
+    rhs = 0.0;
+    Dune::InverseOperatorResult res;
+    BOOST_CHECK_NO_THROW(solver.apply(x, rhs, res));
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_EQUAL(res.iterations, 0);
+
+    // With an exact preconditioner the first half step solves the system,
+    // such that (y, y) vanishes.
+    Matrix I = A;
+    I = 0.0;
+    for (std::size_t i = 0; i < I.N(); ++i) {
+        I[i][i][0][0] = 1.0;
+        I[i][i][1][1] = 1.0;
+    }
+    Operator identity(I);
+    Dune::Richardson<Vector, Vector> richardson(1.0);
+    Opm::PipelinedBiCGSTABSolver<Vector> exact(identity, sp, richardson,
+                                               Dune::Amg::SequentialInformation(),
+                                               1e-8, 100, 0);
+    const Vector b = createRhs(I.N());
+    rhs = b;
+    x = 0.0;
+    BOOST_CHECK_NO_THROW(exact.apply(x, rhs, res));
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_EQUAL(res.iterations, 1);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_SMALL(x[i][0] - b[i][0], 1e-12);
+        BOOST_CHECK_SMALL(x[i][1] - b[i][1], 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PipelinedBiCGSTAB)
+{
+    const Matrix A = createMatrix(30);
+    Operator op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+
+    Dune::BiCGSTABSolver<Vector> reference(op, sp, prec, 1e-8, 500, 0);
+    Vector x(A.N());
+    x = 0.0;
+    Vector rhs = createRhs(A.N());
+    Dune::InverseOperatorResult res;
+    reference.apply(x, rhs, res);
+    BOOST_REQUIRE(res.converged);
+
+    Opm::PipelinedBiCGSTABSolver<Vector> solver(op, sp, prec, Dune::Amg::SequentialInformation(),
+                                                1e-8, 500, 0);
+    checkSolve(solver, A, 2 * res.iterations);
+}
+
+BOOST_AUTO_TEST_CASE(PipelinedGMRes)
+{
+    const Matrix A = createMatrix(30);
+    Operator op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+
+    for (const int restart : {5, 20, 100}) {
+        Dune::RestartedGMResSolver<Vector> reference(op, sp, prec, 1e-8, restart, 1000, 0);
+        Vector x(A.N());
+        x = 0.0;
+        Vector rhs = createRhs(A.N());
+        Dune::InverseOperatorResult res;
+        reference.apply(x, rhs, res);
+        BOOST_REQUIRE(res.converged);
+
+        Opm::PipelinedGMResSolver<Vector> solver(op, sp, prec, Dune::Amg::SequentialInformation(),
+                                                 1e-8, restart, 1000, 0);
+        checkSolve(solver, A, res.iterations + restart);
+    }
+}
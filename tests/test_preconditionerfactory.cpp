@@ -36,6 +36,7 @@
 #include <dune/istl/matrixmarket.hh>
 #include <dune/istl/solvers.hh>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -364,3 +365,82 @@ BOOST_AUTO_TEST_CASE(TestWithRepeatingOperator)
     // Test with 3x3 block solvers.
     test3rep(prm);
 }
+
+
+#if FLOW_INSTANTIATE_FLOAT
+template <int bz>
+M<bz> createLaplaceMatrix(const int n)
+{
+    // 5-point stencil on an n x n grid with a weak coupling between the
+    // components of a block.
+    M<bz> matrix(n * n, n * n, 5 * n * n, M<bz>::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        const int i = row.index() % n;
+        const int j = row.index() / n;
+        if (j > 0) row.insert(row.index() - n);
+        if (i > 0) row.insert(row.index() - 1);
+        row.insert(row.index());
+        if (i < n - 1) row.insert(row.index() + 1);
+        if (j < n - 1) row.insert(row.index() + n);
+    }
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = 0.0;
+            for (int k = 0; k < bz; ++k) {
+                (*col)[k][k] = col.index() == row.index() ? 4.0 + 0.01 * row.index() / n : -1.0;
+                if (col.index() == row.index() && k + 1 < bz) {
+                    (*col)[k][k + 1] = 0.1;
+                }
+            }
+        }
+    }
+    return matrix;
+}
+
+template <int bz>
+int solveIterations(const O<bz>& op, const Opm::PropertyTree& prm, const V<bz>& rhs)
+{
+    auto prec = PF<bz>::create(op, prm);
+    Dune::BiCGSTABSolver<V<bz>> solver(op, *prec, 1e-8, 500, 0);
+    V<bz> x(rhs.size());
+    x = 0.0;
+    V<bz> b = rhs;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, b, res);
+    BOOST_CHECK(res.converged);
+
+    // the solution must have double precision accuracy
+    V<bz> r = rhs;
+    op.getmat().mmv(x, r);
+    BOOST_CHECK_LT(r.two_norm(), 1e-7 * rhs.two_norm());
+    return res.iterations;
+}
+
+BOOST_AUTO_TEST_CASE(TestMixedPrecision)
+{
+    constexpr int bz = 2;
+    const auto matrix = createLaplaceMatrix<bz>(40);
+    O<bz> op(matrix);
+    V<bz> rhs(matrix.N());
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        rhs[i] = {1.0 + i % 5, -0.5 * (i % 3)};
+    }
+
+    for (const std::string type : {"ILU0", "DILU", "amg"}) {
+        Opm::PropertyTree prm;
+        prm.put("type", type);
+        const int iterations = solveIterations<bz>(op, prm, rhs);
+
+        prm.put("mixed_precision", std::string("true"));
+        using MF = Dune::BCRSMatrix<Opm::MatrixBlock<float, bz, bz>>;
+        using VF = Dune::BlockVector<Dune::FieldVector<float, bz>>;
+        using Mixed = Opm::MixedPrecisionPreconditioner<M<bz>, V<bz>, Dune::MatrixAdapter<MF, VF, VF>>;
+        BOOST_CHECK(std::dynamic_pointer_cast<Mixed>(PF<bz>::create(op, prm)) != nullptr);
+        const int mixedIterations = solveIterations<bz>(op, prm, rhs);
+
+        BOOST_TEST_MESSAGE(type << ": " << iterations << " iterations in double, "
+                           << mixedIterations << " with float preconditioner");
+        BOOST_CHECK_LE(mixedIterations, iterations + std::max(2, iterations / 5));
+    }
+}
+#endif
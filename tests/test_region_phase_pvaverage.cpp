@@ -445,6 +445,94 @@ BOOST_AUTO_TEST_CASE(Single_Phase_Full_Varying_PV)
     BOOST_CHECK_CLOSE(avgCalc.value("FIPLRS", p, PVAvg::Region{2}), 3.080203767781622, 1.0e-8);
 }
 
+BOOST_AUTO_TEST_CASE(Single_Phase_Full_Varying_PV_Threaded)
+{
+    const auto x = std::array {
+        // K=1
+        1.0, 1.01, 1.02,
+        1.1, 1.11, 1.12,
+        1.2, 1.21, 1.22,
+
+        // K=2
+        2.0, 2.01, 2.02,
+        2.1, 2.11, 2.12,
+        2.2, 2.21, 2.22,
+
+        // K=3
+        3.0, 3.01, 3.02,
+        3.1, 3.11, 3.12,
+        3.2, 3.21, 3.22,
+    };
+
+    const auto s = std::array {
+        // K=1
+        0.0, 0.1, 0.0,
+        0.1, 0.4, 0.1,
+        0.0, 0.1, 0.0,
+
+        // K=2
+        0.1, 0.0, 0.1,
+        0.0, 0.4, 0.0,
+        0.1, 0.0, 0.1,
+
+        // K=3
+        0.0, 0.0, 0.0,          // s=0 in layer 3 => use PV average instead
+        0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0,
+    };
+
+    const auto pv = std::array {
+        // K=1
+        1729.0,  271.82, 3141.5 ,
+           0.1, 1000.0,   321.09,
+        4321.0, 1234.5,    67.89,
+
+        // K=2
+        0.12, 0.34, 0.56,
+        0.78, 0.90, 1.23,
+        1.45, 1.67, 1.89,
+
+        // K=3
+        500.0, 450.0, 400.0,
+        350.0,   1.0, 300.0,
+        250.0, 200.0, 150.0,
+    };
+
+    auto comm = Opm::Parallel::Communication {
+        Dune::MPIHelper::getCommunicator()
+    };
+
+    const auto rset = RegionSets{};
+    const auto numPhases = std::size_t{1};
+    const auto p = PVAvg::Phase {0};
+
+    auto avgCalc = PVAvg {
+        comm, numPhases, rset.names(), rset
+    };
+
+    avgCalc.prepareAccumulation();
+
+    // Add the cells concurrently, each thread accumulates its own sums
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < static_cast<int>(x.size()); ++c) {
+        const auto cv = PVAvg::CellValue {
+            x[c], s[c], pv[c]
+        };
+
+        avgCalc.addCell(c, p, cv);
+    }
+
+    avgCalc.accumulateParallel();
+
+    BOOST_CHECK_CLOSE(avgCalc.fieldValue(p), 1.128401081038469, 1.0e-8);
+    BOOST_CHECK_CLOSE(avgCalc.value("FIPNUM", p, PVAvg::Region{0}), 1.128401081038469, 1.0e-8);
+    BOOST_CHECK_CLOSE(avgCalc.value("FIPLRS", p, PVAvg::Region{0}), 1.127070395417597, 1.0e-8);
+    BOOST_CHECK_CLOSE(avgCalc.value("FIPLRS", p, PVAvg::Region{1}), 2.146062992125984, 1.0e-8);
+    BOOST_CHECK_CLOSE(avgCalc.value("FIPLRS", p, PVAvg::Region{2}), 3.080203767781622, 1.0e-8);
+}
+
 BOOST_AUTO_TEST_CASE(Three_Phase_All_Present_Full_Varying_PV)
 {
     const auto x = std::array {
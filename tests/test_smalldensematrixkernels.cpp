@@ -0,0 +1,115 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE SmallDenseMatrixKernels
+#include <boost/test/unit_test.hpp>
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <cmath>
+
+namespace {
+
+template <class Block>
+Block createBlock(const double shift)
+{
+    Block A;
+    for (int i = 0; i < Block::rows; ++i) {
+        for (int j = 0; j < Block::cols; ++j) {
+            A[i][j] = std::sin(3.0 * i + j + shift);
+        }
+    }
+    return A;
+}
+
+template <class Block>
+void checkBlockEqual(const Block& A, const Block& B)
+{
+    for (int i = 0; i < Block::rows; ++i) {
+        for (int j = 0; j < Block::cols; ++j) {
+            BOOST_CHECK_SMALL(A[i][j] - B[i][j], 1e-12);
+        }
+    }
+}
+
+// Compare the kernels with the generic implementations of dune-common.
+template <class Block>
+void checkKernels()
+{
+    constexpr int n = Block::rows;
+    using Vector = Dune::FieldVector<typename Block::field_type, n>;
+    const Block A = createBlock<Block>(0.0);
+    const Block B = createBlock<Block>(1.0);
+    Vector x;
+    for (int i = 0; i < n; ++i) {
+        x[i] = 1.0 + i;
+    }
+
+    Vector y;
+    Vector yRef;
+    Opm::detail::mvBlock(A, x, y);
+    A.mv(x, yRef);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(y[i] - yRef[i], 1e-12);
+    }
+
+    Opm::detail::umvBlock(A, x, y);
+    A.umv(x, yRef);
+    Opm::detail::mmvBlock(B, x, y);
+    B.mmv(x, yRef);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(y[i] - yRef[i], 1e-12);
+    }
+
+    Block C = A;
+    Opm::detail::rightMultiplyBlock(C, B);
+    Block CRef = A;
+    CRef.rightmultiply(B);
+    checkBlockEqual(C, CRef);
+
+    Opm::detail::mmmBlock(A, B, C);
+    Block AB = B;
+    AB.leftmultiply(A);
+    CRef -= AB;
+    checkBlockEqual(C, CRef);
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(FieldMatrixKernels)
+{
+    checkKernels<Dune::FieldMatrix<double, 1, 1>>();
+    checkKernels<Dune::FieldMatrix<double, 2, 2>>();
+    checkKernels<Dune::FieldMatrix<double, 3, 3>>();
+    checkKernels<Dune::FieldMatrix<double, 4, 4>>();
+    checkKernels<Dune::FieldMatrix<double, 5, 5>>();
+    checkKernels<Dune::FieldMatrix<double, 6, 6>>();
+}
+
+BOOST_AUTO_TEST_CASE(MatrixBlockKernels)
+{
+    static_assert(Opm::detail::IsFixedSizeBlock<Opm::MatrixBlock<double, 3, 3>>::value);
+    static_assert(!Opm::detail::IsFixedSizeBlock<double>::value);
+    checkKernels<Opm::MatrixBlock<double, 2, 2>>();
+    checkKernels<Opm::MatrixBlock<double, 3, 3>>();
+    checkKernels<Opm::MatrixBlock<double, 4, 4>>();
+}
@@ -0,0 +1,368 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE ThreadedWells
+
+#include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/StreamLog.hpp>
+
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModel.hpp>
+#include <opm/simulators/flow/FlowProblemBlackoil.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/ThreadedWellLoop.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bvector.hh>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+    namespace TTag {
+        struct TestThreadedWellsTypeTag {
+            using InheritsFrom = std::tuple<TestTypeTag>;
+        };
+    }
+}
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename, const bool threaded_wells)
+{
+    using namespace Opm;
+    using Simulator = GetPropType<TypeTag, Properties::Simulator>;
+
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+    const std::string threaded_arg = std::string{"--threaded-wells="} +
+                                     (threaded_wells ? "true" : "false");
+
+    const char* argv[] = {
+        "test_threadedwells",
+        filename_arg.c_str(),
+        threaded_arg.c_str()
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Opm::Parameters::SetDefault<Opm::Parameters::ThreadsPerProcess>(2);
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    FlowGenericVanguard::readDeck(filename);
+    return std::make_unique<Simulator>();
+}
+
+namespace {
+
+struct ThreadedWellsFixture
+{
+    ThreadedWellsFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+using Block = Dune::FieldVector<double, 3>;
+using Vector = Dune::BlockVector<Block>;
+using Matrix = Dune::FieldMatrix<double, 3, 3>;
+
+// A well which perforates a few consecutive cells and contributes
+// M x_local to them, where x_local holds the values of its cells.
+struct TestWell
+{
+    std::vector<int> cells;
+    Matrix m;
+    bool distributed;
+};
+
+std::vector<TestWell> makeWells(const int num_wells, const int num_cells)
+{
+    std::vector<TestWell> wells(num_wells);
+    for (int w = 0; w < num_wells; ++w) {
+        // neighbouring wells perforate common cells
+        for (int i = 0; i < 3; ++i) {
+            wells[w].cells.push_back((2*w + i) % num_cells);
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                wells[w].m[i][j] = 1.0 / (1.0 + w + 2*i + 3*j);
+            }
+        }
+        wells[w].distributed = (w % 3 == 1);
+    }
+    return wells;
+}
+
+// Compute the contribution of a well to its own buffer. Distributed wells
+// sum their contribution over the processes, like the wells whose
+// perforations are shared with other processes.
+void applyWell(const TestWell& well, const Vector& x, Vector& Ax_local,
+               const Opm::Parallel::Communication& comm)
+{
+    Ax_local.resize(well.cells.size());
+    Ax_local = 0.0;
+    for (std::size_t i = 0; i < well.cells.size(); ++i) {
+        well.m.umv(x[well.cells[i]], Ax_local[i]);
+    }
+    if (well.distributed) {
+        for (auto& block : Ax_local) {
+            comm.sum(&block[0], block.size());
+        }
+    }
+}
+
+void initLogger(std::ostringstream& log_stream)
+{
+    Opm::OpmLog::removeAllBackends();
+    auto stream_log = std::make_shared<Opm::StreamLog>(log_stream, Opm::Log::DefaultMessageTypes);
+    Opm::OpmLog::addBackend("STREAM", stream_log);
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(ThreadedWellsFixture);
+
+BOOST_AUTO_TEST_CASE(LoopMatchesSequential)
+{
+    const Opm::Parallel::Communication comm;
+    const int num_cells = 20;
+    const int num_wells = 13;
+    const auto wells = makeWells(num_wells, num_cells);
+
+    Vector x(num_cells);
+    for (int c = 0; c < num_cells; ++c) {
+        for (int i = 0; i < 3; ++i) {
+            x[c][i] = 1.0 + 0.1*c - 0.7*i + comm.rank();
+        }
+    }
+
+    // sequential reference
+    Vector Ax_seq(num_cells);
+    Ax_seq = 0.0;
+    std::ostringstream log_seq;
+    {
+        initLogger(log_seq);
+        Opm::DeferredLogger logger;
+        Vector Ax_local;
+        for (int w = 0; w < num_wells; ++w) {
+            applyWell(wells[w], x, Ax_local, comm);
+            logger.info("well " + std::to_string(w));
+            for (std::size_t i = 0; i < wells[w].cells.size(); ++i) {
+                Ax_seq[wells[w].cells[i]] += Ax_local[i];
+            }
+        }
+        logger.logMessages();
+    }
+
+    // threaded loop, the buffers are added in the order of the wells
+    Vector Ax_thr(num_cells);
+    Ax_thr = 0.0;
+    std::ostringstream log_thr;
+    {
+        initLogger(log_thr);
+        Opm::DeferredLogger logger;
+        std::vector<Vector> Ax_local(num_wells);
+        Opm::threadedWellLoop(num_wells,
+                              [&wells](const int w) { return wells[w].distributed; },
+                              [&](const int w, Opm::DeferredLogger& well_logger)
+                              {
+                                  applyWell(wells[w], x, Ax_local[w], comm);
+                                  well_logger.info("well " + std::to_string(w));
+                              }, logger);
+        for (int w = 0; w < num_wells; ++w) {
+            for (std::size_t i = 0; i < wells[w].cells.size(); ++i) {
+                Ax_thr[wells[w].cells[i]] += Ax_local[w][i];
+            }
+        }
+        logger.logMessages();
+    }
+
+    for (int c = 0; c < num_cells; ++c) {
+        for (int i = 0; i < 3; ++i) {
+            BOOST_CHECK_EQUAL(Ax_thr[c][i], Ax_seq[c][i]);
+        }
+    }
+    BOOST_CHECK_EQUAL(log_thr.str(), log_seq.str());
+}
+
+BOOST_AUTO_TEST_CASE(LoopRethrowsFirstException)
+{
+    const int num_wells = 10;
+    std::vector<int> called(num_wells, 0);
+    Opm::DeferredLogger logger;
+    try {
+        Opm::threadedWellLoop(num_wells,
+                              [](const int w) { return w == 7; },
+                              [&called](const int w, Opm::DeferredLogger&)
+                              {
+                                  called[w] = 1;
+                                  if (w == 3 || w == 7) {
+                                      throw std::runtime_error("well " + std::to_string(w));
+                                  }
+                              }, logger);
+        BOOST_FAIL("No exception was thrown");
+    }
+    catch (const std::runtime_error& e) {
+        BOOST_CHECK_EQUAL(std::string(e.what()), "well 3");
+    }
+    // all wells are processed even if one of them fails
+    for (int w = 0; w < num_wells; ++w) {
+        BOOST_CHECK_EQUAL(called[w], 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LoopReusesBuffers)
+{
+    const int num_wells = 4;
+    const auto not_distributed = [](const int) { return false; };
+    std::vector<Opm::DeferredLogger> well_loggers;
+    std::vector<std::exception_ptr> well_exceptions;
+    Opm::DeferredLogger logger;
+    BOOST_CHECK_THROW(Opm::threadedWellLoop(num_wells, not_distributed,
+                                            [](const int w, Opm::DeferredLogger& well_logger)
+                                            {
+                                                well_logger.info("first " + std::to_string(w));
+                                                if (w == 1) {
+                                                    throw std::runtime_error("well 1");
+                                                }
+                                            }, logger, well_loggers, well_exceptions),
+                      std::runtime_error);
+    logger.clearMessages();
+
+    // neither the messages nor the exception of the first call are kept
+    std::ostringstream log;
+    initLogger(log);
+    Opm::threadedWellLoop(num_wells, not_distributed,
+                          [](const int w, Opm::DeferredLogger& well_logger)
+                          {
+                              well_logger.info("second " + std::to_string(w));
+                          }, logger, well_loggers, well_exceptions);
+    logger.logMessages();
+    BOOST_CHECK(log.str().find("first") == std::string::npos);
+    BOOST_CHECK(log.str().find("second 3") != std::string::npos);
+}
+
+// Assemble the wells of GLIFT1.DATA, apply them and update their solution,
+// once with and once without threaded wells.
+BOOST_AUTO_TEST_CASE(WellModelMatchesSequential)
+{
+    using TypeTag = Opm::Properties::TTag::TestThreadedWellsTypeTag;
+    using WellModel = Opm::BlackoilWellModel<TypeTag>;
+    using BVector = typename WellModel::BVector;
+
+    struct Result
+    {
+        BVector Ax;
+        std::vector<double> bhp;
+        std::vector<double> rates;
+    };
+
+    const auto run = [](const bool threaded)
+    {
+        auto simulator = initSimulator<TypeTag>("GLIFT1.DATA", threaded);
+        simulator->model().applyInitialSolution();
+        simulator->setEpisodeIndex(-1);
+        simulator->setEpisodeLength(0.0);
+        simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+        simulator->setTimeStepSize(43200);  // 12 hours
+        simulator->model().newtonMethod().setIterationIndex(0);
+        WellModel& well_model = simulator->problem().wellModel();
+        well_model.beginReportStep(/*report_step_idx=*/0);
+        well_model.beginTimeStep();
+
+        // assemble
+        well_model.beginIteration();
+
+        const std::size_t num_cells = simulator->model().numTotalDof();
+        BVector x(num_cells);
+        for (std::size_t c = 0; c < num_cells; ++c) {
+            for (std::size_t i = 0; i < x[c].size(); ++i) {
+                x[c][i] = 1.0e-3 * ((c % 7) + 1) * (i + 1);
+            }
+        }
+
+        Result result;
+        result.Ax.resize(num_cells);
+        result.Ax = 0.0;
+        well_model.apply(x, result.Ax);
+
+        well_model.postSolve(x);
+        const auto& well_state = well_model.wellState();
+        for (std::size_t w = 0; w < well_state.size(); ++w) {
+            const auto& ws = well_state.well(w);
+            result.bhp.push_back(ws.bhp);
+            result.rates.insert(result.rates.end(),
+                                ws.surface_rates.begin(), ws.surface_rates.end());
+        }
+        return result;
+    };
+
+    const Result seq = run(false);
+    const Result thr = run(true);
+
+    BOOST_REQUIRE_EQUAL(thr.Ax.size(), seq.Ax.size());
+    for (std::size_t c = 0; c < seq.Ax.size(); ++c) {
+        for (std::size_t i = 0; i < seq.Ax[c].size(); ++i) {
+            BOOST_CHECK_CLOSE(thr.Ax[c][i], seq.Ax[c][i], 1.0e-12);
+        }
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(thr.bhp.begin(), thr.bhp.end(),
+                                  seq.bhp.begin(), seq.bhp.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(thr.rates.begin(), thr.rates.end(),
+                                  seq.rates.begin(), seq.rates.end());
+}
@@ -0,0 +1,157 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TestUpwindOrderedSolver
+
+#include <config.h>
+#include <opm/simulators/linalg/UpwindOrderedSolver.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <boost/test/unit_test.hpp>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 2, 2>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+using Solver = Opm::UpwindOrderedSolver<Matrix, Vector>;
+
+// Upwind discretization of a transport equation on a 1D chain of cells
+// where cell perm[k] is the k-th cell in flow direction. The flux from
+// cell perm[k] to cell perm[k+1] is 1, the blocks of the downstream
+// neighbours are stored but zero. If cycleLength > 1, cell
+// perm[cycleLength-1] also flows back into cell perm[0] with a flux of 1/2.
+Matrix createChainMatrix(const std::vector<int>& perm, const std::size_t cycleLength = 0)
+{
+    const std::size_t n = perm.size();
+    std::vector<std::vector<int>> neighbours(n);
+    auto connect = [&neighbours](const int i, const int j)
+    {
+        neighbours[i].push_back(j);
+        neighbours[j].push_back(i);
+    };
+    for (std::size_t k = 0; k + 1 < n; ++k) {
+        connect(perm[k], perm[k + 1]);
+    }
+    if (cycleLength > 2) {
+        connect(perm[0], perm[cycleLength - 1]);
+    }
+
+    Matrix A(n, n, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        row.insert(row.index());
+        for (const int nb : neighbours[row.index()]) {
+            row.insert(nb);
+        }
+    }
+    A = 0.0;
+
+    auto addFlux = [&A](const int up, const int down, const double flux)
+    {
+        for (int i = 0; i < 2; ++i) {
+            A[up][up][i][i] += flux;
+            A[down][up][i][i] -= flux;
+        }
+    };
+    for (std::size_t k = 0; k < n; ++k) {
+        // storage
+        A[k][k][0][0] += 1.0;
+        A[k][k][1][1] += 2.0;
+    }
+    for (std::size_t k = 0; k + 1 < n; ++k) {
+        addFlux(perm[k], perm[k + 1], 1.0);
+    }
+    if (cycleLength > 1) {
+        addFlux(perm[cycleLength - 1], perm[0], 0.5);
+    }
+    return A;
+}
+
+std::vector<int> createPermutation(const std::size_t n)
+{
+    std::vector<int> perm(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        perm[k] = (7 * k + 3) % n;
+    }
+    return perm;
+}
+
+double residualNorm(const Matrix& A, const Vector& x, const Vector& b)
+{
+    Vector r = b;
+    A.mmv(x, r);
+    return r.two_norm();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(AcyclicOrderFollowsFlow)
+{
+    const std::size_t n = 20;
+    const auto perm = createPermutation(n);
+    const Matrix A = createChainMatrix(perm);
+
+    const Solver solver(A, 1e-10, 100);
+    BOOST_CHECK_EQUAL(solver.numComponents(), n);
+    BOOST_CHECK_EQUAL(solver.largestComponentSize(), std::size_t{1});
+    BOOST_CHECK_EQUAL_COLLECTIONS(solver.ordering().begin(), solver.ordering().end(),
+                                  perm.begin(), perm.end());
+
+    Vector b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        b[i] = {1.0 + i, 2.0 - i};
+    }
+    Vector x(n);
+    BOOST_CHECK(solver.apply(x, b));
+    BOOST_CHECK_SMALL(residualNorm(A, x, b), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(CycleIsSolvedAsOneComponent)
+{
+    const std::size_t n = 12;
+    const auto perm = createPermutation(n);
+
+    const std::size_t cycleLength = 5;
+    const Matrix A = createChainMatrix(perm, cycleLength);
+
+    const Solver solver(A, 1e-12, 100);
+    BOOST_CHECK_EQUAL(solver.numComponents(), n - cycleLength + 1);
+    BOOST_CHECK_EQUAL(solver.largestComponentSize(), cycleLength);
+
+    // the cycle comes first, then the remaining cells in flow order
+    const auto& order = solver.ordering();
+    std::vector<int> cycle(order.begin(), order.begin() + cycleLength);
+    std::vector<int> expectedCycle(perm.begin(), perm.begin() + cycleLength);
+    std::sort(cycle.begin(), cycle.end());
+    std::sort(expectedCycle.begin(), expectedCycle.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(cycle.begin(), cycle.end(),
+                                  expectedCycle.begin(), expectedCycle.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin() + cycleLength, order.end(),
+                                  perm.begin() + cycleLength, perm.end());
+
+    Vector b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        b[i] = {1.0, 0.5 * i};
+    }
+    Vector x(n);
+    BOOST_CHECK(solver.apply(x, b));
+    BOOST_CHECK_SMALL(residualNorm(A, x, b), 1e-8);
+}
@@ -23,6 +23,8 @@
 #define BOOST_TEST_MODULE VFPTest
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <map>
@@ -100,6 +102,25 @@ BOOST_AUTO_TEST_CASE(findInterpData)
     BOOST_CHECK_EQUAL(eval5.factor_, 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(findInterpDataHint)
+{
+    std::vector<double> values = {1, 5, 7, 9, 11, 15};
+    std::vector<double> samples = {-1, 1, 3, 5, 6, 7, 9, 10, 11, 15, 19};
+
+    // The interval found must not depend on the starting guess.
+    for (const double value : samples) {
+        const auto expected = Opm::VFPHelpers<double>::findInterpData(value, values);
+        for (int hint = -1; hint < static_cast<int>(values.size()) + 1; ++hint) {
+            int h = hint;
+            const auto eval = Opm::VFPHelpers<double>::findInterpData(value, values, h);
+            BOOST_CHECK_EQUAL(eval.ind_[0], expected.ind_[0]);
+            BOOST_CHECK_EQUAL(eval.ind_[1], expected.ind_[1]);
+            BOOST_CHECK_EQUAL(eval.factor_, expected.factor_);
+            BOOST_CHECK_EQUAL(h, expected.ind_[0]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperTests
 
 
@@ -571,6 +592,45 @@ BOOST_AUTO_TEST_CASE(ExplicitBhpLookup)
     BOOST_CHECK_CLOSE(bhp_val, bhp_val_explicit, max_d_tol);
 }
 
+BOOST_AUTO_TEST_CASE(BatchAndBracketedBhpLookup)
+{
+    fillDataRandom();
+    initProperties();
+
+    double thp = 0.5;
+    double alq = 0.3;
+    double wfr = 0.7;
+    double gfr = 0.2;
+
+    // Rates sweeping back and forth through the flo axis and beyond.
+    Opm::detail::VFPProdPoints<double> points;
+    points.resize(40);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points.flo[i] = 0.05 + 1.2 * std::abs(std::sin(0.3 * i));
+        points.thp[i] = thp;
+        points.wfr[i] = wfr;
+        points.gfr[i] = gfr;
+        points.alq[i] = alq;
+    }
+
+    std::vector<VFPEvaluation> batch;
+    properties->bhp(1, points, batch);
+    BOOST_REQUIRE_EQUAL(batch.size(), points.size());
+
+    Opm::detail::VFPBrackets brackets;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        // Producer rates are negative, oil rate is the flo.
+        const double liquid = -points.flo[i];
+        const double aqua = wfr * liquid;
+        const double vapour = gfr * liquid;
+        const double bhp_val = properties->bhp(1, aqua, liquid, vapour, thp, alq, 0, 0, false);
+        const double bhp_bracketed = properties->bhp(1, aqua, liquid, vapour, thp, alq,
+                                                     0, 0, false, &brackets);
+        BOOST_CHECK_EQUAL(bhp_bracketed, bhp_val);
+        BOOST_CHECK_CLOSE(batch[i].value, bhp_val, max_d_tol);
+    }
+}
+
 
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
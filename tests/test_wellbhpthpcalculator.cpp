@@ -0,0 +1,170 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE WellBhpThpCalculatorTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/input/eclipse/Units/Units.hpp>
+#include <opm/simulators/wells/WellBhpThpCalculator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace {
+
+using Calculator = Opm::WellBhpThpCalculator<double>;
+using Cache = Opm::BhpAtThpLimitCache<double>;
+
+constexpr double bar = Opm::unit::barsa;
+// the tolerance of the solver
+constexpr double bhp_tolerance = 0.01 * bar;
+
+const std::array<double, 2> range {50.0 * bar, 300.0 * bar};
+
+bool alwaysValid(const double) { return true; }
+
+void checkCounts(const Cache& cache, const std::size_t hits,
+                 const std::size_t warm_starts, const std::size_t misses)
+{
+    BOOST_CHECK_EQUAL(cache.hits, hits);
+    BOOST_CHECK_EQUAL(cache.warm_starts, warm_starts);
+    BOOST_CHECK_EQUAL(cache.misses, misses);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(NoPreviousSolution)
+{
+    Cache cache;
+    const auto eq = [](const double bhp) { return 150.0 * bar - bhp; };
+    const auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                        range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    checkCounts(cache, 0, 0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SkipIfSolutionStillHolds)
+{
+    const double root = 150.0 * bar;
+    const auto eq = [root](const double bhp) { return 0.3 * (root - bhp); };
+    Cache cache;
+    cache.bhp = root + 0.02 * bar;
+    for (int i = 0; i < 3; ++i) {
+        const auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                            range, range[0], 100);
+        BOOST_REQUIRE(bhp.has_value());
+        BOOST_CHECK_EQUAL(*bhp, root + 0.02 * bar);
+    }
+    checkCounts(cache, 3, 0, 0);
+}
+
+BOOST_AUTO_TEST_CASE(BracketExpansion)
+{
+    // The first step is 4.5 bar. The bracket is found after doubling it
+    // twice, on the side of the preferred end for producers and injectors.
+    const double root = 150.0 * bar;
+    const auto eq = [root](const double bhp) { return 0.3 * (root - bhp); };
+    for (const double preferred_end : range) {
+        const double side = preferred_end == range[0] ? 1.0 : -1.0;
+        Cache cache;
+        cache.bhp = root + side * 15.0 * bar;
+        const auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                            range, preferred_end, 100);
+        BOOST_REQUIRE(bhp.has_value());
+        BOOST_CHECK_SMALL(*bhp - root, bhp_tolerance);
+        BOOST_REQUIRE(cache.bhp.has_value());
+        BOOST_CHECK_EQUAL(*cache.bhp, *bhp);
+        checkCounts(cache, 0, 1, 0);
+
+        // the next solve with the same equation skips
+        const auto again = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                              range, preferred_end, 100);
+        BOOST_REQUIRE(again.has_value());
+        BOOST_CHECK_EQUAL(*again, *bhp);
+        checkCounts(cache, 1, 1, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NoBracket)
+{
+    // eq does not change sign within six expansions around the solution
+    const auto eq = [](const double) { return 10.0 * bar; };
+    Cache cache;
+    cache.bhp = 150.0 * bar;
+    const auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                        range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    BOOST_CHECK_EQUAL(*cache.bhp, 150.0 * bar);
+    checkCounts(cache, 0, 0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RejectSolutionAwayFromPreferredEnd)
+{
+    // Two solutions at 100 and 200 bar. The solve from scratch picks the one
+    // closest to the preferred end, hence the other one must not be reused.
+    const double root1 = 100.0 * bar;
+    const double root2 = 200.0 * bar;
+    const auto eq = [root1, root2](const double bhp)
+    { return (bhp - root1) * (root2 - bhp) / (100.0 * bar); };
+
+    Cache cache;
+    cache.bhp = root2;
+    auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                                  range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    checkCounts(cache, 0, 0, 1);
+
+    // also after solving in a bracket
+    cache.bhp = root2 + 5.0 * bar;
+    bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                             range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    checkCounts(cache, 0, 0, 2);
+
+    // the solution closest to the preferred end is accepted
+    cache.bhp = root1;
+    bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, alwaysValid,
+                                             range, range[0], 100);
+    BOOST_REQUIRE(bhp.has_value());
+    BOOST_CHECK_EQUAL(*bhp, root1);
+    checkCounts(cache, 1, 0, 2);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidSolution)
+{
+    const double root = 150.0 * bar;
+    const auto eq = [root](const double bhp) { return 0.3 * (root - bhp); };
+    const auto valid = [root](const double bhp) { return bhp > root + 1.0 * bar; };
+    Cache cache;
+
+    cache.bhp = root;
+    auto bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, valid,
+                                                  range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    checkCounts(cache, 0, 0, 1);
+
+    cache.bhp = root + 15.0 * bar;
+    bhp = Calculator::warmStartBhpAtThpLimit(cache, eq, valid,
+                                             range, range[0], 100);
+    BOOST_CHECK(!bhp.has_value());
+    BOOST_CHECK_EQUAL(*cache.bhp, root + 15.0 * bar);
+    checkCounts(cache, 0, 0, 2);
+}
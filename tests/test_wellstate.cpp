@@ -32,6 +32,7 @@
 
 #include <opm/input/eclipse/Python/Python.hpp>
 
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/input/eclipse/Schedule/MSW/WellSegments.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/SummaryState.hpp>
@@ -41,12 +42,14 @@
 #include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
 
 #include <opm/simulators/wells/GlobalWellInfo.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/PerfData.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
 #include <opm/simulators/wells/SegmentState.hpp>
 #include <opm/simulators/wells/SingleWellState.hpp>
 #include <opm/simulators/wells/WellContainer.hpp>
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <opm/simulators/utils/BlackoilPhases.hpp>
@@ -70,6 +73,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 BOOST_GLOBAL_FIXTURE(MPIFixture);
@@ -625,6 +629,99 @@ BOOST_AUTO_TEST_CASE(TestSingleWellState) {
 
 
 
+BOOST_AUTO_TEST_CASE(TestGroupTree) {
+    const auto deck = Opm::Parser{}.parseString(R"(
+RUNSPEC
+OIL
+GAS
+WATER
+DIMENS
+   10 10  5  /
+GRID
+DXV
+10*1000.0 /
+DYV
+10*1000.0 /
+DZV
+10.0 20.0 30.0 10.0 5.0 /
+TOPS
+  100*10 /
+PERMX
+   500*0.25 /
+COPY
+  PERMX PERMY /
+  PERMX PERMZ /
+/
+PORO
+  500*0.15 /
+SCHEDULE
+GRUPTREE
+ 'PLAT' 'FIELD' /
+ 'G1' 'PLAT' /
+ 'G2' 'PLAT' /
+/
+WELSPECS
+    'INJ1'  'G1'   1  1    8335 'GAS'  /
+    'PROD1' 'G2'  10 10    8400 'OIL'  /
+    'PROD2' 'G2'   5  5    8400 'OIL'  /
+/
+COMPDAT
+    'INJ1'   1  1 1  1 'OPEN' 1   10.6092   0.5  /
+    'PROD1'  10 3 3  3 'OPEN' 0   10.6092   0.5  /
+    'PROD2'  5  3 1  3 'OPEN' 0   10.6092   0.5  /
+/
+GEFAC
+ 'G1' 0.8 /
+ 'PLAT' 0.5 /
+/
+TSTEP
+  10 /
+END
+)");
+    const Setup setup{ deck };
+    const auto& sched = setup.sched;
+    const Opm::GroupTree tree(sched, 0);
+
+    BOOST_CHECK_EQUAL(tree.reportStep(), 0);
+    const int field = tree.groupIndex("FIELD");
+    const int plat = tree.groupIndex("PLAT");
+    const int g1 = tree.groupIndex("G1");
+    const int g2 = tree.groupIndex("G2");
+    BOOST_REQUIRE(field >= 0 && plat >= 0 && g1 >= 0 && g2 >= 0);
+    BOOST_CHECK_EQUAL(tree.groupIndex("NOSUCHGROUP"), -1);
+    BOOST_CHECK_EQUAL(tree.parent(field), -1);
+    BOOST_CHECK_EQUAL(tree.parent(plat), field);
+    BOOST_CHECK_EQUAL(tree.parent(g1), plat);
+    BOOST_CHECK_EQUAL(tree.childGroups(plat).size(), 2U);
+    BOOST_CHECK(tree.childWells(plat).empty());
+    BOOST_CHECK_EQUAL(tree.childWells(g2).size(), 2U);
+    BOOST_CHECK_EQUAL(tree.wellGroup(tree.wellIndex("PROD2")), g2);
+    BOOST_CHECK_EQUAL(tree.parentName("INJ1"), "G1");
+    BOOST_CHECK_EQUAL(tree.parentName("PLAT"), "FIELD");
+    BOOST_CHECK_EQUAL(tree.parentName("FIELD"), "");
+
+    // The tree gives the same results as the lookups in the schedule.
+    const std::vector<std::pair<std::string, std::string>> chains {
+        {"PROD1", "FIELD"}, {"INJ1", "PLAT"}, {"G2", "FIELD"}
+    };
+    for (const auto& [bottom, top] : chains) {
+        const auto expected = Opm::WellGroupHelpers<double>::groupChainTopBot(bottom, top, sched, 0);
+        const auto chain = tree.chainTopBot(bottom, top);
+        BOOST_CHECK_EQUAL_COLLECTIONS(chain.begin(), chain.end(), expected.begin(), expected.end());
+    }
+    for (const int group : {field, plat, g1, g2}) {
+        double expected = 1.0;
+        Opm::WellGroupHelpers<double>::
+            accumulateGroupEfficiencyFactor(sched.getGroup(tree.groupName(group), 0),
+                                            sched, 0, expected);
+        double factor = 1.0;
+        Opm::WellGroupHelpers<double>::accumulateGroupEfficiencyFactor(tree, group, factor);
+        BOOST_CHECK_EQUAL(factor, expected);
+    }
+    BOOST_CHECK_CLOSE(tree.efficiencyFactor(g1), 0.8, 1e-12);
+}
+
+
 BOOST_AUTO_TEST_CASE(TestPU) {
     Opm::PhaseUsage pu({Opm::BlackoilPhases::Polymer, Opm::BlackoilPhases::Solvent, Opm::BlackoilPhases::Aqua, Opm::BlackoilPhases::ZFraction});
 